@@ -6,7 +6,6 @@
 
 #include "../src/Graphics/Animations/Bone.cpp"
 #include "../src/Graphics/Animations/AnimationClip.cpp"
-#include "../src/Graphics/Animations/AnimationKey.cpp"
 #include "../src/Graphics/Animations/Animator.cpp"
 #include "../src/Graphics/Animations/Skeleton.cpp"
 #include "../src/Graphics/Animations/AnimationPose.cpp"
@@ -18,4 +17,5 @@
 #include "../src/Graphics/Animations/AnimationStateMachine.cpp"
 #include "../src/Graphics/Animations/AnimationState.cpp"
 #include "../src/Graphics/Animations/BoneComponent.cpp"
-#include "../src/Graphics/Animations/AnimationCommon.cpp"
\ No newline at end of file
+#include "../src/Graphics/Animations/AnimationCommon.cpp"
+#include "../src/Graphics/Animations/SkinningBuffer.cpp"
\ No newline at end of file
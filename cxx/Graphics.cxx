@@ -13,6 +13,7 @@
 #include "../src/Graphics/Lighting/SpotLight.cpp"
 #include "../src/Graphics/Lighting/AreaLight.cpp"
 #include "../src/Graphics/Lighting/ProbeLight.cpp"
+#include "../src/Graphics/Lighting/LightClusters.cpp"
 #include "../src/Graphics/Lighting/LightSystem.cpp"
 
 #include "../src/Graphics/Loaders/FbxLoader.cpp"
@@ -40,6 +41,7 @@
 #include "../src/Graphics/Font/ITextComponent.cpp"
 #include "../src/Graphics/Font/TextBuilder.cpp"
 #include "../src/Graphics/Font/Glyph.cpp"
+#include "../src/Graphics/Font/GlyphCache.cpp"
 #include "../src/Graphics/Font/FreeType.cpp"
 
 #include "../src/Graphics/UI/Canvas.cpp"
@@ -66,6 +68,7 @@
 
 #include "../src/Graphics/Types/Geometry/DebugWireframeMesh.cpp"
 #include "../src/Graphics/Types/Geometry/DebugLine.cpp"
+#include "../src/Graphics/Types/Geometry/DebugLineBatch.cpp"
 #include "../src/Graphics/Types/Geometry/IndexedMesh.cpp"
 #include "../src/Graphics/Types/Geometry/ProceduralMesh.cpp"
 #include "../src/Graphics/Types/Geometry/Mesh3D.cpp"
@@ -91,7 +94,11 @@
 #include "../src/Graphics/Material/UniqueMaterial.cpp"
 
 #include "../src/Graphics/Utils/MeshUtils.cpp"
+#include "../src/Graphics/Utils/RectPacker.cpp"
 #include "../src/Graphics/Utils/AtlasBuilder.cpp"
+#include "../src/Graphics/Utils/MeshSimplifier.cpp"
+#include "../src/Graphics/Utils/MeshLodCache.cpp"
+#include "../src/Graphics/Utils/ParallelFor.cpp"
 
 #include "../src/Graphics/Window/Window.cpp"
 #include "../src/Graphics/Window/BasicWindowImpl.cpp"
@@ -13,4 +13,5 @@
 #include "../src/Graphics/SRSL/TypeInfo.cpp"
 #include "../src/Graphics/SRSL/Evaluator.cpp"
 #include "../src/Graphics/SRSL/PreProcessor.cpp"
-#include "../src/Graphics/SRSL/ShaderVariables.cpp"
\ No newline at end of file
+#include "../src/Graphics/SRSL/ShaderVariables.cpp"
+#include "../src/Graphics/SRSL/CompilationContext.cpp"
\ No newline at end of file
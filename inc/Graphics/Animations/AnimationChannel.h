@@ -20,8 +20,17 @@ namespace SR_ANIMATIONS_NS {
     class AnimationKey;
     class AnimationPose;
 
+    /**
+     * Канал анимирует одно свойство (перемещение, поворот или масштаб) одного объекта.
+     * Ключи хранятся раздельными потоками: времена отдельно от значений, чтобы поиск ключа
+     * проходил только по плотному массиву времен. Индекс ключа, возвращаемый из UpdateChannel,
+     * служит курсором воспроизведения: при обычном проигрывании ключ ищется шагом от курсора,
+     * при перемотке назад или далеко вперед - бинарным поиском.
+    */
     class AnimationChannel final : public SR_UTILS_NS::NonCopyable {
-        using Keys = std::vector<UnionAnimationKey>;
+        /// Если время ушло дальше чем на столько ключей от курсора, то шагать дольше, чем искать
+        static constexpr uint32_t SEEK_KEYS_THRESHOLD = 8;
+
     public:
         ~AnimationChannel() override;
 
@@ -31,9 +40,11 @@ namespace SR_ANIMATIONS_NS {
         SR_NODISCARD AnimationChannel* Copy() const noexcept {
             auto&& pChannel = new AnimationChannel();
 
-            for (auto&& key : m_keys) {
-                pChannel->m_keys.emplace_back(key);
-            }
+            pChannel->m_type = m_type;
+            pChannel->m_times = m_times;
+            pChannel->m_translations = m_translations;
+            pChannel->m_rotations = m_rotations;
+            pChannel->m_scales = m_scales;
 
             pChannel->m_name = m_name;
             pChannel->m_boneIndex = m_boneIndex;
@@ -44,26 +55,68 @@ namespace SR_ANIMATIONS_NS {
         void SetName(SR_UTILS_NS::StringAtom name);
         void SetBoneIndex(uint16_t index) { m_boneIndex = index; }
 
-        template<class T> void AddKey(double_t timePoint, T key) {
-            auto&& newKey = m_keys.emplace_back();
-            newKey.time = static_cast<float_t>(timePoint);
-            newKey.SetData(key);
+        template<class T> void AddKey(double_t timePoint, const T& key) {
+            if constexpr (std::is_same_v<T, TranslationKey>) {
+                if (!SetKeyType(AnimationKeyType::Translation)) {
+                    return;
+                }
+                m_translations.emplace_back(key.translation);
+            }
+            else if constexpr (std::is_same_v<T, RotationKey>) {
+                if (!SetKeyType(AnimationKeyType::Rotation)) {
+                    return;
+                }
+                m_rotations.emplace_back(key.rotation);
+            }
+            else if constexpr (std::is_same_v<T, ScalingKey>) {
+                if (!SetKeyType(AnimationKeyType::Scaling)) {
+                    return;
+                }
+                m_scales.emplace_back(key.scaling);
+            }
+            else {
+                SRHalt("Unknown key type!");
+                return;
+            }
+
+            m_times.emplace_back(static_cast<float_t>(timePoint));
         }
 
         SR_NODISCARD uint32_t UpdateChannel(uint32_t keyIndex, float_t time, UpdateContext& context, ChannelUpdateContext& channelContext) const;
         SR_NODISCARD uint32_t UpdateChannelWithWeight(uint32_t keyIndex, float_t time, UpdateContext& context, ChannelUpdateContext& channelContext) const;
 
     public:
-        SR_NODISCARD const Keys& GetKeys() const { return m_keys; }
+        SR_NODISCARD AnimationKeyType GetKeyType() const noexcept { return m_type; }
+        SR_NODISCARD const std::vector<float_t>& GetTimes() const noexcept { return m_times; }
+        SR_NODISCARD uint32_t GetKeysCount() const noexcept { return static_cast<uint32_t>(m_times.size()); }
+        SR_NODISCARD float_t GetDuration() const noexcept { return m_times.empty() ? 0.f : m_times.back(); }
 
         SR_NODISCARD SR_FORCE_INLINE SR_UTILS_NS::StringAtom GetGameObjectName() const noexcept { return m_name; }
         SR_NODISCARD SR_FORCE_INLINE uint16_t GetBoneIndex() const noexcept { return m_boneIndex.value_or(SR_UINT16_MAX); }
         SR_NODISCARD SR_FORCE_INLINE bool HasBoneIndex() const noexcept { return m_boneIndex.has_value(); }
 
+    private:
+        bool SetKeyType(AnimationKeyType type);
+
+        /// Сдвигает курсор к первому ключу, время которого не меньше time, и применяет значение
+        template<bool Weighted, typename T> SR_NODISCARD uint32_t UpdateStream(
+            const std::vector<T>& values, uint32_t keyIndex, float_t time, UpdateContext& context, AnimationGameObjectData& data) const;
+
+        template<bool Weighted, typename T> void SetKey(const T& value, AnimationGameObjectData& data, const UpdateContext& context) const;
+        template<bool Weighted, typename T> void UpdateKey(const T& prevValue, const T& value, float_t progress, AnimationGameObjectData& data, const UpdateContext& context) const;
+
+        template<typename T> SR_NODISCARD std::optional<T>& GetTarget(AnimationGameObjectData& data) const noexcept;
+
     private:
         std::optional<uint16_t> m_boneIndex;
         SR_UTILS_NS::StringAtom m_name;
-        Keys m_keys;
+
+        AnimationKeyType m_type = AnimationKeyType::None;
+
+        std::vector<float_t> m_times;
+        std::vector<SR_MATH_NS::FVector3> m_translations;
+        std::vector<SR_MATH_NS::Quaternion> m_rotations;
+        std::vector<SR_MATH_NS::FVector3> m_scales;
 
     };
 }
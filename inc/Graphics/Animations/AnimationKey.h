@@ -68,67 +68,6 @@ namespace SR_ANIMATIONS_NS {
         SR_MATH_NS::FVector3 scaling;
 
     };
-
-    /// ----------------------------------------------------------------------------------------------------------------
-
-    struct UnionAnimationKey {
-        UnionAnimationKey() = default;
-        ~UnionAnimationKey() = default;
-
-        UnionAnimationKey(const UnionAnimationKey& other) {
-            CopyFrom(other);
-        }
-
-        UnionAnimationKey& operator=(const UnionAnimationKey& other) {
-            if (this != &other) {
-                CopyFrom(other);
-            }
-            return *this;
-        }
-
-        void SR_FASTCALL UpdateWithWeight(float_t progress, const UnionAnimationKey& prevKey, AnimationGameObjectData& animation, float_t weight) const noexcept;
-        void SR_FASTCALL SetWithWeight(AnimationGameObjectData& animation, float_t weight) const noexcept;
-
-        void SR_FASTCALL Update(float_t progress, const UnionAnimationKey& prevKey, AnimationGameObjectData& animation) const noexcept;
-        void SR_FASTCALL Set(AnimationGameObjectData& animation) const noexcept;
-
-        void SR_FASTCALL Update(float_t progress, const UnionAnimationKey& prevKey, AnimationGameObjectData& animation, float_t toreance) const noexcept;
-        void SR_FASTCALL Set(AnimationGameObjectData& animation, float_t toreance) const noexcept;
-
-        template<class T> void SetData(T data) {
-            if constexpr (std::is_same_v<T, TranslationKey>) {
-                this->data.translation = data;
-                type = AnimationKeyType::Translation;
-            }
-            else if constexpr (std::is_same_v<T, RotationKey>) {
-                this->data.rotation = data;
-                type = AnimationKeyType::Rotation;
-            }
-            else if constexpr (std::is_same_v<T, ScalingKey>) {
-                this->data.scaling = data;
-                type = AnimationKeyType::Scaling;
-            }
-            else {
-                SRHalt("Unknown key type!");
-            }
-        }
-
-        void CopyFrom(const UnionAnimationKey& other);
-
-    public:
-        union Data {
-            TranslationKey translation;
-            RotationKey rotation;
-            ScalingKey scaling;
-
-            Data() { }
-            ~Data() { }
-        } data;
-
-        AnimationKeyType type = AnimationKeyType::None;
-        float_t time = 0.f;
-
-    };
 }
 
 #endif //SR_ENGINE_ANIMATIONKEY_H
@@ -0,0 +1,60 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_SKINNING_BUFFER_H
+#define SR_ENGINE_SKINNING_BUFFER_H
+
+#include <Graphics/Pipeline/Pipeline.h>
+
+namespace SR_ANIMATIONS_NS {
+    /**
+     * Общий на сцену SSBO с матрицами костей всех скелетных мешей.
+     * Каждый меш получает постоянный участок буфера и пишет в него свои матрицы на CPU,
+     * в видеопамять буфер уходит одним вызовом за кадр и только если что-то поменялось.
+     * Меш привязывает к дескриптору только свой участок, поэтому шейдер индексирует кости с нуля.
+    */
+    class SkinningBuffer : public SR_UTILS_NS::NonCopyable {
+    public:
+        /// Участок буфера, offset и count в матрицах. Границы выровнены так,
+        /// чтобы смещение в байтах подходило для привязки участка к дескриптору
+        struct Region {
+            uint32_t offset = 0;
+            uint32_t count = 0;
+
+            SR_NODISCARD bool Valid() const noexcept { return count > 0; }
+            SR_NODISCARD uint32_t GetByteOffset() const noexcept { return offset * sizeof(SR_MATH_NS::Matrix4x4); }
+            SR_NODISCARD uint32_t GetByteRange() const noexcept { return count * sizeof(SR_MATH_NS::Matrix4x4); }
+        };
+
+    public:
+        ~SkinningBuffer() override;
+
+    public:
+        SR_NODISCARD Region Allocate(uint32_t count);
+        void Free(Region& region);
+
+        /// Копирует матрицы в участок, одинаковые данные не помечают буфер измененным
+        void Write(const Region& region, const SR_MATH_NS::Matrix4x4* pMatrices, uint32_t count);
+
+        /// Возвращает true, если буфер был пересоздан и дескрипторы мешей нужно обновить.
+        /// Если выделить буфер не удалось, повторная попытка будет только когда буферу понадобится больше места
+        bool Upload(SR_GRAPH_NS::Pipeline* pPipeline);
+
+        void FreeVideoMemory(SR_GRAPH_NS::Pipeline* pPipeline);
+
+        SR_NODISCARD int32_t GetSSBO() const noexcept { return m_ssbo; }
+
+    private:
+        std::vector<SR_MATH_NS::Matrix4x4> m_matrices;
+        /// Освобожденные участки, отсортированы по смещению
+        std::vector<Region> m_freeRegions;
+
+        int32_t m_ssbo = SR_ID_INVALID;
+        uint64_t m_capacity = 0;
+        bool m_dirty = false;
+
+    };
+}
+
+#endif //SR_ENGINE_SKINNING_BUFFER_H
@@ -7,6 +7,7 @@
 
 #include <Utils/Resources/IResource.h>
 #include <Graphics/Font/FreeType.h>
+#include <Graphics/Font/GlyphCache.h>
 
 namespace SR_GTYPES_NS {
     class SR_DLL_EXPORT Font : public SR_UTILS_NS::IResource {
@@ -26,6 +27,11 @@ namespace SR_GTYPES_NS {
 
         SR_NODISCARD FT_Glyph GetGlyph(char32_t code, FT_Render_Mode renderMode, FT_Int32 charLoad, FT_Int32 glyphLoad) const;
         SR_NODISCARD FT_Glyph GetGlyph(char32_t code, FT_Render_Mode renderMode) const;
+        /// Глиф для текущего размера шрифта. Повторные запросы берутся из кэша без растеризации
+        SR_NODISCARD SR_GRAPH_NS::Glyph::Ptr GetCachedGlyph(char32_t code, FT_Render_Mode renderMode);
+
+        SR_NODISCARD const SR_GRAPH_NS::GlyphCacheMetrics& GetGlyphCacheMetrics() const noexcept { return m_glyphCache.GetMetrics(); }
+        void SetGlyphCacheBudget(uint64_t budget) { m_glyphCache.SetBudget(budget); }
 
         SR_NODISCARD FT_Pos GetKerning(uint32_t leftCharCode, uint32_t rightCharCode) const;
 
@@ -42,6 +48,8 @@ namespace SR_GTYPES_NS {
         FontLibrary m_library = nullptr;
         FontFace m_face = nullptr;
 
+        SR_GRAPH_NS::GlyphCache m_glyphCache;
+
         bool m_hasColor = false;
         bool m_isColorEmoji = false;
 
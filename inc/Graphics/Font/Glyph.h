@@ -10,10 +10,6 @@
 
 namespace SR_GRAPH_NS {
     struct GlyphMetrics {
-        /// Позиция по горизонтали
-        int32_t posX = 0;
-        /// Позиция по вертикали (от базовой линии)
-        int32_t posY = 0;
         /// Ширина глифа
         int32_t width = 0;
         /// Высота глифа
@@ -36,14 +32,15 @@ namespace SR_GRAPH_NS {
         ~Glyph() override;
 
     public:
-        SR_NODISCARD int32_t GetPosX() const noexcept;
-        SR_NODISCARD int32_t GetPosY() const noexcept;
         SR_NODISCARD uint32_t GetSize() const noexcept;
         SR_NODISCARD uint32_t GetWidth() const noexcept;
         SR_NODISCARD uint32_t GetHeight() const noexcept;
         SR_NODISCARD uint32_t GetPixelSize() const noexcept;
+        /// Сколько памяти занимает глиф вместе с растром FreeType
+        SR_NODISCARD uint64_t GetMemorySize() const noexcept;
         SR_NODISCARD FT_Glyph GetGlyph() const noexcept;
         SR_NODISCARD GlyphMetrics& GetMetrics() noexcept;
+        SR_NODISCARD const GlyphMetrics& GetMetrics() const noexcept { return m_metrics; }
 
     private:
         FT_Render_Mode m_renderMode;
@@ -64,8 +61,10 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD static GlyphImage::Ptr Create(const Glyph::Ptr& pGlyph, bool needInit);
         SR_NODISCARD uint8_t* GetData() const { return m_data; }
 
-        void InsertTo(uint8_t* pTarget, int32_t top, uint32_t sizeX);
-        void Debug(uint8_t* pTarget, int32_t top, uint32_t sizeX);
+        /// posX, posY - положение глифа в тексте. Глиф может быть общим для нескольких текстов,
+        /// поэтому положение не хранится в нем самом
+        void InsertTo(uint8_t* pTarget, int32_t posX, int32_t posY, int32_t top, uint32_t sizeX);
+        void Debug(uint8_t* pTarget, int32_t posX, int32_t posY, int32_t top, uint32_t sizeX);
 
     private:
         SR_NODISCARD bool Init();
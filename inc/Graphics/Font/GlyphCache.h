@@ -0,0 +1,89 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_GLYPH_CACHE_H
+#define SR_ENGINE_GLYPH_CACHE_H
+
+#include <Utils/Common/Hashes.h>
+#include <Graphics/Font/Glyph.h>
+
+namespace SR_GRAPH_NS {
+    struct GlyphCacheKey {
+        char32_t code = 0;
+        FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
+        /// Масштаб текущего размера шрифта в формате 16.16, однозначно задает размер
+        FT_Fixed xScale = 0;
+        FT_Fixed yScale = 0;
+
+        SR_NODISCARD bool operator==(const GlyphCacheKey& other) const noexcept {
+            return code == other.code && renderMode == other.renderMode && xScale == other.xScale && yScale == other.yScale;
+        }
+    };
+
+    struct GlyphCacheKeyHash {
+        SR_NODISCARD size_t operator()(const GlyphCacheKey& key) const noexcept {
+            std::size_t res = std::hash<char32_t>()(key.code);
+            res = SR_UTILS_NS::HashCombine(static_cast<uint32_t>(key.renderMode), res);
+            res = SR_UTILS_NS::HashCombine(static_cast<int64_t>(key.xScale), res);
+            res = SR_UTILS_NS::HashCombine(static_cast<int64_t>(key.yScale), res);
+            return res;
+        }
+    };
+
+    struct GlyphCacheMetrics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        /// Память растров и объектов глифов, находящихся в кэше
+        uint64_t memory = 0;
+        uint32_t glyphsCount = 0;
+
+        SR_NODISCARD float_t GetHitRate() const noexcept {
+            const uint64_t total = hits + misses;
+            return total == 0 ? 0.f : static_cast<float_t>(hits) / static_cast<float_t>(total);
+        }
+    };
+
+    /**
+     * Кэш растеризованных глифов одного шрифта с вытеснением давно не использованных (LRU)
+     * при превышении бюджета памяти. Глифы в кэше неизменяемы и могут одновременно
+     * использоваться несколькими построителями текста.
+    */
+    class GlyphCache : public SR_UTILS_NS::NonCopyable {
+        struct Entry {
+            GlyphCacheKey key;
+            Glyph::Ptr pGlyph;
+            uint64_t memory = 0;
+        };
+        using Entries = std::list<Entry>;
+
+    public:
+        static constexpr uint64_t DEFAULT_BUDGET = 4 * 1024 * 1024;
+
+    public:
+        ~GlyphCache() override;
+
+    public:
+        SR_NODISCARD Glyph::Ptr Find(const GlyphCacheKey& key);
+        SR_NODISCARD const GlyphCacheMetrics& GetMetrics() const noexcept { return m_metrics; }
+        SR_NODISCARD uint64_t GetBudget() const noexcept { return m_budget; }
+
+        void Insert(const GlyphCacheKey& key, const Glyph::Ptr& pGlyph);
+        void SetBudget(uint64_t budget);
+        void Clear();
+
+    private:
+        void Evict();
+
+    private:
+        Entries m_entries;
+        ska::flat_hash_map<GlyphCacheKey, Entries::iterator, GlyphCacheKeyHash> m_lookup;
+
+        GlyphCacheMetrics m_metrics;
+        uint64_t m_budget = DEFAULT_BUDGET;
+
+    };
+}
+
+#endif //SR_ENGINE_GLYPH_CACHE_H
@@ -31,6 +31,7 @@ namespace SR_GTYPES_NS {
         SR_NODISCARD bool IsCalculatable() const override;
         SR_NODISCARD SR_FORCE_INLINE bool GetKerning() const noexcept { return m_kerning; }
         SR_NODISCARD SR_FORCE_INLINE bool IsDebugEnabled() const noexcept { return m_debug; }
+        SR_NODISCARD SR_FORCE_INLINE bool IsSDFEnabled() const noexcept { return m_sdf; }
         SR_NODISCARD SR_FORCE_INLINE bool IsPreprocessorEnabled() const noexcept { return m_preprocessor; }
         SR_NODISCARD SR_FORCE_INLINE bool IsLocalizationEnabled() const noexcept { return m_localization; }
         SR_NODISCARD SR_FORCE_INLINE Font* GetFont() const noexcept { return m_font; }
@@ -48,6 +49,7 @@ namespace SR_GTYPES_NS {
         void SetText(const std::u32string& text);
         void SetKerning(bool enabled);
         void SetDebug(bool enabled);
+        void SetSDF(bool enabled);
         void SetFont(Font* pFont);
         void SetFont(const SR_UTILS_NS::Path& path);
         void SetFontSize(const SR_MATH_NS::UVector2& size);
@@ -74,6 +76,7 @@ namespace SR_GTYPES_NS {
         bool m_is3D = false;
         bool m_kerning = true;
         bool m_debug = false;
+        bool m_sdf = false;
         bool m_preprocessor = false;
         bool m_localization = false;
 
@@ -46,11 +46,12 @@ namespace SR_GRAPH_NS::SDF {
         }                                                                          \
     } while(0)
 
+    /// Сетка 8SSEDT с рамкой в один пиксель вокруг изображения
     struct Grid {
         int32_t w, h;
-        Point* grid;
+        std::vector<Point> grid;
 
-        void GenerateSDF() const {
+        void GenerateSDF() {
             for (int32_t y = 1; y <= h; ++y) {
                 for (int32_t x = 1; x <= w; ++x) {
                     Point p = Get(x, y);
@@ -60,6 +61,11 @@ namespace SR_GRAPH_NS::SDF {
                     SR_SRF_COMPARE( 1, -1);
                     Put(x, y, p);
                 }
+                for (int32_t x = w; x > 0; --x) {
+                    Point p = Get(x, y);
+                    SR_SRF_COMPARE( 1,  0);
+                    Put(x, y, p);
+                }
             }
 
             for(int32_t y = h; y > 0; --y) {
@@ -71,6 +77,11 @@ namespace SR_GRAPH_NS::SDF {
                     SR_SRF_COMPARE( 1,  1);
                     Put(x, y, p);
                 }
+                for (int32_t x = 1; x <= w; ++x) {
+                    Point p = Get(x, y);
+                    SR_SRF_COMPARE(-1,  0);
+                    Put(x, y, p);
+                }
             }
         }
 
@@ -78,29 +89,41 @@ namespace SR_GRAPH_NS::SDF {
             return grid[y * (w + 2) + x];
         }
 
-        void Put(int32_t x, int32_t y, const Point &p) const {
+        void Put(int32_t x, int32_t y, const Point &p) {
             grid[y * (w + 2) + x] = p;
         }
 
         Grid(int32_t width, int32_t height)
             : w(width)
             , h(height)
-        {
-            grid = new Point[(w + 2) * (h + 2)];
-        }
-
-        ~Grid() {
-            delete[] grid;
-        }
+            , grid((w + 2) * (h + 2))
+        { }
     };
 
     struct SDFImage {
-        void* pData;
-        uint32_t width;
-        uint32_t height;
+        void* pData = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        /// Размер пикселя в байтах и канал, из которого читается покрытие / в который пишется расстояние
+        uint32_t pixelSize = 1;
+        uint32_t channel = 0;
+    };
+
+    struct SDFSettings {
+        /// Расстояние в пикселях, которое растягивается на весь выходной диапазон (в каждую сторону от контура)
+        float_t spread = 8.f;
+        /// Значения на расстоянии -spread (снаружи) и +spread (внутри), контур попадает в их середину
+        uint8_t minValue = 0;
+        uint8_t maxValue = 255;
+        /// Пиксели с покрытием больше порога считаются внутренними
+        uint8_t threshold = 127;
+        /// Количество потоков, 0 - по числу ядер
+        uint32_t threadsCount = 0;
     };
 
-    SR_MAYBE_UNUSED static SDFImage DFCalculate(const SDFImage& image, int32_t distanceFieldScale, bool transparent);
+    /// Строит поле расстояний по каналу source и пишет его в канал destination.
+    /// Изображения одного размера, source и destination могут указывать на одну память
+    bool DFCalculate(const SDFImage& source, const SDFImage& destination, const SDFSettings& settings);
 }
 
 #endif //SR_ENGINE_SDFL_H
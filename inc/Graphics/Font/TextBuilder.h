@@ -8,6 +8,7 @@
 #include <Utils/Common/NonCopyable.h>
 #include <Graphics/Font/FreeType.h>
 #include <Graphics/Font/Glyph.h>
+#include <Graphics/Font/SDF.h>
 
 namespace SR_GTYPES_NS {
     class Font;
@@ -25,6 +26,14 @@ namespace SR_GRAPH_NS {
         using Super = SR_UTILS_NS::NonCopyable;
         using FontPtr = SR_GTYPES_NS::Font*;
         using StringType = std::u32string;
+
+        /// Глиф из кэша шрифта и его положение в этом тексте
+        struct PlacedGlyph {
+            Glyph::Ptr pGlyph;
+            int32_t posX = 0;
+            int32_t posY = 0;
+        };
+
     public:
         explicit TextBuilder(FontPtr pFont);
         ~TextBuilder() override;
@@ -37,6 +46,7 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD ImageFormat GetColorFormat() const noexcept;
         SR_NODISCARD uint32_t GetFontSize() const noexcept { return m_fontSize; }
         SR_NODISCARD FontStyle GetFontStyle() const noexcept { return m_fontStyle; }
+        SR_NODISCARD bool IsSDF() const noexcept { return m_sdf; }
 
         SR_NODISCARD int32_t CalculateTextWidth(const char* text);
 
@@ -47,6 +57,10 @@ namespace SR_GRAPH_NS {
         void SetFontSize(uint32_t size) { m_fontSize = size; }
         void SetKerning(bool enabled);
         void SetDebug(bool enabled);
+        /// В альфа-канал пишется поле расстояний вместо покрытия. Такой текст масштабируется в шейдере
+        /// без потери четкости, поэтому одну текстуру можно рисовать любым размером шрифта
+        void SetSDF(bool enabled) { m_sdf = enabled; }
+        void SetSDFSettings(const SDF::SDFSettings& settings) { m_sdfSettings = settings; }
 
     private:
         void InitFontSize();
@@ -63,10 +77,15 @@ namespace SR_GRAPH_NS {
 
         FontPtr m_font = nullptr;
 
-        std::vector<Glyph::Ptr> m_glyphs;
+        std::vector<PlacedGlyph> m_glyphs;
 
         bool m_kerning = false;
         bool m_debug = false;
+        bool m_sdf = false;
+
+        SDF::SDFSettings m_sdfSettings;
+        /// Поле расстояний выходит за контур, поэтому вокруг текста оставляется запас
+        int32_t m_padding = 0;
 
         uint32_t m_fontSize = 12;
 
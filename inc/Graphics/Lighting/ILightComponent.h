@@ -20,15 +20,25 @@ namespace SR_GRAPH_NS {
     )
 
     class ILightComponent : public SR_GTYPES_NS::IRenderComponent {
+        using Super = SR_GTYPES_NS::IRenderComponent;
     public:
+        bool InitializeEntity() noexcept override;
+
         SR_NODISCARD SR_FORCE_INLINE bool ExecuteInEditMode() const override { return true; }
         SR_NODISCARD bool IsUpdatable() const noexcept override { return false; }
         SR_NODISCARD virtual LightType GetLightType() const = 0;
 
+        SR_NODISCARD float_t GetIntensity() const noexcept { return m_intensity; }
+        SR_NODISCARD const SR_MATH_NS::FVector3& GetColor() const noexcept { return m_color; }
+        SR_NODISCARD SR_MATH_NS::FVector3 GetLightPosition() const;
+        /// Направление излучения в мировых координатах, вдоль локальной оси Z
+        SR_NODISCARD SR_MATH_NS::FVector3 GetLightDirection() const;
+
         void OnAttached() override;
         void OnDestroy() override;
 
     protected:
+        SR_MATH_NS::FVector3 m_color = SR_MATH_NS::FVector3(1.f, 1.f, 1.f);
         float_t m_intensity = 1.f;
         float_t m_bounceIntensity = 1.f;
         ShadowType m_shadowType = ShadowType::Soft;
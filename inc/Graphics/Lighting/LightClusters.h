@@ -0,0 +1,106 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_LIGHT_CLUSTERS_H
+#define SR_ENGINE_LIGHT_CLUSTERS_H
+
+#include <Graphics/Pipeline/Pipeline.h>
+
+namespace SR_GTYPES_NS {
+    class Camera;
+}
+
+namespace SR_GRAPH_NS {
+    /// Размеры сетки кластеров: тайлы экрана по X и Y, экспоненциальные срезы по глубине
+    static constexpr uint32_t SR_LIGHT_CLUSTERS_X = 16;
+    static constexpr uint32_t SR_LIGHT_CLUSTERS_Y = 9;
+    static constexpr uint32_t SR_LIGHT_CLUSTERS_Z = 24;
+    static constexpr uint32_t SR_LIGHT_CLUSTERS_COUNT = SR_LIGHT_CLUSTERS_X * SR_LIGHT_CLUSTERS_Y * SR_LIGHT_CLUSTERS_Z;
+
+    /// Источник света в том виде, в котором он лежит в SSBO
+    struct ClusterLight {
+        /// xyz - позиция в мире, w - дальность
+        glm::vec4 positionRange = glm::vec4(0.f);
+        /// rgb - цвет, a - интенсивность
+        glm::vec4 colorIntensity = glm::vec4(0.f);
+        /// xyz - направление, w - LightType
+        glm::vec4 directionType = glm::vec4(0.f);
+        /// x - косинус половины угла конуса прожектора, y - радиус площадного источника
+        glm::vec4 params = glm::vec4(0.f);
+    };
+
+    /**
+     * Кластерное (froxel) распределение источников света для forward рендера.
+     * Каждый кадр на CPU ограничивающие сферы источников раскладываются по кластерам пирамиды видимости камеры.
+     * В шейдер уходят три SSBO: компактный список видимых источников, пары (смещение, количество) для каждого кластера
+     * и общий список индексов источников. Кластер фрагмента считается по его координатам в пространстве камеры.
+    */
+    class LightClusters : public SR_UTILS_NS::NonCopyable {
+    public:
+        ~LightClusters() override;
+
+    public:
+        void Clear();
+
+        /// center и radius - ограничивающая сфера источника в мировых координатах
+        void AddLight(const ClusterLight& light, const SR_MATH_NS::FVector3& center, float_t radius);
+
+        void Build(const SR_GTYPES_NS::Camera* pCamera);
+
+        /// Возвращает true, если хотя бы один буфер был пересоздан и дескрипторы нужно обновить
+        bool Upload(Pipeline* pPipeline);
+
+        void FreeVideoMemory(Pipeline* pPipeline);
+
+        /// x, y, z - размеры сетки, w - количество видимых источников
+        SR_NODISCARD const SR_MATH_NS::FVector4& GetGrid() const noexcept { return m_grid; }
+        /// x, y - масштаб и смещение логарифма глубины для номера среза, z, w - тангенсы половин углов обзора
+        SR_NODISCARD const SR_MATH_NS::FVector4& GetDepth() const noexcept { return m_depth; }
+
+        SR_NODISCARD int32_t GetLightsSSBO() const noexcept { return m_lightsSSBO.ssbo; }
+        SR_NODISCARD int32_t GetRangesSSBO() const noexcept { return m_rangesSSBO.ssbo; }
+        SR_NODISCARD int32_t GetIndicesSSBO() const noexcept { return m_indicesSSBO.ssbo; }
+
+    private:
+        struct Buffer {
+            int32_t ssbo = SR_ID_INVALID;
+            uint64_t capacity = 0;
+        };
+
+        struct LightBounds {
+            SR_MATH_NS::FVector3 center;
+            float_t radius = 0.f;
+        };
+
+        /// Диапазон кластеров, которые задевает источник
+        struct ClusterRange {
+            uint32_t light = 0;
+            uint16_t minX = 0, maxX = 0;
+            uint16_t minY = 0, maxY = 0;
+            uint16_t minZ = 0, maxZ = 0;
+        };
+
+        SR_NODISCARD static bool UploadBuffer(Pipeline* pPipeline, Buffer& buffer, const void* pData, uint64_t size);
+
+    private:
+        std::vector<ClusterLight> m_lights;
+        std::vector<LightBounds> m_bounds;
+
+        std::vector<ClusterLight> m_visibleLights;
+        std::vector<ClusterRange> m_ranges;
+        /// Пары (смещение, количество) для каждого кластера
+        std::vector<int32_t> m_clusters;
+        std::vector<int32_t> m_indices;
+
+        SR_MATH_NS::FVector4 m_grid;
+        SR_MATH_NS::FVector4 m_depth;
+
+        Buffer m_lightsSSBO;
+        Buffer m_rangesSSBO;
+        Buffer m_indicesSSBO;
+
+    };
+}
+
+#endif //SR_ENGINE_LIGHT_CLUSTERS_H
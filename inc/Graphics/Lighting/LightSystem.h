@@ -6,6 +6,11 @@
 #define SR_ENGINE_LIGHTSYSTEM_H
 
 #include <Graphics/Pipeline/Pipeline.h>
+#include <Graphics/Lighting/LightClusters.h>
+
+namespace SR_GTYPES_NS {
+    class Shader;
+}
 
 namespace SR_GRAPH_NS {
     class DirectionalLight;
@@ -26,6 +31,15 @@ namespace SR_GRAPH_NS {
         void Register(ILightComponent* pLightComponent);
         void Remove(ILightComponent* pLightComponent);
 
+        /// Пересобирает кластеры источников света для камеры, вызывается раз в кадр до построения
+        void Update(const SR_GTYPES_NS::Camera* pCamera);
+        void FreeVideoMemory();
+
+        /// Привязывает SSBO кластеров к шейдеру, дескриптор обновится при следующей отрисовке меша
+        void BindClusters(SR_GTYPES_NS::Shader* pShader) const;
+
+        SR_NODISCARD const LightClusters& GetClusters() const noexcept { return m_clusters; }
+
         SR_NODISCARD const SR_MATH_NS::FVector3& GetDirectionalLightPosition() const noexcept { return m_position; }
         void SetDirectionalLightPosition(const SR_MATH_NS::FVector3& position) noexcept;
 
@@ -40,6 +54,9 @@ namespace SR_GRAPH_NS {
     private:
         SR_MATH_NS::FVector3 m_position = SR_MATH_NS::FVector3(20, 60, 5);
 
+        LightClusters m_clusters;
+        bool m_clustersEnabled = false;
+
     };
 }
 
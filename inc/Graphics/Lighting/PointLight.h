@@ -10,6 +10,7 @@
 namespace SR_GRAPH_NS {
     class PointLight : public ILightComponent {
     public:
+        SR_NODISCARD float_t GetRadius() const noexcept { return m_radius; }
 
     protected:
         float_t m_radius = 1.f;
@@ -9,6 +9,10 @@
 
 namespace SR_GRAPH_NS {
     class SpotLight : public ILightComponent {
+    public:
+        SR_NODISCARD float_t GetRadius() const noexcept { return m_radius; }
+        SR_NODISCARD float_t GetDistance() const noexcept { return m_distance; }
+
     protected:
         float_t m_radius = 1.f;
         float_t m_distance = 10.f;
@@ -89,6 +89,9 @@ namespace SR_GRAPH_NS {
         uint32_t samplerId = SR_ID_INVALID;
         bool isArray = false;
         bool isAttachment = false;
+        /// Текстура берется из общей таблицы, в UBO пишется ее индекс в поле tableIndexField
+        bool isBindless = false;
+        SR_UTILS_NS::StringAtom tableIndexField;
         SR_UTILS_NS::StringAtom defaultValue;
     };
     typedef std::map<SR_UTILS_NS::StringAtom, ShaderSampler> ShaderSamplers;
@@ -97,6 +100,9 @@ namespace SR_GRAPH_NS {
         SR_UTILS_NS::StringAtom name;
         uint32_t binding = SR_ID_INVALID;
         uint32_t ssbo = SR_ID_INVALID;
+        /// Область буфера в байтах, если range == 0, то привязывается весь буфер
+        uint32_t offset = 0;
+        uint32_t range = 0;
     };
     typedef std::vector<SSBOBinding> SSBOBindings;
 
@@ -218,6 +224,7 @@ template<> struct SR_UTILS_NS::SRHash<SR_GRAPH_NS::ShaderSamplers> {
         for (auto&& [key, val] : value) {
             res = SR_UTILS_NS::HashCombine(key.GetHash(), res);
             res = SR_UTILS_NS::HashCombine(val.binding, res);
+            res = SR_UTILS_NS::HashCombine(val.isBindless, res);
         }
 
         return res;
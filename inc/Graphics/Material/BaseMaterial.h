@@ -51,6 +51,8 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD bool ContainsTexture(SR_GTYPES_NS::Texture* pTexture) const;
         SR_NODISCARD bool IsTransparent() const;
         SR_NODISCARD ShaderPtr GetShader() const { return m_shader; }
+        /// Смещение глубины при сортировке прозрачных мешей, положительное отодвигает меш от камеры
+        SR_NODISCARD float_t GetSortBias() const noexcept { return m_sortBias; }
         SR_NODISCARD MaterialProperties& GetProperties() { return m_properties; }
         SR_NODISCARD MaterialProperty* GetProperty(const SR_UTILS_NS::StringAtom& id);
         SR_NODISCARD MaterialProperty* GetProperty(uint64_t hashId);
@@ -63,6 +65,7 @@ namespace SR_GRAPH_NS {
 
         virtual void SetShader(ShaderPtr pShader);
         void SetShader(const SR_UTILS_NS::Path& path);
+        void SetSortBias(float_t sortBias) noexcept { m_sortBias = sortBias; }
 
         void OnPropertyChanged(bool onlyUniforms);
 
@@ -83,6 +86,7 @@ namespace SR_GRAPH_NS {
         MaterialProperties m_properties;
         RenderContextPtr m_context;
         SR_UTILS_NS::Subscription m_shaderReloadDoneSubscription;
+        float_t m_sortBias = 0.f;
 
     private:
         bool m_isFinalized = false;
@@ -28,6 +28,7 @@ namespace SR_GRAPH_NS {
             , m_displayName(SR_EXCHANGE(other.m_displayName, { }))
             , m_data(SR_EXCHANGE(other.m_data, { }))
             , m_pushConstant(SR_EXCHANGE(other.m_pushConstant, { }))
+            , m_textureIndex(SR_EXCHANGE(other.m_textureIndex, { }))
             , m_type(SR_EXCHANGE(other.m_type, { }))
         { }
 
@@ -36,6 +37,7 @@ namespace SR_GRAPH_NS {
             m_displayName = SR_EXCHANGE(other.m_displayName, { });
             m_data = SR_EXCHANGE(other.m_data, { });
             m_pushConstant = SR_EXCHANGE(other.m_pushConstant, { });
+            m_textureIndex = SR_EXCHANGE(other.m_textureIndex, { });
             m_type = SR_EXCHANGE(other.m_type, { });
             return *this;
         }
@@ -45,12 +47,15 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD const ShaderPropertyVariant& GetData() const noexcept { return m_data; }
         SR_NODISCARD BaseMaterial* GetMaterial() const noexcept { return m_material; }
         SR_NODISCARD bool IsPushConstant() const noexcept { return m_pushConstant; }
+        /// Bindless текстура: в шейдер передается индекс в общей таблице через блок юниформ
+        SR_NODISCARD bool IsTextureIndex() const noexcept { return m_textureIndex; }
         SR_NODISCARD bool IsSampler() const noexcept;
 
         MaterialProperty& SetDisplayName(SR_UTILS_NS::StringAtom value) noexcept { m_displayName = value; return *this; }
         MaterialProperty& SetShaderVarType(ShaderVarType value) noexcept { m_type = value; return *this; }
         MaterialProperty& SetMaterial(BaseMaterial* value) noexcept { m_material = value; return *this; }
         MaterialProperty& SetPushConstant(bool value) noexcept { m_pushConstant = value; return *this; }
+        MaterialProperty& SetTextureIndex(bool value) noexcept { m_textureIndex = value; return *this; }
 
         void SaveProperty(MarshalRef marshal) const noexcept override;
         void LoadProperty(MarshalRef marshal) noexcept override;
@@ -68,7 +73,9 @@ namespace SR_GRAPH_NS {
                     return *this;
                 }
                 SetTextureInternal(value);
-                OnPropertyChanged(false);
+                /// смена bindless текстуры, которая уже в таблице, меняет только индекс в UBO.
+                /// Новую текстуру таблица получит при загрузке, и наборы нужно перестроить
+                OnPropertyChanged(m_textureIndex && IsTextureInTable(value));
             }
             else {
                 if constexpr (std::is_same_v<T, int32_t>) {
@@ -108,6 +115,7 @@ namespace SR_GRAPH_NS {
 
     private:
         void SetTextureInternal(SR_GTYPES_NS::Texture* pTexture);
+        SR_NODISCARD static bool IsTextureInTable(SR_GTYPES_NS::Texture* pTexture) noexcept;
         void OnPropertyChanged(bool onlyUniforms);
 
     private:
@@ -115,6 +123,7 @@ namespace SR_GRAPH_NS {
         SR_UTILS_NS::StringAtom m_displayName;
         ShaderPropertyVariant m_data;
         bool m_pushConstant = false;
+        bool m_textureIndex = false;
         ShaderVarType m_type = ShaderVarType::Unknown;
         SR_UTILS_NS::Subscription m_textureOnReloadDoneSubscription;
 
@@ -155,6 +164,13 @@ namespace SR_GRAPH_NS {
             for (auto&& pProperty : m_materialUniformsProperties) {
                 pProperty->Use(pShader);
             }
+
+            /// индексы bindless текстур живут в блоке юниформ и обновляются вместе с ним
+            for (auto&& pProperty : m_materialSamplerProperties) {
+                if (pProperty->IsTextureIndex()) {
+                    pProperty->Use(pShader);
+                }
+            }
         }
 
     private:
@@ -25,6 +25,22 @@ namespace SR_GRAPH_NS {
             void* pShaderHandle = nullptr;
             DescriptorSet descriptorSet = SR_ID_INVALID;
         };
+        /// Реальный набор дескрипторов, который может разделяться несколькими виртуальными
+        struct SharedDescriptorSet {
+            void* pShaderHandle = nullptr;
+            /// Хеш записанного содержимого, 0 - содержимое не кешируется
+            uint64_t contentHash = 0;
+            /// Версия таблицы текстур, записанная в набор, 0 - таблица в набор еще не записывалась
+            uint64_t textureTableVersion = 0;
+            uint32_t usages = 0;
+            /// Ключи ресурсов закешированного содержимого, см. m_resourceSets
+            std::vector<uint64_t> resources;
+        };
+        /// Освобожденный набор, который еще может использоваться буферами команд в полете
+        struct RetiredDescriptorSet {
+            DescriptorSet descriptorSet = SR_ID_INVALID;
+            uint64_t frame = 0;
+        };
     public:
         using VirtualDescriptorSet = int32_t;
         enum class BindResult : uint8_t {
@@ -38,21 +54,74 @@ namespace SR_GRAPH_NS {
 
         SR_NODISCARD VirtualDescriptorSet AllocateDescriptorSet(VirtualDescriptorSet reallocation = SR_ID_INVALID);
         BindResult Bind(VirtualDescriptorSet virtualDescriptorSet);
-        void Flush();
+        /// Записывает ресурсы текущего шейдера в набор дескрипторов. Если передан виртуальный набор,
+        /// то набор с тем же содержимым переиспользуется, а запись пропускается
+        void Flush(VirtualDescriptorSet virtualDescriptorSet = SR_ID_INVALID);
 
         bool FreeDescriptorSet(VirtualDescriptorSet* pVirtualDescriptorSet);
 
-        void SetPipeline(SR_HTYPES_NS::SharedPtr<Pipeline> pipeline) noexcept { m_pipeline = std::move(pipeline); }
+        void SetPipeline(SR_HTYPES_NS::SharedPtr<Pipeline> pipeline);
+
+        /// Общая таблица текстур. Индекс стабилен, пока текстура не освобождена.
+        /// Размер таблицы фиксирован (SR_SRSL_TEXTURE_TABLE_SIZE) и не растет,
+        /// SR_ID_INVALID - таблица заполнена, шейдер получит индекс заглушки
+        SR_NODISCARD int32_t RegisterTexture(int32_t textureId);
+        void UpdateTexture(int32_t index, int32_t textureId);
+        void UnregisterTexture(int32_t* pIndex);
+
+        SR_NODISCARD const std::vector<int32_t>& GetTextureTable() const noexcept { return m_textureTable; }
+        /// Меняется при любом изменении таблицы, наборы дескрипторов со старой версией нужно перезаписать
+        SR_NODISCARD uint64_t GetTextureTableVersion() const noexcept { return m_textureTableVersion; }
+        /// Сколько живых наборов содержат таблицу. Пока их нет, изменение таблицы не требует перестроения
+        SR_NODISCARD uint32_t GetTextureTableSetsCount() const noexcept { return m_textureTableSetsCount; }
+        /// Элементы таблицы [first, last), которые нужно записать в набор, чтобы он соответствовал текущей версии.
+        /// Новый набор получает всю таблицу, пустой диапазон - набор уже актуален. Набор помечается актуальным
+        SR_NODISCARD std::pair<uint32_t, uint32_t> AcquireTextureTableRange(DescriptorSet descriptorSet);
 
     private:
-        SR_NODISCARD DescriptorSet AllocateMemory(SR_GTYPES_NS::Shader* pShader) const;
+        SR_NODISCARD DescriptorSet AllocateMemory(SR_GTYPES_NS::Shader* pShader);
+        SR_NODISCARD DescriptorSet AcquireRetired(void* pShaderHandle);
+        void Release(DescriptorSet descriptorSet);
+        void FreeRetired(const std::set<void*>& handles);
+        /// Убирает набор из кеша содержимого и из обратного индекса ресурсов
+        void Uncache(DescriptorSet descriptorSet, SharedDescriptorSet& sharedSet);
+        /// Забывает закешированные наборы, ссылающиеся на освобожденные ресурсы
+        void PurgeFreedResources();
+        /// Забывает наборы освобожденных шейдеров, пока их адреса не достались новым
+        void PurgeFreedShaders();
+
+        SR_NODISCARD uint64_t GetRetireDelay() const;
+
+        void OnTextureTableChanged(int32_t index);
 
     private:
         SR_HTYPES_NS::ObjectPool<std::vector<DescriptorSetInfo>, VirtualDescriptorSet> m_descriptorPool;
         SR_HTYPES_NS::SharedPtr<Pipeline> m_pipeline;
 
+        bool m_isCacheEnabled = true;
+
+        std::unordered_map<DescriptorSet, SharedDescriptorSet> m_descriptorSets;
+        /// Хеш содержимого и раскладки -> набор с таким содержимым
+        std::unordered_map<uint64_t, DescriptorSet> m_contentCache;
+        /// Раскладка (шейдер) -> освобожденные наборы в порядке освобождения.
+        /// Ключ живет до освобождения шейдера, см. PurgeFreedShaders
+        std::unordered_map<void*, std::deque<RetiredDescriptorSet>> m_retiredSets;
+        /// Ресурс (DescriptorResource::GetKey) -> закешированные наборы, которые на него ссылаются
+        std::unordered_map<uint64_t, std::vector<DescriptorSet>> m_resourceSets;
+        std::vector<DescriptorResource> m_resourcesCache;
+
         mutable std::vector<DescriptorType> m_allocationTypesCache;
 
+        std::vector<int32_t> m_textureTable;
+        std::vector<int32_t> m_freeTextureIndices;
+        /// Начинается с 1, чтобы версия 0 у набора означала незаписанную таблицу
+        uint64_t m_textureTableVersion = 1;
+        uint32_t m_textureTableSetsCount = 0;
+        /// Измененные индексы таблицы по версиям. Хранятся только последние изменения,
+        /// набор старше m_textureTableChangesBegin перезаписывается целиком
+        std::deque<std::pair<uint64_t, int32_t>> m_textureTableChanges;
+        uint64_t m_textureTableChangesBegin = 1;
+
     };
 }
 
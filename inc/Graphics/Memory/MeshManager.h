@@ -9,6 +9,7 @@
 #include <Utils/Types/Thread.h>
 
 #include <Graphics/Types/Vertices.h>
+#include <Graphics/Utils/MeshUtils.h>
 #include <Graphics/Pipeline/PipelineType.h>
 
 namespace SR_GTYPES_NS {
@@ -18,7 +19,7 @@ namespace SR_GTYPES_NS {
 namespace SR_GRAPH_NS {
     namespace Memory {
         enum class MeshMemoryType {
-            Unknown, VBO, IBO
+            Unknown, VBO, IBO, SSBO
         };
 
         class MeshVidMemInfo {
@@ -44,6 +45,8 @@ namespace SR_GRAPH_NS {
             uint32_t m_usages = 0;
             uint32_t m_size = 0;
             MeshMemoryType m_type = MeshMemoryType::Unknown;
+            /// Для IBO - упрощенные уровни, лежащие в нем после исходных индексов
+            std::vector<MeshLod> m_lods;
 
         };
 
@@ -78,7 +81,7 @@ namespace SR_GRAPH_NS {
                     return FindImpl(hash, memType);
                 }
 
-                if constexpr (memType == MeshMemoryType::IBO) {
+                if constexpr (memType == MeshMemoryType::IBO || memType == MeshMemoryType::SSBO) {
                     const Hash hash = SR_HASH_STR(identifier);
                     return FindImpl(hash, memType);
                 }
@@ -109,6 +112,10 @@ namespace SR_GRAPH_NS {
                     return RegisterImpl(identifier, memType, size, id);
             }
 
+            /// Уровни детализации лежат в том же IBO, копии меша берут их описание отсюда
+            bool SetLods(const std::string& identifier, const std::vector<MeshLod>& lods);
+            SR_NODISCARD std::vector<MeshLod> GetLods(const std::string& identifier);
+
             template<MeshMemoryType memType> FreeResult Free(int32_t id) {
                 SR_TRACY_ZONE;
                 SR_LOCK_GUARD;
@@ -156,9 +163,12 @@ namespace SR_GRAPH_NS {
         private:
             VideoResources m_IBOs;
             VideoResources m_VBOs;
+            /// Неизменяемые данные, общие для всех мешей одного ресурса (например, смещения костей)
+            VideoResources m_SSBOs;
 
             HashTable m_IBOTable;
             HashTable m_VBOTable;
+            HashTable m_SSBOTable;
 
         };
     }
@@ -14,6 +14,27 @@ namespace SR_GRAPH_NS::Types {
 }
 
 namespace SR_GRAPH_NS::Memory {
+    /// Заранее найденное положение поля в блоке. Позволяет записывать поле без поиска по хешу
+    struct ShaderUBOSlot {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+
+        SR_NODISCARD bool Valid() const noexcept { return size > 0; }
+    };
+
+    /// Положение поля во всех блоках шейдера, найденное один раз через Shader::GetSlot.
+    /// Слот действителен, пока не изменится раскладка блоков (перезагрузка шейдера),
+    /// после этого запись идет по хешу, а слот нужно получить заново
+    struct ShaderSlot {
+        uint64_t hashId = 0;
+        uint32_t layoutVersion = 0;
+        ShaderUBOSlot uniform;
+        ShaderUBOSlot shared;
+        ShaderUBOSlot constant;
+    };
+
+    template<typename T> struct ShaderTypedSlot : public ShaderSlot { };
+
     class ShaderUBOBlock : public SR_UTILS_NS::NonCopyable {
         friend class SR_GRAPH_NS::Types::Shader;
 
@@ -36,7 +57,15 @@ namespace SR_GRAPH_NS::Memory {
         void SR_FASTCALL SetField(uint64_t hashId, const void* data) noexcept;
         void SR_FASTCALL SetField(uint64_t hashId, const ShaderPropertyVariant& property) noexcept;
 
+        void SetField(const ShaderUBOSlot& slot, const void* pData) noexcept {
+            if (!m_memory || !slot.Valid()) SR_UNLIKELY_ATTRIBUTE {
+                return;
+            }
+            memcpy(m_memory + slot.offset, pData, slot.size);
+        }
+
         SR_NODISCARD bool HasField(uint64_t hashId) const noexcept;
+        SR_NODISCARD ShaderUBOSlot GetSlot(uint64_t hashId) const noexcept;
 
         SR_NODISCARD uint32_t GetBinding() const { return m_binding; }
         SR_NODISCARD bool Valid() const noexcept { return m_binding != SR_ID_INVALID; }
@@ -26,6 +26,9 @@ namespace SR_GRAPH_NS::Memory {
             UBO ubo = SR_ID_INVALID;
             void* pShaderHandle = nullptr;
             uint16_t uboSize = 0;
+            /// Смещение внутри страницы, если память выделена из общей страницы UBO
+            uint32_t offset = 0;
+            bool fromPage = false;
 
             void Validate() const {
                 SRAssert(ubo != SR_ID_INVALID);
@@ -80,6 +83,25 @@ namespace SR_GRAPH_NS::Memory {
             Duplicated,
             Failed
         };
+
+        /// Размер страницы, из которой выделяются небольшие UBO
+        static constexpr uint32_t UBO_PAGE_SIZE = 64 * 1024;
+        /// Максимальный размер UBO, который выделяется из страницы (минимальный maxUniformBufferRange)
+        static constexpr uint32_t UBO_PAGE_MAX_RANGE = 16 * 1024;
+
+    private:
+        struct UBOPage {
+            UBO ubo = SR_ID_INVALID;
+            uint32_t used = 0;
+            /// Количество выданных и еще не освобожденных областей
+            uint32_t ranges = 0;
+        };
+
+        struct UBORange {
+            UBO ubo = SR_ID_INVALID;
+            uint32_t offset = 0;
+        };
+
     private:
         UBOManager();
         ~UBOManager() override;
@@ -99,15 +121,35 @@ namespace SR_GRAPH_NS::Memory {
 
         BindResult BindNoDublicateUBO(VirtualUBO virtualUbo) noexcept;
 
-        SR_NODISCARD UBO GetUBO(VirtualUBO virtualUbo) const noexcept;
+        /// Если UBO выделен из страницы, то в pOffset и pRange записывается его область, иначе 0
+        SR_NODISCARD UBO GetUBO(VirtualUBO virtualUbo, uint32_t* pOffset = nullptr, uint32_t* pRange = nullptr) const noexcept;
+
+        SR_NODISCARD uint32_t GetPagesCount() const noexcept { return static_cast<uint32_t>(m_pages.size()); }
 
     private:
-        SR_NODISCARD bool AllocMemory(UBO* ubo, uint32_t uboSize);
+        SR_NODISCARD bool AllocMemory(VirtualUBOInfo::Data& data, uint32_t uboSize, bool shared);
+        SR_NODISCARD bool AllocPageRange(VirtualUBOInfo::Data& data, uint32_t uboSize);
+        SR_NODISCARD uint32_t GetAlignedSize(uint32_t uboSize) const;
+        void FreeMemory(VirtualUBOInfo::Data& data);
+        void FreePage(UBO ubo);
+        void BindMemory(const VirtualUBOInfo::Data& data);
 
     private:
         PipelinePtr m_pipeline;
         SR_HTYPES_NS::ObjectPool<VirtualUBOInfo, VirtualUBO> m_uboPool;
 
+        /// Небольшие UBO выделяются областями из общих страниц вместо отдельного буфера на каждый меш.
+        /// Область постоянна, пока меш жив, и передается в шейдер динамическим смещением (BLOCK),
+        /// поэтому меши одной страницы делят набор дескрипторов. Кольцо по кадрам в полете не нужно:
+        /// буферы команд кадровых буферов записываются в одном экземпляре, а кадр отправляется только
+        /// после завершения предыдущего, так что страница обновляется целиком перед отправкой кадра.
+        /// Освобожденные области складываются в списки по выровненному размеру и переиспользуются,
+        /// опустевшие страницы освобождаются
+        std::unordered_map<UBO, UBOPage> m_pages;
+        UBO m_currentPage = SR_ID_INVALID;
+        std::map<uint32_t, std::vector<UBORange>> m_freeRanges;
+        bool m_pagesEnabled = false;
+
     };
 }
 
@@ -99,6 +99,7 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD Context GetContext() const { return m_context; }
         SR_NODISCARD PipelinePtr GetPassPipeline() const { return m_pipeline; }
         SR_NODISCARD IRenderTechnique* GetTechnique() const { return m_technique; }
+        SR_NODISCARD CameraPtr GetCamera() const noexcept { return m_camera; }
         SR_NODISCARD bool IsInit() const { return m_isInit; }
         SR_NODISCARD SR_UTILS_NS::StringAtom GetName() const;
         SR_NODISCARD BasePass* GetParent() const { return m_parent; }
@@ -19,6 +19,9 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD const std::vector<SR_MATH_NS::Matrix4x4>& GetCascadeMatrices() const { return m_cascadeMatrices; }
         SR_NODISCARD const std::vector<float_t>& GetSplitDepths() const { return m_cascadeSplitDepths; }
 
+        /// Тени отбрасывают и объекты вне поля зрения камеры
+        SR_NODISCARD bool IsFrustumCullingEnabled() const noexcept override { return false; }
+
     protected:
         void UseConstants(ShaderUseInfo info) override;
         void UseUniforms(ShaderUseInfo info, MeshPtr pMesh) override;
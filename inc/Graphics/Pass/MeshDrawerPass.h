@@ -9,6 +9,7 @@
 #include <Graphics/Pass/ISamplersPass.h>
 #include <Graphics/Render/RenderPredicates.h>
 #include <Graphics/Pipeline/IShaderProgram.h>
+#include <Graphics/Memory/ShaderUBOBlock.h>
 #include <Graphics/SRSL/ShaderType.h>
 
 namespace SR_GRAPH_NS {
@@ -29,6 +30,23 @@ namespace SR_GRAPH_NS {
             bool depth = false;
         };
         using Samplers = std::vector<Sampler>;
+
+        /// Слоты общих юниформ, найденные один раз для каждого шейдера
+        struct SharedUniformSlots {
+            Memory::ShaderTypedSlot<float_t> time;
+            Memory::ShaderTypedSlot<SR_MATH_NS::Matrix4x4> viewMatrix;
+            Memory::ShaderTypedSlot<SR_MATH_NS::Matrix4x4> projectionMatrix;
+            Memory::ShaderTypedSlot<SR_MATH_NS::Matrix4x4> orthogonalMatrix;
+            Memory::ShaderTypedSlot<SR_MATH_NS::FVector3> viewDirection;
+            Memory::ShaderTypedSlot<SR_MATH_NS::FVector3> viewPosition;
+            Memory::ShaderTypedSlot<SR_MATH_NS::FVector3> directionalLightPosition;
+            Memory::ShaderTypedSlot<SR_MATH_NS::Matrix4x4> cascadeLightSpaceMatrices;
+            Memory::ShaderTypedSlot<float_t> cascadeSplits;
+            Memory::ShaderTypedSlot<SR_MATH_NS::Matrix4x4> lightSpaceMatrix;
+            Memory::ShaderTypedSlot<SR_MATH_NS::FVector4> lightClusterGrid;
+            Memory::ShaderTypedSlot<SR_MATH_NS::FVector4> lightClusterDepth;
+        };
+
     public:
         using RenderQueuePtr = SR_HTYPES_NS::SharedPtr<RenderQueue>;
 
@@ -48,11 +66,21 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD bool HasPostRender() const noexcept override { return false; }
         SR_NODISCARD virtual bool IsNeedUpdate() const noexcept { return false; }
         SR_NODISCARD virtual bool IsNeedUseMaterials() const noexcept { return m_useMaterials; }
+        SR_NODISCARD virtual bool IsFrustumCullingEnabled() const noexcept { return m_frustumCulling; }
+        SR_NODISCARD virtual bool IsInstancingEnabled() const noexcept { return m_instancing; }
+        /// Меши и серии экземпляров с VBO рисуются через буфер аргументов, отсечение и уровень детализации
+        /// меняют аргументы без перестроения
+        SR_NODISCARD virtual bool IsIndirectDrawEnabled() const noexcept { return m_indirectDraw; }
+        SR_NODISCARD virtual bool IsLodEnabled() const noexcept { return m_lod; }
+        /// Допустимая экранная ошибка уровня детализации в пикселях
+        SR_NODISCARD float_t GetLodErrorThreshold() const noexcept { return m_lodErrorThreshold; }
         SR_NODISCARD virtual uint8_t GetMeshDrawerFBOLayers() const noexcept { return 1; }
 
         virtual void UseUniforms(ShaderUseInfo info, MeshPtr pMesh);
         virtual void UseSharedUniforms(ShaderUseInfo info);
         virtual void UseConstants(ShaderUseInfo info);
+        /// Вызывается перед отрисовкой каждого меша, привязывает общие SSBO прохода
+        virtual void UseSSBO(ShaderUseInfo info);
 
         SR_NODISCARD ShaderUseInfo ReplaceShader(ShaderPtr pShader) const override;
         SR_NODISCARD bool IsLayerAllowed(SR_UTILS_NS::StringAtom layer) const override;
@@ -71,10 +99,16 @@ namespace SR_GRAPH_NS {
 
     private:
         void ClearOverrideShaders();
+        SR_NODISCARD const SharedUniformSlots& GetSharedUniformSlots(ShaderPtr pShader);
 
     private:
         bool m_useMaterials = true;
+        bool m_frustumCulling = true;
+        bool m_instancing = true;
+        bool m_indirectDraw = true;
+        bool m_lod = true;
         bool m_passWasRendered = false;
+        float_t m_lodErrorThreshold = 1.f;
 
         std::vector<RenderQueuePtr> m_renderQueues;
 
@@ -86,6 +120,7 @@ namespace SR_GRAPH_NS {
         std::vector<SR_UTILS_NS::StringAtom> m_materialVariants;
         ska::flat_hash_map<ShaderPtr, ShaderUseInfo> m_shaderReplacements;
         ska::flat_hash_map<SR_SRSL_NS::ShaderType, ShaderUseInfo> m_shaderTypeReplacements;
+        ska::flat_hash_map<ShaderPtr, SharedUniformSlots> m_sharedUniformSlots;
         std::set<SR_UTILS_NS::StringAtom> m_allowedLayers;
         std::set<SR_UTILS_NS::StringAtom> m_disallowedLayers;
 
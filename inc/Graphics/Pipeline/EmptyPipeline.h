@@ -7,8 +7,228 @@
 
 #include <Graphics/Pipeline/Pipeline.h>
 
+#include <Utils/Types/ObjectPool.h>
+
 namespace SR_GRAPH_NS {
-    class EmptyPipeline {
+    SR_ENUM_NS_CLASS_T(EmptyCommandType, uint8_t,
+        Unknown,
+        BeginCmdBuffer, EndCmdBuffer,
+        BeginRender, EndRender,
+        SetViewport, SetScissor,
+        ClearBuffers, ClearDepthBuffer, ClearColorBuffer,
+        UseShader, UnUseShader,
+        BindFrameBuffer, BindVBO, BindIBO, BindUBO, BindSSBO,
+        BindTexture, BindTextureTable, BindAttachment, BindDescriptorSet,
+        UpdateUBO, UpdateSSBO, UpdateDescriptorSets, UpdateIndirectBuffer,
+        PushConstants,
+        Draw, DrawIndices,
+        DrawInstanced, DrawIndicesInstanced,
+        DrawIndicesIndirect, DrawIndirect
+    );
+
+    /// Одна записанная команда. Смысл полей зависит от типа команды:
+    /// resource - идентификатор ресурса (VBO, UBO, шейдер и т.д.),
+    /// slot - точка привязки (для текстур), value - размер данных или количество вершин
+    /// (для отрисовки экземпляров - количество вершин в младших 32 битах и экземпляров в старших,
+    /// для областей UBO - размер в младших 32 битах и смещение в старших,
+    /// для непрямой отрисовки - количество команд в младших 32 битах и первая команда в старших,
+    /// для таблицы текстур - размер массива, resource - текстура-заглушка)
+    struct EmptyCommand {
+        EmptyCommandType type = EmptyCommandType::Unknown;
+        uint8_t slot = 0;
+        int32_t resource = SR_ID_INVALID;
+        uint64_t value = 0;
+    };
+
+    /**
+     * Конвейер без графического API. Принимает все вызовы рендера и записывает их
+     * в поток команд в оперативной памяти, что позволяет гонять рендер (очереди,
+     * построение сцены, менеджеры UBO и дескрипторов) без видеокарты.
+    */
+    class EmptyPipeline : public Pipeline {
+        using Super = Pipeline;
+
+        struct Buffer {
+            uint64_t size = 0;
+        };
+
+        struct Texture {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint64_t size = 0;
+        };
+
+        struct ShaderProgram {
+            int32_t frameBuffer = SR_ID_INVALID;
+        };
+
+        struct FrameBuffer {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t layersCount = 0;
+            /// Адреса элементов служат хендлами слоев кадрового буфера
+            std::vector<uint32_t> layers;
+        };
+
+        using Commands = std::vector<EmptyCommand>;
+        using Counters = std::vector<uint32_t>;
+
+    public:
+        explicit EmptyPipeline(const RenderContextPtr& pContext)
+            : Super(pContext)
+        { }
+
+        ~EmptyPipeline() override;
+
+    public:
+        bool PreInit(const PipelinePreInitInfo& info) override;
+        bool Init() override;
+        bool Destroy() override;
+
+    public:
+        SR_NODISCARD PipelineType GetType() const noexcept override { return PipelineType::Empty; }
+
+        SR_NODISCARD std::string GetVendor() const override { return "None"; }
+        SR_NODISCARD std::string GetRenderer() const override { return "Empty"; }
+        SR_NODISCARD std::string GetVersion() const override { return "None"; }
+
+        SR_NODISCARD void* GetCurrentShaderHandle() const override;
+        SR_NODISCARD void* GetCurrentFBOHandle() const override;
+        SR_NODISCARD std::set<void*> GetFBOHandles() const override;
+        SR_NODISCARD std::set<void*> GetShaderHandles() const override;
+        SR_NODISCARD uint8_t GetFrameBufferSampleCount() const override;
+        SR_NODISCARD uint8_t GetBuildIterationsCount() const noexcept override { return 1; }
+        SR_NODISCARD bool IsShaderConstantSupport() const noexcept override { ++m_state.operations; return true; }
+        SR_NODISCARD bool IsIndirectDrawSupported() const noexcept override { return true; }
+        SR_NODISCARD uint64_t GetUsedMemory() const override { return m_usedMemory; }
+        SR_NODISCARD bool IsVSyncEnabled() const override { return m_vsync; }
+
+        /// Команды текущего (еще не завершенного) кадра
+        SR_NODISCARD const Commands& GetCommands() const noexcept { return m_commands; }
+        /// Команды последнего завершенного кадра
+        SR_NODISCARD const Commands& GetPreviousCommands() const noexcept { return m_previousCommands; }
+        /// Команды, записанные на момент последнего построения сцены рендера
+        SR_NODISCARD const Commands& GetBuildCommands() const noexcept { return m_buildCommands; }
+
+        SR_NODISCARD uint32_t GetCommandsCount(EmptyCommandType type) const noexcept;
+        SR_NODISCARD uint32_t GetPreviousCommandsCount(EmptyCommandType type) const noexcept;
+        SR_NODISCARD uint64_t GetFramesCount() const noexcept { return m_framesCount; }
+        SR_NODISCARD bool IsRecordingEnabled() const noexcept { return m_recordingEnabled; }
+
+        /// Если запись выключена, то считаются только счетчики команд
+        void SetRecordingEnabled(bool enabled) { m_recordingEnabled = enabled; }
+
+        SR_NODISCARD int32_t AllocateUBO(uint32_t uboSize) override;
+        SR_NODISCARD int32_t AllocateVBO(void* pVertices, Vertices::VertexType type, size_t count) override;
+        SR_NODISCARD int32_t AllocateIBO(void* pIndices, uint32_t indexSize, size_t count, int32_t VBO) override;
+        SR_NODISCARD int32_t AllocateSSBO(uint32_t size, SSBOUsage usage) override;
+        SR_NODISCARD int32_t AllocateIndirectBuffer(uint32_t commandsCount) override;
+        SR_NODISCARD int32_t AllocDescriptorSet(const std::vector<DescriptorType>& types) override;
+        SR_NODISCARD int32_t AllocateShaderProgram(const SRShaderCreateInfo& createInfo, int32_t fbo) override;
+        SR_NODISCARD int32_t AllocateTexture(const SRTextureCreateInfo& createInfo) override;
+        SR_NODISCARD int32_t AllocateFrameBuffer(const SRFrameBufferCreateInfo& createInfo) override;
+        SR_NODISCARD int32_t AllocateCubeMap(const SRCubeMapCreateInfo& createInfo) override;
+
+        bool FreeDescriptorSet(int32_t* id) override;
+        bool FreeVBO(int32_t* id) override;
+        bool FreeIBO(int32_t* id) override;
+        bool FreeUBO(int32_t* id) override;
+        bool FreeFBO(int32_t* id) override;
+        bool FreeSSBO(int32_t* id) override;
+        bool FreeIndirectBuffer(int32_t* id) override;
+        bool FreeCubeMap(int32_t* id) override;
+        bool FreeShader(int32_t* id) override;
+        bool FreeTexture(int32_t* id) override;
+        bool IsSamplerValid(int32_t id) const override;
+
+    public:
+        void SetVSyncEnabled(bool enabled) override { m_vsync = enabled; }
+
+        void SetDirty(bool dirty) override;
+
+        bool BeginCmdBuffer() override;
+        void EndCmdBuffer() override;
+
+        bool BeginRender() override;
+        void EndRender() override;
+
+        void DrawFrame() override;
+
+        void SetViewport(int32_t width, int32_t height) override;
+        void SetScissor(int32_t width, int32_t height) override;
+
+        void ClearBuffers() override;
+        void ClearBuffers(float_t r, float_t g, float_t b, float_t a, float_t depth, uint8_t colorCount) override;
+        void ClearBuffers(const ClearColors& clearColors, std::optional<float_t> depth) override;
+        void ClearDepthBuffer(float_t depth) override;
+        void ClearColorBuffer(const ClearColors& clearColors) override;
+
+        void UpdateDescriptorSets(uint32_t descriptorSet, const SRDescriptorUpdateInfos& updateInfo) override;
+        void UpdateUBO(uint32_t UBO, void* pData, uint64_t size) override;
+        void UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset) override;
+        void UpdateSSBO(uint32_t SSBO, void* pData, uint64_t size) override;
+        void UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count) override;
+        void UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command) override;
+
+        void PushConstants(void* pData, uint64_t size) override;
+
+        void UseShader(uint32_t shaderProgram) override;
+        void UnUseShader() override;
+
+        void Draw(uint32_t count) override;
+        void DrawIndices(uint32_t count, uint32_t firstIndex) override;
+        void DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex) override;
+        void DrawInstanced(uint32_t count, uint32_t instanceCount) override;
+        void DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount) override;
+        void DrawIndirect(uint32_t buffer) override;
+
+        void BindAttachment(uint8_t activeTexture, uint32_t textureId) override;
+        void BindVBO(uint32_t VBO) override;
+        void BindUBO(uint32_t UBO) override;
+        void BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range) override;
+        void BindIBO(uint32_t IBO) override;
+        void BindTexture(uint8_t activeTexture, uint32_t textureId) override;
+        void BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture) override;
+        bool BindDescriptorSet(uint32_t descriptorSet) override;
+        void BindFrameBuffer(FramebufferPtr pFBO) override;
+        void BindSSBO(uint32_t SSBO) override;
+
+        void ResetLastShader() override;
+
+    private:
+        void Record(EmptyCommandType type, int32_t resource = SR_ID_INVALID, uint64_t value = 0, uint8_t slot = 0);
+
+        SR_NODISCARD int32_t AllocateBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, uint64_t size);
+        bool FreeBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, int32_t* id, const char* name);
+        bool FreeTextureImpl(int32_t* id, const char* name);
+        SR_NODISCARD int32_t AllocateAttachment(int32_t id, const SRTextureCreateInfo& createInfo);
+        void UpdateBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, uint32_t id, uint64_t size, const char* name);
+
+    private:
+        Commands m_commands;
+        Commands m_previousCommands;
+        Commands m_buildCommands;
+
+        Counters m_counters;
+        Counters m_previousCounters;
+
+        SR_HTYPES_NS::ObjectPool<Buffer, int32_t> m_vboPool;
+        SR_HTYPES_NS::ObjectPool<Buffer, int32_t> m_iboPool;
+        SR_HTYPES_NS::ObjectPool<Buffer, int32_t> m_uboPool;
+        SR_HTYPES_NS::ObjectPool<Buffer, int32_t> m_ssboPool;
+        SR_HTYPES_NS::ObjectPool<Buffer, int32_t> m_indirectPool;
+        SR_HTYPES_NS::ObjectPool<Texture, int32_t> m_texturePool;
+        SR_HTYPES_NS::ObjectPool<FrameBuffer*, int32_t> m_fboPool;
+        SR_HTYPES_NS::ObjectPool<ShaderProgram*, int32_t> m_shaderProgramPool;
+        SR_HTYPES_NS::ObjectPool<std::vector<DescriptorType>, int32_t> m_descriptorSetPool;
+
+        ShaderProgram* m_currentShaderProgram = nullptr;
+
+        uint64_t m_usedMemory = 0;
+        uint64_t m_framesCount = 0;
+
+        bool m_recordingEnabled = true;
+        bool m_vsync = false;
 
     };
 }
@@ -81,6 +81,20 @@ namespace SR_GRAPH_NS {
     SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_COLOR_BUFFER_VALUE = "COLOR_BUFFER_VALUE";
     SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_SSAO_NOISE = "SSAO_NOISE";
     SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_TEXT_ATLAS_TEXTURE = "TEXT_ATLAS_TEXTURE";
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_LIGHT_CLUSTER_GRID = "LIGHT_CLUSTER_GRID";
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_LIGHT_CLUSTER_DEPTH = "LIGHT_CLUSTER_DEPTH";
+
+    /// Имя SSBO блока с матрицами экземпляров, по нему определяется поддержка инстансинга шейдером
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_INSTANCES_BLOCK = "instances";
+    /// Общий на сцену блок матриц костей и неизменяемый блок смещений костей ресурса
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_BONES_BLOCK = "bones";
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_BONE_OFFSETS_BLOCK = "offsets";
+    /// Имя SSBO блока с вершинами пакетной отладочной отрисовки
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_DEBUG_VERTICES_BLOCK = "debugVertices";
+    /// Имена SSBO блоков кластерного освещения
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_CLUSTER_LIGHTS_BLOCK = "clusterLights";
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_CLUSTER_RANGES_BLOCK = "clusterRanges";
+    SR_INLINE_STATIC SR_UTILS_NS::StringAtom SHADER_CLUSTER_INDICES_BLOCK = "clusterIndices";
 
     typedef std::vector<std::pair<Vertices::Attribute, size_t>> VertexAttributes;
     typedef std::vector<SR_VERTEX_DESCRIPTION> VertexDescriptions;
@@ -103,7 +117,7 @@ namespace SR_GRAPH_NS {
         MissSecondary
     );
 
-    SR_ENUM_NS_CLASS(LayoutBinding, Unknown = 0, Uniform, Sampler2D, Attachhment, SSBO)
+    SR_ENUM_NS_CLASS(LayoutBinding, Unknown = 0, Uniform, Sampler2D, Attachhment, SSBO, DynamicUniform)
     SR_ENUM_NS_CLASS(PolygonMode, Unknown, Fill, Line, Point)
     SR_ENUM_NS_CLASS(CullMode, Unknown, None, Front, Back, FrontAndBack)
     SR_ENUM_NS_CLASS(PrimitiveTopology,
@@ -136,6 +150,8 @@ namespace SR_GRAPH_NS {
         ShaderStage stage = ShaderStage::Unknown;
         uint64_t binding = 0;
         uint64_t size = 0;
+        /// Количество дескрипторов в биндинге (массив семплеров)
+        uint32_t count = 1;
     };
 
     typedef std::vector<Uniform> UBOInfo;
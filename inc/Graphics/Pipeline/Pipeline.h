@@ -111,6 +111,8 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD int32_t GetCurrentShaderId() const { ++m_state.operations; return m_state.shaderId; }
         SR_NODISCARD int32_t GetCurrentFrameBufferId() const noexcept { ++m_state.operations; return m_state.frameBufferId; }
         SR_NODISCARD int32_t GetCurrentUBO() const { ++m_state.operations; return m_state.UBOId; }
+        SR_NODISCARD uint32_t GetCurrentUBOOffset() const noexcept { return m_state.UBOOffset; }
+        SR_NODISCARD uint32_t GetCurrentUBORange() const noexcept { return m_state.UBORange; }
         SR_NODISCARD int32_t GetCurrentDescriptorSet() const noexcept { ++m_state.operations; return m_state.descriptorSetId; }
         SR_NODISCARD uint32_t GetCurrentFrameBufferLayer() const noexcept { ++m_state.operations; return m_state.frameBufferLayer; }
         SR_NODISCARD bool IsDirty() const noexcept { ++m_state.operations; return m_dirty; }
@@ -126,6 +128,10 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD virtual uint8_t GetBuildIterationsCount() const noexcept { ++m_state.operations; return 0; }
         SR_NODISCARD virtual uint8_t GetSupportedSamples() const noexcept { return m_supportedSampleCount; }
         SR_NODISCARD virtual bool IsShaderConstantSupport() const { ++m_state.operations; return false; }
+        /// Поддерживается ли непрямая отрисовка. Без нее вызывающий код рисует меши напрямую
+        SR_NODISCARD virtual bool IsIndirectDrawSupported() const noexcept { return false; }
+        /// Выравнивание смещений областей внутри UBO (minUniformBufferOffsetAlignment)
+        SR_NODISCARD uint32_t GetUBOOffsetAlignment() const noexcept { return m_uboOffsetAlignment; }
         SR_NODISCARD virtual SR_MATH_NS::FColor GetPixelColor(uint32_t textureId, uint32_t x, uint32_t y) { return SR_MATH_NS::FColor(0.f); }
 
         virtual void SetCurrentShader(ShaderPtr pShader) { ++m_state.operations; m_state.pShader = pShader; }
@@ -166,6 +172,18 @@ namespace SR_GRAPH_NS {
         virtual void SetVSyncEnabled(bool enabled) { }
 
         SR_NODISCARD uint32_t GetFramesPerSecond() const noexcept { return m_framesPerSecond; }
+        /// Монотонный номер кадра, не сбрасывается
+        SR_NODISCARD uint64_t GetFrameIndex() const noexcept { return m_frameIndex; }
+        /// Сколько ресурсов было освобождено за все время, включая текущий кадр
+        SR_NODISCARD uint64_t GetDeletionsCount() const noexcept { return m_deletionsCount + m_state.deletions; }
+        /// Дескрипторы шейдеров (GetCurrentShaderHandle), освобожденных с последней очистки списка.
+        /// Адрес освобожденного шейдера может достаться новому, поэтому связанные с ним данные нужно забыть сразу
+        SR_NODISCARD const std::vector<void*>& GetFreedShaderHandles() const noexcept { return m_freedShaderHandles; }
+        void ClearFreedShaderHandles() noexcept { m_freedShaderHandles.clear(); }
+        /// Ресурсы, освобожденные с последней очистки списка. Их идентификаторы могут достаться новым,
+        /// поэтому закешированные наборы дескрипторов с ними нужно забыть
+        SR_NODISCARD const std::vector<DescriptorResource>& GetFreedResources() const noexcept { return m_freedResources; }
+        void ClearFreedResources() noexcept { m_freedResources.clear(); }
         SR_NODISCARD const PipelineState& GetPreviousState() const { return m_previousState; }
         SR_NODISCARD const PipelineState& GetBuildState() const { return m_buildState; }
         SR_NODISCARD uint8_t GetSamplesCount() const;
@@ -182,6 +200,8 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD virtual int32_t AllocateIBO(void* pIndices, uint32_t indexSize, size_t count, int32_t VBO) { return SR_ID_INVALID; }
         SR_NODISCARD virtual int32_t AllocateUBO(uint32_t uboSize) { return SR_ID_INVALID; }
         SR_NODISCARD virtual int32_t AllocateSSBO(uint32_t ssboSize, SSBOUsage usage) { return SR_ID_INVALID; }
+        /// Буфер аргументов непрямой отрисовки на commandsCount команд
+        SR_NODISCARD virtual int32_t AllocateIndirectBuffer(uint32_t commandsCount) { return SR_ID_INVALID; }
         SR_NODISCARD virtual int32_t AllocDescriptorSet(const std::vector<DescriptorType>& types) { return SR_ID_INVALID; }
         SR_NODISCARD virtual int32_t AllocateShaderProgram(const SRShaderCreateInfo& createInfo, int32_t fbo) { return SR_ID_INVALID; };
         SR_NODISCARD virtual int32_t AllocateTexture(const SRTextureCreateInfo& createInfo) { return SR_ID_INVALID; };
@@ -194,6 +214,7 @@ namespace SR_GRAPH_NS {
         virtual bool FreeUBO(int32_t* id) { return false; }
         virtual bool FreeFBO(int32_t* id) { return false; }
         virtual bool FreeSSBO(int32_t* id) { return false; }
+        virtual bool FreeIndirectBuffer(int32_t* id) { return false; }
         virtual bool FreeCubeMap(int32_t* id) { return false; }
         virtual bool FreeShader(int32_t* id) { return false; }
         virtual bool FreeTexture(int32_t* id) { return false; }
@@ -202,12 +223,25 @@ namespace SR_GRAPH_NS {
 
         /// ------------------------------------------ Вызовы отрисовки ------------------------------------------------
 
-        /// Отрисовка вершин по индексам
-        virtual void DrawIndices(uint32_t count);
+        /// Отрисовка вершин по индексам, firstIndex - начало диапазона в IBO (например, уровень детализации)
+        virtual void DrawIndices(uint32_t count, uint32_t firstIndex = 0);
 
         /// Обычная отрисовка вершин
         virtual void Draw(uint32_t count);
 
+        /// Отрисовка нескольких экземпляров по индексам, данные экземпляров берутся шейдером из SSBO
+        virtual void DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex = 0);
+
+        /// Отрисовка нескольких экземпляров без индексов
+        virtual void DrawInstanced(uint32_t count, uint32_t instanceCount);
+
+        /// Непрямая отрисовка drawCount команд из буфера аргументов начиная с команды first.
+        /// Количество вершин и экземпляров известно только видеокарте, поэтому в статистику не попадает
+        virtual void DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount);
+
+        /// Непрямая отрисовка одной команды без индексов из начала буфера аргументов
+        virtual void DrawIndirect(uint32_t buffer);
+
         /// --------------------------------------------- Биндинги -----------------------------------------------------
 
         virtual void UseShader(uint32_t shaderProgram);
@@ -224,15 +258,27 @@ namespace SR_GRAPH_NS {
         /// Uniform Buffer Object - обеспечивает привязку для передачм данных в шейдеры
         virtual void BindUBO(uint32_t UBO);
 
+        /// Привязывает область UBO, используется для UBO, выделенных из общей страницы
+        virtual void BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range);
+
         /// Shader Storage Buffer Object - обеспечивает привязку для передачм данных в шейдеры
         virtual void BindSSBO(uint32_t SSBO);
 
         /// Обеспечивает обновление данных в шейдере
         virtual void UpdateUBO(uint32_t UBO, void* pData, uint64_t size);
 
+        /// Обновляет данные области UBO начиная со смещения offset
+        virtual void UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset);
+
         /// Обеспечивает обновление данных в шейдере
         virtual void UpdateSSBO(uint32_t SSBO, void* pData, uint64_t size);
 
+        /// Перезаписывает первые count команд буфера аргументов непрямой отрисовки
+        virtual void UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count);
+
+        /// Перезаписывает команду непрямой отрисовки без индексов в начале буфера
+        virtual void UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command);
+
         /// Привязываем к дескриптору юниформы. Работает не во всех API
         virtual void UpdateDescriptorSets(uint32_t descriptorSet, const SRDescriptorUpdateInfos& updateInfo);
 
@@ -242,12 +288,37 @@ namespace SR_GRAPH_NS {
 
         virtual void BindTexture(uint8_t activeTexture, uint32_t textureId);
         virtual void BindAttachment(uint8_t activeTexture, uint32_t textureId);
+        /// Записывает элементы таблицы [first, first + count) в биндинг-массив текущего набора дескрипторов.
+        /// Пустые и отсутствующие элементы таблицы заменяются на fallbackTexture
+        virtual void BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture);
 
         /// Привязка UBO к набору дескрипторов. Поддерживается не всеми API
         virtual bool BindDescriptorSet(uint32_t descriptorSet);
+        /// Разделяемый набор содержит одинаковые данные для всех пользователей,
+        /// поэтому его можно привязывать несколько раз за проход
+        void SetDescriptorSetShared(uint32_t descriptorSet, bool shared);
 
         virtual void ResetLastShader();
 
+    protected:
+        /// ------------------------------------- Фильтр избыточных смен состояния -------------------------------------
+        /// Возвращают true, если команду нужно записать. Иначе такое же состояние уже записано в буфер команд,
+        /// и команда учитывается как отброшенная
+
+        SR_NODISCARD bool FilterVBO(uint32_t VBO);
+        SR_NODISCARD bool FilterIBO(uint32_t IBO);
+        /// Запись текстуры в текущий набор дескрипторов
+        SR_NODISCARD bool FilterTexture(uint8_t binding, uint32_t textureId);
+        SR_NODISCARD bool FilterDescriptorSet(void* pDescriptorSet, void* pLayout, uint32_t dynamicOffset = 0);
+        SR_NODISCARD bool FilterPushConstants(const void* pData, uint64_t size);
+
+        /// Освобожденный идентификатор может быть сразу переиспользован, поэтому теневое состояние его забывает
+        void ForgetShadowVBO(int32_t VBO);
+        void ForgetShadowIBO(int32_t IBO);
+        void ForgetShadowTextures();
+
+        void OnResourceFreed(DescriptorType type, int32_t id) { m_freedResources.emplace_back(DescriptorResource { type, id }); }
+
     protected:
         std::map<OverlayType, SR_HTYPES_NS::SharedPtr<Overlay>> m_overlays;
 
@@ -267,12 +338,16 @@ namespace SR_GRAPH_NS {
         RenderContextPtr m_renderContext;
 
         SR_HTYPES_NS::PoolSet<bool> m_bindedDescriptors;
+        SR_HTYPES_NS::PoolSet<bool> m_sharedDescriptors;
 
         PipelineState m_state;
         PipelineState m_previousState;
         /// Состояние, которое было на момент постоения сцены рендера
         PipelineState m_buildState;
 
+        PipelineShadowState m_shadowState;
+        bool m_isStateFilterEnabled = true;
+
         /// Все параметры, относящиется к мультисемплингу
         std::optional<uint8_t> m_newSampleCount;
         uint8_t m_currentSampleCount = 0;
@@ -280,8 +355,15 @@ namespace SR_GRAPH_NS {
         uint8_t m_supportedSampleCount = 0;
         bool m_isMultiSampleSupported = false;
 
+        /// Наибольшее допустимое значение minUniformBufferOffsetAlignment, пока устройство не сообщило свое
+        uint32_t m_uboOffsetAlignment = 256;
+
         uint32_t m_frames = 0;
         uint32_t m_framesPerSecond = 0;
+        uint64_t m_frameIndex = 0;
+        uint64_t m_deletionsCount = 0;
+        std::vector<void*> m_freedShaderHandles;
+        std::vector<DescriptorResource> m_freedResources;
         std::optional<SR_UTILS_NS::TimePointType> m_lastSecond;
 
         bool m_isShaderChanged = true;
@@ -10,6 +10,8 @@
 #include <Graphics/Pipeline/TextureHelper.h>
 #include <Graphics/Types/Descriptors.h>
 
+#include <Utils/Types/Map.h>
+
 namespace SR_GTYPES_NS {
     class Shader;
     class Framebuffer;
@@ -39,6 +41,8 @@ namespace SR_GRAPH_NS {
         uint8_t mipLevels = 0;
         bool alpha = false;
         bool cpuUsage = false;
+        /// Прогресс сжатия, если задано compression. Может отменить создание текстуры
+        TextureCompressProgressFn compressProgress;
     };
 
     struct SRCubeMapCreateInfo {
@@ -52,10 +56,34 @@ namespace SR_GRAPH_NS {
         DescriptorType descriptorType = DescriptorType::Unknown;
         uint32_t binding = 0;
         uint32_t ubo = 0;
+        /// Смещение и размер области буфера. Если range == 0, то используется весь буфер
+        uint32_t offset = 0;
+        uint32_t range = 0;
     };
 
     using SRDescriptorUpdateInfos = std::vector<SRDescriptorUpdateInfo>;
 
+    /// Аргументы одной команды непрямой отрисовки, раскладка совпадает с VkDrawIndexedIndirectCommand
+    struct DrawIndexedIndirectCommand {
+        uint32_t indexCount = 0;
+        uint32_t instanceCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t vertexOffset = 0;
+        uint32_t firstInstance = 0;
+    };
+
+    static_assert(sizeof(DrawIndexedIndirectCommand) == 5 * sizeof(uint32_t));
+
+    /// Аргументы непрямой отрисовки без индексов, раскладка совпадает с VkDrawIndirectCommand
+    struct DrawIndirectCommand {
+        uint32_t vertexCount = 0;
+        uint32_t instanceCount = 0;
+        uint32_t firstVertex = 0;
+        uint32_t firstInstance = 0;
+    };
+
+    static_assert(sizeof(DrawIndirectCommand) <= sizeof(DrawIndexedIndirectCommand));
+
     struct PipelinePreInitInfo {
         uint32_t samplesCount = 0;
         std::string appName;
@@ -89,6 +117,9 @@ namespace SR_GRAPH_NS {
         int32_t buildIteration = 0;
 
         int32_t UBOId = SR_ID_INVALID;
+        /// Область текущего UBO, если он выделен из общей страницы. Если UBORange == 0, то используется весь буфер
+        uint32_t UBOOffset = 0;
+        uint32_t UBORange = 0;
         int32_t FBOId = SR_ID_INVALID;
         int32_t SSBOId = SR_ID_INVALID;
         int32_t descriptorSetId = SR_ID_INVALID;
@@ -105,6 +136,9 @@ namespace SR_GRAPH_NS {
         mutable uint32_t vertices = 0;
         /// Количество всех обращений к API в процессе отрисовки
         mutable uint32_t operations = 0;
+        /// Смены состояния, отброшенные как повторные, и фактически записанные в буфер команд
+        mutable uint32_t filteredOperations = 0;
+        mutable uint32_t issuedOperations = 0;
 
         /// Объем данных, который был передан на видеокарту в процессе отрисовки
         mutable uint32_t transferredMemory = 0;
@@ -122,6 +156,45 @@ namespace SR_GRAPH_NS {
         mutable uint32_t deletions = 0;
 
     };
+
+    /// Теневая копия состояния, уже записанного в текущий буфер команд.
+    /// В отличие от PipelineState не сбрасывается каждый кадр, а живет от BeginCmdBuffer до следующего BeginCmdBuffer
+    struct PipelineShadowState {
+    public:
+        void Reset() {
+            VBO = SR_ID_INVALID;
+            IBO = SR_ID_INVALID;
+            textures.clear();
+            ResetShader();
+        }
+
+        /// Смена пайплайна делает недействительными наборы дескрипторов и push constants
+        void ResetShader() {
+            pDescriptorSet = nullptr;
+            pLayout = nullptr;
+            dynamicOffset = 0;
+            pushConstants.clear();
+        }
+
+        SR_NODISCARD static uint64_t TextureKey(int32_t descriptorSet, uint8_t binding) noexcept {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(descriptorSet)) << 8U) | binding;
+        }
+
+    public:
+        int32_t VBO = SR_ID_INVALID;
+        int32_t IBO = SR_ID_INVALID;
+
+        void* pDescriptorSet = nullptr;
+        void* pLayout = nullptr;
+        /// Смещение блока объекта, с которым был привязан набор
+        uint32_t dynamicOffset = 0;
+
+        std::vector<uint8_t> pushConstants;
+
+        /// (набор дескрипторов, binding) -> текстура, уже записанная в набор
+        ska::flat_hash_map<uint64_t, uint32_t> textures;
+
+    };
 }
 
 #endif //SR_ENGINE_PIPELINE_STATE_H
@@ -8,6 +8,8 @@
 #include <Utils/Common/Enumerations.h>
 #include <Utils/Resources/Xml.h>
 
+#include <functional>
+
 namespace SR_GRAPH_NS {
     SR_ENUM_NS_CLASS_T(SSBOUsage, uint8_t,
         Unknown,
@@ -160,7 +162,26 @@ namespace SR_GRAPH_NS {
 
     uint32_t GetPixelSize(ImageFormat format);
 
-    uint8_t* Compress(uint32_t w, uint32_t h, uint8_t* pixels, SR_GRAPH_NS::TextureCompression method);
+    /// Вызывается по мере сжатия полос блоков с прогрессом от 0.f до 1.f, возврат false отменяет сжатие.
+    /// Вызовы идут из рабочих потоков, но никогда не одновременно
+    using TextureCompressProgressFn = std::function<bool(float_t progress)>;
+
+    /// Сколько уровней можно сжать из изображения w x h: каждый следующий уровень вдвое меньше,
+    /// и его размеры должны оставаться кратными 4. maxLevels == 0 - вся цепочка
+    uint32_t GetCompressedMipLevels(uint32_t w, uint32_t h, uint32_t maxLevels);
+
+    /// Размер блока 4x4 в байтах, 0 - метод не блочный
+    uint32_t GetCompressedBlockSize(SR_GRAPH_NS::TextureCompression method);
+
+    /// Смещения уровней в результате Compress, последний элемент - общий размер. Пусто при ошибке
+    std::vector<uint64_t> GetCompressedMipOffsets(uint32_t w, uint32_t h, SR_GRAPH_NS::TextureCompression method, uint32_t mipLevels);
+
+    /// Сжимает изображение RGBA8 (размеры кратны 4) и mipLevels его уменьшенных уровней в BC.
+    /// Уровни строятся усреднением 2x2 и лежат в результате подряд, начиная с исходного.
+    /// Блоки всех уровней разбиваются на полосы, которые сжимаются параллельно, результат не зависит от числа потоков.
+    /// Память освобождается через free(). Возвращает nullptr при ошибке или отмене
+    uint8_t* Compress(uint32_t w, uint32_t h, const uint8_t* pixels, SR_GRAPH_NS::TextureCompression method, uint32_t mipLevels,
+        const TextureCompressProgressFn& progressFn = TextureCompressProgressFn());
 }
 
 #endif //SR_ENGINE_TEXTUREHELPER_H
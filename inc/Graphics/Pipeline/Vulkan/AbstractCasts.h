@@ -88,6 +88,7 @@ namespace SR_GRAPH_NS::VulkanTools {
             switch (uniform.type) {
                 case LayoutBinding::Sampler2D: type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; break;
                 case LayoutBinding::Uniform: type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; break;
+                case LayoutBinding::DynamicUniform: type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; break;
                 case LayoutBinding::Attachhment: type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT; break;
                 case LayoutBinding::SSBO: type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; break;
                 default:
@@ -112,9 +113,11 @@ namespace SR_GRAPH_NS::VulkanTools {
                 }
             }
 
-            descriptorLayoutBindings.emplace_back(EvoVulkan::Tools::Initializers::DescriptorSetLayoutBinding(
+            auto&& layoutBinding = descriptorLayoutBindings.emplace_back(EvoVulkan::Tools::Initializers::DescriptorSetLayoutBinding(
                     type, stage, uniform.binding
             ));
+            /// массив семплеров (таблица текстур)
+            layoutBinding.descriptorCount = SR_MAX(uniform.count, 1u);
 
         skip:
             SR_NOOP;
@@ -236,6 +239,8 @@ namespace SR_GRAPH_NS::VulkanTools {
         switch (descriptorType) {
             case DescriptorType::Uniform:
                 return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            case DescriptorType::DynamicUniform:
+                return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             case DescriptorType::CombinedImage:
                 return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             default: {
@@ -256,6 +261,9 @@ namespace SR_GRAPH_NS::VulkanTools {
                 case DescriptorType::Uniform:
                     vkDescriptorTypes.emplace_back(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
                     break;
+                case DescriptorType::DynamicUniform:
+                    vkDescriptorTypes.emplace_back(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+                    break;
                 case DescriptorType::CombinedImage:
                     vkDescriptorTypes.emplace_back(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
                     break;
@@ -277,6 +285,9 @@ namespace SR_GRAPH_NS::VulkanTools {
             if (type == static_cast<uint64_t>(DescriptorType::Uniform)) {
                 type = static_cast<uint64_t>(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             }
+            else if (type == static_cast<uint64_t>(DescriptorType::DynamicUniform)) {
+                type = static_cast<uint64_t>(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+            }
             else if (type == static_cast<uint64_t>(DescriptorType::CombinedImage)) {
                 type = static_cast<uint64_t>(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
             }
@@ -64,6 +64,7 @@ namespace SR_GRAPH_NS::VulkanTools {
         SR_NODISCARD bool FreeIBO(uint32_t id);
         SR_NODISCARD bool FreeFBO(uint32_t id);
         SR_NODISCARD bool FreeSSBO(uint32_t id);
+        SR_NODISCARD bool FreeIndirectBuffer(uint32_t id);
 
         SR_NODISCARD bool FreeTexture(uint32_t id);
 
@@ -76,6 +77,7 @@ namespace SR_GRAPH_NS::VulkanTools {
         SR_NODISCARD int32_t AllocateUBO(uint32_t UBOSize);
         SR_NODISCARD int32_t AllocateIBO(uint32_t buffSize, void* data);
         SR_NODISCARD int32_t AllocateSSBO(uint32_t size, SSBOUsage usage);
+        SR_NODISCARD int32_t AllocateIndirectBuffer(uint32_t size);
 
         SR_NODISCARD bool ReAllocateFBO(const VulkanFrameBufferAllocInfo& info);
 
@@ -114,6 +116,7 @@ namespace SR_GRAPH_NS::VulkanTools {
         SR_NODISCARD EvoVulkan::Types::VmaBuffer* GetUBO(uint32_t id) { return m_uboPool.At(static_cast<int32_t>(id)); }
         SR_NODISCARD EvoVulkan::Types::VmaBuffer* GetIBO(uint32_t id) { return m_iboPool.At(static_cast<int32_t>(id)); }
         SR_NODISCARD EvoVulkan::Types::VmaBuffer* GetSSBO(uint32_t id) { return m_ssboPool.At(static_cast<int32_t>(id)); }
+        SR_NODISCARD EvoVulkan::Types::VmaBuffer* GetIndirectBuffer(uint32_t id) { return m_indirectPool.At(static_cast<int32_t>(id)); }
         SR_NODISCARD EvoVulkan::Complexes::FrameBuffer* GetFBO(uint32_t id) { return m_fboPool.At(static_cast<int32_t>(id)); }
         SR_NODISCARD EvoVulkan::Complexes::Shader* GetShaderProgram(uint32_t id) { return m_shaderProgramPool.At(static_cast<int32_t>(id)); }
         SR_NODISCARD EvoVulkan::Types::DescriptorSet& GetDescriptorSet(uint32_t id) { return m_descriptorSetPool.At(static_cast<int32_t>(id)); }
@@ -137,6 +140,11 @@ namespace SR_GRAPH_NS::VulkanTools {
         SR_NODISCARD uint32_t GetFBOsCount() const { return m_fboPool.GetAliveCount(); }
         SR_NODISCARD uint32_t GetTexturesCount() const { return m_texturePool.GetAliveCount(); }
 
+    private:
+        /// Записывает готовую цепочку уровней (например, результат Compress) в изображение текстуры,
+        /// по одной области копирования на уровень. offsets - смещения уровней, последний элемент - общий размер
+        SR_NODISCARD bool UploadMipLevels(EvoVulkan::Types::Texture* pTexture, const uint8_t* pixels, uint32_t w, uint32_t h, const std::vector<uint64_t>& offsets);
+
     private:
         EvoVulkan::Core::DescriptorManager* m_descriptorManager = nullptr;
         EvoVulkan::Types::Device* m_device = nullptr;
@@ -149,6 +157,7 @@ namespace SR_GRAPH_NS::VulkanTools {
         SR_HTYPES_NS::ObjectPool<EvoVulkan::Types::VmaBuffer*, int32_t> m_uboPool;
         SR_HTYPES_NS::ObjectPool<EvoVulkan::Types::VmaBuffer*, int32_t> m_iboPool;
         SR_HTYPES_NS::ObjectPool<EvoVulkan::Types::VmaBuffer*, int32_t> m_ssboPool;
+        SR_HTYPES_NS::ObjectPool<EvoVulkan::Types::VmaBuffer*, int32_t> m_indirectPool;
         SR_HTYPES_NS::ObjectPool<EvoVulkan::Complexes::FrameBuffer*, int32_t> m_fboPool;
         SR_HTYPES_NS::ObjectPool<EvoVulkan::Types::Texture*, int32_t> m_texturePool;
 
@@ -23,6 +23,18 @@ namespace EvoVulkan::Complexes {
 namespace SR_GRAPH_NS {
     class VulkanPipeline : public Pipeline {
         using Super = Pipeline;
+
+        struct UBORangeMemory {
+            std::vector<uint8_t> memory;
+            bool dirty = false;
+        };
+
+        /// UBO объекта, записанный в набор дескрипторов как динамический
+        struct DynamicUBO {
+            int32_t ubo = SR_ID_INVALID;
+            uint32_t offset = 0;
+        };
+
     public:
         explicit VulkanPipeline(const RenderContextPtr& pContext)
             : Super(pContext)
@@ -58,6 +70,7 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD VulkanTools::MemoryManager* GetMemoryManager() const noexcept { return m_memory; }
         SR_NODISCARD uint64_t GetUsedMemory() const override;
         SR_NODISCARD bool IsShaderConstantSupport() const noexcept override { ++m_state.operations; return true; }
+        SR_NODISCARD bool IsIndirectDrawSupported() const noexcept override { return true; }
 
         SR_NODISCARD int32_t AllocateUBO(uint32_t uboSize) override;
         SR_NODISCARD int32_t AllocateVBO(void* pVertices, Vertices::VertexType type, size_t count) override;
@@ -68,6 +81,7 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD int32_t AllocateFrameBuffer(const SRFrameBufferCreateInfo& createInfo) override;
         SR_NODISCARD int32_t AllocateCubeMap(const SRCubeMapCreateInfo& createInfo) override;
         SR_NODISCARD int32_t AllocateSSBO(uint32_t size, SSBOUsage usage) override;
+        SR_NODISCARD int32_t AllocateIndirectBuffer(uint32_t commandsCount) override;
 
         bool FreeDescriptorSet(int32_t* id) override;
         bool FreeVBO(int32_t* id) override;
@@ -75,6 +89,7 @@ namespace SR_GRAPH_NS {
         bool FreeUBO(int32_t* id) override;
         bool FreeFBO(int32_t* id) override;
         bool FreeSSBO(int32_t* id) override;
+        bool FreeIndirectBuffer(int32_t* id) override;
         bool FreeCubeMap(int32_t* id) override;
         bool FreeShader(int32_t* id) override;
         bool FreeTexture(int32_t* id) override;
@@ -114,7 +129,10 @@ namespace SR_GRAPH_NS {
 
         void UpdateDescriptorSets(uint32_t descriptorSet, const SRDescriptorUpdateInfos& updateInfo) override;
         void UpdateUBO(uint32_t UBO, void* pData, uint64_t size) override;
+        void UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset) override;
         void UpdateSSBO(uint32_t SSBO, void* pData, uint64_t size) override;
+        void UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count) override;
+        void UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command) override;
 
         void PushConstants(void* pData, uint64_t size) override;
 
@@ -122,13 +140,19 @@ namespace SR_GRAPH_NS {
         void UnUseShader() override;
 
         void Draw(uint32_t count) override;
-        void DrawIndices(uint32_t count) override;
+        void DrawIndices(uint32_t count, uint32_t firstIndex) override;
+        void DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex) override;
+        void DrawInstanced(uint32_t count, uint32_t instanceCount) override;
+        void DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount) override;
+        void DrawIndirect(uint32_t buffer) override;
 
         void BindAttachment(uint8_t activeTexture, uint32_t textureId) override;
         void BindVBO(uint32_t VBO) override;
         void BindUBO(uint32_t UBO) override;
+        void BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range) override;
         void BindIBO(uint32_t IBO) override;
         void BindTexture(uint8_t activeTexture, uint32_t textureId) override;
+        void BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture) override;
         bool BindDescriptorSet(uint32_t descriptorSet) override;
         void BindFrameBuffer(FramebufferPtr pFBO) override;
         void BindSSBO(uint32_t SSBO) override;
@@ -137,6 +161,9 @@ namespace SR_GRAPH_NS {
 
     private:
         bool InitEvoVulkanHooks();
+        void FlushUBORanges();
+        /// Привязывает текущий набор дескрипторов перед отрисовкой, если он еще не привязан
+        void BindCurrentDescriptorSet();
 
     private:
         VkDeviceSize m_offsets[1] = { 0 };
@@ -151,6 +178,16 @@ namespace SR_GRAPH_NS {
         VkPipelineLayout m_currentLayout = VK_NULL_HANDLE;
 
         std::vector<VkClearValue> m_clearValues;
+        /// Буфер записи таблицы текстур, чтобы не выделять память на каждый набор дескрипторов
+        std::vector<VkDescriptorImageInfo> m_textureTableInfos;
+
+        /// Копии страниц UBO в оперативной памяти. Области страниц обновляются здесь,
+        /// а на видеокарту страница копируется целиком один раз за кадр
+        std::unordered_map<uint32_t, UBORangeMemory> m_uboRanges;
+        std::vector<uint32_t> m_dirtyUBORanges;
+        /// Набор дескрипторов -> UBO объекта. Набор делят объекты одной страницы UBO,
+        /// поэтому смещение объекта передается при привязке набора
+        std::unordered_map<int32_t, DynamicUBO> m_dynamicUBOs;
 
         EvoVulkan::Complexes::FrameBuffer* m_currentVkFrameBuffer = nullptr;
         EvoVulkan::Complexes::Shader* m_currentVkShader = nullptr;
@@ -159,6 +196,7 @@ namespace SR_GRAPH_NS {
 
         VulkanTools::MemoryManager* m_memory = nullptr;
 
+
     };
 }
 
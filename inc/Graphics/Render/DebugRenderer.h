@@ -9,6 +9,8 @@
 #include <Utils/Math/Vector3.h>
 #include <Utils/Math/Vector4.h>
 
+#include <Graphics/Types/Geometry/DebugLineBatch.h>
+
 namespace SR_GTYPES_NS {
     class Mesh;
 }
@@ -37,6 +39,12 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD RenderScene* GetRenderScene() const noexcept { return m_renderScene; }
         SR_NODISCARD uint64_t GetTimedObjectPoolSize() const noexcept { return m_timedObjects.size(); }
         SR_NODISCARD uint64_t GetEmptyIdsPoolSize() const noexcept { return m_emptyIds.size(); }
+        SR_NODISCARD bool IsBatching() const noexcept { return m_batching; }
+        SR_NODISCARD bool IsDepthTest() const noexcept { return m_depthTest; }
+
+        /// Проверять ли глубину у примитивов, нарисованных после вызова. Без проверки глубины
+        /// примитивы видны сквозь геометрию сцены. Работает только в пакетном режиме
+        void SetDepthTest(bool enabled);
 
     private:
         void Remove(uint64_t id);
@@ -52,6 +60,38 @@ namespace SR_GRAPH_NS {
         uint64_t AddTimedObject(float_t seconds, SR_GTYPES_NS::Mesh* pMesh);
         void UpdateTimedObject(uint64_t id, float_t seconds);
 
+    private:
+        /// Пакетный режим: примитивы не создают мешей, а хранятся на CPU
+        /// и раз в кадр собираются в общий буфер своего материала
+        enum class BatchType : uint8_t {
+            Line, Wireframe, LineNoDepth, WireframeNoDepth, Count
+        };
+
+        struct DebugBatchObject {
+            uint64_t endPoint = 0;
+            glm::vec4 color = glm::vec4(0.f);
+            /// Концы отрезков в мировых координатах
+            std::vector<glm::vec3> points;
+            BatchType type = BatchType::Line;
+            bool depthTest = true;
+            bool alive = false;
+            /// Примитив хотя бы раз попал в буфер, даже с нулевым временем жизни он должен быть нарисован
+            bool drawn = false;
+        };
+
+        bool InitBatches();
+        void DeInitBatches();
+        void PrepareBatches();
+        void ClearBatches();
+
+        void RemoveBatched(uint64_t id);
+        uint64_t DrawLineBatched(uint64_t id, const SR_MATH_NS::FVector3& start, const SR_MATH_NS::FVector3& end, const SR_MATH_NS::FColor& color, float_t time);
+        uint64_t DrawMeshBatched(SR_HTYPES_NS::RawMesh* pRawMesh, int32_t meshId, uint64_t id, const SR_MATH_NS::FVector3& pos, const SR_MATH_NS::Quaternion& rot, const SR_MATH_NS::FVector3& scale, const SR_MATH_NS::FColor& color, float_t time);
+
+        SR_NODISCARD DebugBatchObject& AcquireBatchObject(uint64_t& id, BatchType type, float_t time);
+        SR_NODISCARD static BatchType GetBatchType(BatchType type, bool depthTest);
+        SR_NODISCARD const std::vector<glm::vec3>& GetMeshEdges(SR_HTYPES_NS::RawMesh* pRawMesh, int32_t meshId);
+
     private:
         mutable std::recursive_mutex m_mutex;
 
@@ -72,6 +112,21 @@ namespace SR_GRAPH_NS {
 
         std::vector<DebugTimedObject> m_timedObjects;
         std::list<uint64_t> m_emptyIds;
+
+        bool m_batching = false;
+        bool m_batchesRegistered = false;
+        bool m_depthTest = true;
+
+        std::vector<DebugBatchObject> m_batchObjects;
+        std::vector<uint64_t> m_batchEmptyIds;
+
+        std::array<SR_GTYPES_NS::DebugLineBatch*, static_cast<uint8_t>(BatchType::Count)> m_batches = { };
+        std::array<FileMaterial*, static_cast<uint8_t>(BatchType::Count)> m_batchMaterials = { };
+        std::array<std::vector<SR_GTYPES_NS::DebugLineBatch::Vertex>, static_cast<uint8_t>(BatchType::Count)> m_batchVertices;
+
+        /// Уникальные ребра треугольников сырых мешей, по два конца на ребро
+        ska::flat_hash_map<std::string, std::vector<glm::vec3>> m_meshEdges;
+
     };
 }
 
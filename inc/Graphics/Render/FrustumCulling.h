@@ -25,16 +25,35 @@ namespace SR_GRAPH_NS {
         FrustumPlane nearFace;
     };
 
+    /**
+     * Пакетные проверки принимают данные в виде структуры массивов (SoA),
+     * чтобы цикл по объектам без ветвлений векторизовался компилятором.
+     * Результат - 1 если объект хотя бы частично внутри пирамиды видимости.
+    */
     class FrustumCulling : public SR_UTILS_NS::NonCopyable {
+    public:
+        static constexpr uint8_t PlanesCount = 6;
+
     public:
         FrustumCulling() = default;
 
-        //void UpdateFrustum(const SR_GTYPES_NS::Camera& camera) noexcept;
-        //SR_NODISCARD bool IsSphereInFrustum(const SR_GTYPES_NS::Vector3& center, float_t radius) const noexcept;
-        //SR_NODISCARD bool IsBoxInFrustum(const SR_GTYPES_NS::Vector3& min, const SR_GTYPES_NS::Vector3& max) const noexcept;
+        /// Извлечение плоскостей из матрицы projection * view (метод Gribb/Hartmann)
+        void UpdateFrustum(const SR_MATH_NS::Matrix4x4& viewProjection) noexcept;
+
+        SR_NODISCARD bool IsSphereInFrustum(const SR_MATH_NS::FVector3& center, float_t radius) const noexcept;
+        SR_NODISCARD bool IsBoxInFrustum(const SR_MATH_NS::FVector3& min, const SR_MATH_NS::FVector3& max) const noexcept;
+
+        void CullSpheres(const float_t* pX, const float_t* pY, const float_t* pZ, const float_t* pRadius,
+            uint32_t count, uint8_t* pVisible) const noexcept;
+
+        void CullBoxes(const float_t* pX, const float_t* pY, const float_t* pZ,
+            const float_t* pExtentX, const float_t* pExtentY, const float_t* pExtentZ,
+            uint32_t count, uint8_t* pVisible) const noexcept;
+
+        SR_NODISCARD Frustum GetFrustum() const noexcept;
 
     private:
-        SR_MATH_NS::FVector4 m_planes[6];
+        SR_MATH_NS::FVector4 m_planes[PlanesCount];
 
     };
 
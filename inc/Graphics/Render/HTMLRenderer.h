@@ -16,6 +16,8 @@ namespace SR_GRAPH_NS {
             SR_GTYPES_NS::Shader::Ptr pShader;
 
             uint32_t index = 0;
+            /// Количество элементов, записанных в командные буферы при последнем построении
+            uint32_t recordedCount = 0;
 
             struct MemInfo {
                 Memory::UBOManager::VirtualUBO virtualUBO;
@@ -60,6 +62,12 @@ namespace SR_GRAPH_NS {
         litehtml::element::ptr create_element(const char* tag_name, const litehtml::string_map& attributes, const std::shared_ptr<litehtml::document>& doc) override;
 
     private:
+        void UpdateInput();
+        /// Переписывает юниформы уже записанных элементов (наведение, нажатие) без перестроения.
+        /// Если набор элементов изменился, помечает конвейер грязным
+        void RedrawElements();
+        void DrawDocument();
+
         bool BeginElement(ShaderInfo& shaderInfo);
         void DrawElement(ShaderInfo& shaderInfo);
         void UpdateElement(ShaderInfo& shaderInfo);
@@ -71,6 +79,7 @@ namespace SR_GRAPH_NS {
 
     private:
         SR_MATH_NS::IVector2 m_scroll;
+        SR_MATH_NS::IVector2 m_mousePosition;
 
         SR_GRAPH_NS::Memory::UBOManager& m_uboManager;
         SR_GRAPH_NS::DescriptorManager& m_descriptorManager;
@@ -79,6 +88,8 @@ namespace SR_GRAPH_NS {
 
         bool m_isRendered = false;
         bool m_updateMode = false;
+        /// В режиме обновления встретился элемент, которого нет в записанных командах
+        bool m_needRebuild = false;
         Pipeline* m_pipeline = nullptr;
         SR_GTYPES_NS::Camera::Ptr m_pCamera = nullptr;
 
@@ -8,6 +8,8 @@
 #include <Utils/Types/SharedPtr.h>
 #include <Utils/Types/SortedVector.h>
 #include <Graphics/Memory/UBOManager.h>
+#include <Graphics/Pipeline/PipelineState.h>
+#include <Graphics/Render/FrustumCulling.h>
 
 namespace SR_GTYPES_NS {
     class Shader;
@@ -15,6 +17,7 @@ namespace SR_GTYPES_NS {
 }
 
 namespace SR_GRAPH_NS {
+    class BaseMaterial;
     class MeshDrawerPass;
     class RenderStrategy;
     class RenderContext;
@@ -41,9 +44,37 @@ namespace SR_GRAPH_NS {
             ShaderUseInfo shaderUseInfo = {};
             VBO vbo = 0;
             MeshPtr pMesh = nullptr;
+            BaseMaterial* pMaterial = nullptr;
             int64_t priority = 0;
+            /// Приоритет, шейдер, материал, VBO и глубина, упакованные от старших разрядов к младшим.
+            /// У прозрачных мешей глубина идет сразу после приоритета
+            uint64_t sortKey = 0;
+            /// Индексы первых элементов после серии с тем же шейдером и с тем же VBO
+            uint32_t shaderRunEnd = 0;
+            uint32_t vboRunEnd = 0;
             QueueStateFlags state = QUEUE_STATE_ERROR;
             bool hasVBO = false;
+            /// Меш снят с регистрации, элемент будет удален при следующей сортировке
+            bool removed = false;
+            /// Меш вне пирамиды видимости, он не рисуется и не обновляет юниформы
+            bool culled = false;
+            /// Меш записан в команды рендера прямым вызовом, рисуется он или нет решено при построении
+            bool direct = false;
+            /// Видимость прямого вызова на момент построения, при ее смене нужно перестроение
+            bool recordedCulled = false;
+            /// Юниформы пропущены, пока меш был отсечен, они обновятся когда он станет видимым
+            bool skippedUniforms = false;
+            /// Материал со смешиванием, такие меши сортируются от дальних к ближним
+            bool transparent = false;
+            /// Выбранный по экранной ошибке уровень детализации
+            uint8_t lod = 0;
+            /// Уровень, с которым записан прямой вызов. Более грубый применится при следующем построении,
+            /// более подробный запрашивает перестроение
+            uint8_t recordedLod = 0;
+            /// Серия экземпляров, в которую меш попал при построении
+            uint32_t instanceBatch = SR_ID_INVALID;
+            /// Команда в буфере аргументов, которой меш нарисован при построении (своя или его серии)
+            uint32_t indirectCommand = SR_ID_INVALID;
 
             bool operator==(const MeshInfo& other) const noexcept {
                 return
@@ -54,28 +85,6 @@ namespace SR_GRAPH_NS {
             }
         };
 
-        struct RenderQueueLessPredicate {
-            SR_NODISCARD constexpr bool operator()(const MeshInfo& left, const MeshInfo& right) const noexcept {
-                /// Сравниваем приоритеты
-                if (left.priority != right.priority) SR_UNLIKELY_ATTRIBUTE {
-                    return left.priority < right.priority;
-                }
-
-                /// Сравниваем указатели на шейдеры
-                if (left.shaderUseInfo.pShader != right.shaderUseInfo.pShader) SR_LIKELY_ATTRIBUTE {
-                    return left.shaderUseInfo.pShader < right.shaderUseInfo.pShader;
-                }
-
-                /// Если шейдеры одинаковые, сравниваем VBO
-                if (left.vbo != right.vbo) SR_UNLIKELY_ATTRIBUTE {
-                    return left.vbo < right.vbo;
-                }
-
-                /// Если и VBO одинаковые, сравниваем указатели на меши
-                return left.pMesh < right.pMesh;
-            }
-        };
-
         struct ShaderInfo {
             ShaderInfo() = default;
             ShaderInfo(ShaderPtr pShader) : info(pShader) { }
@@ -89,7 +98,60 @@ namespace SR_GRAPH_NS {
             }
         };
 
-        using Queue = SR_HTYPES_NS::SortedVector<MeshInfo, RenderQueueLessPredicate>;
+        /// Регистрация только дописывает элемент в конец, очередь сортируется по ключам перед использованием.
+        /// Снятие с регистрации помечает элемент, удаляются они разом при следующей сортировке
+        struct Queue {
+            std::vector<MeshInfo> entries;
+            ska::flat_hash_map<MeshPtr, uint32_t> indices;
+            uint32_t transparentCount = 0;
+            bool dirty = false;
+
+            SR_NODISCARD MeshInfo* data() noexcept { return entries.data(); }
+            SR_NODISCARD const MeshInfo* data() const noexcept { return entries.data(); }
+            SR_NODISCARD size_t size() const noexcept { return entries.size(); }
+            SR_NODISCARD auto begin() noexcept { return entries.begin(); }
+            SR_NODISCARD auto end() noexcept { return entries.end(); }
+            SR_NODISCARD auto begin() const noexcept { return entries.begin(); }
+            SR_NODISCARD auto end() const noexcept { return entries.end(); }
+        };
+
+        /// Плотные номера для полей ключа, указатели и идентификаторы VBO слишком широкие
+        struct SortKeyIds {
+            ska::flat_hash_map<const void*, uint32_t> shaders;
+            ska::flat_hash_map<const void*, uint32_t> materials;
+            ska::flat_hash_map<VBO, uint32_t> vbos;
+
+            void Clear() noexcept {
+                shaders.clear();
+                materials.clear();
+                vbos.clear();
+            }
+        };
+
+        /// Ограничивающие объемы в мировых координатах в виде SoA для пакетной проверки
+        struct CullingBatch {
+            std::vector<float_t> x, y, z;
+            std::vector<float_t> extentX, extentY, extentZ;
+            std::vector<MeshInfo*> meshes;
+            std::vector<uint8_t> visible;
+
+            void Clear() noexcept {
+                x.clear(); y.clear(); z.clear();
+                extentX.clear(); extentY.clear(); extentZ.clear();
+                meshes.clear();
+            }
+        };
+
+        /// Серия одинаковых мешей (шейдер, VBO, материал), рисуемая одним вызовом.
+        /// Матрицы рисуемых мешей лежат в начале буфера экземпляров подряд
+        struct InstanceBatch {
+            std::vector<MeshInfo*> meshes;
+            int32_t ssbo = SR_ID_INVALID;
+            uint32_t capacity = 0;
+            /// Для непрямой серии - одна команда, количество экземпляров в ней равно числу видимых мешей
+            uint32_t indirectCommand = SR_ID_INVALID;
+            bool indirect = false;
+        };
 
     public:
         RenderQueue(RenderStrategy* pStrategy, MeshDrawerPass* pDrawer);
@@ -115,6 +177,27 @@ namespace SR_GRAPH_NS {
     private:
         void UpdateShaders();
         void UpdateMeshes();
+        void UpdateFrustumCulling();
+        void UpdateLods();
+        void UpdateTransparentOrder();
+
+        void SR_FASTCALL SetMeshCulled(MeshInfo& info, bool culled);
+        SR_NODISCARD MeshInfo* SR_FASTCALL FindMeshInfo(MeshPtr pMesh);
+        SR_NODISCARD uint8_t SR_FASTCALL SelectLod(const MeshInfo& info, const SR_MATH_NS::FVector3& cameraPosition, float_t projection) const;
+        /// Позиция камеры и число пикселей на единицу длины на единичном расстоянии, false - уровни выключены
+        SR_NODISCARD bool GetLodView(SR_MATH_NS::FVector3& cameraPosition, float_t& projection) const;
+
+        /// Записывает меш прямым вызовом, возвращает рисуется ли он
+        SR_NODISCARD bool SR_FASTCALL PrepareDirect(MeshInfo& info);
+        SR_NODISCARD bool IsIndirectCandidate(const MeshInfo& info) const;
+        /// Собирает серию экземпляров с начала pElement, возвращает ее длину. visible - рисуется ли серия хоть одним экземпляром
+        SR_NODISCARD uint32_t SR_FASTCALL PrepareInstancing(MeshInfo* pElement, const MeshInfo* pEnd, bool indirect, bool& visible);
+        /// Буфер аргументов вмещает по команде на каждый элемент очередей, его нужно выделить до записи
+        SR_NODISCARD bool PrepareIndirectBuffer();
+        SR_NODISCARD uint32_t AddIndirectCommand();
+        void SR_FASTCALL UpdateIndirectCommand(const MeshInfo& info);
+        void UpdateInstances();
+        void UploadInstanceBatch(InstanceBatch& batch);
 
         SR_NODISCARD bool IsSuitable(const MeshRegistrationInfo& info) const;
 
@@ -123,6 +206,15 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD MeshInfo* SR_FASTCALL FindNextShader(Queue& queue, MeshInfo* pElement);
         SR_NODISCARD MeshInfo* SR_FASTCALL FindNextVBO(Queue& queue, MeshInfo* pElement);
 
+        SR_NODISCARD uint64_t CalculateSortKey(const MeshInfo& info);
+        /// Ключ с обновленной глубиной относительно камеры, остальные поля не меняются
+        SR_NODISCARD uint64_t CalculateDepthKey(const MeshInfo& info, const SR_MATH_NS::FVector3& cameraPosition) const;
+        void UpdateDepthKeys(Queue& queue);
+        void FlushQueues();
+        void FlushQueue(Queue& queue);
+        /// Поразрядная сортировка ключей, после нее заново строятся индексы и границы серий
+        void SortQueue(Queue& queue);
+
         bool SR_FASTCALL UseShader(ShaderUseInfo info);
 
         void PrepareLayers();
@@ -135,13 +227,46 @@ namespace SR_GRAPH_NS {
     private:
         bool m_rendered = false;
         bool m_isInitialized = false;
+        bool m_hasCulledMeshes = false;
+        /// Видимость меша, записанного прямым вызовом, изменилась
+        bool m_cullingRebuild = false;
+        bool m_hasLods = false;
+        bool m_instanceBatchesValid = false;
+        /// Построение идет через непрямую отрисовку, выставляется в начале каждого построения
+        bool m_indirectDraw = false;
 
         uint64_t m_layersStateHash = 0;
 
+        FrustumCulling m_frustumCulling;
+        CullingBatch m_sphereBatch;
+        CullingBatch m_boxBatch;
+
+        std::vector<InstanceBatch> m_instanceBatches;
+        std::vector<SR_MATH_NS::Matrix4x4> m_instanceMatrices;
+        uint32_t m_instanceBatchesCount = 0;
+
+        /// Общий буфер аргументов очереди. Команды серий обновляются вместе с сериями,
+        /// команды одиночных мешей - по списку m_indirectMeshes
+        std::vector<DrawIndexedIndirectCommand> m_indirectCommands;
+        std::vector<MeshInfo*> m_indirectMeshes;
+        int32_t m_indirectBuffer = SR_ID_INVALID;
+        uint32_t m_indirectCapacity = 0;
+        bool m_indirectDirty = false;
+
         Memory::UBOManager& m_uboManager;
 
         std::vector<std::pair<Layer, Queue>> m_queues;
 
+        SortKeyIds m_sortKeyIds;
+        /// Номера в одном из полей ключа закончились, все ключи будут пересчитаны
+        bool m_needRekey = false;
+
+        std::vector<uint64_t> m_sortKeys;
+        std::vector<uint64_t> m_sortTmpKeys;
+        std::vector<uint32_t> m_sortIndices;
+        std::vector<uint32_t> m_sortTmpIndices;
+        std::vector<MeshInfo> m_sortEntries;
+
         SR_HTYPES_NS::SortedVector<ShaderUseInfo, ShaderQueueLessPredicate> m_shaders;
         std::vector<std::pair<MeshPtr, ShaderUseInfo>> m_meshes;
 
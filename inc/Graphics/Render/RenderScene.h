@@ -22,6 +22,7 @@ namespace SR_WORLD_NS {
 
 namespace SR_ANIMATIONS_NS {
     class Skeleton;
+    class SkinningBuffer;
 }
 
 namespace SR_GTYPES_NS {
@@ -87,6 +88,8 @@ namespace SR_GRAPH_NS {
         void ReRegister(const MeshRegistrationInfo& info);
 
         void SetOverlayEnabled(bool enabled);
+        /// Отправляет матрицы костей в видеопамять, при пересоздании буфера помечает скелетные меши
+        void UploadSkinningBuffer();
         void SetCurrentSkeleton(SR_ANIMATIONS_NS::Skeleton* pSkeleton) { m_currentSkeleton = pSkeleton;}
 
         void ForEachTechnique(const SR_HTYPES_NS::Function<void(IRenderTechnique*)>& callback);
@@ -96,6 +99,7 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD bool IsOverlayEnabled() const;
         SR_NODISCARD RenderContext* GetContext() const;
         SR_NODISCARD LightSystem* GetLightSystem() const { return m_lightSystem; }
+        SR_NODISCARD SR_ANIMATIONS_NS::SkinningBuffer* GetSkinningBuffer() const { return m_skinningBuffer; }
         SR_NODISCARD SR_ANIMATIONS_NS::Skeleton* GetCurrentSkeleton() const { return m_currentSkeleton; }
         SR_NODISCARD const RenderScene::PipelinePtr& GetPipeline() const;
         SR_NODISCARD WindowPtr GetWindow() const;
@@ -126,6 +130,7 @@ namespace SR_GRAPH_NS {
         SR_ANIMATIONS_NS::Skeleton* m_currentSkeleton = nullptr;
 
         LightSystem* m_lightSystem = nullptr;
+        SR_ANIMATIONS_NS::SkinningBuffer* m_skinningBuffer = nullptr;
         CameraPtr m_mainCamera;
 
         std::vector<CameraPtr> m_editorCameras;
@@ -145,6 +150,8 @@ namespace SR_GRAPH_NS {
         SR_MATH_NS::UVector2 m_surfaceSize;
 
         SR_HTYPES_NS::SafeVar<uint32_t> m_dirty = 0;
+        /// Версия таблицы текстур на момент последнего построения
+        uint64_t m_textureTableVersion = 0;
 
         bool m_dirtyCameras = true;
         bool m_hasDrawData  = false;
@@ -5,12 +5,11 @@
 #ifndef SR_ENGINE_SRSL_ASSIGNEXPANDER_H
 #define SR_ENGINE_SRSL_ASSIGNEXPANDER_H
 
-#include <Utils/Common/Singleton.h>
+#include <Utils/Common/NonCopyable.h>
 #include <Graphics/SRSL/LexicalTree.h>
 
 namespace SR_SRSL_NS {
-    class SRSLAssignExpander : public SR_UTILS_NS::Singleton<SRSLAssignExpander> {
-        SR_REGISTER_SINGLETON(SRSLAssignExpander)
+    class SRSLAssignExpander : public SR_UTILS_NS::NonCopyable {
     public:
         SR_NODISCARD std::pair<std::vector<Lexem>, SRSLResult> Expand(std::vector<Lexem>&& lexems);
 
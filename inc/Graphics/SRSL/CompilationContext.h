@@ -0,0 +1,66 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_SRSL_COMPILATION_CONTEXT_H
+#define SR_ENGINE_SRSL_COMPILATION_CONTEXT_H
+
+#include <Graphics/SRSL/Lexer.h>
+#include <Graphics/SRSL/PreProcessor.h>
+#include <Graphics/SRSL/AssignExpander.h>
+#include <Graphics/SRSL/LexicalAnalyzer.h>
+#include <Graphics/SRSL/RefAnalyzer.h>
+#include <Graphics/SRSL/GLSLCodeGenerator.h>
+#include <Graphics/SRSL/PseudoCodeGenerator.h>
+
+namespace SR_SRSL_NS {
+    /**
+     * Состояние всех стадий компилятора SRSL для одной компиляции.
+     * Стадии хранят промежуточные данные в своих полях, поэтому у каждого потока,
+     * компилирующего шейдер, должен быть свой контекст. Вложенные вызовы (Evaluator, TypeInfo)
+     * получают его через Current().
+    */
+    class SRSLCompilationContext : public SR_UTILS_NS::NonCopyable {
+    public:
+        /// Делает контекст текущим для потока на время своей жизни
+        class Scope : public SR_UTILS_NS::NonCopyable {
+        public:
+            explicit Scope(SRSLCompilationContext& context);
+            ~Scope();
+
+        private:
+            SRSLCompilationContext* m_previous = nullptr;
+
+        };
+
+    public:
+        SRSLCompilationContext() = default;
+        ~SRSLCompilationContext() = default;
+
+    public:
+        /// Контекст, установленный в текущем потоке. Если его нет - используется контекст потока по умолчанию
+        SR_NODISCARD static SRSLCompilationContext& Current();
+
+        SR_NODISCARD SRSLLexer& GetLexer() noexcept { return m_lexer; }
+        SR_NODISCARD SRSLPreProcessor& GetPreProcessor() noexcept { return m_preProcessor; }
+        SR_NODISCARD SRSLAssignExpander& GetAssignExpander() noexcept { return m_assignExpander; }
+        SR_NODISCARD SRSLLexicalAnalyzer& GetLexicalAnalyzer() noexcept { return m_lexicalAnalyzer; }
+        SR_NODISCARD SRSLMathExpression& GetMathExpression() noexcept { return m_mathExpression; }
+        SR_NODISCARD SRSLRefAnalyzer& GetRefAnalyzer() noexcept { return m_refAnalyzer; }
+        SR_NODISCARD GLSLCodeGenerator& GetGLSLCodeGenerator() noexcept { return m_glslCodeGenerator; }
+        SR_NODISCARD SRSLPseudoCodeGenerator& GetPseudoCodeGenerator() noexcept { return m_pseudoCodeGenerator; }
+
+    private:
+        SRSLLexer m_lexer;
+        SRSLPreProcessor m_preProcessor;
+        SRSLAssignExpander m_assignExpander;
+        SRSLLexicalAnalyzer m_lexicalAnalyzer;
+        SRSLMathExpression m_mathExpression;
+        SRSLRefAnalyzer m_refAnalyzer;
+        GLSLCodeGenerator m_glslCodeGenerator;
+        SRSLPseudoCodeGenerator m_pseudoCodeGenerator;
+
+    };
+}
+
+#endif //SR_ENGINE_SRSL_COMPILATION_CONTEXT_H
@@ -9,9 +9,8 @@
 #include <Graphics/SRSL/ShaderType.h>
 
 namespace SR_SRSL_NS {
-    class GLSLCodeGenerator : public ISRSLCodeGenerator, public SR_UTILS_NS::Singleton<GLSLCodeGenerator> {
-        SR_REGISTER_SINGLETON(GLSLCodeGenerator)
-    private:
+    class GLSLCodeGenerator : public ISRSLCodeGenerator, public SR_UTILS_NS::NonCopyable {
+    public:
         GLSLCodeGenerator() = default;
         ~GLSLCodeGenerator() override = default;
 
@@ -8,13 +8,13 @@
 #include <Graphics/SRSL/LexerUtils.h>
 
 namespace SR_SRSL_NS {
-    class SRSLLexer : public SR_UTILS_NS::Singleton<SRSLLexer> {
-        SR_REGISTER_SINGLETON(SRSLLexer)
+    class SRSLLexer : public SR_UTILS_NS::NonCopyable {
         using Lexems = std::vector<Lexem>;
         using ProcessedLexem = std::optional<Lexem>;
         using SourceCode = std::vector<std::string>;
-    protected:
-        ~SRSLLexer() override;
+    public:
+        SRSLLexer() = default;
+        ~SRSLLexer();
 
     public:
         SR_NODISCARD Lexems Parse(const SR_UTILS_NS::Path& path, uint16_t fileIndex);
@@ -6,6 +6,7 @@
 #define SR_ENGINE_SRSL_LEXERUTILS_H
 
 #include <Utils/Common/Singleton.h>
+#include <Utils/Common/NonCopyable.h>
 #include <Utils/Common/Enumerations.h>
 #include <Utils/Common/StringFormat.h>
 #include <Utils/Common/ToString.h>
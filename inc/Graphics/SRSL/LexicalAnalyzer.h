@@ -8,14 +8,17 @@
 #include <Graphics/SRSL/MathExpression.h>
 
 namespace SR_SRSL_NS {
-    class SRSLLexicalAnalyzer : public SR_UTILS_NS::Singleton<SRSLLexicalAnalyzer> {
-        SR_REGISTER_SINGLETON(SRSLLexicalAnalyzer)
+    class SRSLLexicalAnalyzer : public SR_UTILS_NS::NonCopyable {
     private:
         enum class LXAState {
             Decorators, Decorator, DecoratorArgs,
             Expression, Variable, Function, FunctionArgs, FunctionBody, IfStatement, IfStatementBody,
             ForStatement, ForStatementVariable, ForStatementCondition, ForStatementExpression, ForStatementBody,
         };
+    public:
+        SRSLLexicalAnalyzer() = default;
+        ~SRSLLexicalAnalyzer();
+
     public:
         SR_NODISCARD std::pair<SRSLAnalyzedTree::Ptr, SRSLResult> Analyze(std::vector<Lexem>&& lexems);
 
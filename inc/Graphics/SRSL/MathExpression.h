@@ -5,12 +5,11 @@
 #ifndef SR_ENGINE_SRSL_MATHEXPRESSION_H
 #define SR_ENGINE_SRSL_MATHEXPRESSION_H
 
-#include <Utils/Common/Singleton.h>
+#include <Utils/Common/NonCopyable.h>
 #include <Graphics/SRSL/LexicalTree.h>
 
 namespace SR_SRSL_NS {
-    class SRSLMathExpression : public SR_UTILS_NS::Singleton<SRSLMathExpression> {
-        SR_REGISTER_SINGLETON(SRSLMathExpression)
+    class SRSLMathExpression : public SR_UTILS_NS::NonCopyable {
     public:
         SR_NODISCARD std::pair<SRSLExpr*, SRSLResult> Analyze(std::vector<Lexem>&& lexems);
 
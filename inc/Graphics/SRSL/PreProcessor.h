@@ -5,12 +5,11 @@
 #ifndef SR_ENGINE_SRSL_PREPROCESSOR_H
 #define SR_ENGINE_SRSL_PREPROCESSOR_H
 
-#include <Utils/Common/Singleton.h>
+#include <Utils/Common/NonCopyable.h>
 #include <Graphics/SRSL/LexicalTree.h>
 
 namespace SR_SRSL_NS {
-    class SRSLPreProcessor : public SR_UTILS_NS::Singleton<SRSLPreProcessor> {
-        SR_REGISTER_SINGLETON(SRSLPreProcessor)
+    class SRSLPreProcessor : public SR_UTILS_NS::NonCopyable {
         enum class PPState : uint8_t {
             Idle, Macro, MacroName, IncludeOpen, IncludePath
         };
@@ -8,9 +8,8 @@
 #include <Graphics/SRSL/ICodeGenerator.h>
 
 namespace SR_SRSL_NS {
-    class SRSLPseudoCodeGenerator : public ISRSLCodeGenerator, public SR_UTILS_NS::Singleton<SRSLPseudoCodeGenerator> {
-        SR_REGISTER_SINGLETON(SRSLPseudoCodeGenerator)
-    protected:
+    class SRSLPseudoCodeGenerator : public ISRSLCodeGenerator, public SR_UTILS_NS::NonCopyable {
+    public:
         SRSLPseudoCodeGenerator() = default;
         ~SRSLPseudoCodeGenerator() override = default;
 
@@ -30,8 +30,7 @@ namespace SR_SRSL_NS {
         std::set<std::string> variables;
     };
 
-    class SRSLRefAnalyzer : public SR_UTILS_NS::Singleton<SRSLRefAnalyzer> {
-        SR_REGISTER_SINGLETON(SRSLRefAnalyzer)
+    class SRSLRefAnalyzer : public SR_UTILS_NS::NonCopyable {
     public:
         SR_NODISCARD SRSLUseStack::Ptr Analyze(const SRSLAnalyzedTree::Ptr& pAnalyzedTree);
 
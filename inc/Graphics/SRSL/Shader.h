@@ -21,6 +21,10 @@ namespace SR_SRSL_NS {
         bool isPublic = false;
         uint64_t binding = 0;
         int32_t attachment = -1;
+        /// Размер массива, больше единицы только у таблицы текстур
+        uint32_t count = 1;
+        /// Семплер читается из таблицы текстур и не имеет собственного биндинга
+        bool bindless = false;
         std::set<ShaderStage> stages;
         SR_UTILS_NS::StringAtom defaultValue;
     };
@@ -51,7 +55,8 @@ namespace SR_SRSL_NS {
         using Ptr = std::shared_ptr<SRSLShader>;
         using Super = SR_UTILS_NS::NonCopyable;
         using UniformBlocks = std::map<SR_UTILS_NS::StringAtom, SRSLUniformBlock>;
-        uint64_t VERSION = 1000;
+        /// Версия формата артефакта компиляции, при изменении формата нужно увеличить
+        static constexpr uint64_t VERSION = 1005;
     private:
         explicit SRSLShader(SR_UTILS_NS::Path path);
 
@@ -77,8 +82,8 @@ namespace SR_SRSL_NS {
         SR_NODISCARD const SRSLUniformBlock& GetPushConstants() const { return m_pushConstants; }
         SR_NODISCARD const SRSLSamplers& GetSamplers() const { return m_samplers; }
         SR_NODISCARD const SRShaderCreateInfo& GetCreateInfo() const { return m_createInfo; }
-        SR_NODISCARD const std::vector<std::pair<SR_UTILS_NS::StringAtom, SRSLVariable*>>& GetShared() const { return m_shared; }
-        SR_NODISCARD const std::map<SR_UTILS_NS::StringAtom, SRSLVariable*>& GetConstants() const { return m_constants; }
+        SR_NODISCARD const std::vector<std::pair<SR_UTILS_NS::StringAtom, SRSLVariable*>>& GetShared() const;
+        SR_NODISCARD const std::map<SR_UTILS_NS::StringAtom, SRSLVariable*>& GetConstants() const;
         SR_NODISCARD const std::vector<SR_UTILS_NS::StringAtom>& GetIncludes() const { return m_includes; }
 
     private:
@@ -89,13 +94,30 @@ namespace SR_SRSL_NS {
         SR_NODISCARD std::optional<ShaderPropertyVariant> EvalExpressionValue(SRSLExpr* pExpression) const;
 
         SR_NODISCARD ISRSLCodeGenerator::SRSLCodeGenRes GenerateStages(ShaderLanguage shaderLanguage) const;
+        /// Возвращает сохраненный код языка, если он есть. Иначе генерирует код и дописывает его в артефакт
+        SR_NODISCARD ISRSLCodeGenerator::SRSLCodeGenRes GetStages(ShaderLanguage shaderLanguage) const;
 
         SR_NODISCARD bool SaveCache() const;
         SR_NODISCARD uint64_t GetHash() const;
 
+        /// Артефакт содержит рефлексию шейдера и сгенерированный GLSL код, что позволяет
+        /// при актуальном кэше не запускать лексер, анализатор и генератор кода
+        SR_NODISCARD static SRSLShader::Ptr LoadArtifact(const SR_UTILS_NS::Path& path);
+        SR_NODISCARD bool SaveArtifact() const;
+        SR_NODISCARD SR_UTILS_NS::Path GetArtifactPath() const;
+
+        /// Лексер, препроцессор и анализаторы без кеша, в текущем контексте компиляции
+        SR_NODISCARD static SRSLShader::Ptr Compile(const SR_UTILS_NS::Path& path);
+        /// Шейдер из артефакта не имеет дерева разбора. Оно компилируется заново при первом обращении,
+        /// рефлексия при этом не меняется
+        SR_NODISCARD bool RestoreAnalyzedState() const;
+
         bool Prepare();
         bool PrepareSettings();
         bool PrepareUniformBlocks();
+        /// Матрица модели читается только в вершинах и других юниформ объекта нет,
+        /// тогда она берется из блока экземпляров
+        SR_NODISCARD bool IsInstancingAvailable() const;
         bool PrepareSamplers();
         bool PrepareStages();
 
@@ -103,17 +125,20 @@ namespace SR_SRSL_NS {
         SR_UTILS_NS::Path m_path;
 
         std::vector<SR_UTILS_NS::StringAtom> m_includes;
-        std::vector<std::pair<SR_UTILS_NS::StringAtom, SRSLVariable*>> m_shared;
-        std::map<SR_UTILS_NS::StringAtom, SRSLVariable*> m_constants;
+        mutable std::vector<std::pair<SR_UTILS_NS::StringAtom, SRSLVariable*>> m_shared;
+        mutable std::map<SR_UTILS_NS::StringAtom, SRSLVariable*> m_constants;
         ShaderType m_type = ShaderType::Unknown;
         SRShaderCreateInfo m_createInfo;
-        SRSLAnalyzedTree::Ptr m_analyzedTree;
-        SRSLUseStack::Ptr m_useStack;
+        mutable SRSLAnalyzedTree::Ptr m_analyzedTree;
+        mutable SRSLUseStack::Ptr m_useStack;
         UniformBlocks m_ssboBlocks;
         UniformBlocks m_uniformBlocks;
         SRSLUniformBlock m_pushConstants;
         SRSLSamplers m_samplers;
 
+        /// Сгенерированный код по языкам и стадиям. Заполняется при компиляции, генерации или из артефакта
+        mutable std::map<ShaderLanguage, std::map<ShaderStage, std::string>> m_generatedStages;
+
     };
 }
 
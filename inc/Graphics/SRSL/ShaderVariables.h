@@ -33,8 +33,65 @@ namespace SR_SRSL_NS {
             { "DIRECTIONAL_LIGHT_POSITION",     "vec3"          },
             { "VIEW_POSITION",                  "vec3"          },
             { "VIEW_DIRECTION",                 "vec3"          },
+
+            { "LIGHT_CLUSTER_GRID",             "vec4"          },
+            { "LIGHT_CLUSTER_DEPTH",            "vec4"          },
+    };
+
+    /// Встроенные модули, подключаются через #include <Имя> без файла в ресурсах
+    SR_INLINE_STATIC const std::map<std::string, std::string> SR_SRSL_BUILTIN_INCLUDES = { /** NOLINT */
+            { "LightClusters", R"(
+[[uniform]] vec4 LIGHT_CLUSTER_GRID;
+[[uniform]] vec4 LIGHT_CLUSTER_DEPTH;
+
+[[ssbo(clusterLights)]] vec4 CLUSTER_LIGHTS[];
+[[ssbo(clusterRanges)]] int CLUSTER_RANGES[];
+[[ssbo(clusterIndices)]] int CLUSTER_LIGHT_INDICES[];
+
+int SRLightClusterIndex(vec3 viewPos) {
+    float depth = max(-viewPos.z, 0.0001);
+    vec2 ndc = viewPos.xy / (depth * LIGHT_CLUSTER_DEPTH.zw);
+    int x = clamp(int((ndc.x * 0.5 + 0.5) * LIGHT_CLUSTER_GRID.x), 0, int(LIGHT_CLUSTER_GRID.x) - 1);
+    int y = clamp(int((ndc.y * 0.5 + 0.5) * LIGHT_CLUSTER_GRID.y), 0, int(LIGHT_CLUSTER_GRID.y) - 1);
+    int z = clamp(int(floor(log(depth) * LIGHT_CLUSTER_DEPTH.x + LIGHT_CLUSTER_DEPTH.y)), 0, int(LIGHT_CLUSTER_GRID.z) - 1);
+    return (z * int(LIGHT_CLUSTER_GRID.y) + y) * int(LIGHT_CLUSTER_GRID.x) + x;
+}
+
+int SRLightClusterOffset(int cluster) {
+    return CLUSTER_RANGES[cluster * 2];
+}
+
+int SRLightClusterCount(int cluster) {
+    return CLUSTER_RANGES[cluster * 2 + 1];
+}
+
+int SRLightClusterLight(int index) {
+    return CLUSTER_LIGHT_INDICES[index];
+}
+
+vec4 SRClusterLightPositionRange(int light) {
+    return CLUSTER_LIGHTS[light * 4];
+}
+
+vec4 SRClusterLightColorIntensity(int light) {
+    return CLUSTER_LIGHTS[light * 4 + 1];
+}
+
+vec4 SRClusterLightDirectionType(int light) {
+    return CLUSTER_LIGHTS[light * 4 + 2];
+}
+
+vec4 SRClusterLightParams(int light) {
+    return CLUSTER_LIGHTS[light * 4 + 3];
+}
+)" },
     };
 
+    /// Блок матриц экземпляров. Статический меш, которому из юниформ объекта нужна только MODEL_MATRIX,
+    /// получает ее из этого блока по gl_InstanceIndex и может рисоваться серией экземпляров
+    SR_INLINE_STATIC const std::string SR_SRSL_INSTANCES_BLOCK = "instances"; /** NOLINT */
+    SR_INLINE_STATIC const std::string SR_SRSL_INSTANCE_MATRICES = "SR_INSTANCE_MATRICES"; /** NOLINT */
+
     SR_INLINE_STATIC const std::map<std::string, std::string> SR_SRSL_DEFAULT_UNIFORMS = { /** NOLINT */
             { "MODEL_MATRIX",                   "mat4"          },
             { "MODEL_NO_SCALE_MATRIX",          "mat4"          },
@@ -71,6 +128,14 @@ namespace SR_SRSL_NS {
             { "SSAO_NOISE",                     "sampler2D"     },
     };
 
+    /// Семплеры с декоратором [[bindless]] читаются из общей таблицы текстур,
+    /// а в блок юниформ попадает только индекс текстуры в таблице
+    SR_INLINE_STATIC const std::string SR_SRSL_TEXTURE_TABLE = "SR_TEXTURE_TABLE"; /** NOLINT */
+    SR_INLINE_STATIC const std::string SR_SRSL_TEXTURE_INDEX_PREFIX = "SR_TEXTURE_INDEX_"; /** NOLINT */
+    /// Фиксированная емкость таблицы, она не растет: массив такого размера объявлен в шейдере
+    /// и зарезервирован в каждом наборе дескрипторов. Текстуры сверх емкости получают заглушку
+    SR_INLINE_STATIC const uint32_t SR_SRSL_TEXTURE_TABLE_SIZE = 256;
+
     SR_INLINE_STATIC const std::string SR_SRSL_MAIN_OUT_LAYER = "COLOR_INDEX_0"; /** NOLINT */
 
     SR_INLINE_STATIC const std::set<std::string> SR_SRSL_DEFAULT_OUT_LAYERS = { /** NOLINT */
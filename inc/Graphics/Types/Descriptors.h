@@ -8,8 +8,21 @@
 #include <Utils/macros.h>
 
 namespace SR_GRAPH_NS {
+    /// DynamicUniform - UBO объекта, смещение которого задается при привязке набора,
+    /// поэтому набор не зависит от того, где в странице лежат данные объекта
     enum class DescriptorType {
-        Unknown, Uniform, CombinedImage, Storage
+        Unknown, Uniform, CombinedImage, Storage, DynamicUniform
+    };
+
+    /// Ресурс, записанный в набор дескрипторов. UBO объекта учитывается как Uniform,
+    /// текстуры и кубические карты - как CombinedImage
+    struct DescriptorResource {
+        DescriptorType type = DescriptorType::Unknown;
+        int32_t id = SR_ID_INVALID;
+
+        SR_NODISCARD uint64_t GetKey() const noexcept {
+            return (static_cast<uint64_t>(type) << 32U) | static_cast<uint32_t>(id);
+        }
     };
 }
 
@@ -0,0 +1,65 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_DEBUG_LINE_BATCH_H
+#define SR_ENGINE_DEBUG_LINE_BATCH_H
+
+#include <Graphics/Types/Mesh.h>
+#include <Graphics/Types/Uniforms.h>
+
+namespace SR_GTYPES_NS {
+    /**
+     * Все отладочные отрезки одного материала, рисуемые одним вызовом.
+     * Вершины лежат в SSBO (шейдер читает их по gl_VertexIndex), буфер перезаписывается каждый кадр.
+     * Количество вершин записывается в команду непрямой отрисовки, поэтому перестраивать сцену нужно только при росте буфера.
+     * Без непрямой отрисовки рисуется вся емкость буфера, а неиспользуемые вершины с нулевой альфой отбрасываются шейдером.
+    */
+    class DebugLineBatch final : public Mesh {
+        using Super = Mesh;
+    public:
+        struct Vertex {
+            glm::vec4 position;
+            glm::vec4 color;
+        };
+
+    public:
+        explicit DebugLineBatch(SR_UTILS_NS::StringAtom layer);
+
+    public:
+        /// Возвращает true, если буфер был пересоздан и команды рендера нужно записать заново.
+        /// При ошибке выделения памяти возвращает false, батч ничего не рисует до следующего роста
+        bool Upload(const std::vector<Vertex>& vertices);
+
+        void UseSSBO() override;
+
+        SR_NODISCARD uint32_t GetIndicesCount() const override { return m_capacity; }
+        SR_NODISCARD int32_t GetIndirectBuffer() const noexcept override { return m_drawBuffer; }
+        SR_NODISCARD bool IsSupportVBO() const override { return false; }
+        SR_NODISCARD SR_UTILS_NS::StringAtom GetMeshLayer() const override { return m_layer; }
+
+    protected:
+        void FreeVideoMemory() override;
+
+    private:
+        bool Reserve(uint32_t count);
+
+    private:
+        SR_UTILS_NS::StringAtom m_layer;
+
+        int32_t m_ssbo = SR_ID_INVALID;
+        int32_t m_drawBuffer = SR_ID_INVALID;
+        uint32_t m_capacity = 0;
+        /// Емкость, которую не удалось выделить, до ее превышения выделение не повторяется
+        uint32_t m_failedCapacity = 0;
+        /// Количество вершин в команде непрямой отрисовки
+        uint32_t m_drawCount = SR_UINT32_MAX;
+        /// Сколько вершин было записано в прошлый раз, их нужно затереть если сейчас вершин меньше
+        uint32_t m_uploaded = 0;
+
+        std::vector<Vertex> m_staging;
+
+    };
+}
+
+#endif //SR_ENGINE_DEBUG_LINE_BATCH_H
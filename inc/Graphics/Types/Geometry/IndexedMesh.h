@@ -8,6 +8,7 @@
 #include <Graphics/Memory/MeshManager.h>
 #include <Graphics/Types/Mesh.h>
 #include <Graphics/Pipeline/Pipeline.h>
+#include <Graphics/Utils/MeshSimplifier.h>
 
 namespace SR_GTYPES_NS {
     class IndexedMesh : public Mesh {
@@ -25,6 +26,9 @@ namespace SR_GTYPES_NS {
         SR_NODISCARD uint32_t GetVerticesCount() const { return m_countVertices; }
         SR_NODISCARD uint32_t GetIndicesCount() const override { return m_countIndices; }
 
+        SR_NODISCARD uint8_t GetLodsCount() const noexcept override { return static_cast<uint8_t>(m_lods.size() + 1); }
+        SR_NODISCARD MeshLod GetLod(uint8_t level) const override;
+
         SR_NODISCARD virtual std::vector<uint32_t> GetIndices() const { return { }; }
 
         SR_NODISCARD bool IsSupportVBO() const override { return true; }
@@ -41,12 +45,20 @@ namespace SR_GTYPES_NS {
         bool FreeVBO();
         bool FreeIBO();
 
+    protected:
+        /// Готовая цепочка LOD, упрощенные уровни дописываются в IBO после исходных индексов.
+        /// Вызывается только при создании IBO, строить цепочку здесь нельзя - это поток рендера
+        SR_NODISCARD virtual std::vector<MeshLodLevel> GetLodChain() const { return { }; }
+
     protected:
         int32_t m_IBO = SR_ID_INVALID;
         int32_t m_VBO = SR_ID_INVALID;
         uint32_t m_countIndices = 0;
         uint32_t m_countVertices = 0;
 
+        /// Уровни начиная с первого, нулевой - исходные индексы в начале IBO
+        std::vector<MeshLod> m_lods;
+
     };
 
     /// ----------------------------------------------------------------------------------------------------------------
@@ -28,12 +28,16 @@ namespace SR_GTYPES_NS {
         bool OnResourceReloaded(SR_UTILS_NS::IResource* pResource) override;
 
         SR_NODISCARD bool IsCalculatable() const override;
+        SR_NODISCARD bool IsInstancingSupported() const override { return true; }
         SR_NODISCARD std::vector<uint32_t> GetIndices() const override;
         SR_NODISCARD std::string GetMeshIdentifier() const override;
         SR_NODISCARD FrustumCullingType GetFrustumCullingType() const override { return m_frustumCullingType; }
 
     private:
         bool Calculate() override;
+        void CalculateBounds();
+
+        SR_NODISCARD std::vector<MeshLodLevel> GetLodChain() const override;
 
     private:
         FrustumCullingType m_frustumCullingType = FrustumCullingType::Sphere;
@@ -10,6 +10,7 @@
 
 #include <Graphics/Types/Geometry/MeshComponent.h>
 #include <Graphics/Animations/Skeleton.h>
+#include <Graphics/Animations/SkinningBuffer.h>
 
 namespace SR_GTYPES_NS {
     class SkinnedMesh final : public IndexedMeshComponent, public SR_HTYPES_NS::IRawMeshHolder {
@@ -51,13 +52,17 @@ namespace SR_GTYPES_NS {
         bool Calculate() override;
 
         void FreeSSBO();
+        bool AllocateOffsets();
+
+        /// Смещения костей зависят только от ресурса, поэтому один SSBO делят все его меши
+        SR_NODISCARD std::string GetBoneOffsetsIdentifier() const;
 
         SR_NODISCARD std::vector<uint32_t> GetIndices() const override;
 
     private:
         bool m_skeletonIsBroken = false;
-        int32_t m_ssboBones = SR_ID_INVALID;
         int32_t m_ssboOffsets = SR_ID_INVALID;
+        SR_ANIMATIONS_NS::SkinningBuffer::Region m_bonesRegion;
 
     };
 }
@@ -88,6 +88,8 @@ namespace SR_GTYPES_NS {
 
         SR_NODISCARD virtual bool IsCalculatable() const;
         SR_NODISCARD virtual bool IsUniqueMesh() const { return false; }
+        /// Меш можно рисовать экземплярами, если из уникальных юниформ у него только матрица модели
+        SR_NODISCARD virtual bool IsInstancingSupported() const { return false; }
 
         SR_NODISCARD virtual SR_FORCE_INLINE bool IsMeshActive() const noexcept { return !m_hasErrors; }
         SR_NODISCARD virtual SR_FORCE_INLINE bool IsFlatMesh() const noexcept { return false; }
@@ -98,7 +100,14 @@ namespace SR_GTYPES_NS {
         SR_NODISCARD virtual SR_UTILS_NS::StringAtom GetMeshLayer() const { return SR_UTILS_NS::StringAtom(); }
         SR_NODISCARD virtual bool IsSupportVBO() const = 0;
         SR_NODISCARD virtual uint32_t GetIndicesCount() const = 0;
+        /// Буфер аргументов, из которого меш рисует одну непрямую команду, SR_ID_INVALID - обычная отрисовка
+        SR_NODISCARD virtual int32_t GetIndirectBuffer() const noexcept { return m_indirectBuffer; }
         SR_NODISCARD virtual FrustumCullingType GetFrustumCullingType() const { return FrustumCullingType::None; }
+        /// Количество уровней детализации, нулевой уровень - исходная сетка
+        SR_NODISCARD virtual uint8_t GetLodsCount() const noexcept { return 1; }
+        /// Все уровни лежат в одном IBO, уровень выбирается смещением при отрисовке
+        SR_NODISCARD virtual MeshLod GetLod(uint8_t level) const { return MeshLod { 0, GetIndicesCount(), 0.f }; }
+        SR_NODISCARD const MeshBounds& GetLocalBounds() const noexcept { return m_localBounds; }
 
         SR_NODISCARD ShaderPtr GetShader() const;
         SR_NODISCARD MeshMaterialProperty& GetMaterialProperty() noexcept { return m_materialProperty; }
@@ -127,9 +136,9 @@ namespace SR_GTYPES_NS {
         virtual void Draw();
 
         virtual void UseMaterial();
-        virtual void UseModelMatrix() { }
+        virtual void UseModelMatrix();
         virtual void UseSamplers();
-        virtual void UseSSBO() { }
+        virtual void UseSSBO();
 
         void OnReRegistered();
         void MarkUniformsDirty(bool force = false);
@@ -141,6 +150,11 @@ namespace SR_GTYPES_NS {
         void SetMaterial(BaseMaterial* pMaterial);
         void SetMaterial(const SR_UTILS_NS::Path& path);
 
+        /// Если задан indirectBuffer, то меш рисует из него команду indirectCommand, количество экземпляров записано в ней.
+        /// Уровень детализации прямого вызова сбрасывается на исходный, его задает SetLod
+        void SetInstancing(int32_t ssbo, uint32_t instanceCount, int32_t indirectBuffer = SR_ID_INVALID, uint32_t indirectCommand = 0);
+        /// Диапазон индексов уровня выбирается при записи прямого вызова, непрямая команда хранит свой
+        void SetLod(uint8_t level) { m_lod = level; }
         void SetErrorsClean() { m_hasErrors = false; }
         void SetUniformsClean() { m_isUniformsDirty = false; }
 
@@ -149,6 +163,10 @@ namespace SR_GTYPES_NS {
 
         virtual bool Calculate();
 
+        /// Шейдер с инстансингом берет матрицу модели из буфера экземпляров. Вне серии RenderQueue
+        /// меш рисуется одним экземпляром из собственного буфера
+        SR_NODISCARD bool PrepareModelSSBO();
+
     protected:
         RenderQueues m_renderQueues;
 
@@ -159,13 +177,24 @@ namespace SR_GTYPES_NS {
 
         MeshMaterialProperty m_materialProperty;
 
+        MeshBounds m_localBounds;
+
         bool m_isWaitReRegister = false;
         bool m_hasErrors = false;
         bool m_dirtyMaterial = false;
         bool m_isUniformsDirty = false;
+        bool m_dirtyInstancing = false;
 
         int32_t m_virtualUBO = SR_ID_INVALID;
+        int32_t m_instanceSSBO = SR_ID_INVALID;
+        uint32_t m_instanceCount = 1;
+        int32_t m_indirectBuffer = SR_ID_INVALID;
+        uint32_t m_indirectCommand = 0;
+        uint8_t m_lod = 0;
+        int32_t m_modelSSBO = SR_ID_INVALID;
         int32_t m_virtualDescriptor = SR_ID_INVALID;
+        /// Версия таблицы текстур, записанная в дескриптор при последнем обновлении
+        uint64_t m_textureTableVersion = 0;
 
     private:
         std::optional<MeshRegistrationInfo> m_registrationInfo;
@@ -16,12 +16,17 @@
 #include <Graphics/Loaders/SRSL.h>
 #include <Graphics/Memory/ShaderProgramManager.h>
 #include <Graphics/Memory/IGraphicsResource.h>
+#include <Graphics/Types/Descriptors.h>
 #include <Graphics/Memory/UBOManager.h>
 
 namespace SR_GTYPES_NS {
     class Texture;
 }
 
+namespace SR_SRSL_NS {
+    class SRSLShader;
+}
+
 namespace SR_GRAPH_NS {
     class Render;
     class RenderContext;
@@ -41,6 +46,9 @@ namespace SR_GTYPES_NS {
 
     public:
         static Shader* Load(const SR_UTILS_NS::Path& rawPath);
+        /// Компилирует SRSL всех шейдеров параллельно, затем регистрирует ресурсы в вызывающем потоке.
+        /// Результаты идут в порядке путей, nullptr - шейдер не загрузился
+        static std::vector<Shader*> Load(const std::vector<SR_UTILS_NS::Path>& rawPaths);
 
         ShaderBindResult Use() noexcept;
 
@@ -54,6 +62,12 @@ namespace SR_GTYPES_NS {
         void StartWatch() override;
 
         void AttachDescriptorSets();
+        /// Сбрасывает SSBO, привязанные до следующей записи набора дескрипторов
+        void ResetSSBOBindings() noexcept;
+        /// Хеш всего, что AttachDescriptorSets запишет в текущий набор дескрипторов.
+        /// 0 - содержимое нельзя кешировать (например, есть вложения кадрового буфера).
+        /// В pResources дописываются ресурсы, на которые будет ссылаться набор
+        SR_NODISCARD uint64_t GetDescriptorContentHash(std::vector<DescriptorResource>* pResources = nullptr) const;
 
         bool BeginSharedUBO();
         void EndSharedUBO();
@@ -72,9 +86,40 @@ namespace SR_GTYPES_NS {
         SR_NODISCARD bool IsAvailable() const;
         SR_NODISCARD bool IsSamplersValid() const;
         SR_NODISCARD bool HasSharedUBO() const noexcept { return m_uniformSharedBlock.Valid(); }
+        SR_NODISCARD bool IsInstancingSupported() const noexcept { return m_instancingSupported; }
+        SR_NODISCARD bool HasTextureTable() const noexcept { return m_textureTableBinding != SR_ID_INVALID; }
         SR_NODISCARD SR_SRSL_NS::ShaderType GetType() const noexcept;
 
+        template<typename T> SR_NODISCARD Memory::ShaderTypedSlot<T> GetSlot(uint64_t hashId) const noexcept {
+            Memory::ShaderTypedSlot<T> slot;
+            ResolveSlot(slot, hashId);
+            return slot;
+        }
+
+        SR_NODISCARD bool IsSlotValid(const Memory::ShaderSlot& slot) const noexcept {
+            return m_layoutVersion != 0 && slot.layoutVersion == m_layoutVersion;
+        }
+
     public:
+        template<bool constant, typename T> void SetValue(const Memory::ShaderTypedSlot<T>& slot, const T* v) noexcept {
+            if (!IsSlotValid(slot)) SR_UNLIKELY_ATTRIBUTE {
+                SetValue<constant>(slot.hashId, v);
+                return;
+            }
+
+            if constexpr (constant) {
+                m_constBlock.SetField(slot.constant, v);
+            }
+            else {
+                if (m_sharedUBOMode) SR_UNLIKELY_ATTRIBUTE {
+                    m_uniformSharedBlock.SetField(slot.shared, v);
+                }
+                else {
+                    m_uniformBlock.SetField(slot.uniform, v);
+                }
+            }
+        }
+
         template<bool constant, typename T> void SetValue(uint64_t hashId, const T* v) noexcept {
             if constexpr (constant) {
                 m_constBlock.SetField(hashId, v);
@@ -111,8 +156,12 @@ namespace SR_GTYPES_NS {
         void SR_FASTCALL SetSampler2D(SR_UTILS_NS::StringAtom name, Texture* sampler) noexcept;
         void SR_FASTCALL SetSampler2D(SR_UTILS_NS::StringAtom name, int32_t sampler) noexcept;
         void SR_FASTCALL SetSamplerCube(SR_UTILS_NS::StringAtom name, int32_t sampler) noexcept;
+        /// Для bindless семплера пишет индекс текстуры из общей таблицы в блок юниформ.
+        /// Возвращает false, если семплер не bindless
+        bool SR_FASTCALL SetTextureIndex(SR_UTILS_NS::StringAtom name, Texture* pTexture) noexcept;
+        SR_NODISCARD bool IsBindlessSampler(SR_UTILS_NS::StringAtom name) const noexcept;
 
-        void BindSSBO(SR_UTILS_NS::StringAtom name, uint32_t ssbo) noexcept;
+        void BindSSBO(SR_UTILS_NS::StringAtom name, uint32_t ssbo, uint32_t offset = 0, uint32_t range = 0) noexcept;
 
         SR_NODISCARD bool HasErrors() const noexcept { return m_hasErrors; }
 
@@ -129,7 +178,14 @@ namespace SR_GTYPES_NS {
         void UnloadDefaultSamplers();
 
     private:
+        SR_NODISCARD static SR_UTILS_NS::Path NormalizePath(const SR_UTILS_NS::Path& rawPath);
+        SR_NODISCARD static Shader* Create(const SR_UTILS_NS::Path& path, std::shared_ptr<SR_SRSL_NS::SRSLShader> pPrecompiled);
+
         void SetSampler(SR_UTILS_NS::StringAtom name, int32_t sampler) noexcept;
+        void ResolveSlot(Memory::ShaderSlot& slot, uint64_t hashId) const noexcept;
+
+        /// Записывает данные в текущий UBO или в его область, если он выделен из страницы
+        void UpdateCurrentUBO(void* pMemory, uint64_t size) const;
 
     private:
         Memory::UBOManager& m_uboManager;
@@ -140,11 +196,21 @@ namespace SR_GTYPES_NS {
         bool m_hasErrors = false;
         bool m_isRegistered = false;
         bool m_sharedUBOMode = false;
+        bool m_instancingSupported = false;
+
+        /// Меняется при каждой загрузке шейдера, 0 - блоки не инициализированы
+        uint32_t m_layoutVersion = 0;
+
+        uint32_t m_textureTableBinding = SR_ID_INVALID;
+        uint32_t m_bindlessSamplersCount = 0;
 
         SRShaderCreateInfo m_shaderCreateInfo = { };
 
         std::pair<int32_t, bool> m_virtualUBO = { SR_ID_INVALID, true };
 
+        /// Уже скомпилированный и экспортированный SRSL, полученный при пакетной загрузке
+        std::shared_ptr<SR_SRSL_NS::SRSLShader> m_precompiled;
+
         std::vector<SR_UTILS_NS::StringAtom> m_includes;
         Memory::ShaderUBOBlock m_uniformBlock;
         Memory::ShaderUBOBlock m_uniformSharedBlock;
@@ -42,6 +42,10 @@ namespace SR_GTYPES_NS {
         SR_NODISCARD uint32_t GetHeight() const noexcept;
         SR_NODISCARD uint32_t GetChannels() const noexcept;
         SR_NODISCARD int32_t GetId() noexcept;
+        /// Индекс в общей таблице текстур (DescriptorManager), SR_ID_INVALID - текстура не в таблице
+        SR_NODISCARD int32_t GetTableIndex() noexcept;
+        /// Текстура уже загружена в видеопамять и попала в таблицу, в отличие от GetTableIndex не загружает ее
+        SR_NODISCARD bool HasTableIndex() const noexcept { return m_tableIndex != SR_ID_INVALID; }
         SR_NODISCARD void* GetDescriptor();
         SR_NODISCARD SR_UTILS_NS::Path GetAssociatedPath() const override;
 
@@ -65,6 +69,7 @@ namespace SR_GTYPES_NS {
         RenderContextPtr m_context = { };
 
         int32_t m_id = SR_ID_INVALID;
+        int32_t m_tableIndex = SR_ID_INVALID;
 
         std::atomic<bool> m_hasErrors = false;
 
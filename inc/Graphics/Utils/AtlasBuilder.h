@@ -8,6 +8,7 @@
 #include <Utils/FileSystem/Path.h>
 #include <Utils/Math/Vector2.h>
 #include <Graphics/Loaders/TextureLoader.h>
+#include <Graphics/Utils/RectPacker.h>
 
 namespace SR_GRAPH_NS {
     struct AtlasBuilderData {
@@ -17,6 +18,29 @@ namespace SR_GRAPH_NS {
         bool saveInCache = false;
         SR_MATH_NS::UVector2 quantityOnAxes;
         SR_MATH_NS::UVector2 step;
+
+        /// Без упаковки спрайты кладутся в одну полосу (только одинакового размера)
+        bool pack = true;
+        RectPackMethod packMethod = RectPackMethod::MaxRects;
+        bool allowRotation = true;
+        /// Пустое место между спрайтами
+        uint32_t padding = 2;
+        /// Сколько раз дублируются крайние пиксели спрайта, чтобы фильтрация не цепляла соседей
+        uint32_t extrude = 1;
+        bool powerOfTwo = true;
+        /// Все страницы размером maxPageSize, иначе страница обрезается по содержимому
+        bool fixedPageSize = false;
+        SR_MATH_NS::UVector2 maxPageSize = SR_MATH_NS::UVector2(4096, 4096);
+    };
+
+    struct AtlasSprite {
+        SR_GRAPH_NS::TextureData::Ptr pTextureData;
+        std::string name;
+        uint32_t page = 0;
+        /// Положение самого спрайта на странице, без отступов
+        uint32_t x = 0;
+        uint32_t y = 0;
+        bool rotated = false;
     };
 
     class AtlasBuilder : public SR_UTILS_NS::NonCopyable {
@@ -35,17 +59,29 @@ namespace SR_GRAPH_NS {
         SR_NODISCARD bool IsInCache() const { return m_data.saveInCache; }
         SR_NODISCARD SR_MATH_NS::UVector2 GetQuantity() const { return m_data.quantityOnAxes; }
         SR_NODISCARD SR_MATH_NS::UVector2 GetStep() const { return m_data.step; }
+        SR_NODISCARD const std::vector<AtlasSprite>& GetSprites() const { return m_sprites; }
+        SR_NODISCARD uint32_t GetPagesCount() const { return static_cast<uint32_t>(m_pages.size()); }
 
     private:
+        SR_NODISCARD bool LoadSprites(const std::vector<SR_UTILS_NS::Path>& files);
+
         SR_NODISCARD bool Create();
-        SR_NODISCARD bool CreateLinearAtlas();;
+        SR_NODISCARD bool CreateLinearAtlas();
+        SR_NODISCARD bool CreatePackedAtlas();
+
+        SR_NODISCARD SR_MATH_NS::UVector2 GetSlotSize(const AtlasSprite& sprite) const;
+        /// Раскладывает спрайты [begin, end) на странице размером pageSize, возвращает количество уместившихся
+        SR_NODISCARD uint32_t PackPage(uint32_t begin, uint32_t end, const SR_MATH_NS::UVector2& pageSize, SR_MATH_NS::UVector2& usedSize);
+        void BlitSprite(uint8_t* pPage, uint32_t pageWidth, uint32_t pageHeight, const AtlasSprite& sprite) const;
+
+        SR_NODISCARD SR_UTILS_NS::Path GetPagePath(uint32_t page) const;
 
     private:
         AtlasBuilderData m_data;
         SR_MATH_NS::UVector2 m_totalSize;
 
-        std::vector<SR_GRAPH_NS::TextureData::Ptr> m_sprites;
-        SR_GRAPH_NS::TextureData::Ptr m_atlas;
+        std::vector<AtlasSprite> m_sprites;
+        std::vector<SR_GRAPH_NS::TextureData::Ptr> m_pages;
     };
 
 }
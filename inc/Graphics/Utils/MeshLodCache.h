@@ -0,0 +1,42 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_MESH_LOD_CACHE_H
+#define SR_ENGINE_MESH_LOD_CACHE_H
+
+#include <Utils/Common/Singleton.h>
+#include <Graphics/Utils/MeshSimplifier.h>
+
+namespace SR_HTYPES_NS {
+    class RawMesh;
+}
+
+namespace SR_GRAPH_NS {
+    /**
+     * Цепочки LOD сырых мешей. Строятся один раз при загрузке файла меша и сохраняются в кеш
+     * рядом с кешем текстур и шейдеров. Расчет меша на потоке рендера цепочку только читает,
+     * упрощение там никогда не запускается.
+    */
+    class MeshLodCache : public SR_UTILS_NS::Singleton<MeshLodCache> {
+        SR_REGISTER_SINGLETON(MeshLodCache)
+    public:
+        /// Строит недостающие цепочки всех мешей файла, повторный вызов для той же версии файла ничего не делает
+        void Prepare(SR_HTYPES_NS::RawMesh* pRawMesh);
+
+        /// Пустой результат - цепочки в кеше нет или она не подходит к сетке, меш рисуется без LOD
+        SR_NODISCARD std::vector<MeshLodLevel> Load(SR_HTYPES_NS::RawMesh* pRawMesh, uint32_t meshId, uint32_t indicesCount, uint32_t verticesCount) const;
+
+    private:
+        SR_NODISCARD SR_UTILS_NS::Path GetCachePath(SR_HTYPES_NS::RawMesh* pRawMesh, uint32_t meshId) const;
+        SR_NODISCARD bool Save(const SR_UTILS_NS::Path& path, const std::vector<MeshLodLevel>& levels) const;
+
+    private:
+        std::mutex m_mutex;
+        /// Файлы (идентификатор ресурса и номер перезагрузки), для которых кеш уже проверен
+        std::unordered_set<std::string> m_prepared;
+
+    };
+}
+
+#endif //SR_ENGINE_MESH_LOD_CACHE_H
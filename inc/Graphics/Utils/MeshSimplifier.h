@@ -0,0 +1,83 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_MESH_SIMPLIFIER_H
+#define SR_ENGINE_MESH_SIMPLIFIER_H
+
+#include <Utils/stdInclude.h>
+
+namespace SR_GRAPH_NS {
+    /// Параметры построения цепочки LOD
+    struct MeshLodSettings {
+        /// Максимальное количество уровней помимо исходного
+        uint8_t levels = 4;
+        /// Во сколько раз каждый следующий уровень меньше предыдущего по количеству треугольников
+        float_t reduction = 0.5f;
+        /// Допустимая ошибка уровня относительно радиуса меша
+        float_t maxRelativeError = 0.25f;
+        /// Меши и уровни меньше этого количества треугольников не упрощаются
+        uint32_t minTriangles = 64;
+    };
+
+    /// Уровень детализации: индексы над исходным набором вершин и геометрическая
+    /// ошибка (максимальное отклонение поверхности) в локальных координатах меша
+    struct MeshLodLevel {
+        std::vector<uint32_t> indices;
+        float_t error = 0.f;
+    };
+
+    /**
+     * Упрощение индексированной сетки стягиванием ребер по квадрикам ошибок (Garland-Heckbert).
+     * Вершины никогда не создаются и не перемещаются: ребро стягивается в одну из своих вершин,
+     * поэтому все уровни используют исходный VBO. Вершины на швах (одна позиция - несколько вершин
+     * с разными атрибутами) и на открытых границах не сдвигаются, чтобы не рвать сетку.
+    */
+    class MeshSimplifier : public SR_UTILS_NS::NonCopyable {
+        using Super = SR_UTILS_NS::NonCopyable;
+
+        struct Quadric {
+            double_t a2 = 0, ab = 0, ac = 0, ad = 0;
+            double_t b2 = 0, bc = 0, bd = 0;
+            double_t c2 = 0, cd = 0;
+            double_t d2 = 0;
+            double_t weight = 0;
+
+            void Add(const Quadric& other);
+            SR_NODISCARD double_t Evaluate(float_t x, float_t y, float_t z) const;
+        };
+
+    public:
+        /// pPositions - три float_t на вершину, stride - шаг между вершинами в байтах
+        MeshSimplifier(const void* pPositions, uint32_t stride, uint32_t verticesCount);
+
+    public:
+        SR_NODISCARD float_t GetRadius() const noexcept { return m_radius; }
+
+        /// Упрощает до targetIndicesCount индексов, не превышая ошибку targetError.
+        /// В pError возвращается достигнутая ошибка
+        SR_NODISCARD std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, uint32_t targetIndicesCount, float_t targetError, float_t* pError) const;
+
+        /// Каждый уровень строится из предыдущего, ошибка уровней не убывает
+        SR_NODISCARD std::vector<MeshLodLevel> BuildLodChain(const std::vector<uint32_t>& indices, const MeshLodSettings& settings) const;
+
+    private:
+        SR_NODISCARD const float_t* GetPosition(uint32_t vertex) const noexcept {
+            return reinterpret_cast<const float_t*>(m_positions + static_cast<size_t>(vertex) * m_stride);
+        }
+
+    private:
+        const uint8_t* m_positions = nullptr;
+        uint32_t m_stride = 0;
+        uint32_t m_verticesCount = 0;
+        float_t m_radius = 0.f;
+
+        /// Вершина -> представитель группы вершин с той же позицией
+        std::vector<uint32_t> m_positionClass;
+        /// Вершины, лежащие на шве атрибутов
+        std::vector<bool> m_seam;
+
+    };
+}
+
+#endif //SR_ENGINE_MESH_SIMPLIFIER_H
@@ -7,6 +7,8 @@
 
 #include <Graphics/Utils/MeshTypes.h>
 
+#include <Utils/Math/Vector3.h>
+
 namespace SR_GTYPES_NS {
     class Mesh;
     class Shader;
@@ -23,6 +25,24 @@ namespace SR_GRAPH_NS {
         ConvexHull
     );
 
+    /// Ограничивающий объем меша в локальных координатах
+    struct MeshBounds {
+        SR_MATH_NS::FVector3 min;
+        SR_MATH_NS::FVector3 max;
+        bool valid = false;
+
+        SR_NODISCARD SR_MATH_NS::FVector3 Center() const noexcept { return (min + max) * 0.5f; }
+        SR_NODISCARD SR_MATH_NS::FVector3 Extents() const noexcept { return (max - min) * 0.5f; }
+        SR_NODISCARD float_t Radius() const noexcept { return static_cast<float_t>(Extents().Length()); }
+    };
+
+    /// Уровень детализации - участок общего IBO меша и его геометрическая ошибка в локальных координатах
+    struct MeshLod {
+        uint32_t firstIndex = 0;
+        uint32_t indicesCount = 0;
+        float_t error = 0.f;
+    };
+
     class RenderScene;
     class MeshRenderStage;
     class BaseMaterial;
@@ -0,0 +1,91 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_GRAPHICS_PARALLEL_FOR_H
+#define SR_ENGINE_GRAPHICS_PARALLEL_FOR_H
+
+#include <Utils/Common/Singleton.h>
+
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+namespace SR_GRAPH_NS {
+    /**
+     * Постоянные рабочие потоки для ParallelFor, создаются один раз по числу ядер.
+     * Задания ставятся в очередь, вызывающий поток выполняет задачи своего задания вместе
+     * с рабочими, поэтому вложенный ParallelFor из задачи не блокирует пул.
+    */
+    class ParallelForPool : public SR_UTILS_NS::Singleton<ParallelForPool> {
+        SR_REGISTER_SINGLETON(ParallelForPool)
+        using Super = SR_UTILS_NS::Singleton<ParallelForPool>;
+    public:
+        struct Job {
+            void (*pInvoke)(const void* pFunction, uint32_t task) = nullptr;
+            const void* pFunction = nullptr;
+            uint32_t tasksCount = 0;
+            /// Сколько рабочих потоков может взяться за задание, не считая вызывающего
+            uint32_t maxWorkers = 0;
+            std::atomic<uint32_t> nextTask = 0;
+            /// Рабочие потоки, которые сейчас выполняют задачи задания, защищено мьютексом пула
+            uint32_t workers = 0;
+        };
+
+    private:
+        ParallelForPool();
+        ~ParallelForPool() override;
+
+    public:
+        SR_NODISCARD uint32_t GetThreadsCount() const noexcept { return static_cast<uint32_t>(m_threads.size()); }
+
+        /// Возврат только после выполнения всех задач задания
+        void Run(Job& job);
+
+    private:
+        void WorkerLoop();
+        static void RunTasks(Job& job);
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_jobCondition;
+        std::condition_variable m_doneCondition;
+
+        std::deque<Job*> m_jobs;
+        std::vector<std::thread> m_threads;
+        bool m_stop = false;
+
+    };
+
+    /**
+     * Раздает задачи [0, tasksCount) потокам по одной, вызывающий поток тоже берет задачи.
+     * threadsCount == 0 - по числу ядер. Если поток один или задача одна, все выполняется
+     * на вызывающем потоке без участия пула. Возврат только после выполнения всех задач.
+    */
+    template<typename Function> void ParallelFor(uint32_t tasksCount, uint32_t threadsCount, const Function& function) {
+        if (threadsCount == 0) {
+            threadsCount = SR_MAX(std::thread::hardware_concurrency(), 1u);
+        }
+
+        const uint32_t workersCount = SR_MIN(threadsCount, tasksCount);
+
+        if (workersCount <= 1) {
+            for (uint32_t task = 0; task < tasksCount; ++task) {
+                function(task);
+            }
+            return;
+        }
+
+        ParallelForPool::Job job;
+        job.pInvoke = [](const void* pFunction, uint32_t task) {
+            (*static_cast<const Function*>(pFunction))(task);
+        };
+        job.pFunction = &function;
+        job.tasksCount = tasksCount;
+        job.maxWorkers = workersCount - 1;
+
+        ParallelForPool::Instance().Run(job);
+    }
+}
+
+#endif //SR_ENGINE_GRAPHICS_PARALLEL_FOR_H
@@ -0,0 +1,80 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef SR_ENGINE_RECT_PACKER_H
+#define SR_ENGINE_RECT_PACKER_H
+
+#include <Utils/stdInclude.h>
+#include <Utils/Common/Enumerations.h>
+
+namespace SR_GRAPH_NS {
+    SR_ENUM_NS_CLASS_T(RectPackMethod, uint8_t,
+        MaxRects, /// Список свободных прямоугольников, плотнее упаковка, медленнее вставка
+        Skyline   /// Линия горизонта, быстрее вставка, подходит для множества мелких элементов
+    );
+
+    struct PackedRect {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        /// Размер после поворота
+        uint32_t width = 0;
+        uint32_t height = 0;
+        /// Повернут на 90 градусов по часовой стрелке
+        bool rotated = false;
+    };
+
+    /**
+     * Упаковка прямоугольников в одну страницу фиксированного размера.
+     * MaxRects - эвристика best short side fit, Skyline - bottom left.
+    */
+    class RectPacker : public SR_UTILS_NS::NonCopyable {
+        using Super = SR_UTILS_NS::NonCopyable;
+
+        struct SkylineNode {
+            uint32_t x = 0;
+            uint32_t y = 0;
+            uint32_t width = 0;
+        };
+
+    public:
+        RectPacker(RectPackMethod method, uint32_t width, uint32_t height, bool allowRotation);
+
+    public:
+        /// Возвращает false, если прямоугольник не помещается в оставшееся место
+        SR_NODISCARD bool Insert(uint32_t width, uint32_t height, PackedRect& result);
+
+        void Reset(uint32_t width, uint32_t height);
+
+        SR_NODISCARD uint32_t GetUsedWidth() const noexcept { return m_usedWidth; }
+        SR_NODISCARD uint32_t GetUsedHeight() const noexcept { return m_usedHeight; }
+        SR_NODISCARD float_t GetOccupancy() const noexcept;
+
+    private:
+        SR_NODISCARD bool InsertMaxRects(uint32_t width, uint32_t height, PackedRect& result);
+        SR_NODISCARD bool InsertSkyline(uint32_t width, uint32_t height, PackedRect& result);
+
+        void SplitFreeRects(const PackedRect& used);
+        void PruneFreeRects();
+
+        SR_NODISCARD bool SkylineFits(uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+        void SkylineAddLevel(uint32_t index, const PackedRect& rect);
+
+    private:
+        RectPackMethod m_method = RectPackMethod::MaxRects;
+
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        bool m_allowRotation = false;
+
+        uint32_t m_usedWidth = 0;
+        uint32_t m_usedHeight = 0;
+        uint64_t m_usedArea = 0;
+
+        std::vector<PackedRect> m_freeRects;
+        std::vector<SkylineNode> m_skyline;
+
+    };
+}
+
+#endif //SR_ENGINE_RECT_PACKER_H
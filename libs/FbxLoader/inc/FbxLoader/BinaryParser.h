@@ -0,0 +1,67 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef FBXLOADER_BINARYPARSER_H
+#define FBXLOADER_BINARYPARSER_H
+
+#include <FbxLoader/Debug.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace FbxLoader::Binary {
+    /// Свойство узла бинарного FBX.
+    /// Скаляры хранятся сразу в integer/real, массивы - уже распакованными
+    /// в data (count элементов), строки и сырые данные - в data как есть
+    struct Property {
+        [[nodiscard]] bool IsArray() const;
+        [[nodiscard]] bool IsString() const { return type == 'S'; }
+
+        [[nodiscard]] int64_t AsInt() const;
+        [[nodiscard]] double AsDouble() const;
+        /// Имена объектов в бинарном формате хранятся как "name\x00\x01Class",
+        /// приводим их к текстовому виду "Class::name"
+        [[nodiscard]] std::string AsString() const;
+
+        [[nodiscard]] std::vector<float_t> AsFloats() const;
+        [[nodiscard]] std::vector<int32_t> AsInt32s() const;
+        [[nodiscard]] std::vector<uint32_t> AsUInt32s() const;
+
+        char type = 0;
+        int64_t integer = 0;
+        double real = 0.0;
+        uint32_t count = 0;
+        std::vector<uint8_t> data;
+    };
+
+    struct Node {
+        [[nodiscard]] const Node* Find(const std::string& _name) const {
+            for (auto&& child : children)
+                if (child.name == _name)
+                    return &child;
+            return nullptr;
+        }
+
+        /// Первое свойство первого дочернего узла с заданным именем, например
+        /// массив "a" у "Vertices"
+        [[nodiscard]] const Property* FindProperty(const std::string& _name) const {
+            if (auto&& pNode = Find(_name); pNode && !pNode->properties.empty())
+                return &pNode->properties[0];
+            return nullptr;
+        }
+
+        std::string name;
+        std::vector<Property> properties;
+        std::vector<Node> children;
+    };
+
+    [[nodiscard]] bool IsBinary(const std::string& path);
+
+    /// Читает файл целиком и строит дерево узлов. Корень имеет имя "Fbx",
+    /// в version возвращается версия формата (например, 7400)
+    [[nodiscard]] bool Parse(const std::string& path, Node& root, uint32_t& version);
+}
+
+#endif //FBXLOADER_BINARYPARSER_H
@@ -6,6 +6,7 @@
 #define FBXLOADER_FBX_H
 
 #include <FbxLoader/Mesh.h>
+#include <FbxLoader/Meshlet.h>
 #include <FbxLoader/Node.h>
 #include <FbxLoader/ISerializable.h>
 
@@ -60,6 +61,9 @@ namespace FbxLoader {
             vertices = std::exchange(geometry.vertices, {});
             indices = std::exchange(geometry.indices, {});
             materials = std::exchange(geometry.materials, {});
+            meshlets = std::exchange(geometry.meshlets, {});
+            meshletVertices = std::exchange(geometry.meshletVertices, {});
+            meshletTriangles = std::exchange(geometry.meshletTriangles, {});
         }
 
         RawGeometry& operator=(RawGeometry&& geometry) noexcept {
@@ -69,6 +73,9 @@ namespace FbxLoader {
             vertices = std::exchange(geometry.vertices, {});
             indices = std::exchange(geometry.indices, {});
             materials = std::exchange(geometry.materials, {});
+            meshlets = std::exchange(geometry.meshlets, {});
+            meshletVertices = std::exchange(geometry.meshletVertices, {});
+            meshletTriangles = std::exchange(geometry.meshletTriangles, {});
             return *this;
         }
 
@@ -81,6 +88,11 @@ namespace FbxLoader {
         std::vector<uint32_t> indices;
         std::vector<MaterialRange> materials;
 
+        /// Кластеры строятся после разбиения по материалам, см. Meshlet
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint8_t> meshletTriangles;
+
     };
 
     struct RawModel : public Tools::ISerializable, public Tools::NonCopyable {
@@ -0,0 +1,19 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef FBXLOADER_INFLATE_H
+#define FBXLOADER_INFLATE_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace FbxLoader::Tools {
+    /// Распаковывает zlib-поток (RFC 1950/1951) в заранее выделенный буфер.
+    /// В бинарном FBX размер распакованного массива всегда известен заранее,
+    /// поэтому выходной буфер не растет. Возвращает false при поврежденном потоке
+    /// или если распакованные данные не совпали по размеру с outSize.
+    [[nodiscard]] bool Inflate(const uint8_t* pData, size_t size, uint8_t* pOut, size_t outSize);
+}
+
+#endif //FBXLOADER_INFLATE_H
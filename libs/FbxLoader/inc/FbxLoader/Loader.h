@@ -6,6 +6,7 @@
 #define FBXLOADER_LOADER_H
 
 #include <FbxLoader/Parser.h>
+#include <FbxLoader/BinaryParser.h>
 #include <FbxLoader/Fbx.h>
 #include <FbxLoader/Optimization.h>
 #include <mutex>
@@ -18,6 +19,9 @@ namespace FbxLoader {
     typedef std::vector<Vertex> VertexGroup;
     typedef std::vector<VertexGroup> VertexGroups;
 
+    /// Меняется при изменении формата кэша, старый кэш тогда перестраивается
+    static constexpr uint32_t CACHE_VERSION = 2;
+
     class Loader {
     public:
         Loader(const Loader&) = delete;
@@ -26,7 +30,6 @@ namespace FbxLoader {
 
     public:
         static RawFbx Load(
-                const std::string& converter,
                 const std::string& cache,
                 const std::string& models,
                 const std::string& path,
@@ -34,12 +37,16 @@ namespace FbxLoader {
 
     private:
         static RawFbx LoadFbx(const std::string& ascii, const std::string& cache, bool needOptimize);
+        static RawFbx LoadBinaryFbx(const std::string& path, const std::string& cache, bool needOptimize);
         static RawFbx LoadObj(const std::string& path, const std::string& cache, bool needOptimize);
 
         static bool OptimizeGeometry(RawGeometry* geometry);
+        static bool BuildMeshlets(RawGeometry* geometry);
 
         static std::vector<RawGeometry> SplitByMaterials(RawGeometry&& geometries);
 
+        static void PrepareGeometries(RawFbx& fbx, bool needOptimize);
+
         static RawGeometry ParseGeometry(Parser::Node* node);
         static RawModel ParseModel(Parser::Node* node);
         static NodeAttribute ParseNodeAttribute(Parser::Node* node);
@@ -48,6 +55,15 @@ namespace FbxLoader {
         static Objects GetObjects(Parser::Node* node);
         static std::vector<MaterialRange> GetMaterialRanges(Parser::Node* node);
 
+        static RawGeometry ParseGeometry(const Binary::Node& node);
+        static RawModel ParseModel(const Binary::Node& node);
+
+        static std::vector<Vertex> GetVertices(const Binary::Node& node, const std::vector<uint32_t>& indices);
+        static Objects GetObjects(const Binary::Node& node);
+        static std::vector<MaterialRange> GetMaterialRanges(const Binary::Node& node);
+
+        static std::vector<MaterialRange> MakeMaterialRanges(const std::vector<int32_t>& materials);
+
     };
 }
 
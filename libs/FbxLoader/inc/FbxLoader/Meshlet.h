@@ -0,0 +1,50 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#ifndef FBXLOADER_MESHLET_H
+#define FBXLOADER_MESHLET_H
+
+#include <FbxLoader/Mesh.h>
+
+namespace FbxLoader {
+    /// Ограничения совпадают с типичными для mesh shader'ов, локальные индексы влезают в uint8_t
+    constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+    constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+    /// Кластер треугольников геометрии.
+    /// Вершины кластера - это индексы в общий массив вершин, они лежат в meshletVertices
+    /// начиная с vertexOffset. Треугольники - тройки локальных индексов (в пределах кластера)
+    /// в meshletTriangles начиная с triangleOffset * 3.
+    /// Кластер целиком смотрит от камеры, если dot(normalize(coneApex - camera), coneAxis) >= coneCutoff
+    struct Meshlet : public Tools::ISerializable {
+        void Save(std::ofstream& file) const override;
+        void Load(std::ifstream& file) override;
+
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t triangleOffset = 0;
+        uint32_t triangleCount = 0;
+
+        /// Ограничивающая сфера
+        vec3 center;
+        float_t radius = 0.f;
+
+        /// Конус нормалей, coneCutoff = 1 отключает отсечение по нему
+        vec3 coneApex;
+        vec3 coneAxis;
+        float_t coneCutoff = 1.f;
+    };
+
+    /// Разбивает индексированный список треугольников на кластеры.
+    /// Треугольники набираются жадно: следующим берется смежный треугольник,
+    /// добавляющий в кластер меньше всего новых вершин
+    bool BuildMeshlets(
+            const std::vector<Vertex>& vertices,
+            const std::vector<uint32_t>& indices,
+            std::vector<Meshlet>& meshlets,
+            std::vector<uint32_t>& meshletVertices,
+            std::vector<uint8_t>& meshletTriangles);
+}
+
+#endif //FBXLOADER_MESHLET_H
@@ -0,0 +1,364 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <FbxLoader/BinaryParser.h>
+#include <FbxLoader/Inflate.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace FbxLoader::Binary {
+    namespace {
+        constexpr char MAGIC[] = "Kaydara FBX Binary  ";
+        constexpr size_t HEADER_SIZE = 27;
+        /// Начиная с 7.5 смещения и размеры в записях узлов 64-битные
+        constexpr uint32_t LARGE_RECORDS_VERSION = 7500;
+        /// Защита от зацикливания на поврежденных файлах
+        constexpr uint32_t MAX_DEPTH = 64;
+        /// Самое короткое свойство - тип и один байт значения
+        constexpr uint64_t MIN_PROPERTY_SIZE = 2;
+        /// deflate не может распаковать больше 1032 байт из одного сжатого
+        constexpr uint64_t MAX_DEFLATE_RATIO = 1032;
+
+        uint32_t GetArrayElementSize(char type) {
+            switch (type) {
+                case 'f': case 'i': return 4;
+                case 'd': case 'l': return 8;
+                case 'b': return 1;
+                default:
+                    return 0;
+            }
+        }
+
+        class Reader {
+        public:
+            Reader(const uint8_t* pData, size_t size, uint32_t version)
+                : m_data(pData)
+                , m_size(size)
+                , m_pos(HEADER_SIZE)
+                , m_version(version)
+            { }
+
+        public:
+            [[nodiscard]] bool IsEnd() const { return m_pos >= m_size; }
+
+            bool ReadNode(Node& node, bool& isNull, uint32_t depth) {
+                if (depth > MAX_DEPTH) {
+                    FBX_ERROR("Binary::Reader::ReadNode() : nodes hierarchy is too deep!");
+                    return false;
+                }
+
+                uint64_t endOffset = 0, propertiesCount = 0, propertiesSize = 0;
+
+                if (m_version >= LARGE_RECORDS_VERSION) {
+                    endOffset = Read<uint64_t>();
+                    propertiesCount = Read<uint64_t>();
+                    propertiesSize = Read<uint64_t>();
+                }
+                else {
+                    endOffset = Read<uint32_t>();
+                    propertiesCount = Read<uint32_t>();
+                    propertiesSize = Read<uint32_t>();
+                }
+
+                const uint8_t nameLength = Read<uint8_t>();
+
+                if (m_error) {
+                    return false;
+                }
+
+                /// Нулевая запись закрывает список дочерних узлов
+                if (endOffset == 0) {
+                    isNull = true;
+                    return true;
+                }
+
+                isNull = false;
+
+                if (endOffset > m_size || endOffset < m_pos || !ReadString(node.name, nameLength)) {
+                    FBX_ERROR("Binary::Reader::ReadNode() : invalid node record!");
+                    return false;
+                }
+
+                const uint64_t propertiesEnd = m_pos + propertiesSize;
+                if (m_pos > endOffset || propertiesSize > endOffset - m_pos || propertiesCount > propertiesSize / MIN_PROPERTY_SIZE) {
+                    FBX_ERROR("Binary::Reader::ReadNode() : invalid properties size! Node: " + node.name);
+                    return false;
+                }
+
+                node.properties.resize(propertiesCount);
+                for (auto&& property : node.properties) {
+                    if (!ReadProperty(property, propertiesEnd)) {
+                        FBX_ERROR("Binary::Reader::ReadNode() : failed to read property! Node: " + node.name);
+                        return false;
+                    }
+                }
+
+                m_pos = propertiesEnd;
+
+                while (m_pos < endOffset) {
+                    Node child;
+                    bool childIsNull = false;
+
+                    if (!ReadNode(child, childIsNull, depth + 1)) {
+                        return false;
+                    }
+
+                    if (childIsNull) {
+                        break;
+                    }
+
+                    node.children.emplace_back(std::move(child));
+                }
+
+                m_pos = endOffset;
+
+                return true;
+            }
+
+        private:
+            template<typename T> T Read() {
+                T value = T();
+
+                if (m_pos + sizeof(T) > m_size) {
+                    m_error = true;
+                    return value;
+                }
+
+                memcpy(&value, m_data + m_pos, sizeof(T));
+                m_pos += sizeof(T);
+
+                return value;
+            }
+
+            bool ReadString(std::string& str, uint64_t length) {
+                if (m_pos + length > m_size) {
+                    return false;
+                }
+
+                str.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+                m_pos += length;
+
+                return true;
+            }
+
+            bool ReadBytes(std::vector<uint8_t>& bytes, uint64_t length, uint64_t end) {
+                if (length > end - m_pos) {
+                    return false;
+                }
+
+                bytes.assign(m_data + m_pos, m_data + m_pos + length);
+                m_pos += length;
+
+                return true;
+            }
+
+            /// end - конец свойств узла, ни одно свойство не может выйти за него
+            bool ReadProperty(Property& property, uint64_t end) {
+                property.type = static_cast<char>(Read<uint8_t>());
+
+                switch (property.type) {
+                    case 'Y': property.integer = Read<int16_t>(); break;
+                    case 'C': property.integer = Read<uint8_t>(); break;
+                    case 'I': property.integer = Read<int32_t>(); break;
+                    case 'L': property.integer = Read<int64_t>(); break;
+                    case 'F': property.real = Read<float>(); break;
+                    case 'D': property.real = Read<double>(); break;
+                    case 'S':
+                    case 'R': {
+                        const uint32_t length = Read<uint32_t>();
+                        if (m_error || m_pos > end || !ReadBytes(property.data, length, end)) {
+                            return false;
+                        }
+                        property.count = length;
+                        break;
+                    }
+                    case 'f': case 'd': case 'l': case 'i': case 'b':
+                        return ReadArray(property, end);
+                    default:
+                        FBX_ERROR("Binary::Reader::ReadProperty() : unknown property type! Type: " + std::to_string(property.type));
+                        return false;
+                }
+
+                return !m_error && m_pos <= end;
+            }
+
+            bool ReadArray(Property& property, uint64_t end) {
+                const uint32_t count = Read<uint32_t>();
+                const uint32_t encoding = Read<uint32_t>();
+                const uint32_t compressedSize = Read<uint32_t>();
+
+                if (m_error || m_pos > end || compressedSize > end - m_pos) {
+                    return false;
+                }
+
+                const uint64_t size = static_cast<uint64_t>(count) * GetArrayElementSize(property.type);
+
+                /// Размер проверяется до выделения памяти, иначе поврежденный счетчик запросит гигабайты
+                if ((encoding == 0 && size != compressedSize) || (encoding == 1 && size > compressedSize * MAX_DEFLATE_RATIO)) {
+                    FBX_ERROR("Binary::Reader::ReadArray() : array size does not match its data!");
+                    return false;
+                }
+
+                property.count = count;
+
+                if (encoding == 0) {
+                    property.data.resize(size);
+                    if (size > 0) {
+                        memcpy(property.data.data(), m_data + m_pos, size);
+                    }
+                }
+                else if (encoding == 1) {
+                    property.data.resize(size);
+                    if (!Tools::Inflate(m_data + m_pos, compressedSize, property.data.data(), size)) {
+                        FBX_ERROR("Binary::Reader::ReadArray() : failed to inflate array!");
+                        return false;
+                    }
+                }
+                else {
+                    FBX_ERROR("Binary::Reader::ReadArray() : unknown array encoding! Encoding: " + std::to_string(encoding));
+                    return false;
+                }
+
+                m_pos += compressedSize;
+
+                return true;
+            }
+
+        private:
+            const uint8_t* m_data = nullptr;
+            size_t m_size = 0;
+            size_t m_pos = 0;
+            uint32_t m_version = 0;
+            bool m_error = false;
+
+        };
+
+        template<typename T, typename U> std::vector<T> CastArray(const Property& property) {
+            std::vector<T> result(property.count);
+            const U* pData = reinterpret_cast<const U*>(property.data.data());
+            for (uint32_t i = 0; i < property.count; ++i) {
+                U value;
+                memcpy(&value, pData + i, sizeof(U));
+                result[i] = static_cast<T>(value);
+            }
+            return result;
+        }
+
+        template<typename T> std::vector<T> ConvertArray(const Property& property) {
+            switch (property.type) {
+                case 'f': return CastArray<T, float>(property);
+                case 'd': return CastArray<T, double>(property);
+                case 'i': return CastArray<T, int32_t>(property);
+                case 'l': return CastArray<T, int64_t>(property);
+                case 'b': return CastArray<T, uint8_t>(property);
+                default:
+                    FBX_ERROR("Binary::Property::ConvertArray() : property is not an array! Type: " + std::string(1, property.type));
+                    return {};
+            }
+        }
+    }
+
+    bool Property::IsArray() const {
+        return GetArrayElementSize(type) != 0;
+    }
+
+    int64_t Property::AsInt() const {
+        switch (type) {
+            case 'F': case 'D': return static_cast<int64_t>(real);
+            default:
+                return integer;
+        }
+    }
+
+    double Property::AsDouble() const {
+        switch (type) {
+            case 'F': case 'D': return real;
+            default:
+                return static_cast<double>(integer);
+        }
+    }
+
+    std::string Property::AsString() const {
+        std::string str(data.begin(), data.end());
+
+        if (auto&& separator = str.find(std::string("\x00\x01", 2)); separator != std::string::npos) {
+            return str.substr(separator + 2) + "::" + str.substr(0, separator);
+        }
+
+        return str;
+    }
+
+    std::vector<float_t> Property::AsFloats() const {
+        return ConvertArray<float_t>(*this);
+    }
+
+    std::vector<int32_t> Property::AsInt32s() const {
+        return ConvertArray<int32_t>(*this);
+    }
+
+    std::vector<uint32_t> Property::AsUInt32s() const {
+        return ConvertArray<uint32_t>(*this);
+    }
+
+    bool IsBinary(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        char magic[sizeof(MAGIC)] = { };
+        file.read(magic, sizeof(MAGIC));
+
+        return file.gcount() == sizeof(MAGIC) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    bool Parse(const std::string& path, Node& root, uint32_t& version) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            FBX_ERROR("Binary::Parse() : failed to open file! \n\tPath: " + path);
+            return false;
+        }
+
+        const auto size = static_cast<size_t>(file.tellg());
+        if (size < HEADER_SIZE) {
+            FBX_ERROR("Binary::Parse() : file is too small! \n\tPath: " + path);
+            return false;
+        }
+
+        std::vector<uint8_t> bytes(size);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size));
+
+        if (memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            FBX_ERROR("Binary::Parse() : file is not a binary fbx! \n\tPath: " + path);
+            return false;
+        }
+
+        memcpy(&version, bytes.data() + HEADER_SIZE - sizeof(uint32_t), sizeof(uint32_t));
+
+        root = Node();
+        root.name = "Fbx";
+
+        Reader reader(bytes.data(), bytes.size(), version);
+
+        while (!reader.IsEnd()) {
+            Node node;
+            bool isNull = false;
+
+            if (!reader.ReadNode(node, isNull, 0)) {
+                FBX_ERROR("Binary::Parse() : failed to parse file! \n\tPath: " + path);
+                return false;
+            }
+
+            /// После последнего узла верхнего уровня идет нулевая запись и служебный футер
+            if (isNull) {
+                break;
+            }
+
+            root.children.emplace_back(std::move(node));
+        }
+
+        return true;
+    }
+}
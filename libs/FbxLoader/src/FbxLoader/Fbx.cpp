@@ -26,6 +26,9 @@ void FbxLoader::RawGeometry::Save(std::ofstream &file) const {
     Tools::SaveComplexVector(file, vertices);
     Tools::SaveVector(file, indices);
     Tools::SaveVectorOfPairs(file, materials);
+    Tools::SaveComplexVector(file, meshlets);
+    Tools::SaveVector(file, meshletVertices);
+    Tools::SaveVector(file, meshletTriangles);
 }
 
 void FbxLoader::RawGeometry::Load(std::ifstream &file) {
@@ -35,6 +38,9 @@ void FbxLoader::RawGeometry::Load(std::ifstream &file) {
     vertices = Tools::LoadComplexVector<Vertex>(file);
     indices = Tools::LoadVector<uint32_t>(file);
     materials = Tools::LoadVectorOfPairs<uint32_t, uint32_t>(file);
+    meshlets = Tools::LoadComplexVector<Meshlet>(file);
+    meshletVertices = Tools::LoadVector<uint32_t>(file);
+    meshletTriangles = Tools::LoadVector<uint8_t>(file);
 }
 
 bool FbxLoader::RawGeometry::Valid() const {
@@ -0,0 +1,404 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <FbxLoader/Inflate.h>
+
+#include <cstring>
+
+namespace FbxLoader::Tools {
+    namespace {
+        constexpr int32_t MAX_BITS = 15;
+        constexpr int32_t MAX_LENGTH_CODES = 286;
+        constexpr int32_t MAX_DISTANCE_CODES = 30;
+        constexpr int32_t FIXED_LENGTH_CODES = 288;
+
+        struct Huffman {
+            int16_t count[MAX_BITS + 1] = { };
+            int16_t symbol[FIXED_LENGTH_CODES] = { };
+        };
+
+        class InflateState {
+        public:
+            InflateState(const uint8_t* pData, size_t size, uint8_t* pOut, size_t outSize)
+                : m_in(pData)
+                , m_inSize(size)
+                , m_out(pOut)
+                , m_outSize(outSize)
+            { }
+
+        public:
+            [[nodiscard]] size_t GetInPos() const { return m_inPos; }
+            [[nodiscard]] size_t GetOutPos() const { return m_outPos; }
+            [[nodiscard]] bool HasError() const { return m_error; }
+
+            uint32_t Bits(int32_t need) {
+                uint32_t value = m_bitBuffer;
+
+                while (m_bitCount < need) {
+                    if (m_inPos >= m_inSize) {
+                        m_error = true;
+                        return 0;
+                    }
+                    value |= static_cast<uint32_t>(m_in[m_inPos++]) << m_bitCount;
+                    m_bitCount += 8;
+                }
+
+                m_bitBuffer = value >> need;
+                m_bitCount -= need;
+
+                return value & ((1u << need) - 1u);
+            }
+
+            /// Остаток текущего байта отбрасывается, Bits никогда не держит больше 7 бит
+            void AlignToByte() {
+                m_bitBuffer = 0;
+                m_bitCount = 0;
+            }
+
+            bool Stored() {
+                AlignToByte();
+
+                if (m_inPos + 4 > m_inSize) {
+                    return false;
+                }
+
+                const uint32_t length = m_in[m_inPos] | (m_in[m_inPos + 1] << 8);
+                const uint32_t inverted = m_in[m_inPos + 2] | (m_in[m_inPos + 3] << 8);
+                m_inPos += 4;
+
+                if (length != (~inverted & 0xffffu) || m_inPos + length > m_inSize || m_outPos + length > m_outSize) {
+                    return false;
+                }
+
+                /// Пустой блок допустим, а выходного буфера у пустого массива может не быть
+                if (length > 0) {
+                    memcpy(m_out + m_outPos, m_in + m_inPos, length);
+                }
+
+                m_inPos += length;
+                m_outPos += length;
+
+                return true;
+            }
+
+            int32_t Decode(const Huffman& huffman) {
+                int32_t code = 0;
+                int32_t first = 0;
+                int32_t index = 0;
+
+                for (int32_t length = 1; length <= MAX_BITS; ++length) {
+                    code |= static_cast<int32_t>(Bits(1));
+                    const int32_t count = huffman.count[length];
+                    if (code - count < first) {
+                        return huffman.symbol[index + (code - first)];
+                    }
+                    index += count;
+                    first += count;
+                    first <<= 1;
+                    code <<= 1;
+                }
+
+                return -1;
+            }
+
+            bool Codes(const Huffman& lengthCode, const Huffman& distanceCode) {
+                static constexpr uint16_t lengthBase[29] = {
+                    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+                };
+                static constexpr uint8_t lengthExtra[29] = {
+                    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+                };
+                static constexpr uint16_t distanceBase[30] = {
+                    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+                };
+                static constexpr uint8_t distanceExtra[30] = {
+                    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+                };
+
+                while (true) {
+                    int32_t symbol = Decode(lengthCode);
+                    if (symbol < 0 || m_error) {
+                        return false;
+                    }
+
+                    if (symbol < 256) {
+                        if (m_outPos >= m_outSize) {
+                            return false;
+                        }
+                        m_out[m_outPos++] = static_cast<uint8_t>(symbol);
+                        continue;
+                    }
+
+                    if (symbol == 256) {
+                        return true;
+                    }
+
+                    symbol -= 257;
+                    if (symbol >= 29) {
+                        return false;
+                    }
+
+                    const size_t length = lengthBase[symbol] + Bits(lengthExtra[symbol]);
+
+                    symbol = Decode(distanceCode);
+                    if (symbol < 0 || symbol >= MAX_DISTANCE_CODES || m_error) {
+                        return false;
+                    }
+
+                    const size_t distance = distanceBase[symbol] + Bits(distanceExtra[symbol]);
+
+                    if (m_error || distance > m_outPos || m_outPos + length > m_outSize) {
+                        return false;
+                    }
+
+                    /// Области могут перекрываться (distance < length), поэтому копируем побайтово
+                    uint8_t* pDst = m_out + m_outPos;
+                    const uint8_t* pSrc = pDst - distance;
+                    for (size_t i = 0; i < length; ++i) {
+                        pDst[i] = pSrc[i];
+                    }
+                    m_outPos += length;
+                }
+            }
+
+            bool Fixed();
+            bool Dynamic();
+
+        private:
+            const uint8_t* m_in = nullptr;
+            size_t m_inSize = 0;
+            size_t m_inPos = 0;
+
+            uint8_t* m_out = nullptr;
+            size_t m_outSize = 0;
+            size_t m_outPos = 0;
+
+            uint32_t m_bitBuffer = 0;
+            int32_t m_bitCount = 0;
+
+            bool m_error = false;
+
+        };
+
+        /// Возвращает false для переполненного набора длин. Неполные наборы допустимы,
+        /// встретить недостающий код можно только в поврежденном потоке, и Decode его отклонит
+        bool Construct(Huffman& huffman, const int16_t* pLengths, int32_t count) {
+            memset(huffman.count, 0, sizeof(huffman.count));
+
+            for (int32_t symbol = 0; symbol < count; ++symbol) {
+                ++huffman.count[pLengths[symbol]];
+            }
+
+            if (huffman.count[0] == count) {
+                return true;
+            }
+
+            int32_t left = 1;
+            for (int32_t length = 1; length <= MAX_BITS; ++length) {
+                left <<= 1;
+                left -= huffman.count[length];
+                if (left < 0) {
+                    return false;
+                }
+            }
+
+            int16_t offsets[MAX_BITS + 1];
+            offsets[1] = 0;
+            for (int32_t length = 1; length < MAX_BITS; ++length) {
+                offsets[length + 1] = static_cast<int16_t>(offsets[length] + huffman.count[length]);
+            }
+
+            for (int32_t symbol = 0; symbol < count; ++symbol) {
+                if (pLengths[symbol] != 0) {
+                    huffman.symbol[offsets[pLengths[symbol]]++] = static_cast<int16_t>(symbol);
+                }
+            }
+
+            return true;
+        }
+
+        bool InflateState::Fixed() {
+            struct FixedTables {
+                FixedTables() {
+                    int16_t lengths[FIXED_LENGTH_CODES];
+                    int32_t symbol = 0;
+
+                    for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+                    for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+                    for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+                    for (; symbol < FIXED_LENGTH_CODES; ++symbol) lengths[symbol] = 8;
+                    Construct(lengthCode, lengths, FIXED_LENGTH_CODES);
+
+                    for (symbol = 0; symbol < MAX_DISTANCE_CODES; ++symbol) lengths[symbol] = 5;
+                    Construct(distanceCode, lengths, MAX_DISTANCE_CODES);
+                }
+
+                Huffman lengthCode;
+                Huffman distanceCode;
+            };
+
+            static const FixedTables tables;
+
+            return Codes(tables.lengthCode, tables.distanceCode);
+        }
+
+        bool InflateState::Dynamic() {
+            static constexpr uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+            const int32_t lengthsCount = static_cast<int32_t>(Bits(5)) + 257;
+            const int32_t distancesCount = static_cast<int32_t>(Bits(5)) + 1;
+            const int32_t codesCount = static_cast<int32_t>(Bits(4)) + 4;
+
+            if (m_error || lengthsCount > MAX_LENGTH_CODES || distancesCount > MAX_DISTANCE_CODES) {
+                return false;
+            }
+
+            int16_t lengths[MAX_LENGTH_CODES + MAX_DISTANCE_CODES] = { };
+
+            for (int32_t index = 0; index < codesCount; ++index) {
+                lengths[order[index]] = static_cast<int16_t>(Bits(3));
+            }
+
+            Huffman lengthCode;
+            Huffman distanceCode;
+
+            if (m_error || !Construct(lengthCode, lengths, 19)) {
+                return false;
+            }
+
+            int32_t index = 0;
+            while (index < lengthsCount + distancesCount) {
+                int32_t symbol = Decode(lengthCode);
+                if (symbol < 0 || m_error) {
+                    return false;
+                }
+
+                if (symbol < 16) {
+                    lengths[index++] = static_cast<int16_t>(symbol);
+                    continue;
+                }
+
+                int16_t length = 0;
+                if (symbol == 16) {
+                    if (index == 0) {
+                        return false;
+                    }
+                    length = lengths[index - 1];
+                    symbol = 3 + static_cast<int32_t>(Bits(2));
+                }
+                else if (symbol == 17) {
+                    symbol = 3 + static_cast<int32_t>(Bits(3));
+                }
+                else {
+                    symbol = 11 + static_cast<int32_t>(Bits(7));
+                }
+
+                if (m_error || index + symbol > lengthsCount + distancesCount) {
+                    return false;
+                }
+
+                while (symbol--) {
+                    lengths[index++] = length;
+                }
+            }
+
+            /// Без кода конца блока распаковка никогда не завершится
+            if (lengths[256] == 0) {
+                return false;
+            }
+
+            if (!Construct(lengthCode, lengths, lengthsCount)) {
+                return false;
+            }
+
+            if (!Construct(distanceCode, lengths + lengthsCount, distancesCount)) {
+                return false;
+            }
+
+            return Codes(lengthCode, distanceCode);
+        }
+
+        uint32_t Adler32(const uint8_t* pData, size_t size) {
+            constexpr uint32_t modulo = 65521;
+            /// Максимальное число байт, при котором сумма гарантированно не переполнит 32 бита
+            constexpr size_t block = 5552;
+
+            uint32_t a = 1;
+            uint32_t b = 0;
+
+            while (size > 0) {
+                const size_t count = size < block ? size : block;
+                for (size_t i = 0; i < count; ++i) {
+                    a += pData[i];
+                    b += a;
+                }
+                a %= modulo;
+                b %= modulo;
+                pData += count;
+                size -= count;
+            }
+
+            return (b << 16) | a;
+        }
+    }
+
+    bool Inflate(const uint8_t* pData, size_t size, uint8_t* pOut, size_t outSize) {
+        if (!pData || size < 6) {
+            return false;
+        }
+
+        const uint8_t cmf = pData[0];
+        const uint8_t flags = pData[1];
+
+        /// Метод сжатия deflate, контрольная сумма заголовка и отсутствие словаря
+        if ((cmf & 0x0f) != 8 || ((cmf << 8) | flags) % 31 != 0 || (flags & 0x20) != 0) {
+            return false;
+        }
+
+        InflateState state(pData + 2, size - 2, pOut, outSize);
+
+        bool last = false;
+        while (!last) {
+            last = state.Bits(1) != 0;
+            const uint32_t type = state.Bits(2);
+
+            if (state.HasError()) {
+                return false;
+            }
+
+            bool result = false;
+            switch (type) {
+                case 0: result = state.Stored(); break;
+                case 1: result = state.Fixed(); break;
+                case 2: result = state.Dynamic(); break;
+                default:
+                    break;
+            }
+
+            if (!result) {
+                return false;
+            }
+        }
+
+        if (state.GetOutPos() != outSize) {
+            return false;
+        }
+
+        state.AlignToByte();
+
+        const size_t adlerPos = 2 + state.GetInPos();
+        if (adlerPos + 4 > size) {
+            return false;
+        }
+
+        const uint32_t adler = (static_cast<uint32_t>(pData[adlerPos]) << 24) | (static_cast<uint32_t>(pData[adlerPos + 1]) << 16)
+            | (static_cast<uint32_t>(pData[adlerPos + 2]) << 8) | static_cast<uint32_t>(pData[adlerPos + 3]);
+
+        return adler == Adler32(pOut, outSize);
+    }
+}
@@ -10,7 +10,6 @@
 #include <inc/tiny_obj_loader.h>
 
 FbxLoader::RawFbx FbxLoader::Loader::Load(
-    const std::string& converter,
     const std::string& cache,
     const std::string& models,
     const std::string& path,
@@ -22,40 +21,33 @@ FbxLoader::RawFbx FbxLoader::Loader::Load(
     const std::string name      = Tools::BackReadTo(path, '/', 1);
     const std::string ext       = Tools::BackReadTo(name, '.', 1);
     const std::string dir       = Tools::ReadToLast(path, '/', 1);
-    const std::string ascii     = Tools::FixPath(cache + "/fbx_ascii/" + dir);
+    const std::string cacheDir  = Tools::FixPath(cache + "/fbx_cache/" + dir);
     const std::string model     = models + "/" + path;
-    const std::string hashPath  = ascii + name + ".hash";
-    const std::string cacheFile = ascii + name + ".cache";
+    const std::string hashPath  = cacheDir + name + ".hash";
+    const std::string cacheFile = cacheDir + name + ".cache";
 
     if (!Tools::FileExists(model)) {
         FBX_ERROR("Loader::Load() : file not exists! Path: " + model);
         return {};
     }
 
-    const std::string hash = Tools::GetHash(model);
+    const std::string hash = Tools::GetHash(model) + "-" + std::to_string(CACHE_VERSION);
 
     if (Tools::FileExists(cacheFile) && Tools::LoadHash(hashPath) == hash) {
         RawFbx fbx;
         fbx.LoadFrom(cacheFile);
         return fbx;
     }
-    else {
-        Tools::CreatePath(ascii);
-        if (ext == "fbx") {
-            /// TODO: make cross-platform
-            const std::string args = converter + " -c " + model + " -o " + ascii + name + " -ascii";
-            system(args.c_str());
-
-            if (!Tools::FileExists(ascii + name)) {
-                FBX_ERROR("Loader::Load() : failed to convert binary to ascii!");
-                return {};
-            }
-        }
-        Tools::SaveHash(hashPath, hash);
-    }
+
+    Tools::CreatePath(cacheDir);
+    Tools::SaveHash(hashPath, hash);
 
     if (ext == "fbx") {
-        return LoadFbx(ascii + name, cacheFile, optimizeGeometry);
+        /// Бинарный FBX читается напрямую, текстовый - старым парсером
+        if (Binary::IsBinary(model)) {
+            return LoadBinaryFbx(model, cacheFile, optimizeGeometry);
+        }
+        return LoadFbx(model, cacheFile, optimizeGeometry);
     }
     else if (ext == "obj") {
         return LoadObj(model, cacheFile, optimizeGeometry);
@@ -147,9 +139,14 @@ bool FbxLoader::Loader::OptimizeGeometry(FbxLoader::RawGeometry *geometry) {
     return true;
 }
 
-std::vector<FbxLoader::MaterialRange> FbxLoader::Loader::GetMaterialRanges(FbxLoader::Parser::Node *object) {
-    std::vector<MaterialRange> materials;
+bool FbxLoader::Loader::BuildMeshlets(FbxLoader::RawGeometry *geometry) {
+    if (!geometry)
+        return false;
+
+    return FbxLoader::BuildMeshlets(geometry->vertices, geometry->indices, geometry->meshlets, geometry->meshletVertices, geometry->meshletTriangles);
+}
 
+std::vector<FbxLoader::MaterialRange> FbxLoader::Loader::GetMaterialRanges(FbxLoader::Parser::Node *object) {
     auto materials_node = [object]() -> Parser::Node* {
         if (auto v = object->Find("LayerElementMaterial"); v) return v->Find("Materials")->Get2SubNode(); return nullptr;
     }();
@@ -157,15 +154,22 @@ std::vector<FbxLoader::MaterialRange> FbxLoader::Loader::GetMaterialRanges(FbxLo
     if (!materials_node)
         return {};
 
-    std::istringstream ss(materials_node->value);
-    std::string value;
+    return MakeMaterialRanges(Tools::SplitAndCastToInt32(materials_node->value, ','));
+}
+
+std::vector<FbxLoader::MaterialRange> FbxLoader::Loader::MakeMaterialRanges(const std::vector<int32_t>& ids) {
+    std::vector<MaterialRange> materials;
+
+    if (ids.empty())
+        return materials;
+
     MaterialRange material;
 
     uint32_t last = 0;
     uint32_t counter = 0;
     uint32_t counterPrev = 0;
-    while (getline(ss, value, ',')) {
-        auto id = static_cast<uint32_t>(std::stoi(value));
+    for (auto&& value : ids) {
+        auto id = static_cast<uint32_t>(value);
 
         if (id != last) {
             last = id;
@@ -236,6 +240,25 @@ std::vector<FbxLoader::RawGeometry> FbxLoader::Loader::SplitByMaterials(RawGeome
     return geometries;
 }
 
+void FbxLoader::Loader::PrepareGeometries(RawFbx& fbx, bool needOptimize) {
+    if (needOptimize)
+        for (auto& geometry : fbx.objects.geometries)
+            if (!OptimizeGeometry(&geometry))
+                FBX_ERROR("FbxLoader::Load() : failed to optimize \"" + geometry.name + "\" geometry!");
+
+    if (!fbx.objects.geometries.empty()) {
+        auto source = std::exchange(fbx.objects.geometries, {});
+        for (auto&& src : source) {
+            for (auto &&geometry : SplitByMaterials(std::move(src)))
+                fbx.objects.geometries.emplace_back(std::move(geometry));
+        }
+    }
+
+    for (auto& geometry : fbx.objects.geometries)
+        if (!BuildMeshlets(&geometry))
+            FBX_ERROR("FbxLoader::Load() : failed to build meshlets for \"" + geometry.name + "\" geometry!");
+}
+
 FbxLoader::RawFbx FbxLoader::Loader::LoadFbx(const std::string &ascii, const std::string &cache, bool needOptimize) {
     if (auto text = Tools::ReadAllText(ascii); text.empty()) {
         FBX_ERROR("FbxLoader::Load() : failed to read file! \n\tPath: " + ascii);
@@ -250,21 +273,10 @@ FbxLoader::RawFbx FbxLoader::Loader::LoadFbx(const std::string &ascii, const std
             return {};
         }
 
-        if (needOptimize)
-            for (auto& geometry : fbx.objects.geometries)
-                if (!OptimizeGeometry(&geometry))
-                    FBX_ERROR("FbxLoader::Load() : failed to optimize \"" + geometry.name + "\" geometry!");
-
-        if (!fbx.objects.geometries.empty()) {
-            auto source = std::exchange(fbx.objects.geometries, {});
-            for (auto&& src : source) {
-                for (auto &&geometry : SplitByMaterials(std::move(src)))
-                    fbx.objects.geometries.emplace_back(std::move(geometry));
-            }
-        }
-
         delete nodes;
 
+        PrepareGeometries(fbx, needOptimize);
+
         fbx.SaveTo(cache);
 
         return fbx;
@@ -275,6 +287,29 @@ FbxLoader::RawFbx FbxLoader::Loader::LoadFbx(const std::string &ascii, const std
     }
 }
 
+FbxLoader::RawFbx FbxLoader::Loader::LoadBinaryFbx(const std::string &path, const std::string &cache, bool needOptimize) {
+    Binary::Node root;
+    uint32_t version = 0;
+
+    if (!Binary::Parse(path, root, version)) {
+        FBX_ERROR("FbxLoader::LoadBinaryFbx() : failed to parse file! \n\tPath: " + path);
+        return {};
+    }
+
+    RawFbx fbx = {};
+
+    if (fbx.objects = GetObjects(root); !fbx.objects.Ready()) {
+        FBX_ERROR("FbxLoader::LoadBinaryFbx() : failed to get objects! Version: " + std::to_string(version));
+        return {};
+    }
+
+    PrepareGeometries(fbx, needOptimize);
+
+    fbx.SaveTo(cache);
+
+    return fbx;
+}
+
 FbxLoader::RawFbx FbxLoader::Loader::LoadObj(const std::string &path, const std::string &cache, bool needOptimize) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
@@ -339,6 +374,9 @@ FbxLoader::RawFbx FbxLoader::Loader::LoadObj(const std::string &path, const std:
             geometry.indices.push_back(uniqueVertices[vertex]);
         }
 
+        if (!BuildMeshlets(&geometry))
+            FBX_ERROR("Loader::LoadObj() : failed to build meshlets for \"" + geometry.name + "\" geometry!");
+
         fbx.objects.geometries.emplace_back(std::move(geometry));
     }
 
@@ -436,6 +474,153 @@ FbxLoader::RawModel FbxLoader::Loader::ParseModel(FbxLoader::Parser::Node *node)
     return model;
 }
 
+FbxLoader::Objects FbxLoader::Loader::GetObjects(const Binary::Node& node) {
+    auto&& pObjects = node.Find("Objects");
+    if (!pObjects)
+        return {};
+
+    Objects objects = {};
+
+    for (auto&& object : pObjects->children) {
+        if (object.name == "Geometry") {
+            if (auto geometry = ParseGeometry(object); geometry.Valid())
+                objects.geometries.emplace_back(std::move(geometry));
+        }
+        else if (object.name == "Model") {
+            if (auto model = ParseModel(object); model.Valid())
+                objects.models.emplace_back(std::move(model));
+        }
+    }
+
+    return objects;
+}
+
+std::vector<FbxLoader::Vertex> FbxLoader::Loader::GetVertices(const Binary::Node& object, const std::vector<uint32_t>& indices) {
+    const auto getLayerArray = [&object](const char* layer, const char* array) -> const Binary::Property* {
+        if (auto&& pLayer = object.Find(layer); pLayer) return pLayer->FindProperty(array); return nullptr;
+    };
+
+    auto&& pVertices  = object.FindProperty("Vertices");
+    auto&& pNormals   = getLayerArray("LayerElementNormal", "Normals");
+    auto&& pBinormals = getLayerArray("LayerElementBinormal", "Binormals");
+    auto&& pTangents  = getLayerArray("LayerElementTangent", "Tangents");
+    auto&& pUVs       = getLayerArray("LayerElementUV", "UV");
+    auto&& pUVIndices = getLayerArray("LayerElementUV", "UVIndex");
+
+    return MakeVertices(
+            indices,
+            pVertices  ? pVertices->AsFloats()   : std::vector<float_t>(),
+            pNormals   ? pNormals->AsFloats()    : std::vector<float_t>(),
+            pBinormals ? pBinormals->AsFloats()  : std::vector<float_t>(),
+            pTangents  ? pTangents->AsFloats()   : std::vector<float_t>(),
+            pUVs       ? pUVs->AsFloats()        : std::vector<float_t>(),
+            pUVIndices ? pUVIndices->AsUInt32s() : std::vector<uint32_t>()
+    );
+}
+
+std::vector<FbxLoader::MaterialRange> FbxLoader::Loader::GetMaterialRanges(const Binary::Node& object) {
+    if (auto&& pLayer = object.Find("LayerElementMaterial"); pLayer) {
+        if (auto&& pMaterials = pLayer->FindProperty("Materials"); pMaterials) {
+            return MakeMaterialRanges(pMaterials->AsInt32s());
+        }
+    }
+
+    return {};
+}
+
+FbxLoader::RawGeometry FbxLoader::Loader::ParseGeometry(const Binary::Node& node) {
+    if (node.properties.size() != 3) {
+        FBX_ERROR("FbxLoader::ParseGeometry() : failed to get geometry info!");
+        return {};
+    }
+
+    RawGeometry geometry = { };
+    geometry.id = static_cast<uint64_t>(node.properties[0].AsInt());
+    geometry.name = node.properties[1].AsString();
+    geometry.type = node.properties[2].AsString();
+
+    if (geometry.type == "Shape") {
+        FBX_WARN("FbxLoader::ParseGeometry() : shape \"" + geometry.name + "\" ignored.")
+        return RawGeometry();
+    }
+
+    if (auto&& pIndices = node.FindProperty("PolygonVertexIndex"); pIndices) {
+        geometry.indices = FixIndices(pIndices->AsInt32s());
+        if (geometry.indices.empty()) {
+            FBX_ERROR("FbxLoader::ParseGeometry() : failed to parse indices!");
+            return {};
+        }
+
+        if (geometry.vertices = GetVertices(node, geometry.indices); geometry.vertices.empty()) {
+            FBX_ERROR("FbxLoader::ParseGeometry() : failed parse vertices!");
+            return {};
+        }
+
+        geometry.materials = GetMaterialRanges(node);
+    }
+
+    if (geometry.vertices.empty()) {
+        FBX_WARN("FbxLoader::ParseGeometry() : geometry \"" + geometry.name + "\" have not vertices!");
+    }
+
+    if (geometry.indices.empty()) {
+        FBX_WARN("FbxLoader::ParseGeometry() : geometry \"" + geometry.name + "\" have not indices!");
+    }
+
+    return geometry;
+}
+
+FbxLoader::RawModel FbxLoader::Loader::ParseModel(const Binary::Node& node) {
+    FbxLoader::RawModel model;
+
+    int64_t version = INT32_MAX;
+
+    if (auto&& pVersion = node.FindProperty("Version"); pVersion) {
+        version = pVersion->AsInt();
+    }
+    else {
+        FBX_ERROR("Loader::ParseModel() : model have not version!");
+        return {};
+    }
+
+    if (version != 232) {
+        FBX_ERROR("Loader::ParseModel() : unsupported model version! Version: " + std::to_string(version));
+        return {};
+    }
+
+    auto&& pProperties = node.Find("Properties70");
+    if (!pProperties) {
+        FBX_ERROR("Loader::ParseModel() : model have not \"Properties70\" node!");
+        return model;
+    }
+
+    for (auto&& property : pProperties->children) {
+        /// P: "Name", "Type", "Label", "Flags", x, y, z
+        if (property.properties.size() < 7 || !property.properties[0].IsString())
+            continue;
+
+        const std::string name = property.properties[0].AsString();
+
+        const auto value = vec3(
+            static_cast<float_t>(property.properties[4].AsDouble()),
+            static_cast<float_t>(property.properties[5].AsDouble()),
+            static_cast<float_t>(property.properties[6].AsDouble())
+        );
+
+        if (name == "Lcl Translation") {
+            model.Translation = value;
+        }
+        else if (name == "Lcl Rotation") {
+            model.Rotation = value;
+        }
+        else if (name == "Lcl Scaling") {
+            model.Scale = value;
+        }
+    }
+
+    return model;
+}
+
 FbxLoader::NodeAttribute FbxLoader::Loader::ParseNodeAttribute(FbxLoader::Parser::Node *node) {
     return FbxLoader::NodeAttribute();
 }
@@ -0,0 +1,286 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <FbxLoader/Meshlet.h>
+#include <FbxLoader/Utils.h>
+
+#include <limits>
+
+namespace FbxLoader {
+    namespace {
+        constexpr uint8_t INVALID_LOCAL_INDEX = 0xff;
+        constexpr uint32_t INVALID_TRIANGLE = std::numeric_limits<uint32_t>::max();
+        /// При большем раскрытии конуса отсечение почти ничего не дает
+        constexpr float_t MIN_CONE_DOT = 0.1f;
+
+        vec3 Sub(const vec3& a, const vec3& b) { return vec3(a.x - b.x, a.y - b.y, a.z - b.z); }
+        vec3 Add(const vec3& a, const vec3& b) { return vec3(a.x + b.x, a.y + b.y, a.z + b.z); }
+        vec3 Mul(const vec3& a, float_t s) { return vec3(a.x * s, a.y * s, a.z * s); }
+        float_t Dot(const vec3& a, const vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        float_t Length(const vec3& a) { return std::sqrt(Dot(a, a)); }
+
+        vec3 Cross(const vec3& a, const vec3& b) {
+            return vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+        }
+
+        void ComputeBounds(
+                Meshlet& meshlet,
+                const std::vector<Vertex>& vertices,
+                const std::vector<uint32_t>& meshletVertices,
+                const std::vector<uint8_t>& meshletTriangles)
+        {
+            const uint32_t* pVertices = meshletVertices.data() + meshlet.vertexOffset;
+            const uint8_t* pTriangles = meshletTriangles.data() + meshlet.triangleOffset * 3;
+
+            vec3 min = vertices[pVertices[0]].pos;
+            vec3 max = min;
+
+            for (uint32_t i = 1; i < meshlet.vertexCount; ++i) {
+                const vec3& pos = vertices[pVertices[i]].pos;
+                min = vec3(std::min(min.x, pos.x), std::min(min.y, pos.y), std::min(min.z, pos.z));
+                max = vec3(std::max(max.x, pos.x), std::max(max.y, pos.y), std::max(max.z, pos.z));
+            }
+
+            meshlet.center = Mul(Add(min, max), 0.5f);
+            meshlet.radius = 0.f;
+
+            for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+                meshlet.radius = std::max(meshlet.radius, Length(Sub(vertices[pVertices[i]].pos, meshlet.center)));
+            }
+
+            /// Нормали и центры треугольников нужны дважды: для оси конуса и для его вершины
+            std::vector<std::pair<vec3, vec3>> triangles;
+            triangles.reserve(meshlet.triangleCount);
+
+            vec3 axis;
+
+            for (uint32_t i = 0; i < meshlet.triangleCount; ++i) {
+                const vec3& a = vertices[pVertices[pTriangles[i * 3 + 0]]].pos;
+                const vec3& b = vertices[pVertices[pTriangles[i * 3 + 1]]].pos;
+                const vec3& c = vertices[pVertices[pTriangles[i * 3 + 2]]].pos;
+
+                const vec3 normal = Cross(Sub(b, a), Sub(c, a));
+                const float_t area = Length(normal);
+
+                if (area <= std::numeric_limits<float_t>::epsilon())
+                    continue;
+
+                const vec3 unit = Mul(normal, 1.f / area);
+                triangles.emplace_back(unit, Mul(Add(Add(a, b), c), 1.f / 3.f));
+                axis = Add(axis, unit);
+            }
+
+            meshlet.coneApex = meshlet.center;
+            meshlet.coneAxis = vec3();
+            meshlet.coneCutoff = 1.f;
+
+            const float_t axisLength = Length(axis);
+            if (triangles.empty() || axisLength <= std::numeric_limits<float_t>::epsilon())
+                return;
+
+            axis = Mul(axis, 1.f / axisLength);
+            meshlet.coneAxis = axis;
+
+            float_t minDot = 1.f;
+            for (auto&& [normal, centroid] : triangles)
+                minDot = std::min(minDot, Dot(normal, axis));
+
+            if (minDot <= MIN_CONE_DOT)
+                return;
+
+            /// Вершину конуса сдвигаем назад вдоль оси так, чтобы она лежала
+            /// позади плоскостей всех треугольников кластера
+            float_t maxT = 0.f;
+            for (auto&& [normal, centroid] : triangles)
+                maxT = std::max(maxT, Dot(Sub(meshlet.center, centroid), normal) / Dot(axis, normal));
+
+            meshlet.coneApex = Sub(meshlet.center, Mul(axis, maxT));
+            meshlet.coneCutoff = std::sqrt(1.f - minDot * minDot);
+        }
+    }
+
+    void Meshlet::Save(std::ofstream& file) const {
+        Tools::SaveValue(file, vertexOffset);
+        Tools::SaveValue(file, vertexCount);
+        Tools::SaveValue(file, triangleOffset);
+        Tools::SaveValue(file, triangleCount);
+        center.Save(file);
+        Tools::SaveValue(file, radius);
+        coneApex.Save(file);
+        coneAxis.Save(file);
+        Tools::SaveValue(file, coneCutoff);
+    }
+
+    void Meshlet::Load(std::ifstream& file) {
+        vertexOffset = Tools::LoadValue<uint32_t>(file);
+        vertexCount = Tools::LoadValue<uint32_t>(file);
+        triangleOffset = Tools::LoadValue<uint32_t>(file);
+        triangleCount = Tools::LoadValue<uint32_t>(file);
+        center.Load(file);
+        radius = Tools::LoadValue<float_t>(file);
+        coneApex.Load(file);
+        coneAxis.Load(file);
+        coneCutoff = Tools::LoadValue<float_t>(file);
+    }
+
+    bool BuildMeshlets(
+            const std::vector<Vertex>& vertices,
+            const std::vector<uint32_t>& indices,
+            std::vector<Meshlet>& meshlets,
+            std::vector<uint32_t>& meshletVertices,
+            std::vector<uint8_t>& meshletTriangles)
+    {
+        meshlets.clear();
+        meshletVertices.clear();
+        meshletTriangles.clear();
+
+        if (indices.size() % 3 != 0) {
+            FBX_ERROR("FbxLoader::BuildMeshlets() : indices count is not a multiple of 3!");
+            return false;
+        }
+
+        for (auto&& index : indices) {
+            if (index >= vertices.size()) {
+                FBX_ERROR("FbxLoader::BuildMeshlets() : index out of range!");
+                return false;
+            }
+        }
+
+        const auto trianglesCount = static_cast<uint32_t>(indices.size() / 3);
+        const auto verticesCount = static_cast<uint32_t>(vertices.size());
+
+        /// Смежность вершина -> треугольники в виде сжатых строк
+        std::vector<uint32_t> adjacencyOffsets(verticesCount + 1, 0);
+        std::vector<uint32_t> adjacency(indices.size());
+        /// Сколько еще не распределенных треугольников использует вершину
+        std::vector<uint32_t> liveTriangles(verticesCount, 0);
+
+        for (auto&& index : indices)
+            ++adjacencyOffsets[index + 1];
+
+        for (uint32_t i = 0; i < verticesCount; ++i) {
+            liveTriangles[i] = adjacencyOffsets[i + 1];
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        }
+
+        {
+            std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (uint32_t triangle = 0; triangle < trianglesCount; ++triangle)
+                for (uint32_t k = 0; k < 3; ++k)
+                    adjacency[cursor[indices[triangle * 3 + k]]++] = triangle;
+        }
+
+        std::vector<bool> emitted(trianglesCount, false);
+        std::vector<uint8_t> local(verticesCount, INVALID_LOCAL_INDEX);
+
+        const auto countNewVertices = [&local](const uint32_t* pTriangle) -> uint32_t {
+            uint32_t count = 0;
+            for (uint32_t k = 0; k < 3; ++k)
+                count += local[pTriangle[k]] == INVALID_LOCAL_INDEX ? 1 : 0;
+            return count;
+        };
+
+        const auto releaseTriangle = [&](uint32_t triangle) {
+            emitted[triangle] = true;
+            for (uint32_t k = 0; k < 3; ++k)
+                --liveTriangles[indices[triangle * 3 + k]];
+        };
+
+        Meshlet current;
+
+        const auto flush = [&]() {
+            if (current.triangleCount == 0)
+                return;
+
+            ComputeBounds(current, vertices, meshletVertices, meshletTriangles);
+
+            for (uint32_t i = 0; i < current.vertexCount; ++i)
+                local[meshletVertices[current.vertexOffset + i]] = INVALID_LOCAL_INDEX;
+
+            meshlets.emplace_back(current);
+
+            current = Meshlet();
+            current.vertexOffset = static_cast<uint32_t>(meshletVertices.size());
+            current.triangleOffset = static_cast<uint32_t>(meshletTriangles.size() / 3);
+        };
+
+        /// Лучший смежный с текущим кластером треугольник: меньше новых вершин,
+        /// при равенстве - тот, чьи вершины раньше остальных останутся без треугольников
+        const auto findAdjacent = [&]() -> uint32_t {
+            uint32_t best = INVALID_TRIANGLE;
+            uint32_t bestNew = std::numeric_limits<uint32_t>::max();
+            uint32_t bestLive = std::numeric_limits<uint32_t>::max();
+
+            for (uint32_t i = 0; i < current.vertexCount; ++i) {
+                const uint32_t vertex = meshletVertices[current.vertexOffset + i];
+
+                for (uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j) {
+                    const uint32_t triangle = adjacency[j];
+                    if (emitted[triangle])
+                        continue;
+
+                    const uint32_t* pTriangle = indices.data() + triangle * 3;
+                    const uint32_t newVertices = countNewVertices(pTriangle);
+                    const uint32_t live = liveTriangles[pTriangle[0]] + liveTriangles[pTriangle[1]] + liveTriangles[pTriangle[2]];
+
+                    if (newVertices < bestNew || (newVertices == bestNew && live < bestLive)) {
+                        best = triangle;
+                        bestNew = newVertices;
+                        bestLive = live;
+                    }
+                }
+
+                if (bestNew == 0)
+                    break;
+            }
+
+            return best;
+        };
+
+        uint32_t seed = 0;
+        uint32_t remaining = trianglesCount;
+
+        while (remaining > 0) {
+            uint32_t triangle = findAdjacent();
+
+            if (triangle == INVALID_TRIANGLE) {
+                while (emitted[seed])
+                    ++seed;
+                triangle = seed;
+            }
+
+            const uint32_t* pTriangle = indices.data() + triangle * 3;
+
+            --remaining;
+
+            /// Вырожденные треугольники ничего не рисуют, в кластеры их не кладем
+            if (pTriangle[0] == pTriangle[1] || pTriangle[1] == pTriangle[2] || pTriangle[0] == pTriangle[2]) {
+                releaseTriangle(triangle);
+                continue;
+            }
+
+            if (current.vertexCount + countNewVertices(pTriangle) > MESHLET_MAX_VERTICES || current.triangleCount + 1 > MESHLET_MAX_TRIANGLES)
+                flush();
+
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint8_t& localIndex = local[pTriangle[k]];
+
+                if (localIndex == INVALID_LOCAL_INDEX) {
+                    localIndex = static_cast<uint8_t>(current.vertexCount++);
+                    meshletVertices.emplace_back(pTriangle[k]);
+                }
+
+                meshletTriangles.emplace_back(localIndex);
+            }
+
+            ++current.triangleCount;
+
+            releaseTriangle(triangle);
+        }
+
+        flush();
+
+        return true;
+    }
+}
@@ -6,77 +6,158 @@
 
 namespace SR_ANIMATIONS_NS {
     AnimationChannel::~AnimationChannel() {
-        m_keys.clear();
+        m_times.clear();
+        m_translations.clear();
+        m_rotations.clear();
+        m_scales.clear();
     }
 
-    uint32_t AnimationChannel::UpdateChannelWithWeight(uint32_t keyIndex, float_t time,  UpdateContext& context, ChannelUpdateContext& channelContext) const {
-        AnimationGameObjectData& data = context.pPose->GetGameObjectData(channelContext.gameObjectIndex.value());
-        const auto keysCount = static_cast<uint32_t>(m_keys.size());
-        const UnionAnimationKey* pData = m_keys.data();
+    static SR_MATH_NS::FVector3 InterpolateKey(const SR_MATH_NS::FVector3& from, const SR_MATH_NS::FVector3& to, float_t progress) {
+        return from.Lerp(to, progress);
+    }
 
-        while (keyIndex < keysCount && time > pData[keyIndex].time) SR_UNLIKELY_ATTRIBUTE {
-            if (context.fpsCompensation) SR_UNLIKELY_ATTRIBUTE {
-                pData[keyIndex].SetWithWeight(data, context.weight);
-            }
+    static SR_MATH_NS::Quaternion InterpolateKey(const SR_MATH_NS::Quaternion& from, const SR_MATH_NS::Quaternion& to, float_t progress) {
+        return from.Slerp(to, progress);
+    }
 
-            keyIndex += context.frameRate;
+    bool AnimationChannel::SetKeyType(AnimationKeyType type) {
+        if (m_type != AnimationKeyType::None && m_type != type) SR_UNLIKELY_ATTRIBUTE {
+            SRHalt("AnimationChannel::SetKeyType() : channel can't contain keys of different types!");
+            return false;
         }
 
-        const uint32_t workingKeyIndex = SR_MIN(keyIndex, keysCount - 1);
-        auto&& key = pData[workingKeyIndex];
+        m_type = type;
+        return true;
+    }
 
-        if (workingKeyIndex == 0) SR_UNLIKELY_ATTRIBUTE {
-            key.SetWithWeight(data, context.weight);
+    template<typename T> std::optional<T>& AnimationChannel::GetTarget(AnimationGameObjectData& data) const noexcept {
+        if constexpr (std::is_same_v<T, SR_MATH_NS::Quaternion>) {
+            return data.rotation;
+        }
+        else {
+            return m_type == AnimationKeyType::Translation ? data.translation : data.scaling;
+        }
+    }
+
+    template<bool Weighted, typename T> void AnimationChannel::SetKey(const T& value, AnimationGameObjectData& data, const UpdateContext& context) const {
+        auto&& target = GetTarget<T>(data);
+
+        if constexpr (Weighted) {
+            if (!target.has_value()) SR_UNLIKELY_ATTRIBUTE {
+                target = value;
+                return;
+            }
+            target = InterpolateKey(target.value(), value, context.weight);
         }
         else {
-            auto&& prevKey = pData[workingKeyIndex - 1];
+            if (context.tolerance != 0.f && target.has_value() && target.value().IsEquals(value, context.tolerance)) SR_UNLIKELY_ATTRIBUTE {
+                return;
+            }
+            target = value;
+            data.dirty = true;
+        }
+    }
 
-            const float_t currentTime = time - prevKey.time;
-            const float_t keyCurrTime = key.time - prevKey.time;
-            const float_t progress = currentTime / keyCurrTime;
+    template<bool Weighted, typename T> void AnimationChannel::UpdateKey(const T& prevValue, const T& value, float_t progress, AnimationGameObjectData& data, const UpdateContext& context) const {
+        auto&& target = GetTarget<T>(data);
 
-            key.UpdateWithWeight(progress, prevKey, data, context.weight);
+        if constexpr (Weighted) {
+            if (!target.has_value()) SR_UNLIKELY_ATTRIBUTE {
+                target = InterpolateKey(prevValue, value, progress);
+            }
+            else {
+                target = InterpolateKey(target.value(), InterpolateKey(prevValue, value, progress), context.weight);
+            }
+        }
+        else {
+            if (context.tolerance != 0.f && prevValue.IsEquals(value, context.tolerance)) SR_UNLIKELY_ATTRIBUTE {
+                return;
+            }
+            target = InterpolateKey(prevValue, value, progress);
         }
 
-        return keyIndex;
+        data.dirty = true;
     }
 
-    uint32_t AnimationChannel::UpdateChannel(uint32_t keyIndex, float_t time, UpdateContext& context, ChannelUpdateContext& channelContext) const {
-        if (!channelContext.gameObjectIndex) SR_UNLIKELY_ATTRIBUTE {
+    template<bool Weighted, typename T> uint32_t AnimationChannel::UpdateStream(
+        const std::vector<T>& values, uint32_t keyIndex, float_t time, UpdateContext& context, AnimationGameObjectData& data
+    ) const {
+        const auto keysCount = static_cast<uint32_t>(m_times.size());
+        if (keysCount == 0) SR_UNLIKELY_ATTRIBUTE {
             return keyIndex;
         }
 
-        AnimationGameObjectData& data = context.pPose->GetGameObjectData(channelContext.gameObjectIndex.value());
-        const auto keysCount = static_cast<uint32_t>(m_keys.size());
-        const UnionAnimationKey* pData = m_keys.data();
+        const float_t* pTimes = m_times.data();
 
-        while (keyIndex < keysCount && time > pData[keyIndex].time) {
-            if (context.fpsCompensation) SR_UNLIKELY_ATTRIBUTE {
-                pData[keyIndex].Set(data, context.tolerance);
-            }
+        /// Курсор указывает на первый ключ не раньше прошлого времени. Если время ушло назад (сброс, перемотка)
+        /// или убежало далеко вперед, то шагать по ключам дорого - ищем бинарным поиском.
+        /// При компенсации FPS пропущенные вперед ключи нужно применить, поэтому там всегда идем шагами
+        const uint32_t cursor = SR_MIN(keyIndex, keysCount);
+        const bool isBehind = cursor > 0 && time <= pTimes[cursor - 1];
+        const bool isFarAhead = cursor + SEEK_KEYS_THRESHOLD < keysCount && time > pTimes[cursor + SEEK_KEYS_THRESHOLD];
 
-            keyIndex += context.frameRate;
+        if (isBehind || (isFarAhead && !context.fpsCompensation)) SR_UNLIKELY_ATTRIBUTE {
+            keyIndex = static_cast<uint32_t>(std::lower_bound(pTimes, pTimes + keysCount, time) - pTimes);
+        }
+        else {
+            while (keyIndex < keysCount && time > pTimes[keyIndex]) {
+                if (context.fpsCompensation) SR_UNLIKELY_ATTRIBUTE {
+                    SetKey<Weighted>(values[keyIndex], data, context);
+                }
+
+                keyIndex += context.frameRate;
+            }
         }
 
         const uint32_t workingKeyIndex = SR_MIN(keyIndex, keysCount - 1);
-        auto&& key = pData[workingKeyIndex];
 
         if (workingKeyIndex == 0) SR_UNLIKELY_ATTRIBUTE {
-            key.Set(data, context.tolerance);
+            SetKey<Weighted>(values[0], data, context);
         }
         else {
-            auto&& prevKey = pData[workingKeyIndex - 1];
-
-            const float_t currentTime = time - prevKey.time;
-            const float_t keyCurrTime = key.time - prevKey.time;
-            const float_t progress = currentTime / keyCurrTime;
+            const float_t prevTime = pTimes[workingKeyIndex - 1];
+            const float_t progress = (time - prevTime) / (pTimes[workingKeyIndex] - prevTime);
 
-            key.Update(progress, prevKey, data, context.tolerance);
+            UpdateKey<Weighted>(values[workingKeyIndex - 1], values[workingKeyIndex], progress, data, context);
         }
 
         return keyIndex;
     }
 
+    uint32_t AnimationChannel::UpdateChannelWithWeight(uint32_t keyIndex, float_t time, UpdateContext& context, ChannelUpdateContext& channelContext) const {
+        if (!channelContext.gameObjectIndex) SR_UNLIKELY_ATTRIBUTE {
+            return keyIndex;
+        }
+
+        AnimationGameObjectData& data = context.pPose->GetGameObjectData(channelContext.gameObjectIndex.value());
+
+        switch (m_type) {
+            case AnimationKeyType::Translation: return UpdateStream<true>(m_translations, keyIndex, time, context, data);
+            case AnimationKeyType::Rotation: return UpdateStream<true>(m_rotations, keyIndex, time, context, data);
+            case AnimationKeyType::Scaling: return UpdateStream<true>(m_scales, keyIndex, time, context, data);
+            default:
+                SRHalt("Unknown key type!");
+                return keyIndex;
+        }
+    }
+
+    uint32_t AnimationChannel::UpdateChannel(uint32_t keyIndex, float_t time, UpdateContext& context, ChannelUpdateContext& channelContext) const {
+        if (!channelContext.gameObjectIndex) SR_UNLIKELY_ATTRIBUTE {
+            return keyIndex;
+        }
+
+        AnimationGameObjectData& data = context.pPose->GetGameObjectData(channelContext.gameObjectIndex.value());
+
+        switch (m_type) {
+            case AnimationKeyType::Translation: return UpdateStream<false>(m_translations, keyIndex, time, context, data);
+            case AnimationKeyType::Rotation: return UpdateStream<false>(m_rotations, keyIndex, time, context, data);
+            case AnimationKeyType::Scaling: return UpdateStream<false>(m_scales, keyIndex, time, context, data);
+            default:
+                SRHalt("Unknown key type!");
+                return keyIndex;
+        }
+    }
+
     void AnimationChannel::Load(SR_HTYPES_NS::RawMesh* pRawMesh, aiNodeAnim* pChannel, float_t ticksPerSecond, std::vector<AnimationChannel*>& channels) {
         SR_TRACY_ZONE;
 
@@ -159,10 +159,8 @@ namespace SR_ANIMATIONS_NS {
         }
 
         for (auto&& pChannel : GetChannels()) {
-            m_maxKeyFrame = SR_MAX(m_maxKeyFrame, pChannel->GetKeys().size());
-            for (auto&& key : pChannel->GetKeys()) {
-                m_duration = SR_MAX(m_duration, key.time);
-            }
+            m_maxKeyFrame = SR_MAX(m_maxKeyFrame, pChannel->GetKeysCount());
+            m_duration = SR_MAX(m_duration, pChannel->GetDuration());
         }
 
         return Super::Load();
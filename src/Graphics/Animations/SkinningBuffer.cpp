@@ -0,0 +1,146 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Animations/SkinningBuffer.h>
+
+namespace SR_ANIMATIONS_NS {
+    /// Максимально допустимое в Vulkan minStorageBufferOffsetAlignment - 256 байт, то есть 4 матрицы
+    static constexpr uint32_t SR_SKINNING_REGION_ALIGNMENT = 256 / sizeof(SR_MATH_NS::Matrix4x4);
+
+    SkinningBuffer::~SkinningBuffer() {
+        SRAssert2(m_ssbo == SR_ID_INVALID, "Skinning buffer is not freed!");
+    }
+
+    SkinningBuffer::Region SkinningBuffer::Allocate(uint32_t count) {
+        Region region;
+
+        if (count == 0) {
+            return region;
+        }
+
+        count = (count + SR_SKINNING_REGION_ALIGNMENT - 1) / SR_SKINNING_REGION_ALIGNMENT * SR_SKINNING_REGION_ALIGNMENT;
+        region.count = count;
+
+        for (auto pIt = m_freeRegions.begin(); pIt != m_freeRegions.end(); ++pIt) {
+            if (pIt->count < count) {
+                continue;
+            }
+
+            region.offset = pIt->offset;
+
+            if (pIt->count == count) {
+                m_freeRegions.erase(pIt);
+            }
+            else {
+                pIt->offset += count;
+                pIt->count -= count;
+            }
+
+            return region;
+        }
+
+        region.offset = static_cast<uint32_t>(m_matrices.size());
+        m_matrices.resize(m_matrices.size() + count, SR_MATH_NS::Matrix4x4::Identity());
+        m_dirty = true;
+
+        return region;
+    }
+
+    void SkinningBuffer::Free(Region& region) {
+        if (!region.Valid()) {
+            return;
+        }
+
+        auto&& pIt = std::lower_bound(m_freeRegions.begin(), m_freeRegions.end(), region, [](const Region& left, const Region& right) {
+            return left.offset < right.offset;
+        });
+        pIt = m_freeRegions.insert(pIt, region);
+
+        /// Склеиваем с соседями, чтобы буфер не дробился при пересоздании мешей
+        if (pIt + 1 != m_freeRegions.end() && pIt->offset + pIt->count == (pIt + 1)->offset) {
+            pIt->count += (pIt + 1)->count;
+            m_freeRegions.erase(pIt + 1);
+        }
+
+        if (pIt != m_freeRegions.begin() && (pIt - 1)->offset + (pIt - 1)->count == pIt->offset) {
+            (pIt - 1)->count += pIt->count;
+            pIt = m_freeRegions.erase(pIt) - 1;
+        }
+
+        /// Хвост буфера просто отрезаем
+        if (pIt->offset + pIt->count == m_matrices.size()) {
+            m_matrices.resize(pIt->offset);
+            m_freeRegions.erase(pIt);
+        }
+
+        region = Region();
+    }
+
+    void SkinningBuffer::Write(const Region& region, const SR_MATH_NS::Matrix4x4* pMatrices, uint32_t count) {
+        if (!region.Valid() || !pMatrices) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        count = SR_MIN(count, region.count);
+
+        auto&& pDestination = m_matrices.data() + region.offset;
+        const size_t size = count * sizeof(SR_MATH_NS::Matrix4x4);
+
+        if (std::memcmp(pDestination, pMatrices, size) == 0) {
+            return;
+        }
+
+        std::memcpy(pDestination, pMatrices, size);
+        m_dirty = true;
+    }
+
+    bool SkinningBuffer::Upload(SR_GRAPH_NS::Pipeline* pPipeline) {
+        SR_TRACY_ZONE;
+
+        if (m_matrices.empty() && m_ssbo == SR_ID_INVALID) SR_LIKELY_ATTRIBUTE {
+            return false;
+        }
+
+        const uint64_t size = m_matrices.size() * sizeof(SR_MATH_NS::Matrix4x4);
+        bool reallocated = false;
+
+        if (size > m_capacity || (m_ssbo == SR_ID_INVALID && m_capacity == 0)) SR_UNLIKELY_ATTRIBUTE {
+            if (m_ssbo != SR_ID_INVALID) {
+                pPipeline->FreeSSBO(&m_ssbo);
+            }
+
+            /// Пустой буфер нельзя привязать к дескриптору, поэтому минимальный размер ненулевой
+            m_capacity = SR_MAX(static_cast<uint64_t>(sizeof(SR_MATH_NS::Matrix4x4) * 256), m_capacity);
+            while (m_capacity < size) {
+                m_capacity *= 2;
+            }
+
+            m_ssbo = pPipeline->AllocateSSBO(static_cast<uint32_t>(m_capacity), SSBOUsage::Write);
+
+            if (m_ssbo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+                /// Запрошенная емкость запоминается, иначе неудачное выделение повторялось бы каждый кадр
+                SR_ERROR("SkinningBuffer::Upload() : failed to allocate SSBO! Size: {}", m_capacity);
+                return false;
+            }
+
+            reallocated = true;
+            m_dirty = true;
+        }
+
+        if (m_dirty && size > 0 && m_ssbo != SR_ID_INVALID) {
+            pPipeline->UpdateSSBO(m_ssbo, m_matrices.data(), size);
+        }
+
+        m_dirty = false;
+
+        return reallocated;
+    }
+
+    void SkinningBuffer::FreeVideoMemory(SR_GRAPH_NS::Pipeline* pPipeline) {
+        if (m_ssbo != SR_ID_INVALID) {
+            pPipeline->FreeSSBO(&m_ssbo);
+        }
+        m_capacity = 0;
+    }
+}
@@ -41,6 +41,9 @@ namespace SR_GTYPES_NS {
     bool Font::Unload() {
         SR_TRACY_ZONE;
 
+        /// Глифы держат растры FreeType, поэтому освобождаются до библиотеки
+        m_glyphCache.Clear();
+
         if (m_library) {
             FT_Done_FreeType(m_library);
             m_library = nullptr;
@@ -149,6 +152,31 @@ namespace SR_GTYPES_NS {
         return GetGlyph(code, renderMode, FT_LOAD_RENDER, FT_LOAD_DEFAULT);
     }
 
+    SR_GRAPH_NS::Glyph::Ptr Font::GetCachedGlyph(char32_t code, FT_Render_Mode renderMode) {
+        SR_GRAPH_NS::GlyphCacheKey key;
+        key.code = code;
+        key.renderMode = renderMode;
+
+        if (m_face && m_face->size) SR_LIKELY_ATTRIBUTE {
+            key.xScale = m_face->size->metrics.x_scale;
+            key.yScale = m_face->size->metrics.y_scale;
+        }
+
+        if (auto&& pGlyph = m_glyphCache.Find(key)) SR_LIKELY_ATTRIBUTE {
+            return pGlyph;
+        }
+
+        auto&& glyph = GetGlyph(code, renderMode);
+        if (!glyph) {
+            return nullptr;
+        }
+
+        auto&& pGlyph = std::make_shared<SR_GRAPH_NS::Glyph>(glyph, renderMode);
+        m_glyphCache.Insert(key, pGlyph);
+
+        return pGlyph;
+    }
+
     FT_Glyph Font::GetGlyph(char32_t code, FT_Render_Mode renderMode, FT_Int32 charLoad, FT_Int32 glyphLoad) const {
          FT_Glyph glyph = nullptr;
 
@@ -37,6 +37,17 @@ namespace SR_GRAPH_NS {
         return 4;
     }
 
+    uint64_t Glyph::GetMemorySize() const noexcept {
+        uint64_t size = sizeof(Glyph);
+
+        if (m_glyph && m_glyph->format == FT_GLYPH_FORMAT_BITMAP) {
+            auto&& bitmap = reinterpret_cast<FT_BitmapGlyph>(m_glyph)->bitmap;
+            size += sizeof(FT_BitmapGlyphRec) + static_cast<uint64_t>(std::abs(bitmap.pitch)) * bitmap.rows;
+        }
+
+        return size;
+    }
+
     GlyphMetrics& Glyph::GetMetrics() noexcept {
         return m_metrics;
     }
@@ -53,14 +64,6 @@ namespace SR_GRAPH_NS {
         return m_glyph;
     }
 
-    int32_t Glyph::GetPosX() const noexcept {
-        return m_metrics.posX;
-    }
-
-    int32_t Glyph::GetPosY() const noexcept {
-        return m_metrics.posY;
-    }
-
     /// ----------------------------------------------------------------------------------------------------------------
 
     GlyphImage::Ptr GlyphImage::Create(const Glyph::Ptr& pGlyph, bool needInit) {
@@ -121,10 +124,7 @@ namespace SR_GRAPH_NS {
         return true;
     }
 
-    void GlyphImage::InsertTo(uint8_t* pTarget, int32_t top, uint32_t sizeX) {
-        const int32_t posX = m_glyph->GetPosX();
-        const int32_t posY = m_glyph->GetPosY();
-
+    void GlyphImage::InsertTo(uint8_t* pTarget, int32_t posX, int32_t posY, int32_t top, uint32_t sizeX) {
         const uint32_t pixelSize = m_glyph->GetPixelSize();
         const uint32_t width = m_glyph->GetWidth();
         const uint32_t height = m_glyph->GetHeight();
@@ -178,11 +178,8 @@ namespace SR_GRAPH_NS {
         }
     }
 
-    void GlyphImage::Debug(uint8_t* pTarget, int32_t top, uint32_t sizeX)
+    void GlyphImage::Debug(uint8_t* pTarget, int32_t posX, int32_t posY, int32_t top, uint32_t sizeX)
     {
-        const int32_t posX = m_glyph->GetPosX();
-        const int32_t posY = m_glyph->GetPosY();
-
         const uint32_t pixelSize = m_glyph->GetPixelSize();
         const uint32_t width = m_glyph->GetWidth();
         const uint32_t height = m_glyph->GetHeight();
@@ -0,0 +1,71 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Font/GlyphCache.h>
+
+namespace SR_GRAPH_NS {
+    GlyphCache::~GlyphCache() {
+        Clear();
+    }
+
+    Glyph::Ptr GlyphCache::Find(const GlyphCacheKey& key) {
+        auto&& pIt = m_lookup.find(key);
+        if (pIt == m_lookup.end()) {
+            ++m_metrics.misses;
+            return nullptr;
+        }
+
+        ++m_metrics.hits;
+
+        /// Перемещаем в начало списка - самый свежий глиф
+        m_entries.splice(m_entries.begin(), m_entries, pIt->second);
+
+        return pIt->second->pGlyph;
+    }
+
+    void GlyphCache::Insert(const GlyphCacheKey& key, const Glyph::Ptr& pGlyph) {
+        if (!pGlyph || m_lookup.count(key) != 0) {
+            return;
+        }
+
+        auto&& entry = m_entries.emplace_front();
+        entry.key = key;
+        entry.pGlyph = pGlyph;
+        entry.memory = pGlyph->GetMemorySize();
+
+        m_lookup[key] = m_entries.begin();
+
+        m_metrics.memory += entry.memory;
+        ++m_metrics.glyphsCount;
+
+        Evict();
+    }
+
+    void GlyphCache::SetBudget(uint64_t budget) {
+        m_budget = budget;
+        Evict();
+    }
+
+    void GlyphCache::Clear() {
+        m_lookup.clear();
+        m_entries.clear();
+
+        m_metrics.memory = 0;
+        m_metrics.glyphsCount = 0;
+    }
+
+    void GlyphCache::Evict() {
+        /// Самый свежий глиф не вытесняем, даже если он один больше бюджета
+        while (m_metrics.memory > m_budget && m_entries.size() > 1) {
+            auto&& entry = m_entries.back();
+
+            m_metrics.memory -= entry.memory;
+            --m_metrics.glyphsCount;
+            ++m_metrics.evictions;
+
+            m_lookup.erase(entry.key);
+            m_entries.pop_back();
+        }
+    }
+}
@@ -69,6 +69,7 @@ namespace SR_GTYPES_NS {
         TextBuilder textBuilder(m_font);
         textBuilder.SetKerning(m_kerning);
         textBuilder.SetDebug(m_debug);
+        textBuilder.SetSDF(m_sdf);
         //textBuilder.SetCharSize(m_fontSize);
 
         if (!textBuilder.Build(m_text)) {
@@ -85,7 +86,8 @@ namespace SR_GTYPES_NS {
         textureCreateInfo.width = m_atlasSize.x;
         textureCreateInfo.height = m_atlasSize.y;
         textureCreateInfo.compression = TextureCompression::None;
-        textureCreateInfo.filter = TextureFilter::NEAREST;
+        /// Поле расстояний интерполируется, иначе при масштабировании контур станет ступенчатым
+        textureCreateInfo.filter = m_sdf ? TextureFilter::LINEAR : TextureFilter::NEAREST;
         textureCreateInfo.mipLevels = 1;
         textureCreateInfo.cpuUsage = false;
         textureCreateInfo.alpha = true;
@@ -194,6 +196,11 @@ namespace SR_GTYPES_NS {
         OnTextDirty();
     }
 
+    void IText::SetSDF(bool enabled) {
+        m_sdf = enabled;
+        OnTextDirty();
+    }
+
     void IText::SetFont(const SR_UTILS_NS::Path& path) {
         SetFont(SR_GTYPES_NS::Font::Load(path));
     }
@@ -41,6 +41,9 @@ namespace SR_GTYPES_NS {
         GetComponentProperties().AddStandardProperty("Debug", &m_debug)
             .SetSetter([this](void* pValue) { SetDebug(*static_cast<bool*>(pValue)); });
 
+        GetComponentProperties().AddStandardProperty("SDF", &m_sdf)
+            .SetSetter([this](void* pValue) { SetSDF(*static_cast<bool*>(pValue)); });
+
         GetComponentProperties().AddStandardProperty("Font size", &m_fontSize)
             .SetDrag(1)
             .SetResetValue(512.f)
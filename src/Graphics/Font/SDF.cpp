@@ -3,74 +3,127 @@
 //
 
 #include <Graphics/Font/SDF.h>
+#include <Graphics/Utils/ParallelFor.h>
 
 namespace SR_GRAPH_NS::SDF {
-    SDFImage DFCalculate(const SDFImage& image, int32_t distanceFieldScale, bool transparent) {
-        SDFImage result;
+    namespace {
+        /// Меньшие изображения (обычный глиф) быстрее посчитать в одном потоке, чем запускать потоки
+        constexpr uint32_t SDF_MIN_PARALLEL_PIXELS = 128 * 128;
+        constexpr uint32_t SDF_ROWS_PER_TASK = 32;
 
-        int32_t x, y;
-        int32_t w = image.width, h = image.height;
+        constexpr Point POINT_INSIDE = { 0, 0, 0 };
+        constexpr Point POINT_EMPTY = { 9999, 9999, 9999 * 9999 };
 
-        Grid grid[2] = { Grid(w, h), Grid(w, h) };
+        /// Делит строки [0, rows) на полосы и раздает их потокам
+        template<typename Function> void ForEachRows(uint32_t rows, uint32_t threadsCount, const Function& function) {
+            const uint32_t tasksCount = (rows + SDF_ROWS_PER_TASK - 1) / SDF_ROWS_PER_TASK;
 
-        constexpr Point pointInside = { 0, 0, 0 };
-        constexpr Point pointEmpty = { 9999, 9999, 9999 * 9999 };
+            ParallelFor(tasksCount, threadsCount, [&](uint32_t task) {
+                const uint32_t begin = task * SDF_ROWS_PER_TASK;
+                function(begin, SR_MIN(begin + SDF_ROWS_PER_TASK, rows));
+            });
+        }
+    }
 
-        /** create 1-pixel gap */
-        for(x = 0; x < w + 2; ++x) {
-            grid[0].Put(x, 0, pointInside);
-            grid[1].Put(x, 0, pointEmpty);
+    bool DFCalculate(const SDFImage& source, const SDFImage& destination, const SDFSettings& settings) {
+        SR_TRACY_ZONE;
+
+        if (!source.pData || !destination.pData) {
+            SR_ERROR("SDF::DFCalculate() : image data is nullptr!");
+            return false;
         }
 
-        for(y = 1; y <= h; ++y) {
-            grid[0].Put(0, y, pointInside);
-            grid[1].Put(0, y, pointEmpty);
-
-            for(x = 1; x <= w; ++x)
-            {
-                // if(qGreen(img->pixel(x - 1, y - 1)) > 128) {
-                //     grid[0].Put(x, y, pointEmpty);
-                //     grid[1].Put(x, y, pointInside);
-                // }
-                // else {
-                //     grid[0].Put(x, y, pointInside);
-                //     grid[1].Put(x, y, pointEmpty);
-                // }
-            }
-            grid[0].Put(w + 1, y, pointInside);
-            grid[1].Put(w + 1, y, pointEmpty);
+        if (source.width != destination.width || source.height != destination.height) {
+            SR_ERROR("SDF::DFCalculate() : source and destination sizes are different!");
+            return false;
         }
 
-        for(x = 0; x < w + 2; ++x) {
-            grid[0].Put(x, h + 1, pointInside);
-            grid[1].Put(x, h + 1, pointEmpty);
+        if (source.channel >= source.pixelSize || destination.channel >= destination.pixelSize) {
+            SR_ERROR("SDF::DFCalculate() : invalid image channel!");
+            return false;
         }
 
-        grid[0].GenerateSDF();
-        grid[1].GenerateSDF();
-
-        for(y = 1; y <= h; y++) {
-            for (x = 1; x <= w; x++) {
-                double_t dist1 = sqrt((double)(grid[0].Get(x, y).f + 1));
-                double_t dist2 = sqrt((double)(grid[1].Get(x, y).f + 1));
-                double_t dist = dist1 - dist2;
-                /// Clamp and scale
-                int c = dist + 128;
-                if (c < 0) c = 0;
-                if (c > 255) c = 255;
-
-                // if (transparent) {
-                //     img->setPixel(x - 1, y - 1, qRgba(255, 255, 255, c));
-                // }
-                // else {
-                //     img->setPixel(x - 1, y - 1, qRgb(c, c, c));
-                // }
-            }
+        /// Point хранит смещения в uint16_t
+        if (source.width >= POINT_EMPTY.dx || source.height >= POINT_EMPTY.dy) {
+            SR_ERROR("SDF::DFCalculate() : image is too large!");
+            return false;
+        }
+
+        if (source.width == 0 || source.height == 0) {
+            return true;
+        }
+
+        const auto w = static_cast<int32_t>(source.width);
+        const auto h = static_cast<int32_t>(source.height);
+
+        uint32_t threadsCount = settings.threadsCount;
+        if (threadsCount == 0) {
+            threadsCount = SR_MAX(std::thread::hardware_concurrency(), 1u);
+        }
+        if (source.width * source.height < SDF_MIN_PARALLEL_PIXELS) {
+            threadsCount = 1;
+        }
+
+        /// grid[0] - расстояние от внутренних пикселей до внешних, grid[1] - наоборот
+        Grid grid[2] = { Grid(w, h), Grid(w, h) };
+
+        /** create 1-pixel gap */
+        for (int32_t x = 0; x < w + 2; ++x) {
+            grid[0].Put(x, 0, POINT_INSIDE);
+            grid[1].Put(x, 0, POINT_EMPTY);
+            grid[0].Put(x, h + 1, POINT_INSIDE);
+            grid[1].Put(x, h + 1, POINT_EMPTY);
         }
 
-        free(grid[0].grid);
-        free(grid[1].grid);
+        auto&& pSource = static_cast<const uint8_t*>(source.pData);
+
+        ForEachRows(source.height, threadsCount, [&](uint32_t begin, uint32_t end) {
+            for (int32_t y = static_cast<int32_t>(begin) + 1; y <= static_cast<int32_t>(end); ++y) {
+                grid[0].Put(0, y, POINT_INSIDE);
+                grid[1].Put(0, y, POINT_EMPTY);
+
+                const uint8_t* pRow = pSource + static_cast<size_t>(y - 1) * source.width * source.pixelSize + source.channel;
+
+                for (int32_t x = 1; x <= w; ++x) {
+                    if (pRow[static_cast<size_t>(x - 1) * source.pixelSize] > settings.threshold) {
+                        grid[0].Put(x, y, POINT_EMPTY);
+                        grid[1].Put(x, y, POINT_INSIDE);
+                    }
+                    else {
+                        grid[0].Put(x, y, POINT_INSIDE);
+                        grid[1].Put(x, y, POINT_EMPTY);
+                    }
+                }
+
+                grid[0].Put(w + 1, y, POINT_INSIDE);
+                grid[1].Put(w + 1, y, POINT_EMPTY);
+            }
+        });
+
+        /// Проходы 8SSEDT последовательны внутри сетки, но сетки между собой независимы
+        ParallelFor(2, threadsCount, [&grid](uint32_t index) {
+            grid[index].GenerateSDF();
+        });
+
+        const float_t spread = SR_MAX(settings.spread, 1.f);
+        const float_t range = static_cast<float_t>(settings.maxValue) - static_cast<float_t>(settings.minValue);
+
+        auto&& pDestination = static_cast<uint8_t*>(destination.pData);
+
+        ForEachRows(source.height, threadsCount, [&](uint32_t begin, uint32_t end) {
+            for (int32_t y = static_cast<int32_t>(begin) + 1; y <= static_cast<int32_t>(end); ++y) {
+                uint8_t* pRow = pDestination + static_cast<size_t>(y - 1) * destination.width * destination.pixelSize + destination.channel;
+
+                for (int32_t x = 1; x <= w; ++x) {
+                    /// Положительное внутри контура, отрицательное снаружи
+                    const float_t distance = std::sqrt(static_cast<float_t>(grid[0].Get(x, y).f)) - std::sqrt(static_cast<float_t>(grid[1].Get(x, y).f));
+                    const float_t value = std::clamp(0.5f + 0.5f * distance / spread, 0.f, 1.f);
+
+                    pRow[static_cast<size_t>(x - 1) * destination.pixelSize] = static_cast<uint8_t>(static_cast<float_t>(settings.minValue) + value * range + 0.5f);
+                }
+            }
+        });
 
-        return result;
+        return true;
     }
 }
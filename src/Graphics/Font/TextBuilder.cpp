@@ -45,6 +45,12 @@ namespace SR_GRAPH_NS {
             return false;
         }
 
+        if (m_sdf) {
+            m_padding = static_cast<int32_t>(std::ceil(SR_MAX(m_sdfSettings.spread, 1.f)));
+            m_imageWidth += m_padding * 2;
+            m_imageHeight += m_padding * 2;
+        }
+
         auto&& size = GetSize();
         if (size == 0) {
             SR_ERROR("TextBuilder::Build() : failed to calculate size!");
@@ -54,21 +60,35 @@ namespace SR_GRAPH_NS {
         m_textureData = new uint8_t[size];
         memset(m_textureData, 0, size);
 
-        for (auto&& pGlyph : m_glyphs) {
-            auto&& pGlyphImage = GlyphImage::Create(pGlyph, false);
+        for (auto&& glyph : m_glyphs) {
+            auto&& pGlyphImage = GlyphImage::Create(glyph.pGlyph, false);
             if (!pGlyphImage) {
                 continue;
             }
-            pGlyphImage->InsertTo(m_textureData, m_top, m_imageWidth);
+            pGlyphImage->InsertTo(m_textureData, glyph.posX + m_padding, glyph.posY + m_padding, m_top, m_imageWidth);
+        }
+
+        if (m_sdf) {
+            SDF::SDFImage image;
+            image.pData = m_textureData;
+            image.width = m_imageWidth;
+            image.height = m_imageHeight;
+            image.pixelSize = 4;
+            image.channel = 3;
+
+            if (!SDF::DFCalculate(image, image, m_sdfSettings)) {
+                SR_ERROR("TextBuilder::Build() : failed to calculate distance field!");
+                return false;
+            }
         }
 
         if (m_debug) {
-            for (auto&& pGlyph : m_glyphs) {
-                auto&& pGlyphImage = GlyphImage::Create(pGlyph, false);
+            for (auto&& glyph : m_glyphs) {
+                auto&& pGlyphImage = GlyphImage::Create(glyph.pGlyph, false);
                 if (!pGlyphImage) {
                     continue;
                 }
-                pGlyphImage->Debug(m_textureData, m_top, m_imageWidth);
+                pGlyphImage->Debug(m_textureData, glyph.posX + m_padding, glyph.posY + m_padding, m_top, m_imageWidth);
             }
 
             for (uint32_t x = 0; x < m_imageWidth; ++x) {
@@ -134,46 +154,46 @@ namespace SR_GRAPH_NS {
                 continue;
             }
 
-            auto&& glyph = m_font->GetGlyph(code, m_renderMode);
-            if (!glyph) {
+            auto&& pGlyph = m_font->GetCachedGlyph(code, m_renderMode);
+            if (!pGlyph) {
                 continue;
             }
 
-            auto&& pGlyph = std::make_shared<Glyph>(glyph, m_renderMode);
+            const GlyphMetrics& metrics = pGlyph->GetMetrics();
+            auto&& placed = m_glyphs.emplace_back();
+            placed.pGlyph = pGlyph;
 
             if (m_kerning && prevCode.has_value()) {
                 posX += m_font->GetKerning(prevCode.value(), code);
             }
             prevCode = code;
             
-            if (posX == 0 && pGlyph->GetMetrics().left < 0) {
-                posX += -pGlyph->GetMetrics().left << 6;
+            if (posX == 0 && metrics.left < 0) {
+                posX += -metrics.left << 6;
             }
             else {
-                pGlyph->GetMetrics().posX = (posX >> 6) + pGlyph->GetMetrics().left;
+                placed.posX = (posX >> 6) + metrics.left;
             }
 
-            pGlyph->GetMetrics().posY = -pGlyph->GetMetrics().top;
+            placed.posY = -metrics.top;
 
             posX += m_align << 6;
-            posX += pGlyph->GetMetrics().advanceX >> 10;
+            posX += metrics.advanceX >> 10;
 
-            pGlyph->GetMetrics().posY += rowOffset;
+            placed.posY += rowOffset;
 
             /// Вычисляем самую верхнюю позицию
-            m_top = SR_MIN(m_top, pGlyph->GetMetrics().posY);
+            m_top = SR_MIN(m_top, placed.posY);
             /// Вычисляем самую левую позицию
-            left = SR_MIN(left, pGlyph->GetMetrics().posX);
+            left = SR_MIN(left, placed.posX);
             /// Вычисляем самую нижнюю позицию
-            bottom = SR_MAX(bottom, pGlyph->GetMetrics().posY + pGlyph->GetMetrics().height);
-
-            m_imageWidth = SR_MAX(m_imageWidth, SR_ABS(pGlyph->GetPosX()) + pGlyph->GetWidth());
+            bottom = SR_MAX(bottom, placed.posY + metrics.height);
 
-            m_glyphs.emplace_back(pGlyph);
+            m_imageWidth = SR_MAX(m_imageWidth, SR_ABS(placed.posX) + pGlyph->GetWidth());
         }
 
-        for (auto&& pGlyph : m_glyphs) {
-            pGlyph->GetMetrics().posY -= left;
+        for (auto&& glyph : m_glyphs) {
+            glyph.posY -= left;
         }
 
         if (m_glyphs.empty()) {
@@ -195,6 +215,7 @@ namespace SR_GRAPH_NS {
         m_imageWidth = 0;
 
         m_top = 0;
+        m_padding = 0;
 
         m_glyphs.clear();
     }
@@ -5,7 +5,15 @@
 #include <Graphics/Lighting/LightSystem.h>
 #include <Graphics/Lighting/ILightComponent.h>
 
+#include <Utils/ECS/GameObject.h>
+
 namespace SR_GRAPH_NS {
+    bool ILightComponent::InitializeEntity() noexcept {
+        GetComponentProperties().AddStandardProperty("Color", &m_color);
+        GetComponentProperties().AddStandardProperty("Intensity", &m_intensity);
+
+        return Super::InitializeEntity();
+    }
 
     void ILightComponent::OnAttached() {
         if (auto&& pRenderScene = GetRenderScene()) {
@@ -23,4 +31,25 @@ namespace SR_GRAPH_NS {
             pRenderScene->GetLightSystem()->Remove(this);
         }
     }
-}
\ No newline at end of file
+
+    SR_MATH_NS::FVector3 ILightComponent::GetLightPosition() const {
+        if (auto&& pTransform = GetTransform()) {
+            return pTransform->GetMatrix().GetTranslate();
+        }
+
+        return SR_MATH_NS::FVector3();
+    }
+
+    SR_MATH_NS::FVector3 ILightComponent::GetLightDirection() const {
+        if (auto&& pTransform = GetTransform()) {
+            const SR_MATH_NS::FVector4 direction = pTransform->GetMatrix() * SR_MATH_NS::FVector4(0.f, 0.f, 1.f, 0.f);
+            const float_t length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+
+            if (length > 0.f) {
+                return SR_MATH_NS::FVector3(direction.x / length, direction.y / length, direction.z / length);
+            }
+        }
+
+        return SR_MATH_NS::FVector3(0.f, 0.f, 1.f);
+    }
+}
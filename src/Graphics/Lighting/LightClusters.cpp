@@ -0,0 +1,199 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Lighting/LightClusters.h>
+#include <Graphics/Types/Camera.h>
+
+namespace SR_GRAPH_NS {
+    LightClusters::~LightClusters() {
+        SRAssert(m_lightsSSBO.ssbo == SR_ID_INVALID && m_rangesSSBO.ssbo == SR_ID_INVALID && m_indicesSSBO.ssbo == SR_ID_INVALID);
+    }
+
+    void LightClusters::Clear() {
+        m_lights.clear();
+        m_bounds.clear();
+    }
+
+    void LightClusters::AddLight(const ClusterLight& light, const SR_MATH_NS::FVector3& center, float_t radius) {
+        if (radius <= 0.f) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        m_lights.emplace_back(light);
+        m_bounds.emplace_back(LightBounds { center, radius });
+    }
+
+    void LightClusters::Build(const SR_GTYPES_NS::Camera* pCamera) {
+        SR_TRACY_ZONE;
+
+        m_visibleLights.clear();
+        m_ranges.clear();
+        m_indices.clear();
+        m_clusters.assign(SR_LIGHT_CLUSTERS_COUNT * 2, 0);
+
+        m_grid = SR_MATH_NS::FVector4(SR_LIGHT_CLUSTERS_X, SR_LIGHT_CLUSTERS_Y, SR_LIGHT_CLUSTERS_Z, 0.f);
+
+        if (!pCamera) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        const float_t zNear = SR_MAX(pCamera->GetNear(), 0.0001f);
+        const float_t zFar = SR_MAX(pCamera->GetFar(), zNear * 2.f);
+        const float_t tanY = std::tan(SR_RAD(pCamera->GetFOV()) * 0.5f);
+        const float_t tanX = tanY * pCamera->GetAspect();
+
+        /// slice = log(depth) * scale + bias, срезы равномерны в логарифмическом масштабе
+        const float_t scale = static_cast<float_t>(SR_LIGHT_CLUSTERS_Z) / std::log(zFar / zNear);
+        const float_t bias = -std::log(zNear) * scale;
+
+        m_depth = SR_MATH_NS::FVector4(scale, bias, tanX, tanY);
+
+        const auto toSlice = [scale, bias](float_t depth) -> uint16_t {
+            const float_t slice = std::floor(std::log(depth) * scale + bias);
+            return static_cast<uint16_t>(std::clamp(slice, 0.f, static_cast<float_t>(SR_LIGHT_CLUSTERS_Z - 1)));
+        };
+
+        const auto toTile = [](float_t ndc, uint32_t tiles) -> uint16_t {
+            const float_t tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float_t>(tiles));
+            return static_cast<uint16_t>(std::clamp(tile, 0.f, static_cast<float_t>(tiles - 1)));
+        };
+
+        /// Консервативная проекция отрезка [low; high] пространства камеры при глубине в [minDepth; maxDepth]
+        const auto project = [](float_t low, float_t high, float_t minDepth, float_t maxDepth, float_t tan) -> std::pair<float_t, float_t> {
+            const float_t lowNdc = low < 0.f ? low / (minDepth * tan) : low / (maxDepth * tan);
+            const float_t highNdc = high > 0.f ? high / (minDepth * tan) : high / (maxDepth * tan);
+            return std::make_pair(lowNdc, highNdc);
+        };
+
+        auto&& view = pCamera->GetViewTranslate();
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_lights.size()); ++i) {
+            auto&& bounds = m_bounds[i];
+
+            const SR_MATH_NS::FVector4 center = view * SR_MATH_NS::FVector4(bounds.center.x, bounds.center.y, bounds.center.z, 1.f);
+            /// Камера смотрит вдоль -Z
+            const float_t depth = -center.z;
+
+            if (depth + bounds.radius < zNear || depth - bounds.radius > zFar) {
+                continue;
+            }
+
+            const float_t minDepth = SR_MAX(depth - bounds.radius, zNear);
+            const float_t maxDepth = SR_MIN(depth + bounds.radius, zFar);
+
+            auto&& [minNdcX, maxNdcX] = project(center.x - bounds.radius, center.x + bounds.radius, minDepth, maxDepth, tanX);
+            auto&& [minNdcY, maxNdcY] = project(center.y - bounds.radius, center.y + bounds.radius, minDepth, maxDepth, tanY);
+
+            if (minNdcX > 1.f || maxNdcX < -1.f || minNdcY > 1.f || maxNdcY < -1.f) {
+                continue;
+            }
+
+            ClusterRange range;
+            range.light = static_cast<uint32_t>(m_visibleLights.size());
+            range.minX = toTile(minNdcX, SR_LIGHT_CLUSTERS_X);
+            range.maxX = toTile(maxNdcX, SR_LIGHT_CLUSTERS_X);
+            range.minY = toTile(minNdcY, SR_LIGHT_CLUSTERS_Y);
+            range.maxY = toTile(maxNdcY, SR_LIGHT_CLUSTERS_Y);
+            range.minZ = toSlice(minDepth);
+            range.maxZ = toSlice(maxDepth);
+
+            m_ranges.emplace_back(range);
+            m_visibleLights.emplace_back(m_lights[i]);
+        }
+
+        m_grid.w = static_cast<float_t>(m_visibleLights.size());
+
+        const auto clusterIndex = [](uint32_t x, uint32_t y, uint32_t z) -> uint32_t {
+            return (z * SR_LIGHT_CLUSTERS_Y + y) * SR_LIGHT_CLUSTERS_X + x;
+        };
+
+        /// Два прохода: подсчет источников в кластерах, затем раскладка индексов по префиксным суммам
+        for (auto&& range : m_ranges) {
+            for (uint32_t z = range.minZ; z <= range.maxZ; ++z) {
+                for (uint32_t y = range.minY; y <= range.maxY; ++y) {
+                    for (uint32_t x = range.minX; x <= range.maxX; ++x) {
+                        ++m_clusters[clusterIndex(x, y, z) * 2 + 1];
+                    }
+                }
+            }
+        }
+
+        int32_t offset = 0;
+        for (uint32_t i = 0; i < SR_LIGHT_CLUSTERS_COUNT; ++i) {
+            m_clusters[i * 2] = offset;
+            offset += m_clusters[i * 2 + 1];
+            m_clusters[i * 2 + 1] = 0;
+        }
+
+        m_indices.resize(offset);
+
+        for (auto&& range : m_ranges) {
+            for (uint32_t z = range.minZ; z <= range.maxZ; ++z) {
+                for (uint32_t y = range.minY; y <= range.maxY; ++y) {
+                    for (uint32_t x = range.minX; x <= range.maxX; ++x) {
+                        const uint32_t cluster = clusterIndex(x, y, z);
+                        m_indices[m_clusters[cluster * 2] + m_clusters[cluster * 2 + 1]++] = static_cast<int32_t>(range.light);
+                    }
+                }
+            }
+        }
+    }
+
+    bool LightClusters::Upload(Pipeline* pPipeline) {
+        SR_TRACY_ZONE;
+
+        if (m_clusters.empty()) {
+            m_clusters.assign(SR_LIGHT_CLUSTERS_COUNT * 2, 0);
+        }
+
+        bool reallocated = false;
+
+        reallocated |= UploadBuffer(pPipeline, m_lightsSSBO, m_visibleLights.data(), m_visibleLights.size() * sizeof(ClusterLight));
+        reallocated |= UploadBuffer(pPipeline, m_rangesSSBO, m_clusters.data(), m_clusters.size() * sizeof(int32_t));
+        reallocated |= UploadBuffer(pPipeline, m_indicesSSBO, m_indices.data(), m_indices.size() * sizeof(int32_t));
+
+        return reallocated;
+    }
+
+    bool LightClusters::UploadBuffer(Pipeline* pPipeline, Buffer& buffer, const void* pData, uint64_t size) {
+        bool reallocated = false;
+
+        if (size > buffer.capacity || (buffer.ssbo == SR_ID_INVALID && buffer.capacity == 0)) SR_UNLIKELY_ATTRIBUTE {
+            if (buffer.ssbo != SR_ID_INVALID) {
+                pPipeline->FreeSSBO(&buffer.ssbo);
+            }
+
+            /// Пустой буфер нельзя привязать к дескриптору, поэтому минимальный размер ненулевой
+            buffer.capacity = SR_MAX(static_cast<uint64_t>(1024), buffer.capacity);
+            while (buffer.capacity < size) {
+                buffer.capacity *= 2;
+            }
+
+            buffer.ssbo = pPipeline->AllocateSSBO(static_cast<uint32_t>(buffer.capacity), SSBOUsage::Write);
+
+            if (buffer.ssbo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+                /// Запрошенная емкость запоминается, иначе неудачное выделение повторялось бы каждый кадр
+                SR_ERROR("LightClusters::UploadBuffer() : failed to allocate SSBO! Size: {}", buffer.capacity);
+                return false;
+            }
+
+            reallocated = true;
+        }
+
+        if (size > 0 && buffer.ssbo != SR_ID_INVALID) {
+            pPipeline->UpdateSSBO(buffer.ssbo, const_cast<void*>(pData), size);
+        }
+
+        return reallocated;
+    }
+
+    void LightClusters::FreeVideoMemory(Pipeline* pPipeline) {
+        for (auto&& pBuffer : { &m_lightsSSBO, &m_rangesSSBO, &m_indicesSSBO }) {
+            if (pBuffer->ssbo != SR_ID_INVALID) {
+                pPipeline->FreeSSBO(&pBuffer->ssbo);
+            }
+            pBuffer->capacity = 0;
+        }
+    }
+}
@@ -4,7 +4,12 @@
 
 #include <Graphics/Render/RenderScene.h>
 #include <Graphics/Lighting/LightSystem.h>
+#include <Graphics/Lighting/PointLight.h>
+#include <Graphics/Lighting/SpotLight.h>
+#include <Graphics/Lighting/AreaLight.h>
 #include <Graphics/Types/Mesh.h>
+#include <Graphics/Types/Shader.h>
+#include <Utils/Common/Features.h>
 
 namespace SR_GRAPH_NS {
     LightSystem::LightSystem(RenderScenePtr pRenderScene)
@@ -21,6 +26,104 @@ namespace SR_GRAPH_NS {
         SRAssert(m_pointLights.empty());
     }
 
+    void LightSystem::Update(const SR_GTYPES_NS::Camera* pCamera) {
+        SR_TRACY_ZONE;
+
+        m_clustersEnabled = SR_UTILS_NS::Features::Instance().Enabled("ClusteredLighting", true);
+        if (!m_clustersEnabled) {
+            return;
+        }
+
+        m_clusters.Clear();
+
+        for (auto&& pLight : m_pointLights) {
+            if (!pLight->IsActive()) {
+                continue;
+            }
+
+            auto&& position = pLight->GetLightPosition();
+            auto&& color = pLight->GetColor();
+
+            ClusterLight light;
+            light.positionRange = glm::vec4(position.x, position.y, position.z, pLight->GetRadius());
+            light.colorIntensity = glm::vec4(color.x, color.y, color.z, pLight->GetIntensity());
+            light.directionType = glm::vec4(0.f, 0.f, 0.f, static_cast<float_t>(LightType::Point));
+
+            m_clusters.AddLight(light, position, pLight->GetRadius());
+        }
+
+        for (auto&& pLight : m_spotLights) {
+            if (!pLight->IsActive()) {
+                continue;
+            }
+
+            auto&& position = pLight->GetLightPosition();
+            auto&& direction = pLight->GetLightDirection();
+            auto&& color = pLight->GetColor();
+
+            const float_t distance = pLight->GetDistance();
+            const float_t radius = pLight->GetRadius();
+
+            ClusterLight light;
+            light.positionRange = glm::vec4(position.x, position.y, position.z, distance);
+            light.colorIntensity = glm::vec4(color.x, color.y, color.z, pLight->GetIntensity());
+            light.directionType = glm::vec4(direction.x, direction.y, direction.z, static_cast<float_t>(LightType::Spot));
+            light.params.x = distance / std::sqrt(distance * distance + radius * radius);
+
+            /// Сфера вокруг конуса: центр посередине оси, радиус до края основания
+            const float_t halfDistance = distance * 0.5f;
+            const SR_MATH_NS::FVector3 center(
+                position.x + direction.x * halfDistance,
+                position.y + direction.y * halfDistance,
+                position.z + direction.z * halfDistance
+            );
+
+            m_clusters.AddLight(light, center, std::sqrt(halfDistance * halfDistance + radius * radius));
+        }
+
+        for (auto&& pLight : m_areaLights) {
+            if (!pLight->IsActive()) {
+                continue;
+            }
+
+            auto&& position = pLight->GetLightPosition();
+            auto&& direction = pLight->GetLightDirection();
+            auto&& color = pLight->GetColor();
+
+            ClusterLight light;
+            light.positionRange = glm::vec4(position.x, position.y, position.z, pLight->GetDistance());
+            light.colorIntensity = glm::vec4(color.x, color.y, color.z, pLight->GetIntensity());
+            light.directionType = glm::vec4(direction.x, direction.y, direction.z, static_cast<float_t>(LightType::Area));
+            light.params.y = pLight->GetRadius();
+
+            m_clusters.AddLight(light, position, pLight->GetDistance() + pLight->GetRadius());
+        }
+
+        m_clusters.Build(pCamera);
+
+        /// Дескрипторы мешей ссылаются на старые буферы, их нужно переписать
+        if (m_clusters.Upload(m_renderScene->GetPipeline().Get())) {
+            m_renderScene->GetRenderStrategy()->ForEachMesh([](SR_GTYPES_NS::Mesh* pMesh) {
+                pMesh->MarkMaterialDirty();
+            });
+            m_renderScene->SetDirty();
+        }
+    }
+
+    void LightSystem::FreeVideoMemory() {
+        m_clusters.FreeVideoMemory(m_renderScene->GetPipeline().Get());
+    }
+
+    void LightSystem::BindClusters(SR_GTYPES_NS::Shader* pShader) const {
+        if (!m_clustersEnabled || m_clusters.GetLightsSSBO() == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        pShader->BindSSBO(SHADER_CLUSTER_LIGHTS_BLOCK, m_clusters.GetLightsSSBO());
+        pShader->BindSSBO(SHADER_CLUSTER_RANGES_BLOCK, m_clusters.GetRangesSSBO());
+        pShader->BindSSBO(SHADER_CLUSTER_INDICES_BLOCK, m_clusters.GetIndicesSSBO());
+    }
+
     void LightSystem::Register(ILightComponent* pLightComponent) {
         if (!pLightComponent) {
             SRHalt("LightSystem::Register() : PointLight is nullptr!");
@@ -192,6 +192,7 @@ namespace SR_GRAPH_NS {
             m_properties.AddCustomProperty<MaterialProperty>(property.id, property.type)
                 .SetData(property.GetData())
                 .SetMaterial(this)
+                .SetTextureIndex(m_shader->IsBindlessSampler(property.id))
                 .SetDisplayName(property.id); // TODO: make a pretty name
         }
     }
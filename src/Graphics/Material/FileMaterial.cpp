@@ -108,6 +108,8 @@ namespace SR_GRAPH_NS {
 
         LoadProperties(matXml.TryGetNode("Properties"));
 
+        SetSortBias(matXml.TryGetAttribute("SortBias").ToFloat(0.f));
+
         return IResource::Load();
     }
 
@@ -95,6 +95,9 @@ namespace SR_GRAPH_NS {
                 pShader->SetVec4(hashId, std::get<SR_MATH_NS::FVector4>(GetData()).template Cast<float_t>());
                 break;
             case ShaderVarType::Sampler2D:
+                if (m_textureIndex && pShader->SetTextureIndex(GetName(), std::get<SR_GTYPES_NS::Texture*>(GetData()))) {
+                    break;
+                }
                 pShader->SetSampler2D(GetName(), std::get<SR_GTYPES_NS::Texture*>(GetData()));
                 break;
             default:
@@ -123,6 +126,11 @@ namespace SR_GRAPH_NS {
         }
     }
 
+    bool MaterialProperty::IsTextureInTable(SR_GTYPES_NS::Texture* pTexture) noexcept {
+        /// Без текстуры используется заглушка, она всегда в таблице
+        return !pTexture || pTexture->HasTableIndex();
+    }
+
     MaterialProperty::~MaterialProperty() {
         if (GetShaderVarType() == ShaderVarType::Sampler2D) {
             if (auto&& pTexture = std::get<SR_GTYPES_NS::Texture*>(GetData())) {
@@ -3,8 +3,16 @@
 //
 
 #include <Graphics/Memory/DescriptorManager.h>
+#include <Graphics/SRSL/ShaderVariables.h>
+
+#include <Utils/Common/Features.h>
 
 namespace SR_GRAPH_NS {
+    void DescriptorManager::SetPipeline(SR_HTYPES_NS::SharedPtr<Pipeline> pipeline) {
+        m_pipeline = std::move(pipeline);
+        m_isCacheEnabled = SR_UTILS_NS::Features::Instance().Enabled("DescriptorSetCache", true);
+    }
+
     DescriptorManager::VirtualDescriptorSet DescriptorManager::AllocateDescriptorSet(VirtualDescriptorSet reallocation) {
         SR_TRACY_ZONE;
 
@@ -19,6 +27,8 @@ namespace SR_GRAPH_NS {
             return SR_ID_INVALID;
         }
 
+        PurgeFreedShaders();
+
         auto&& descriptorSet = AllocateMemory(pShader);
         if (descriptorSet == SR_ID_INVALID && !m_allocationTypesCache.empty()) SR_UNLIKELY_ATTRIBUTE {
             SRHalt("DescriptorManager::AllocateDescriptorSet() : failed to allocate descriptor set!");
@@ -30,10 +40,7 @@ namespace SR_GRAPH_NS {
         if (reallocation != SR_ID_INVALID) {
             auto&& descriptors = m_descriptorPool.At(reallocation);
             for (auto&& descriptor : descriptors) {
-                if (descriptor.descriptorSet == SR_ID_INVALID) {
-                    continue;
-                }
-                m_pipeline->FreeDescriptorSet(&descriptor.descriptorSet);
+                Release(descriptor.descriptorSet);
             }
             descriptors.clear();
             descriptors.emplace_back(pShaderHandle, descriptorSet);
@@ -49,6 +56,8 @@ namespace SR_GRAPH_NS {
             return BindResult::Failed;
         }
 
+        PurgeFreedShaders();
+
         auto&& info = m_descriptorPool.At(virtualDescriptorSet);
         auto&& pShaderHandle = m_pipeline->GetCurrentShaderHandle();
 
@@ -89,21 +98,170 @@ namespace SR_GRAPH_NS {
         return result;
     }
 
-    void DescriptorManager::Flush() {
+    void DescriptorManager::Flush(VirtualDescriptorSet virtualDescriptorSet) {
+        SR_TRACY_ZONE;
+
         auto&& pShader = m_pipeline->GetCurrentShader();
+
+        const DescriptorSet descriptorSet = m_pipeline->GetCurrentDescriptorSet();
+        auto&& pShaderHandle = m_pipeline->GetCurrentShaderHandle();
+
+        PurgeFreedResources();
+
+        if (!m_isCacheEnabled || virtualDescriptorSet == SR_ID_INVALID || descriptorSet == SR_ID_INVALID) {
+            pShader->AttachDescriptorSets();
+            return;
+        }
+
+        DescriptorSetInfo* pInfo = nullptr;
+        for (auto&& descriptor : m_descriptorPool.At(virtualDescriptorSet)) {
+            if (descriptor.pShaderHandle == pShaderHandle && descriptor.descriptorSet == descriptorSet) {
+                pInfo = &descriptor;
+                break;
+            }
+        }
+
+        if (!pInfo || m_descriptorSets.count(descriptorSet) == 0) SR_UNLIKELY_ATTRIBUTE {
+            pShader->AttachDescriptorSets();
+            return;
+        }
+
+        m_resourcesCache.clear();
+
+        uint64_t contentHash = pShader->GetDescriptorContentHash(&m_resourcesCache);
+        if (contentHash != 0) {
+            contentHash = SR_UTILS_NS::HashCombine(pShaderHandle, contentHash);
+        }
+
+        if (auto&& pCached = m_contentCache.find(contentHash); contentHash != 0 && pCached != m_contentCache.end()) {
+            const DescriptorSet cachedSet = pCached->second;
+
+            /// Набор с таким же содержимым уже записан, переключаемся на него без записи
+            if (cachedSet != descriptorSet) {
+                if (++m_descriptorSets[cachedSet].usages == 2) {
+                    m_pipeline->SetDescriptorSetShared(cachedSet, true);
+                }
+
+                pInfo->descriptorSet = cachedSet;
+                Release(descriptorSet);
+
+                if (!m_pipeline->BindDescriptorSet(cachedSet)) {
+                    SR_ERROR("DescriptorManager::Flush() : failed to bind descriptor set!");
+                }
+            }
+
+            pShader->ResetSSBOBindings();
+            return;
+        }
+
+        DescriptorSet targetSet = descriptorSet;
+
+        /// Содержимое меняется, а набор разделяется с другими - пишем в собственный
+        if (m_descriptorSets[descriptorSet].usages > 1) {
+            targetSet = AllocateMemory(pShader);
+            if (targetSet == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+                SRHalt("DescriptorManager::Flush() : failed to allocate descriptor set!");
+                pShader->ResetSSBOBindings();
+                return;
+            }
+
+            pInfo->descriptorSet = targetSet;
+            Release(descriptorSet);
+
+            if (!m_pipeline->BindDescriptorSet(targetSet)) {
+                SR_ERROR("DescriptorManager::Flush() : failed to bind descriptor set!");
+                pShader->ResetSSBOBindings();
+                return;
+            }
+        }
+
+        auto&& sharedSet = m_descriptorSets[targetSet];
+
+        Uncache(targetSet, sharedSet);
+
         pShader->AttachDescriptorSets();
+
+        if (contentHash == 0) {
+            return;
+        }
+
+        sharedSet.contentHash = contentHash;
+        m_contentCache[contentHash] = targetSet;
+
+        for (auto&& resource : m_resourcesCache) {
+            const uint64_t key = resource.GetKey();
+            sharedSet.resources.emplace_back(key);
+            m_resourceSets[key].emplace_back(targetSet);
+        }
     }
 
-    DescriptorManager::DescriptorSet DescriptorManager::AllocateMemory(SR_GTYPES_NS::Shader* pShader) const {
+    void DescriptorManager::Uncache(DescriptorSet descriptorSet, SharedDescriptorSet& sharedSet) {
+        if (sharedSet.contentHash != 0) {
+            if (auto&& pCached = m_contentCache.find(sharedSet.contentHash); pCached != m_contentCache.end() && pCached->second == descriptorSet) {
+                m_contentCache.erase(pCached);
+            }
+            sharedSet.contentHash = 0;
+        }
+
+        for (auto&& key : sharedSet.resources) {
+            auto&& pIt = m_resourceSets.find(key);
+            if (pIt == m_resourceSets.end()) {
+                continue;
+            }
+
+            auto&& sets = pIt->second;
+            sets.erase(std::remove(sets.begin(), sets.end(), descriptorSet), sets.end());
+
+            if (sets.empty()) {
+                m_resourceSets.erase(pIt);
+            }
+        }
+
+        sharedSet.resources.clear();
+    }
+
+    void DescriptorManager::PurgeFreedResources() {
+        auto&& freedResources = m_pipeline->GetFreedResources();
+        if (freedResources.empty()) SR_LIKELY_ATTRIBUTE {
+            return;
+        }
+
+        /// Идентификатор освобожденного ресурса достанется новому, и наборы с ним совпадут по хешу с новым содержимым.
+        /// Остальной кеш остается, его наборы ссылаются только на живые ресурсы
+        for (auto&& resource : freedResources) {
+            auto&& pIt = m_resourceSets.find(resource.GetKey());
+            if (pIt == m_resourceSets.end()) SR_LIKELY_ATTRIBUTE {
+                continue;
+            }
+
+            const std::vector<DescriptorSet> sets = std::move(pIt->second);
+            m_resourceSets.erase(pIt);
+
+            for (auto&& descriptorSet : sets) {
+                if (auto&& pSet = m_descriptorSets.find(descriptorSet); pSet != m_descriptorSets.end()) {
+                    Uncache(descriptorSet, pSet->second);
+                }
+            }
+        }
+
+        m_pipeline->ClearFreedResources();
+    }
+
+    DescriptorManager::DescriptorSet DescriptorManager::AllocateMemory(SR_GTYPES_NS::Shader* pShader) {
         m_allocationTypesCache.clear();
 
         if (pShader->GetUBOBlockSize() > 0) SR_LIKELY_ATTRIBUTE {
-            m_allocationTypesCache.emplace_back(DescriptorType::Uniform);
+            m_allocationTypesCache.emplace_back(DescriptorType::DynamicUniform);
         }
         else if (pShader->GetSamplersCount() > 0) {
             m_allocationTypesCache.emplace_back(DescriptorType::CombinedImage);
         }
 
+        /// Пул резервирует дескрипторы по количеству элементов списка, а таблица занимает все свои элементы
+        if (pShader->HasTextureTable()) {
+            m_allocationTypesCache.insert(m_allocationTypesCache.end(), SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE, DescriptorType::CombinedImage);
+        }
+
         if (pShader->HasSharedUBO()) {
             m_allocationTypesCache.emplace_back(DescriptorType::Uniform);
         }
@@ -117,15 +275,101 @@ namespace SR_GRAPH_NS {
             return SR_ID_INVALID;
         }
 
-        const DescriptorSet descriptorSet = m_pipeline->AllocDescriptorSet(m_allocationTypesCache);
+        auto&& pShaderHandle = m_pipeline->GetCurrentShaderHandle();
+
+        /// Наборы одной раскладки взаимозаменяемы, поэтому сначала берем освобожденный
+        DescriptorSet descriptorSet = m_isCacheEnabled ? AcquireRetired(pShaderHandle) : SR_ID_INVALID;
+
+        if (descriptorSet == SR_ID_INVALID) {
+            descriptorSet = m_pipeline->AllocDescriptorSet(m_allocationTypesCache);
+        }
+
         if (descriptorSet == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
             SRHalt("DescriptorManager::AllocateMemory() : failed to allocate descriptor set!");
             return SR_ID_INVALID;
         }
 
+        m_descriptorSets[descriptorSet] = SharedDescriptorSet { pShaderHandle, 0, 0, 1 };
+
         return descriptorSet;
     }
 
+    DescriptorManager::DescriptorSet DescriptorManager::AcquireRetired(void* pShaderHandle) {
+        auto&& pIt = m_retiredSets.find(pShaderHandle);
+        if (pIt == m_retiredSets.end() || pIt->second.empty()) {
+            return SR_ID_INVALID;
+        }
+
+        /// Наборы лежат в порядке освобождения, первый - самый старый
+        auto&& retired = pIt->second.front();
+        if (m_pipeline->GetFrameIndex() < retired.frame + GetRetireDelay()) {
+            return SR_ID_INVALID;
+        }
+
+        const DescriptorSet descriptorSet = retired.descriptorSet;
+        pIt->second.pop_front();
+
+        return descriptorSet;
+    }
+
+    void DescriptorManager::Release(DescriptorSet descriptorSet) {
+        if (descriptorSet == SR_ID_INVALID) {
+            return;
+        }
+
+        auto&& pIt = m_descriptorSets.find(descriptorSet);
+        if (pIt == m_descriptorSets.end()) SR_UNLIKELY_ATTRIBUTE {
+            SRHalt("DescriptorManager::Release() : descriptor set is not registered!");
+            return;
+        }
+
+        auto&& sharedSet = pIt->second;
+
+        if (--sharedSet.usages > 0) {
+            if (sharedSet.usages == 1) {
+                m_pipeline->SetDescriptorSetShared(descriptorSet, false);
+            }
+            return;
+        }
+
+        Uncache(descriptorSet, sharedSet);
+
+        if (sharedSet.textureTableVersion != 0) {
+            --m_textureTableSetsCount;
+        }
+
+        if (m_isCacheEnabled) {
+            /// Буферы команд в полете еще могут ссылаться на набор, поэтому он переиспользуется только через несколько кадров
+            m_retiredSets[sharedSet.pShaderHandle].emplace_back(RetiredDescriptorSet { descriptorSet, m_pipeline->GetFrameIndex() });
+        }
+        else {
+            m_pipeline->FreeDescriptorSet(&descriptorSet);
+        }
+
+        m_descriptorSets.erase(pIt);
+    }
+
+    void DescriptorManager::FreeRetired(const std::set<void*>& handles) {
+        for (auto pIt = m_retiredSets.begin(); pIt != m_retiredSets.end(); ) {
+            if (handles.count(pIt->first) != 0) {
+                ++pIt;
+                continue;
+            }
+
+            /// Раскладки больше нет, набор уже не получит ни один шейдер
+            for (auto&& retired : pIt->second) {
+                m_pipeline->FreeDescriptorSet(&retired.descriptorSet);
+            }
+
+            pIt = m_retiredSets.erase(pIt);
+        }
+    }
+
+    uint64_t DescriptorManager::GetRetireDelay() const {
+        /// Пока не сменятся все кадры в полете, плюс кадр, в котором набор освободили
+        return static_cast<uint64_t>(m_pipeline->GetBuildIterationsCount()) + 1;
+    }
+
     bool DescriptorManager::FreeDescriptorSet(DescriptorManager::VirtualDescriptorSet* pVirtualDescriptorSet) {
         SR_TRACY_ZONE;
 
@@ -138,25 +382,65 @@ namespace SR_GRAPH_NS {
 
         auto&& info = m_descriptorPool.RemoveByIndex(*pVirtualDescriptorSet);
         for (auto&& descriptor : info) {
-            if (descriptor.descriptorSet == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
-                continue;
-            }
-            m_pipeline->FreeDescriptorSet(&descriptor.descriptorSet);
+            Release(descriptor.descriptorSet);
         }
 
         *pVirtualDescriptorSet = SR_ID_INVALID;
         return true;
     }
 
+    void DescriptorManager::PurgeFreedShaders() {
+        auto&& freedHandles = m_pipeline->GetFreedShaderHandles();
+        if (freedHandles.empty()) SR_LIKELY_ATTRIBUTE {
+            return;
+        }
+
+        auto&& isFreed = [&freedHandles](void* pShaderHandle) {
+            return std::find(freedHandles.begin(), freedHandles.end(), pShaderHandle) != freedHandles.end();
+        };
+
+        /// Сначала отпускаем живые наборы, они попадут в список освобожденных и будут удалены вместе с ним
+        m_descriptorPool.ForEach([&](VirtualDescriptorSet, std::vector<DescriptorSetInfo>& descriptorSetInfos) {
+            for (auto pIt = descriptorSetInfos.begin(); pIt != descriptorSetInfos.end(); ) {
+                if (isFreed(pIt->pShaderHandle)) {
+                    Release(pIt->descriptorSet);
+                    pIt = descriptorSetInfos.erase(pIt);
+                }
+                else {
+                    ++pIt;
+                }
+            }
+        });
+
+        for (void* pShaderHandle : freedHandles) {
+            auto&& pIt = m_retiredSets.find(pShaderHandle);
+            if (pIt == m_retiredSets.end()) {
+                continue;
+            }
+
+            for (auto&& retired : pIt->second) {
+                m_pipeline->FreeDescriptorSet(&retired.descriptorSet);
+            }
+
+            m_retiredSets.erase(pIt);
+        }
+
+        m_pipeline->ClearFreedShaderHandles();
+    }
+
     void DescriptorManager::CollectUnused() {
         SR_TRACY_ZONE;
 
+        PurgeFreedShaders();
+        PurgeFreedResources();
+
+        auto&& handles = m_pipeline->GetShaderHandles();
+
         if (m_descriptorPool.IsEmpty()) {
+            FreeRetired(handles);
             return;
         }
 
-        auto&& handles = m_pipeline->GetShaderHandles();
-
         uint32_t count = 0;
 
         m_descriptorPool.ForEach([&](VirtualDescriptorSet , std::vector<DescriptorSetInfo>& descriptorSetInfos) {
@@ -164,9 +448,7 @@ namespace SR_GRAPH_NS {
                 DescriptorSetInfo& data = *pIt;
 
                 if (handles.count(data.pShaderHandle) == 0) {
-                    if (data.descriptorSet != SR_ID_INVALID) {
-                        m_pipeline->FreeDescriptorSet(&data.descriptorSet);
-                    }
+                    Release(data.descriptorSet);
                     pIt = descriptorSetInfos.erase(pIt);
                     ++count;
                 }
@@ -176,8 +458,118 @@ namespace SR_GRAPH_NS {
             }
         });
 
+        FreeRetired(handles);
+
         if (count > 0) {
             SR_LOG("DescriptorManager::CollectUnused() : collected {} unused descriptors.", count);
         }
     }
-}
\ No newline at end of file
+
+    int32_t DescriptorManager::RegisterTexture(int32_t textureId) {
+        if (textureId == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            return SR_ID_INVALID;
+        }
+
+        int32_t index = SR_ID_INVALID;
+
+        if (!m_freeTextureIndices.empty()) {
+            index = m_freeTextureIndices.back();
+            m_freeTextureIndices.pop_back();
+            m_textureTable[index] = textureId;
+        }
+        else if (m_textureTable.size() < SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE) SR_LIKELY_ATTRIBUTE {
+            index = static_cast<int32_t>(m_textureTable.size());
+            m_textureTable.emplace_back(textureId);
+        }
+        else {
+            SR_WARN("DescriptorManager::RegisterTexture() : texture table is full! Capacity: {}", SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE);
+            return SR_ID_INVALID;
+        }
+
+        OnTextureTableChanged(index);
+
+        return index;
+    }
+
+    void DescriptorManager::UpdateTexture(int32_t index, int32_t textureId) {
+        if (index < 0 || index >= static_cast<int32_t>(m_textureTable.size())) SR_UNLIKELY_ATTRIBUTE {
+            SRHalt("DescriptorManager::UpdateTexture() : invalid texture index!");
+            return;
+        }
+
+        if (m_textureTable[index] == textureId) {
+            return;
+        }
+
+        m_textureTable[index] = textureId;
+        OnTextureTableChanged(index);
+    }
+
+    void DescriptorManager::UnregisterTexture(int32_t* pIndex) {
+        SRAssert(pIndex);
+
+        const int32_t index = *pIndex;
+        if (index < 0 || index >= static_cast<int32_t>(m_textureTable.size())) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        *pIndex = SR_ID_INVALID;
+
+        /// Хвост просто отрезаем, остальные индексы переиспользуются
+        if (index + 1 == static_cast<int32_t>(m_textureTable.size())) {
+            m_textureTable.pop_back();
+        }
+        else {
+            m_textureTable[index] = SR_ID_INVALID;
+            m_freeTextureIndices.emplace_back(index);
+        }
+
+        /// Наборы все еще ссылаются на освобожденное изображение. Новая версия заставит сцены
+        /// перестроиться до следующей отправки, и при записи слот получит заглушку
+        OnTextureTableChanged(index);
+    }
+
+    void DescriptorManager::OnTextureTableChanged(int32_t index) {
+        /// Больше изменений нет смысла хранить, дешевле перезаписать таблицу целиком
+        static constexpr uint32_t maxChanges = SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE;
+
+        m_textureTableChanges.emplace_back(++m_textureTableVersion, index);
+
+        if (m_textureTableChanges.size() > maxChanges) {
+            m_textureTableChangesBegin = m_textureTableChanges.front().first;
+            m_textureTableChanges.pop_front();
+        }
+    }
+
+    std::pair<uint32_t, uint32_t> DescriptorManager::AcquireTextureTableRange(DescriptorSet descriptorSet) {
+        constexpr std::pair<uint32_t, uint32_t> fullRange = { 0, SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE };
+
+        auto&& pIt = m_descriptorSets.find(descriptorSet);
+        if (pIt == m_descriptorSets.end()) SR_UNLIKELY_ATTRIBUTE {
+            return fullRange;
+        }
+
+        auto&& version = pIt->second.textureTableVersion;
+        if (version == m_textureTableVersion) SR_LIKELY_ATTRIBUTE {
+            return { 0, 0 };
+        }
+
+        std::pair<uint32_t, uint32_t> range = fullRange;
+
+        if (version != 0 && version >= m_textureTableChangesBegin) {
+            range = { SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE_SIZE, 0 };
+
+            for (auto pChange = m_textureTableChanges.rbegin(); pChange != m_textureTableChanges.rend() && pChange->first > version; ++pChange) {
+                range.first = SR_MIN(range.first, static_cast<uint32_t>(pChange->second));
+                range.second = SR_MAX(range.second, static_cast<uint32_t>(pChange->second) + 1);
+            }
+        }
+        else if (version == 0) {
+            ++m_textureTableSetsCount;
+        }
+
+        version = m_textureTableVersion;
+
+        return range;
+    }
+}
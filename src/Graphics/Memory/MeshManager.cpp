@@ -12,6 +12,7 @@ namespace SR_GRAPH_NS::Memory {
         m_IBOs.reserve(reserve);
         m_VBOTable.resize(reserve);
         m_IBOTable.resize(reserve);
+        m_SSBOTable.resize(reserve);
     }
 
     MeshManager::VideoResourcesIter MeshManager::FindImpl(Hash hash, MeshMemoryType memType) {
@@ -28,6 +29,12 @@ namespace SR_GRAPH_NS::Memory {
                 }
                 break;
             }
+            case MeshMemoryType::SSBO: {
+                if (auto mem = m_SSBOs.find(hash); mem != m_SSBOs.end()) {
+                    return mem;
+                }
+                break;
+            }
             default:
                 SRHalt("MeshManager::FindImpl() : unknown memory type!");
                 return std::nullopt;
@@ -68,6 +75,16 @@ namespace SR_GRAPH_NS::Memory {
 
                 return true;
             }
+            case MeshMemoryType::SSBO: {
+                m_SSBOs[hash] = MeshVidMemInfo(size, id, memType);
+
+                if (id >= m_SSBOTable.size()) {
+                    m_SSBOTable.resize(SR_MAX(m_SSBOTable.size() * 2, id + 1));
+                }
+                m_SSBOTable[id] = hash;
+
+                return true;
+            }
 
             default:
                 SR_ERROR("MeshManager::RegisterImpl() : unknown type!");
@@ -81,6 +98,8 @@ namespace SR_GRAPH_NS::Memory {
                 case MeshMemoryType::VBO: m_VBOs.erase(iter.value());
                     goto skip;
                 case MeshMemoryType::IBO: m_IBOs.erase(iter.value());
+                    goto skip;
+                case MeshMemoryType::SSBO: m_SSBOs.erase(iter.value());
                 skip:
                     return FreeResult::Freed;
                 case MeshMemoryType::Unknown:
@@ -104,11 +123,17 @@ namespace SR_GRAPH_NS::Memory {
             SR_WARN("MeshManager::OnSingletonDestroy() : IBOs isn't empty! \n\tCount = {} \n\tMemory leak possible.", m_IBOs.size());
         }
 
+        if (!m_SSBOs.empty()) {
+            SR_WARN("MeshManager::OnSingletonDestroy() : SSBOs isn't empty! \n\tCount = {} \n\tMemory leak possible.", m_SSBOs.size());
+        }
+
         m_VBOs.clear();
         m_IBOs.clear();
+        m_SSBOs.clear();
 
         m_VBOTable.clear();
         m_IBOTable.clear();
+        m_SSBOTable.clear();
     }
 
     MeshManager::VideoResourcesIter MeshManager::FindById(int32_t id, MeshMemoryType memType) {
@@ -117,6 +142,7 @@ namespace SR_GRAPH_NS::Memory {
         switch (memType) {
             case MeshMemoryType::VBO: pHashTable = &m_VBOTable; break;
             case MeshMemoryType::IBO: pHashTable = &m_IBOTable; break;
+            case MeshMemoryType::SSBO: pHashTable = &m_SSBOTable; break;
             case MeshMemoryType::Unknown:
             default:
                 SRHalt("MeshManager::FindById() : unknown memory type!");
@@ -131,6 +157,27 @@ namespace SR_GRAPH_NS::Memory {
         return FindImpl((*pHashTable)[id], memType);
     }
 
+    bool MeshManager::SetLods(const std::string& identifier, const std::vector<MeshLod>& lods) {
+        SR_LOCK_GUARD;
+
+        if (auto&& memory = Find<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(identifier); memory.has_value()) {
+            memory.value()->second.m_lods = lods;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::vector<MeshLod> MeshManager::GetLods(const std::string& identifier) {
+        SR_LOCK_GUARD;
+
+        if (auto&& memory = Find<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(identifier); memory.has_value()) {
+            return memory.value()->second.m_lods;
+        }
+
+        return { };
+    }
+
     uint32_t MeshVidMemInfo::Copy() {
     #ifndef SR_RELEASE
         if (m_type == MeshMemoryType::Unknown) {
@@ -141,6 +188,7 @@ namespace SR_GRAPH_NS::Memory {
             switch (m_type) {
                 case MeshMemoryType::VBO: SR_LOG("MeshVidMemInfo::Copy() : copy VBO..."); break;
                 case MeshMemoryType::IBO: SR_LOG("MeshVidMemInfo::Copy() : copy IBO..."); break;
+                case MeshMemoryType::SSBO: SR_LOG("MeshVidMemInfo::Copy() : copy SSBO..."); break;
                 default: break;
             }
         }
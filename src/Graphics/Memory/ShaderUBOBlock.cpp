@@ -152,6 +152,18 @@ namespace SR_GRAPH_NS::Memory {
         return false;
     }
 
+    ShaderUBOSlot ShaderUBOBlock::GetSlot(uint64_t hashId) const noexcept {
+        for (uint8_t i = 0; i < m_dataCount; ++i) {
+            if (m_data[i].hashId == hashId) {
+                return ShaderUBOSlot {
+                    .offset = static_cast<uint32_t>(m_data[i].offset),
+                    .size = static_cast<uint32_t>(m_data[i].size),
+                };
+            }
+        }
+        return ShaderUBOSlot();
+    }
+
     void ShaderUBOBlock::FreeMemory(char*& pMemory) {
         if (!pMemory) {
             return;
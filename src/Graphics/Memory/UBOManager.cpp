@@ -42,33 +42,27 @@ namespace SR_GRAPH_NS::Memory {
             return SR_ID_INVALID;
         }
 
-        UBO ubo = SR_ID_INVALID;
-
-        if (uboSize > 0) SR_LIKELY_ATTRIBUTE {
-            if (!AllocMemory(&ubo, uboSize)) SR_UNLIKELY_ATTRIBUTE {
-                SR_ERROR("UBOManager::AllocateUBO() : failed to allocate memory!");
-                return SR_ID_INVALID;
-            }
-        }
-
         VirtualUBOInfo virtualUboInfo;
         virtualUboInfo.shared = shared;
 
         VirtualUBOInfo::Data& data = virtualUboInfo.data.emplace_back();
-        data.ubo = ubo;
         data.pShaderHandle = pShaderHandle;
         data.uboSize = uboSize;
 
+        if (uboSize > 0) SR_LIKELY_ATTRIBUTE {
+            if (!AllocMemory(data, uboSize, shared)) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("UBOManager::AllocateUBO() : failed to allocate memory!");
+                return SR_ID_INVALID;
+            }
+        }
+
         if (virtualUbo == SR_ID_INVALID) SR_LIKELY_ATTRIBUTE {
             return m_uboPool.Add(std::move(virtualUboInfo));
         }
 
         auto&& info = m_uboPool.At(virtualUbo);
         for (auto&& dataToFree : info.data) {
-            if (dataToFree.uboSize <= 0) {
-                continue;
-            }
-            m_pipeline->FreeUBO(&dataToFree.ubo);
+            FreeMemory(dataToFree);
         }
         info = std::move(virtualUboInfo);
         return virtualUbo;
@@ -81,11 +75,7 @@ namespace SR_GRAPH_NS::Memory {
 
         auto&& info = m_uboPool.RemoveByIndex(*virtualUbo);
         for (auto&& data : info.data) {
-            if (data.uboSize <= 0) {
-                SRAssert(data.ubo == SR_ID_INVALID);
-                continue;
-            }
-            m_pipeline->FreeUBO(&data.ubo);
+            FreeMemory(data);
         }
 
         *virtualUbo = SR_ID_INVALID;
@@ -93,17 +83,129 @@ namespace SR_GRAPH_NS::Memory {
         return true;
     }
 
-    bool UBOManager::AllocMemory(UBO *ubo, uint32_t uboSize) {
+    bool UBOManager::AllocMemory(VirtualUBOInfo::Data& data, uint32_t uboSize, bool shared) {
         SR_TRACY_ZONE;
 
-        if (*ubo = m_pipeline->AllocateUBO(uboSize); *ubo < 0) SR_UNLIKELY_ATTRIBUTE {
+        /// общие UBO привязываются сразу к нескольким шейдерам, их немного, поэтому они живут в отдельных буферах
+        if (m_pagesEnabled && !shared && uboSize <= UBO_PAGE_MAX_RANGE) SR_LIKELY_ATTRIBUTE {
+            return AllocPageRange(data, uboSize);
+        }
+
+        if (data.ubo = m_pipeline->AllocateUBO(uboSize); data.ubo < 0) SR_UNLIKELY_ATTRIBUTE {
             SR_ERROR("UBOManager::AllocMemory() : failed to allocate uniform buffer object!");
+            data.ubo = SR_ID_INVALID;
             return false;
         }
 
+        data.offset = 0;
+        data.fromPage = false;
+
+        return true;
+    }
+
+    uint32_t UBOManager::GetAlignedSize(uint32_t uboSize) const {
+        const uint32_t alignment = SR_MAX(1U, m_pipeline->GetUBOOffsetAlignment());
+        return ((uboSize + alignment - 1) / alignment) * alignment;
+    }
+
+    bool UBOManager::AllocPageRange(VirtualUBOInfo::Data& data, uint32_t uboSize) {
+        const uint32_t alignedSize = GetAlignedSize(uboSize);
+
+        if (auto&& pIt = m_freeRanges.find(alignedSize); pIt != m_freeRanges.end() && !pIt->second.empty()) SR_LIKELY_ATTRIBUTE {
+            const UBORange range = pIt->second.back();
+            pIt->second.pop_back();
+
+            data.ubo = range.ubo;
+            data.offset = range.offset;
+            data.fromPage = true;
+
+            ++m_pages.at(range.ubo).ranges;
+
+            return true;
+        }
+
+        auto&& pCurrent = m_pages.find(m_currentPage);
+
+        if (pCurrent == m_pages.end() || pCurrent->second.used + alignedSize > UBO_PAGE_SIZE) SR_UNLIKELY_ATTRIBUTE {
+            UBOPage page;
+
+            if (page.ubo = m_pipeline->AllocateUBO(UBO_PAGE_SIZE); page.ubo < 0) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("UBOManager::AllocPageRange() : failed to allocate uniform buffer page!");
+                return false;
+            }
+
+            m_currentPage = page.ubo;
+            pCurrent = m_pages.emplace(page.ubo, page).first;
+        }
+
+        UBOPage& page = pCurrent->second;
+
+        data.ubo = page.ubo;
+        data.offset = page.used;
+        data.fromPage = true;
+
+        page.used += alignedSize;
+        ++page.ranges;
+
         return true;
     }
 
+    void UBOManager::FreePage(UBO ubo) {
+        for (auto&& [alignedSize, ranges] : m_freeRanges) {
+            ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [ubo](const UBORange& range) {
+                return range.ubo == ubo;
+            }), ranges.end());
+        }
+
+        /// Заполняемую страницу не освобождаем, чтобы не пересоздавать буфер при каждом выделении, а начинаем заново
+        if (ubo == m_currentPage) SR_LIKELY_ATTRIBUTE {
+            m_pages.at(ubo).used = 0;
+            return;
+        }
+
+        m_pages.erase(ubo);
+        m_pipeline->FreeUBO(&ubo);
+    }
+
+    void UBOManager::FreeMemory(VirtualUBOInfo::Data& data) {
+        if (data.uboSize <= 0) {
+            SRAssert(data.ubo == SR_ID_INVALID);
+            return;
+        }
+
+        if (!data.fromPage) SR_UNLIKELY_ATTRIBUTE {
+            m_pipeline->FreeUBO(&data.ubo);
+            return;
+        }
+
+        auto&& page = m_pages.at(data.ubo);
+        SRAssert(page.ranges > 0);
+
+        if (--page.ranges == 0) {
+            FreePage(data.ubo);
+        }
+        else {
+            UBORange range;
+            range.ubo = data.ubo;
+            range.offset = data.offset;
+            m_freeRanges[GetAlignedSize(data.uboSize)].emplace_back(range);
+        }
+
+        data.ubo = SR_ID_INVALID;
+        data.offset = 0;
+        data.fromPage = false;
+    }
+
+    void UBOManager::BindMemory(const VirtualUBOInfo::Data& data) {
+        if (data.fromPage) SR_LIKELY_ATTRIBUTE {
+            m_pipeline->BindUBORange(data.ubo, data.offset, data.uboSize);
+        }
+        else {
+            /// SR_ID_INVALID is allowed
+            m_pipeline->BindUBO(data.ubo);
+        }
+    }
+
     UBOManager::BindResult UBOManager::BindUBO(VirtualUBO virtualUbo) noexcept {
         auto&& uboSize = m_pipeline->GetCurrentShader()->GetUBOBlockSize();
         return BindUBO(virtualUbo, uboSize);
@@ -119,37 +221,35 @@ namespace SR_GRAPH_NS::Memory {
         auto&& info = m_uboPool.At(virtualUbo);
         BindResult result = BindResult::Success;
 
-        UBO ubo = SR_ID_INVALID;
-        bool isFound = false;
+        const VirtualUBOInfo::Data* pData = nullptr;
 
         for (auto&& data : info.data) {
             if (data.pShaderHandle == pShaderHandle || info.shared) SR_LIKELY_ATTRIBUTE {
-                ubo = data.ubo;
-                isFound = true;
+                pData = &data;
                 break;
             }
         }
 
-        if (!isFound) SR_UNLIKELY_ATTRIBUTE {
+        if (!pData) SR_UNLIKELY_ATTRIBUTE {
             SRAssert2(!info.shared, "Something went wrong! UBO not found in shared mode!");
 
+            VirtualUBOInfo::Data data;
+            data.pShaderHandle = pShaderHandle;
+            data.uboSize = uboSize;
+
             if (uboSize > 0) SR_LIKELY_ATTRIBUTE {
-                if (!AllocMemory(&ubo, uboSize)) SR_UNLIKELY_ATTRIBUTE {
+                if (!AllocMemory(data, uboSize, info.shared)) SR_UNLIKELY_ATTRIBUTE {
                     SR_ERROR("UBOManager::BindUBO() : failed to allocate memory!");
                     return BindResult::Failed;
                 }
             }
 
-            VirtualUBOInfo::Data& data = info.data.emplace_back();
-            data.ubo = ubo;
-            data.pShaderHandle = pShaderHandle;
-            data.uboSize = uboSize;
+            pData = &info.data.emplace_back(data);
 
             result = BindResult::Duplicated;
         }
 
-        /// SR_ID_INVALID is allowed
-        m_pipeline->BindUBO(ubo);
+        BindMemory(*pData);
 
         return result;
     }
@@ -164,8 +264,7 @@ namespace SR_GRAPH_NS::Memory {
 
         for (auto&& data : info.data) {
             if (data.pShaderHandle == pShaderHandle || info.shared) SR_LIKELY_ATTRIBUTE {
-                /// SR_ID_INVALID is allowed
-                m_pipeline->BindUBO(data.ubo);
+                BindMemory(data);
                 return BindResult::Success;
             }
         }
@@ -175,9 +274,10 @@ namespace SR_GRAPH_NS::Memory {
 
     void UBOManager::SetPipeline(UBOManager::PipelinePtr pPipeline) {
         m_pipeline = std::move(pPipeline);
+        m_pagesEnabled = SR_UTILS_NS::Features::Instance().Enabled("UBOPages", true);
     }
 
-    UBOManager::UBO UBOManager::GetUBO(UBOManager::VirtualUBO virtualUbo) const noexcept {
+    UBOManager::UBO UBOManager::GetUBO(UBOManager::VirtualUBO virtualUbo, uint32_t* pOffset, uint32_t* pRange) const noexcept {
         SR_TRACY_ZONE;
 
         auto&& pShaderHandle = m_pipeline->GetCurrentShaderHandle();
@@ -185,6 +285,12 @@ namespace SR_GRAPH_NS::Memory {
         auto&& info = m_uboPool.At(virtualUbo);
         for (auto&& data : info.data) {
             if (data.pShaderHandle == pShaderHandle || info.shared) SR_LIKELY_ATTRIBUTE {
+                if (pOffset) {
+                    *pOffset = data.fromPage ? data.offset : 0;
+                }
+                if (pRange) {
+                    *pRange = data.fromPage ? data.uboSize : 0;
+                }
                 return data.ubo;
             }
         }
@@ -208,9 +314,7 @@ namespace SR_GRAPH_NS::Memory {
                 VirtualUBOInfo::Data& data = *pIt;
 
                 if (handles.count(data.pShaderHandle) == 0) {
-                    if (data.uboSize > 0) {
-                        m_pipeline->FreeUBO(&data.ubo);
-                    }
+                    FreeMemory(data);
                     pIt = virtualUboInfo.data.erase(pIt);
                     ++count;
                 }
@@ -64,6 +64,7 @@ namespace SR_GRAPH_NS {
                 (*meshGroup.begin())->BindMesh();
 
                 for (auto&& pMesh : meshGroup) {
+                    pMesh->SetInstancing(SR_ID_INVALID, 1);
                     pMesh->Draw();
                 }
             }
@@ -36,6 +36,36 @@ namespace SR_GRAPH_NS {
         ClearOverrideShaders();
 
         if (auto&& shaderOverrideNode = passNode.TryGetNode("Shaders")) {
+            /// Все шейдеры прохода компилируются разом, загрузка ниже находит их в менеджере ресурсов
+            std::vector<SR_UTILS_NS::Path> preloadPaths;
+
+            for (auto&& overrideNode : shaderOverrideNode.TryGetNodes("Override")) {
+                if (auto&& shaderPath = overrideNode.TryGetAttribute("Shader").ToString(std::string()); !shaderPath.empty()) {
+                    preloadPaths.emplace_back(shaderPath);
+                }
+
+                if (auto&& shaderPathAttribute = overrideNode.TryGetAttribute("Path")) {
+                    preloadPaths.emplace_back(shaderPathAttribute.ToString());
+                }
+            }
+
+            auto&& preloaded = SR_GTYPES_NS::Shader::Load(preloadPaths);
+
+            /// Ошибки компиляции уже выведены, повторно такие шейдеры не загружаются
+            std::unordered_map<std::string, SR_GTYPES_NS::Shader*> preloadedShaders;
+
+            for (uint32_t i = 0; i < preloaded.size(); ++i) {
+                if (preloaded[i]) {
+                    preloaded[i]->AddUsePoint();
+                }
+                preloadedShaders[preloadPaths[i].ToString()] = preloaded[i];
+            }
+
+            auto&& getShader = [&preloadedShaders](const std::string& path) -> SR_GTYPES_NS::Shader* {
+                auto&& pIt = preloadedShaders.find(path);
+                return pIt == preloadedShaders.end() ? nullptr : pIt->second;
+            };
+
             for (auto&& overrideNode : shaderOverrideNode.TryGetNodes("Override")) {
                 auto&& shaderPath = overrideNode.TryGetAttribute("Shader").ToString(std::string());
                 const bool ignoreReplace = overrideNode.TryGetAttribute("Ignore").ToBool(false);
@@ -59,7 +89,7 @@ namespace SR_GRAPH_NS {
                         continue;
                     }
 
-                    if (auto&& pShader = SR_GTYPES_NS::Shader::Load(shaderPath)) {
+                    if (auto&& pShader = getShader(shaderPath)) {
                         pShader->AddUsePoint();
                         shaderReplaceInfo.pShader = pShader;
                         m_shaderTypeReplacements[shaderType] = shaderReplaceInfo;
@@ -79,7 +109,7 @@ namespace SR_GRAPH_NS {
                         continue;
                     }
 
-                    auto&& pKeyShader = SR_GTYPES_NS::Shader::Load(shaderPathAttribute.ToString());
+                    auto&& pKeyShader = getShader(shaderPathAttribute.ToString());
                     if (pKeyShader) {
                         pKeyShader->AddUsePoint();
                     }
@@ -95,7 +125,7 @@ namespace SR_GRAPH_NS {
                         continue;
                     }
 
-                    auto&& pShader = SR_GTYPES_NS::Shader::Load(shaderPath);
+                    auto&& pShader = getShader(shaderPath);
                     if (pShader) {
                         pShader->AddUsePoint();
                     }
@@ -109,6 +139,12 @@ namespace SR_GRAPH_NS {
                     m_shaderReplacements[pKeyShader] = shaderReplaceInfo;
                 }
             }
+
+            for (auto&& pShader : preloaded) {
+                if (pShader) {
+                    pShader->RemoveUsePoint();
+                }
+            }
         }
 
         if (auto&& allowedLayersNode = passNode.TryGetNode("AllowedLayers")) {
@@ -124,6 +160,11 @@ namespace SR_GRAPH_NS {
         }
 
         m_useMaterials = passNode.TryGetAttribute("UseMaterials").ToBool(true);
+        m_frustumCulling = passNode.TryGetAttribute("FrustumCulling").ToBool(true);
+        m_instancing = passNode.TryGetAttribute("Instancing").ToBool(true);
+        m_indirectDraw = passNode.TryGetAttribute("IndirectDraw").ToBool(true);
+        m_lod = passNode.TryGetAttribute("MeshLod").ToBool(true);
+        m_lodErrorThreshold = passNode.TryGetAttribute("LodErrorThreshold").ToFloat(1.f);
 
         ISamplersPass::LoadSamplersPass(passNode);
 
@@ -155,6 +196,12 @@ namespace SR_GRAPH_NS {
             return false;
         }
 
+        /// Проход перестраивается, слоты ищутся заново только для шейдеров, которые в нем остались.
+        /// Уничтожение шейдера делает сцены рендера грязными, поэтому его запись уходит здесь же
+        if (layer == 0 && GetPassPipeline()->GetCurrentBuildIteration() == 0) {
+            m_sharedUniformSlots.clear();
+        }
+
         return m_renderQueues[layer]->Render();
     }
 
@@ -183,32 +230,64 @@ namespace SR_GRAPH_NS {
         SR_TRACY_ZONE;
 
         const auto pShader = info.pShader;
+        auto&& slots = GetSharedUniformSlots(pShader);
 
-        pShader->SetFloat(SHADER_TIME, static_cast<float_t>(m_time.Clock()));
+        const auto time = static_cast<float_t>(m_time.Clock());
+        pShader->SetValue<false>(slots.time, &time);
 
         if (m_camera) SR_LIKELY_ATTRIBUTE {
-            pShader->SetMat4(SHADER_VIEW_MATRIX, m_camera->GetViewTranslate());
-            pShader->SetMat4(SHADER_PROJECTION_MATRIX, m_camera->GetProjection());
-            pShader->SetMat4(SHADER_ORTHOGONAL_MATRIX, m_camera->GetOrthogonal());
-            pShader->SetVec3(SHADER_VIEW_DIRECTION, m_camera->GetViewDirection());
-            pShader->SetVec3(SHADER_VIEW_POSITION, m_camera->GetPosition());
+            pShader->SetValue<false>(slots.viewMatrix, &m_camera->GetViewTranslate());
+            pShader->SetValue<false>(slots.projectionMatrix, &m_camera->GetProjection());
+            pShader->SetValue<false>(slots.orthogonalMatrix, &m_camera->GetOrthogonal());
+            pShader->SetValue<false>(slots.viewDirection, &m_camera->GetViewDirection());
+            pShader->SetValue<false>(slots.viewPosition, &m_camera->GetPosition());
         }
 
-        pShader->SetVec3(SHADER_DIRECTIONAL_LIGHT_POSITION, GetRenderScene()->GetLightSystem()->GetDirectionalLightPosition());
+        auto&& pLightSystem = GetRenderScene()->GetLightSystem();
+
+        pShader->SetValue<false>(slots.directionalLightPosition, &pLightSystem->GetDirectionalLightPosition());
+        pShader->SetValue<false>(slots.lightClusterGrid, &pLightSystem->GetClusters().GetGrid());
+        pShader->SetValue<false>(slots.lightClusterDepth, &pLightSystem->GetClusters().GetDepth());
 
         if (m_cascadedShadowMapPass) {
-            pShader->SetValue<false>(SHADER_CASCADE_LIGHT_SPACE_MATRICES, m_cascadedShadowMapPass->GetCascadeMatrices().data());
-            pShader->SetValue<false>(SHADER_CASCADE_SPLITS, m_cascadedShadowMapPass->GetSplitDepths().data());
+            pShader->SetValue<false>(slots.cascadeLightSpaceMatrices, m_cascadedShadowMapPass->GetCascadeMatrices().data());
+            pShader->SetValue<false>(slots.cascadeSplits, m_cascadedShadowMapPass->GetSplitDepths().data());
         }
         else if (m_shadowMapPass) {
-            pShader->SetMat4(SHADER_LIGHT_SPACE_MATRIX, m_shadowMapPass->GetLightSpaceMatrix());
+            pShader->SetValue<false>(slots.lightSpaceMatrix, &m_shadowMapPass->GetLightSpaceMatrix());
         }
     }
 
+    const MeshDrawerPass::SharedUniformSlots& MeshDrawerPass::GetSharedUniformSlots(ShaderPtr pShader) {
+        auto&& slots = m_sharedUniformSlots[pShader];
+
+        /// шейдер перезагрузился или на его месте оказался другой
+        if (!pShader->IsSlotValid(slots.time)) SR_UNLIKELY_ATTRIBUTE {
+            slots.time = pShader->GetSlot<float_t>(SHADER_TIME);
+            slots.viewMatrix = pShader->GetSlot<SR_MATH_NS::Matrix4x4>(SHADER_VIEW_MATRIX);
+            slots.projectionMatrix = pShader->GetSlot<SR_MATH_NS::Matrix4x4>(SHADER_PROJECTION_MATRIX);
+            slots.orthogonalMatrix = pShader->GetSlot<SR_MATH_NS::Matrix4x4>(SHADER_ORTHOGONAL_MATRIX);
+            slots.viewDirection = pShader->GetSlot<SR_MATH_NS::FVector3>(SHADER_VIEW_DIRECTION);
+            slots.viewPosition = pShader->GetSlot<SR_MATH_NS::FVector3>(SHADER_VIEW_POSITION);
+            slots.directionalLightPosition = pShader->GetSlot<SR_MATH_NS::FVector3>(SHADER_DIRECTIONAL_LIGHT_POSITION);
+            slots.cascadeLightSpaceMatrices = pShader->GetSlot<SR_MATH_NS::Matrix4x4>(SHADER_CASCADE_LIGHT_SPACE_MATRICES);
+            slots.cascadeSplits = pShader->GetSlot<float_t>(SHADER_CASCADE_SPLITS);
+            slots.lightSpaceMatrix = pShader->GetSlot<SR_MATH_NS::Matrix4x4>(SHADER_LIGHT_SPACE_MATRIX);
+            slots.lightClusterGrid = pShader->GetSlot<SR_MATH_NS::FVector4>(SHADER_LIGHT_CLUSTER_GRID);
+            slots.lightClusterDepth = pShader->GetSlot<SR_MATH_NS::FVector4>(SHADER_LIGHT_CLUSTER_DEPTH);
+        }
+
+        return slots;
+    }
+
     void MeshDrawerPass::UseConstants(ShaderUseInfo info) {
         info.pShader->SetConstInt(SHADER_COLOR_BUFFER_MODE, 0);
     }
 
+    void MeshDrawerPass::UseSSBO(ShaderUseInfo info) {
+        GetRenderScene()->GetLightSystem()->BindClusters(info.pShader);
+    }
+
     RenderStrategy* MeshDrawerPass::GetRenderStrategy() const {
         return GetRenderScene()->GetRenderStrategy();
     }
@@ -265,6 +344,7 @@ namespace SR_GRAPH_NS {
 
     void MeshDrawerPass::DeInit() {
         ClearOverrideShaders();
+        m_sharedUniformSlots.clear();
         for (auto&& pRenderQueue : m_renderQueues) {
             pRenderQueue.AutoFree();
         }
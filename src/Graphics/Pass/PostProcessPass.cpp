@@ -41,7 +41,7 @@ namespace SR_GRAPH_NS {
         if (GetPassPipeline()->GetCurrentBuildIteration() == 0) {
             if (result == DescriptorManager::BindResult::Duplicated || m_dirtyShader) SR_UNLIKELY_ATTRIBUTE {
                 UseSamplers(ShaderUseInfo(m_shader));
-                m_descriptorManager.Flush();
+                m_descriptorManager.Flush(m_virtualDescriptor);
             }
             GetPassPipeline()->GetCurrentShader()->FlushConstants();
         }
@@ -3,3 +3,764 @@
 //
 
 #include <Graphics/Pipeline/EmptyPipeline.h>
+#include <Graphics/Types/Framebuffer.h>
+#include <Graphics/Types/Shader.h>
+
+namespace SR_GRAPH_NS {
+    EmptyPipeline::~EmptyPipeline() {
+        SRAssert2(m_fboPool.GetAliveCount() == 0, "Frame buffers are not freed!");
+        SRAssert2(m_shaderProgramPool.GetAliveCount() == 0, "Shader programs are not freed!");
+    }
+
+    bool EmptyPipeline::PreInit(const PipelinePreInitInfo& info) {
+        if (!Super::PreInit(info)) {
+            PipelineError("EmptyPipeline::PreInit() : failed to pre-initialize pipeline!");
+            return false;
+        }
+
+        m_vsync = info.vsync;
+
+        /// Мультисемплинга нет, но вызывающий код ожидает хотя бы один сэмпл
+        m_supportedSampleCount = 1;
+        m_currentSampleCount = 1;
+
+        return true;
+    }
+
+    bool EmptyPipeline::Init() {
+        SR_GRAPH("EmptyPipeline::Init() : initializing empty pipeline...");
+
+        m_commands.reserve(4096);
+        m_previousCommands.reserve(4096);
+
+        return Super::Init();
+    }
+
+    bool EmptyPipeline::Destroy() {
+        SR_INFO("EmptyPipeline::Destroy() : destroying empty pipeline...");
+
+        DestroyOverlay();
+
+        std::vector<int32_t> leaked;
+
+        m_fboPool.ForEach([&leaked](int32_t index, FrameBuffer*) { leaked.emplace_back(index); });
+        for (auto&& index : leaked) {
+            delete m_fboPool.RemoveByIndex(index);
+        }
+
+        leaked.clear();
+
+        m_shaderProgramPool.ForEach([&leaked](int32_t index, ShaderProgram*) { leaked.emplace_back(index); });
+        for (auto&& index : leaked) {
+            delete m_shaderProgramPool.RemoveByIndex(index);
+        }
+
+        m_currentShaderProgram = nullptr;
+
+        m_commands.clear();
+        m_previousCommands.clear();
+        m_buildCommands.clear();
+
+        return Super::Destroy();
+    }
+
+    void EmptyPipeline::Record(EmptyCommandType type, int32_t resource, uint64_t value, uint8_t slot) {
+        const auto index = static_cast<uint32_t>(type);
+
+        if (index >= m_counters.size()) SR_UNLIKELY_ATTRIBUTE {
+            m_counters.resize(index + 1, 0);
+        }
+
+        ++m_counters[index];
+
+        if (!m_recordingEnabled) {
+            return;
+        }
+
+        EmptyCommand& command = m_commands.emplace_back();
+        command.type = type;
+        command.slot = slot;
+        command.resource = resource;
+        command.value = value;
+    }
+
+    uint32_t EmptyPipeline::GetCommandsCount(EmptyCommandType type) const noexcept {
+        const auto index = static_cast<uint32_t>(type);
+        return index < m_counters.size() ? m_counters[index] : 0;
+    }
+
+    uint32_t EmptyPipeline::GetPreviousCommandsCount(EmptyCommandType type) const noexcept {
+        const auto index = static_cast<uint32_t>(type);
+        return index < m_previousCounters.size() ? m_previousCounters[index] : 0;
+    }
+
+    /// ----------------------------------------------------------------------------------------------------------------
+
+    void EmptyPipeline::DrawFrame() {
+        SR_TRACY_ZONE;
+
+        Super::DrawFrame();
+
+        ++m_framesCount;
+
+        std::swap(m_previousCommands, m_commands);
+        m_commands.clear();
+
+        std::swap(m_previousCounters, m_counters);
+        m_counters.assign(m_counters.size(), 0);
+    }
+
+    void EmptyPipeline::SetDirty(bool dirty) {
+        Super::SetDirty(dirty);
+
+        if (!m_dirty) {
+            m_buildCommands = m_commands;
+        }
+    }
+
+    bool EmptyPipeline::BeginCmdBuffer() {
+        Record(EmptyCommandType::BeginCmdBuffer, m_state.frameBufferId);
+        return Super::BeginCmdBuffer();
+    }
+
+    void EmptyPipeline::EndCmdBuffer() {
+        Record(EmptyCommandType::EndCmdBuffer, m_state.frameBufferId);
+        Super::EndCmdBuffer();
+    }
+
+    bool EmptyPipeline::BeginRender() {
+        if (!Super::BeginRender()) {
+            return false;
+        }
+
+        Record(EmptyCommandType::BeginRender, m_state.frameBufferId, m_state.frameBufferLayer);
+
+        return true;
+    }
+
+    void EmptyPipeline::EndRender() {
+        Record(EmptyCommandType::EndRender, m_state.frameBufferId, m_state.frameBufferLayer);
+        Super::EndRender();
+    }
+
+    void EmptyPipeline::SetViewport(int32_t width, int32_t height) {
+        Super::SetViewport(width, height);
+        Record(EmptyCommandType::SetViewport, SR_ID_INVALID, (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32U) | static_cast<uint32_t>(height));
+    }
+
+    void EmptyPipeline::SetScissor(int32_t width, int32_t height) {
+        Super::SetScissor(width, height);
+        Record(EmptyCommandType::SetScissor, SR_ID_INVALID, (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32U) | static_cast<uint32_t>(height));
+    }
+
+    void EmptyPipeline::ClearBuffers() {
+        Super::ClearBuffers();
+        Record(EmptyCommandType::ClearBuffers);
+    }
+
+    void EmptyPipeline::ClearBuffers(float_t r, float_t g, float_t b, float_t a, float_t depth, uint8_t colorCount) {
+        Super::ClearBuffers(r, g, b, a, depth, colorCount);
+        Record(EmptyCommandType::ClearBuffers, SR_ID_INVALID, colorCount);
+    }
+
+    void EmptyPipeline::ClearBuffers(const ClearColors& clearColors, std::optional<float_t> depth) {
+        Super::ClearBuffers(clearColors, depth);
+        Record(EmptyCommandType::ClearBuffers, SR_ID_INVALID, clearColors.size());
+    }
+
+    void EmptyPipeline::ClearDepthBuffer(float_t depth) {
+        Super::ClearDepthBuffer(depth);
+        Record(EmptyCommandType::ClearDepthBuffer);
+    }
+
+    void EmptyPipeline::ClearColorBuffer(const ClearColors& clearColors) {
+        Super::ClearColorBuffer(clearColors);
+        Record(EmptyCommandType::ClearColorBuffer, SR_ID_INVALID, clearColors.size());
+    }
+
+    /// ----------------------------------------------------------------------------------------------------------------
+
+    void EmptyPipeline::UseShader(uint32_t shaderProgram) {
+        Super::UseShader(shaderProgram);
+
+        auto&& pShaderProgram = m_shaderProgramPool.IsAlive(static_cast<int32_t>(shaderProgram))
+            ? m_shaderProgramPool.At(static_cast<int32_t>(shaderProgram)) : nullptr;
+
+        if (!pShaderProgram) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::UseShader() : shader program is not exists! Id: " + SR_UTILS_NS::ToString(shaderProgram));
+            return;
+        }
+
+        m_isShaderChanged = pShaderProgram != m_currentShaderProgram;
+        m_currentShaderProgram = pShaderProgram;
+
+        if (m_isShaderChanged) {
+            m_shadowState.ResetShader();
+        }
+
+        Record(EmptyCommandType::UseShader, static_cast<int32_t>(shaderProgram));
+    }
+
+    void EmptyPipeline::UnUseShader() {
+        Super::UnUseShader();
+        Record(EmptyCommandType::UnUseShader);
+    }
+
+    void EmptyPipeline::ResetLastShader() {
+        m_currentShaderProgram = nullptr;
+        Super::ResetLastShader();
+    }
+
+    void EmptyPipeline::Draw(uint32_t count) {
+        Super::Draw(count);
+        Record(EmptyCommandType::Draw, m_state.shaderId, count);
+    }
+
+    void EmptyPipeline::DrawIndices(uint32_t count, uint32_t firstIndex) {
+        Super::DrawIndices(count, firstIndex);
+        Record(EmptyCommandType::DrawIndices, m_state.shaderId, (static_cast<uint64_t>(firstIndex) << 32U) | count);
+    }
+
+    void EmptyPipeline::DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex) {
+        Super::DrawIndicesInstanced(count, instanceCount, firstIndex);
+        Record(EmptyCommandType::DrawIndicesInstanced, m_state.shaderId, (static_cast<uint64_t>(instanceCount) << 32U) | count);
+    }
+
+    void EmptyPipeline::DrawInstanced(uint32_t count, uint32_t instanceCount) {
+        Super::DrawInstanced(count, instanceCount);
+        Record(EmptyCommandType::DrawInstanced, m_state.shaderId, (static_cast<uint64_t>(instanceCount) << 32U) | count);
+    }
+
+    void EmptyPipeline::DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount) {
+        Super::DrawIndicesIndirect(buffer, first, drawCount);
+        UpdateBuffer(m_indirectPool, buffer, static_cast<uint64_t>(first + drawCount) * sizeof(DrawIndexedIndirectCommand), "indirect buffer");
+        Record(EmptyCommandType::DrawIndicesIndirect, static_cast<int32_t>(buffer), (static_cast<uint64_t>(first) << 32U) | drawCount);
+    }
+
+    void EmptyPipeline::DrawIndirect(uint32_t buffer) {
+        Super::DrawIndirect(buffer);
+        UpdateBuffer(m_indirectPool, buffer, sizeof(DrawIndirectCommand), "indirect buffer");
+        Record(EmptyCommandType::DrawIndirect, static_cast<int32_t>(buffer));
+    }
+
+    void EmptyPipeline::BindFrameBuffer(FramebufferPtr pFBO) {
+        Super::BindFrameBuffer(pFBO);
+        Record(EmptyCommandType::BindFrameBuffer, pFBO ? pFBO->GetId() : 0);
+    }
+
+    void EmptyPipeline::BindVBO(uint32_t VBO) {
+        Super::BindVBO(VBO);
+        SRAssert2(m_vboPool.IsAlive(static_cast<int32_t>(VBO)), "Invalid VBO!");
+
+        if (!FilterVBO(VBO)) {
+            return;
+        }
+
+        Record(EmptyCommandType::BindVBO, static_cast<int32_t>(VBO));
+    }
+
+    void EmptyPipeline::BindIBO(uint32_t IBO) {
+        Super::BindIBO(IBO);
+        SRAssert2(m_iboPool.IsAlive(static_cast<int32_t>(IBO)), "Invalid IBO!");
+
+        if (!FilterIBO(IBO)) {
+            return;
+        }
+
+        Record(EmptyCommandType::BindIBO, static_cast<int32_t>(IBO));
+    }
+
+    void EmptyPipeline::BindUBO(uint32_t UBO) {
+        Super::BindUBO(UBO);
+        Record(EmptyCommandType::BindUBO, static_cast<int32_t>(UBO));
+    }
+
+    void EmptyPipeline::BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range) {
+        Super::BindUBORange(UBO, offset, range);
+        UpdateBuffer(m_uboPool, UBO, static_cast<uint64_t>(offset) + range, "UBO");
+        Record(EmptyCommandType::BindUBO, static_cast<int32_t>(UBO), (static_cast<uint64_t>(offset) << 32U) | range);
+    }
+
+    void EmptyPipeline::BindSSBO(uint32_t SSBO) {
+        Super::BindSSBO(SSBO);
+        Record(EmptyCommandType::BindSSBO, static_cast<int32_t>(SSBO));
+    }
+
+    void EmptyPipeline::BindTexture(uint8_t activeTexture, uint32_t textureId) {
+        Super::BindTexture(activeTexture, textureId);
+
+        if (!IsSamplerValid(static_cast<int32_t>(textureId))) {
+            PipelineError("EmptyPipeline::BindTexture() : texture is not exists! Id: " + SR_UTILS_NS::ToString(textureId));
+            return;
+        }
+
+        if (!FilterTexture(activeTexture, textureId)) {
+            return;
+        }
+
+        Record(EmptyCommandType::BindTexture, static_cast<int32_t>(textureId), 0, activeTexture);
+    }
+
+    void EmptyPipeline::BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture) {
+        Super::BindTextureTable(binding, textures, first, count, fallbackTexture);
+
+        if (!IsSamplerValid(fallbackTexture)) {
+            PipelineError("EmptyPipeline::BindTextureTable() : fallback texture is not exists! Id: " + SR_UTILS_NS::ToString(fallbackTexture));
+            return;
+        }
+
+        Record(EmptyCommandType::BindTextureTable, fallbackTexture, (static_cast<uint64_t>(first) << 32) | count, binding);
+    }
+
+    void EmptyPipeline::BindAttachment(uint8_t activeTexture, uint32_t textureId) {
+        Super::BindAttachment(activeTexture, textureId);
+
+        if (!IsSamplerValid(static_cast<int32_t>(textureId))) {
+            PipelineError("EmptyPipeline::BindAttachment() : texture is not exists!");
+            return;
+        }
+
+        Record(EmptyCommandType::BindAttachment, static_cast<int32_t>(textureId), 0, activeTexture);
+    }
+
+    bool EmptyPipeline::BindDescriptorSet(uint32_t descriptorSet) {
+        if (!Super::BindDescriptorSet(descriptorSet)) {
+            return false;
+        }
+
+        Record(EmptyCommandType::BindDescriptorSet, static_cast<int32_t>(descriptorSet));
+
+        return true;
+    }
+
+    void EmptyPipeline::UpdateDescriptorSets(uint32_t descriptorSet, const SRDescriptorUpdateInfos& updateInfo) {
+        Super::UpdateDescriptorSets(descriptorSet, updateInfo);
+
+        if (!m_descriptorSetPool.IsAlive(static_cast<int32_t>(descriptorSet))) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::UpdateDescriptorSets() : descriptor set is not exists!");
+            return;
+        }
+
+        Record(EmptyCommandType::UpdateDescriptorSets, static_cast<int32_t>(descriptorSet), updateInfo.size());
+    }
+
+    void EmptyPipeline::UpdateUBO(uint32_t UBO, void* pData, uint64_t size) {
+        Super::UpdateUBO(UBO, pData, size);
+        UpdateBuffer(m_uboPool, UBO, size, "UBO");
+        Record(EmptyCommandType::UpdateUBO, static_cast<int32_t>(UBO), size);
+    }
+
+    void EmptyPipeline::UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset) {
+        Super::UpdateUBORange(UBO, pData, size, offset);
+        UpdateBuffer(m_uboPool, UBO, offset + size, "UBO");
+        Record(EmptyCommandType::UpdateUBO, static_cast<int32_t>(UBO), (offset << 32U) | size);
+    }
+
+    void EmptyPipeline::UpdateSSBO(uint32_t SSBO, void* pData, uint64_t size) {
+        Super::UpdateSSBO(SSBO, pData, size);
+        UpdateBuffer(m_ssboPool, SSBO, size, "SSBO");
+        Record(EmptyCommandType::UpdateSSBO, static_cast<int32_t>(SSBO), size);
+    }
+
+    void EmptyPipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count) {
+        Super::UpdateIndirectBuffer(buffer, pCommands, count);
+        UpdateBuffer(m_indirectPool, buffer, count * sizeof(DrawIndexedIndirectCommand), "indirect buffer");
+        Record(EmptyCommandType::UpdateIndirectBuffer, static_cast<int32_t>(buffer), count);
+    }
+
+    void EmptyPipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command) {
+        Super::UpdateIndirectBuffer(buffer, command);
+        UpdateBuffer(m_indirectPool, buffer, sizeof(DrawIndirectCommand), "indirect buffer");
+        Record(EmptyCommandType::UpdateIndirectBuffer, static_cast<int32_t>(buffer), 1);
+    }
+
+    void EmptyPipeline::PushConstants(void* pData, uint64_t size) {
+        Super::PushConstants(pData, size);
+
+        if (!m_currentShaderProgram) SR_UNLIKELY_ATTRIBUTE {
+            SRHalt("Shader is nullptr!");
+            return;
+        }
+
+        if (!FilterPushConstants(pData, size)) {
+            return;
+        }
+
+        Record(EmptyCommandType::PushConstants, m_state.shaderId, size);
+    }
+
+    /// ----------------------------------------------------------------------------------------------------------------
+
+    void* EmptyPipeline::GetCurrentShaderHandle() const {
+        ++m_state.operations;
+
+        if (!m_state.pShader) SR_UNLIKELY_ATTRIBUTE {
+            return nullptr;
+        }
+
+        auto&& shaderProgram = m_state.pShader->GetId();
+        if (shaderProgram == SR_ID_INVALID || !m_shaderProgramPool.IsAlive(shaderProgram)) SR_UNLIKELY_ATTRIBUTE {
+            return nullptr;
+        }
+
+        return (void*)m_shaderProgramPool.At(shaderProgram);
+    }
+
+    void* EmptyPipeline::GetCurrentFBOHandle() const {
+        if (m_state.pFrameBuffer) SR_LIKELY_ATTRIBUTE {
+            auto&& FBO = m_state.pFrameBuffer->GetId();
+
+            if (FBO == SR_ID_INVALID || !m_fboPool.IsAlive(FBO - 1)) SR_UNLIKELY_ATTRIBUTE {
+                PipelineError("EmptyPipeline::GetCurrentFBOHandle() : invalid FBO!");
+                return nullptr;
+            }
+
+            auto&& layers = m_fboPool.At(FBO - 1)->layers;
+            return (void*)&layers[SR_MIN(layers.size() - 1, m_state.frameBufferLayer)];
+        }
+
+        return (void*)this; /// Кадровый буфер окна
+    }
+
+    std::set<void*> EmptyPipeline::GetFBOHandles() const {
+        std::set<void*> handles = { (void*)this };
+
+        m_fboPool.ForEach([&handles](int32_t, FrameBuffer* pFrameBuffer) {
+            for (auto&& layer : pFrameBuffer->layers) {
+                handles.insert((void*)&layer);
+            }
+        });
+
+        return handles;
+    }
+
+    std::set<void*> EmptyPipeline::GetShaderHandles() const {
+        std::set<void*> handles;
+
+        m_shaderProgramPool.ForEach([&handles](int32_t, ShaderProgram* pShaderProgram) {
+            handles.insert((void*)pShaderProgram);
+        });
+
+        return handles;
+    }
+
+    uint8_t EmptyPipeline::GetFrameBufferSampleCount() const {
+        ++m_state.operations;
+
+        if (m_state.pFrameBuffer) {
+            return m_state.pFrameBuffer->GetSamplesCount();
+        }
+
+        return GetSamplesCount();
+    }
+
+    bool EmptyPipeline::IsSamplerValid(int32_t id) const {
+        return id >= 0 && m_texturePool.IsAlive(id);
+    }
+
+    /// ----------------------------------------------------------------------------------------------------------------
+
+    int32_t EmptyPipeline::AllocateBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, uint64_t size) {
+        ++m_state.operations;
+        ++m_state.allocations;
+        m_state.allocatedMemory += size;
+
+        m_usedMemory += size;
+
+        Buffer buffer;
+        buffer.size = size;
+
+        return pool.Add(buffer);
+    }
+
+    bool EmptyPipeline::FreeBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, int32_t* id, const char* name) {
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        if (*id == SR_ID_INVALID || !pool.IsAlive(*id)) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError(std::string("EmptyPipeline::FreeBuffer() : failed to free ") + name + "! (" + std::to_string(*id) + ")");
+            *id = SR_ID_INVALID;
+            return false;
+        }
+
+        m_usedMemory -= pool.RemoveByIndex(*id).size;
+
+        *id = SR_ID_INVALID;
+
+        return true;
+    }
+
+    void EmptyPipeline::UpdateBuffer(SR_HTYPES_NS::ObjectPool<Buffer, int32_t>& pool, uint32_t id, uint64_t size, const char* name) {
+        if (!pool.IsAlive(static_cast<int32_t>(id))) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError(std::string("EmptyPipeline::UpdateBuffer() : ") + name + " is not exists! Id: " + std::to_string(id));
+            return;
+        }
+
+        if (pool.At(static_cast<int32_t>(id)).size < size) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError(std::string("EmptyPipeline::UpdateBuffer() : ") + name + " overflow! Id: " + std::to_string(id));
+        }
+    }
+
+    int32_t EmptyPipeline::AllocateUBO(uint32_t uboSize) {
+        SRAssert2(uboSize > 0, "Incorrect UBO size!");
+        return AllocateBuffer(m_uboPool, uboSize);
+    }
+
+    int32_t EmptyPipeline::AllocateVBO(void* pVertices, Vertices::VertexType type, size_t count) {
+        return AllocateBuffer(m_vboPool, Vertices::GetVertexSize(type) * count);
+    }
+
+    int32_t EmptyPipeline::AllocateIBO(void* pIndices, uint32_t indexSize, size_t count, int32_t VBO) {
+        return AllocateBuffer(m_iboPool, indexSize * count);
+    }
+
+    int32_t EmptyPipeline::AllocateSSBO(uint32_t size, SSBOUsage usage) {
+        SRAssert2(size > 0, "Incorrect SSBO size!");
+        return AllocateBuffer(m_ssboPool, size);
+    }
+
+    int32_t EmptyPipeline::AllocateIndirectBuffer(uint32_t commandsCount) {
+        SRAssert2(commandsCount > 0, "Incorrect indirect buffer size!");
+        return AllocateBuffer(m_indirectPool, commandsCount * sizeof(DrawIndexedIndirectCommand));
+    }
+
+    bool EmptyPipeline::FreeVBO(int32_t* id) { ForgetShadowVBO(*id); return FreeBuffer(m_vboPool, id, "VBO"); }
+    bool EmptyPipeline::FreeIBO(int32_t* id) { ForgetShadowIBO(*id); return FreeBuffer(m_iboPool, id, "IBO"); }
+    bool EmptyPipeline::FreeUBO(int32_t* id) { OnResourceFreed(DescriptorType::Uniform, *id); return FreeBuffer(m_uboPool, id, "UBO"); }
+    bool EmptyPipeline::FreeSSBO(int32_t* id) { OnResourceFreed(DescriptorType::Storage, *id); return FreeBuffer(m_ssboPool, id, "SSBO"); }
+    bool EmptyPipeline::FreeIndirectBuffer(int32_t* id) { return FreeBuffer(m_indirectPool, id, "indirect buffer"); }
+
+    int32_t EmptyPipeline::AllocDescriptorSet(const std::vector<DescriptorType>& types) {
+        ++m_state.operations;
+        ++m_state.allocations;
+
+        if (m_state.shaderId < 0) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::AllocDescriptorSet() : shader program is not set!");
+            SRHaltOnce0();
+            return SR_ID_INVALID;
+        }
+
+        return m_descriptorSetPool.Add(types);
+    }
+
+    bool EmptyPipeline::FreeDescriptorSet(int32_t* id) {
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        ForgetShadowTextures();
+
+        if (*id == SR_ID_INVALID || !m_descriptorSetPool.IsAlive(*id)) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::FreeDescriptorSet() : failed to free descriptor set!");
+            *id = SR_ID_INVALID;
+            return false;
+        }
+
+        m_descriptorSetPool.RemoveByIndex(*id);
+        *id = SR_ID_INVALID;
+
+        return true;
+    }
+
+    int32_t EmptyPipeline::AllocateShaderProgram(const SRShaderCreateInfo& createInfo, int32_t fbo) {
+        ++m_state.operations;
+        ++m_state.allocations;
+
+        if (fbo < 0) {
+            SRHalt("EmptyPipeline::AllocateShaderProgram() : shaders requires valid FBO!");
+            return SR_ID_INVALID;
+        }
+
+        if (!createInfo.Validate()) {
+            PipelineError("EmptyPipeline::AllocateShaderProgram() : failed to validate shader create info!");
+            return SR_ID_INVALID;
+        }
+
+        if (createInfo.stages.empty()) {
+            PipelineError("EmptyPipeline::AllocateShaderProgram() : no shader modules were found!");
+            return SR_ID_INVALID;
+        }
+
+        auto&& pShaderProgram = new ShaderProgram();
+        pShaderProgram->frameBuffer = fbo;
+
+        return m_shaderProgramPool.Add(pShaderProgram);
+    }
+
+    bool EmptyPipeline::FreeShader(int32_t* id) {
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        if (*id == SR_ID_INVALID || !m_shaderProgramPool.IsAlive(*id)) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::FreeShader() : failed free shader program!");
+            return false;
+        }
+
+        auto&& pShaderProgram = m_shaderProgramPool.RemoveByIndex(*id);
+        m_freedShaderHandles.emplace_back((void*)pShaderProgram);
+
+        if (m_currentShaderProgram == pShaderProgram) {
+            m_currentShaderProgram = nullptr;
+        }
+
+        delete pShaderProgram;
+
+        *id = SR_ID_INVALID;
+
+        return true;
+    }
+
+    int32_t EmptyPipeline::AllocateTexture(const SRTextureCreateInfo& createInfo) {
+        ++m_state.operations;
+        ++m_state.allocations;
+
+        if (createInfo.width == 0 || createInfo.height == 0) {
+            PipelineError("EmptyPipeline::AllocateTexture() : width or height equals zero!");
+            return SR_ID_INVALID;
+        }
+
+        Texture texture;
+        texture.width = createInfo.width;
+        texture.height = createInfo.height;
+        texture.size = static_cast<uint64_t>(GetPixelSize(createInfo.format)) * createInfo.width * createInfo.height;
+
+        m_state.allocatedMemory += texture.size;
+        m_usedMemory += texture.size;
+
+        return m_texturePool.Add(texture);
+    }
+
+    int32_t EmptyPipeline::AllocateCubeMap(const SRCubeMapCreateInfo& createInfo) {
+        ++m_state.operations;
+        ++m_state.allocations;
+
+        Texture texture;
+        texture.width = createInfo.width;
+        texture.height = createInfo.height;
+        texture.size = static_cast<uint64_t>(4) * 6 * createInfo.width * createInfo.height;
+
+        m_state.allocatedMemory += texture.size;
+        m_usedMemory += texture.size;
+
+        return m_texturePool.Add(texture);
+    }
+
+    bool EmptyPipeline::FreeTextureImpl(int32_t* id, const char* name) {
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        OnResourceFreed(DescriptorType::CombinedImage, *id);
+
+        ForgetShadowTextures();
+
+        if (*id == SR_ID_INVALID || !m_texturePool.IsAlive(*id)) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError(std::string("EmptyPipeline::FreeTexture() : failed to free ") + name + "! (" + std::to_string(*id) + ")");
+            *id = SR_ID_INVALID;
+            return false;
+        }
+
+        m_usedMemory -= m_texturePool.RemoveByIndex(*id).size;
+
+        *id = SR_ID_INVALID;
+
+        return true;
+    }
+
+    bool EmptyPipeline::FreeTexture(int32_t* id) { return FreeTextureImpl(id, "texture"); }
+    bool EmptyPipeline::FreeCubeMap(int32_t* id) { return FreeTextureImpl(id, "cube map"); }
+
+    int32_t EmptyPipeline::AllocateAttachment(int32_t id, const SRTextureCreateInfo& createInfo) {
+        /// Вложениями владеет Framebuffer, поэтому при пересоздании идентификаторы сохраняются
+        if (id == SR_ID_INVALID || !m_texturePool.IsAlive(id)) {
+            return AllocateTexture(createInfo);
+        }
+
+        auto&& texture = m_texturePool.At(id);
+        m_usedMemory -= texture.size;
+
+        texture.width = createInfo.width;
+        texture.height = createInfo.height;
+        texture.size = static_cast<uint64_t>(GetPixelSize(createInfo.format)) * createInfo.width * createInfo.height;
+
+        m_usedMemory += texture.size;
+
+        return id;
+    }
+
+    int32_t EmptyPipeline::AllocateFrameBuffer(const SRFrameBufferCreateInfo& createInfo) {
+        SR_TRACY_ZONE;
+
+        ++m_state.allocations;
+        ++m_state.operations;
+
+        if (createInfo.size.x == 0 || createInfo.size.y == 0) {
+            PipelineError("EmptyPipeline::AllocateFrameBuffer() : width or height equals zero!");
+            return false;
+        }
+
+        if (*createInfo.pFBO == 0) {
+            PipelineError("EmptyPipeline::AllocateFrameBuffer() : zero frame buffer are default frame buffer!");
+            return false;
+        }
+
+        if (*createInfo.pFBO > 0 && !m_fboPool.IsAlive(*createInfo.pFBO - 1)) {
+            PipelineError("EmptyPipeline::AllocateFrameBuffer() : frame buffer is not exists!");
+            return false;
+        }
+
+        auto&& pFrameBuffer = *createInfo.pFBO > 0 ? m_fboPool.At(*createInfo.pFBO - 1) : new FrameBuffer();
+
+        pFrameBuffer->width = static_cast<uint32_t>(createInfo.size.x);
+        pFrameBuffer->height = static_cast<uint32_t>(createInfo.size.y);
+        pFrameBuffer->layersCount = SR_MAX(1U, createInfo.layersCount);
+
+        /// Хендлы слоев должны меняться при пересоздании, как и у настоящих кадровых буферов
+        pFrameBuffer->layers = std::vector<uint32_t>(pFrameBuffer->layersCount);
+
+        SRTextureCreateInfo textureCreateInfo;
+        textureCreateInfo.width = pFrameBuffer->width;
+        textureCreateInfo.height = pFrameBuffer->height;
+
+        for (auto&& color : (*createInfo.colors)) {
+            textureCreateInfo.format = color.format;
+            color.texture = AllocateAttachment(color.texture, textureCreateInfo);
+        }
+
+        if (createInfo.pDepth && createInfo.pDepth->format != ImageFormat::None && createInfo.pDepth->aspect != ImageAspect::None) {
+            textureCreateInfo.format = createInfo.pDepth->format == ImageFormat::Auto ? ImageFormat::D32_SFLOAT : createInfo.pDepth->format;
+
+            createInfo.pDepth->texture = AllocateAttachment(createInfo.pDepth->texture, textureCreateInfo);
+
+            if (pFrameBuffer->layersCount > 1) {
+                createInfo.pDepth->subLayers.resize(pFrameBuffer->layersCount, SR_ID_INVALID);
+                for (auto&& subLayer : createInfo.pDepth->subLayers) {
+                    subLayer = AllocateAttachment(subLayer, textureCreateInfo);
+                }
+            }
+        }
+
+        if (*createInfo.pFBO < 0) {
+            *createInfo.pFBO = m_fboPool.Add(pFrameBuffer) + 1;
+        }
+
+        return true;
+    }
+
+    bool EmptyPipeline::FreeFBO(int32_t* id) {
+        SR_TRACY_ZONE;
+
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        if (*id <= 0 || !m_fboPool.IsAlive(*id - 1)) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("EmptyPipeline::FreeFBO() : frame buffer is not exists!");
+            *id = SR_ID_INVALID;
+            return false;
+        }
+
+        delete m_fboPool.RemoveByIndex(*id - 1);
+
+        *id = SR_ID_INVALID;
+
+        return true;
+    }
+}
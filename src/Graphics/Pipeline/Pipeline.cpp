@@ -36,10 +36,12 @@ namespace SR_GRAPH_NS {
         SR_TRACY_ZONE;
 
         ++m_state.operations;
+        m_deletionsCount += m_state.deletions;
         m_previousState = m_state;
         m_state = PipelineState();
 
         ++m_frames;
+        ++m_frameIndex;
 
         auto&& now = SR_HTYPES_NS::Time::ClockT::now();
 
@@ -82,7 +84,7 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
     }
 
-    void Pipeline::DrawIndices(uint32_t count) {
+    void Pipeline::DrawIndices(uint32_t count, uint32_t firstIndex) {
         SR_PIPELINE_RENDER_GUARD(void())
         ++m_state.operations;
         ++m_state.drawCalls;
@@ -96,6 +98,32 @@ namespace SR_GRAPH_NS {
         m_state.vertices += count;
     }
 
+    void Pipeline::DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex) {
+        SR_PIPELINE_RENDER_GUARD(void())
+        ++m_state.operations;
+        ++m_state.drawCalls;
+        m_state.vertices += count * instanceCount;
+    }
+
+    void Pipeline::DrawInstanced(uint32_t count, uint32_t instanceCount) {
+        SR_PIPELINE_RENDER_GUARD(void())
+        ++m_state.operations;
+        ++m_state.drawCalls;
+        m_state.vertices += count * instanceCount;
+    }
+
+    void Pipeline::DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount) {
+        SR_PIPELINE_RENDER_GUARD(void())
+        ++m_state.operations;
+        ++m_state.drawCalls;
+    }
+
+    void Pipeline::DrawIndirect(uint32_t buffer) {
+        SR_PIPELINE_RENDER_GUARD(void())
+        ++m_state.operations;
+        ++m_state.drawCalls;
+    }
+
     bool Pipeline::BeginCmdBuffer() {
         ++m_state.operations;
 
@@ -110,6 +138,10 @@ namespace SR_GRAPH_NS {
         }
 
         m_isCmdState = true;
+
+        /// Новый буфер команд не наследует привязки предыдущего
+        m_shadowState.Reset();
+
         return true;
     }
 
@@ -154,6 +186,15 @@ namespace SR_GRAPH_NS {
     void Pipeline::BindUBO(uint32_t UBO) {
         ++m_state.operations;
         m_state.UBOId = static_cast<int32_t>(UBO);
+        m_state.UBOOffset = 0;
+        m_state.UBORange = 0;
+    }
+
+    void Pipeline::BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range) {
+        ++m_state.operations;
+        m_state.UBOId = static_cast<int32_t>(UBO);
+        m_state.UBOOffset = offset;
+        m_state.UBORange = range;
     }
 
     void Pipeline::BindSSBO(uint32_t SSBO) {
@@ -168,6 +209,14 @@ namespace SR_GRAPH_NS {
         ++m_state.transferredCount;
     }
 
+    void Pipeline::UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset) {
+        SRAssert(pData != nullptr && size > 0);
+        SRAssert2(offset % GetUBOOffsetAlignment() == 0, "Unaligned UBO offset!");
+        ++m_state.operations;
+        m_state.transferredMemory += size;
+        ++m_state.transferredCount;
+    }
+
     void Pipeline::UpdateSSBO(uint32_t SSBO, void *pData, uint64_t size) {
         SRAssert(pData != nullptr && size > 0);
         ++m_state.operations;
@@ -175,6 +224,19 @@ namespace SR_GRAPH_NS {
         ++m_state.transferredCount;
     }
 
+    void Pipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count) {
+        SRAssert(pCommands != nullptr && count > 0);
+        ++m_state.operations;
+        m_state.transferredMemory += count * sizeof(DrawIndexedIndirectCommand);
+        ++m_state.transferredCount;
+    }
+
+    void Pipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command) {
+        ++m_state.operations;
+        m_state.transferredMemory += sizeof(DrawIndirectCommand);
+        ++m_state.transferredCount;
+    }
+
     void Pipeline::PushConstants(void* pData, uint64_t size) {
         ++m_state.operations;
         m_state.transferredMemory += size;
@@ -186,15 +248,22 @@ namespace SR_GRAPH_NS {
         ++m_state.usedTextures;
     }
 
+    void Pipeline::BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture) {
+        ++m_state.operations;
+        ++m_state.usedTextures;
+        m_shadowState.textures.erase(PipelineShadowState::TextureKey(m_state.descriptorSetId, binding));
+    }
+
     void Pipeline::BindAttachment(uint8_t activeTexture, uint32_t textureId) {
         ++m_state.operations;
         ++m_state.usedTextures;
+        m_shadowState.textures.erase(PipelineShadowState::TextureKey(m_state.descriptorSetId, activeTexture));
     }
 
     bool Pipeline::BindDescriptorSet(uint32_t descriptorSet) {
         ++m_state.operations;
 
-        if (m_bindedDescriptors.Get(descriptorSet, false)) {
+        if (m_bindedDescriptors.Get(descriptorSet, false) && !m_sharedDescriptors.Get(descriptorSet, false)) {
             PipelineError("Pipeline::BindDescriptorSet() : descriptor set already binded!");
             return false;
         }
@@ -206,6 +275,10 @@ namespace SR_GRAPH_NS {
         return true;
     }
 
+    void Pipeline::SetDescriptorSetShared(uint32_t descriptorSet, bool shared) {
+        m_sharedDescriptors.Set(descriptorSet, shared);
+    }
+
     void Pipeline::UseShader(uint32_t shaderProgram) {
         ++m_state.operations;
         ++m_state.usedShaders;
@@ -338,6 +411,7 @@ namespace SR_GRAPH_NS {
 
     bool Pipeline::PreInit(const PipelinePreInitInfo& info) {
         m_requiredSampleCount = info.samplesCount;
+        m_isStateFilterEnabled = SR_UTILS_NS::Features::Instance().Enabled("PipelineStateFilter", true);
 
         m_preInitInfo = info;
         SRAssert2(m_requiredSampleCount >= 1 && m_requiredSampleCount <= 64, "Sample count must be greater 0 and less or equals 64!");
@@ -360,6 +434,90 @@ namespace SR_GRAPH_NS {
         SR_ERROR(msg);
     }
 
+    bool Pipeline::FilterVBO(uint32_t VBO) {
+        if (m_isStateFilterEnabled && m_shadowState.VBO == static_cast<int32_t>(VBO)) {
+            ++m_state.filteredOperations;
+            return false;
+        }
+
+        m_shadowState.VBO = static_cast<int32_t>(VBO);
+        ++m_state.issuedOperations;
+        return true;
+    }
+
+    bool Pipeline::FilterIBO(uint32_t IBO) {
+        if (m_isStateFilterEnabled && m_shadowState.IBO == static_cast<int32_t>(IBO)) {
+            ++m_state.filteredOperations;
+            return false;
+        }
+
+        m_shadowState.IBO = static_cast<int32_t>(IBO);
+        ++m_state.issuedOperations;
+        return true;
+    }
+
+    bool Pipeline::FilterTexture(uint8_t binding, uint32_t textureId) {
+        auto&& [pIt, inserted] = m_shadowState.textures.try_emplace(
+            PipelineShadowState::TextureKey(m_state.descriptorSetId, binding), textureId
+        );
+
+        if (!inserted) {
+            if (m_isStateFilterEnabled && pIt->second == textureId) {
+                ++m_state.filteredOperations;
+                return false;
+            }
+            pIt->second = textureId;
+        }
+
+        ++m_state.issuedOperations;
+        return true;
+    }
+
+    bool Pipeline::FilterDescriptorSet(void* pDescriptorSet, void* pLayout, uint32_t dynamicOffset) {
+        if (m_isStateFilterEnabled && m_shadowState.pDescriptorSet == pDescriptorSet && m_shadowState.pLayout == pLayout &&
+            m_shadowState.dynamicOffset == dynamicOffset
+        ) {
+            ++m_state.filteredOperations;
+            return false;
+        }
+
+        m_shadowState.pDescriptorSet = pDescriptorSet;
+        m_shadowState.pLayout = pLayout;
+        m_shadowState.dynamicOffset = dynamicOffset;
+        ++m_state.issuedOperations;
+        return true;
+    }
+
+    bool Pipeline::FilterPushConstants(const void* pData, uint64_t size) {
+        auto&& shadow = m_shadowState.pushConstants;
+
+        if (m_isStateFilterEnabled && shadow.size() == size && std::memcmp(shadow.data(), pData, size) == 0) {
+            ++m_state.filteredOperations;
+            return false;
+        }
+
+        auto&& pBytes = static_cast<const uint8_t*>(pData);
+        shadow.assign(pBytes, pBytes + size);
+        ++m_state.issuedOperations;
+        return true;
+    }
+
+    void Pipeline::ForgetShadowVBO(int32_t VBO) {
+        if (m_shadowState.VBO == VBO) {
+            m_shadowState.VBO = SR_ID_INVALID;
+        }
+    }
+
+    void Pipeline::ForgetShadowIBO(int32_t IBO) {
+        if (m_shadowState.IBO == IBO) {
+            m_shadowState.IBO = SR_ID_INVALID;
+        }
+    }
+
+    void Pipeline::ForgetShadowTextures() {
+        m_shadowState.textures.clear();
+    }
+
     void Pipeline::ResetLastShader() {
         ++m_state.operations;
     }
@@ -372,6 +530,10 @@ namespace SR_GRAPH_NS {
 
     void Pipeline::UpdateDescriptorSets(uint32_t descriptorSet, const SRDescriptorUpdateInfos& updateInfo) {
         ++m_state.operations;
+
+        for (auto&& info : updateInfo) {
+            m_shadowState.textures.erase(PipelineShadowState::TextureKey(static_cast<int32_t>(descriptorSet), static_cast<uint8_t>(info.binding)));
+        }
     }
 
     void Pipeline::SetOverlayEnabled(OverlayType overlayType, bool enabled) {
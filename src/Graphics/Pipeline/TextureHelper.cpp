@@ -3,30 +3,32 @@
 //
 
 #include <Graphics/Pipeline/TextureHelper.h>
+#include <Graphics/Utils/ParallelFor.h>
 #include <Utils/Debug.h>
 
 #include <cmp_core.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace SR_GRAPH_NS {
-    uint8_t* Compress(uint32_t w, uint32_t h, const uint8_t *pixels, TextureCompression method) {
-        uint32_t blockCount = (w / 4) * (h / 4);
-        auto* cmpBuffer = (uint8_t*)malloc(16 * blockCount * 4);
-        for (uint32_t col = 0; col < w / 4; col++) {
-            for (uint32_t row = 0; row < h / 4; row++) {
-                uint32_t colOffs = col * 16;
-                uint32_t rowOffs = row * w;
+    /// Количество строк блоков в одной полосе, которую сжимает рабочий поток
+    static constexpr uint32_t SR_COMPRESS_TILE_BLOCK_ROWS = 8;
+
+    static void CompressBlockRows(uint32_t w, uint32_t firstRow, uint32_t lastRow, const uint8_t* pixels, uint8_t* pOutput, TextureCompression method) {
+        const uint32_t blocksPerRow = w / 4;
+
+        for (uint32_t row = firstRow; row < lastRow; ++row) {
+            for (uint32_t col = 0; col < blocksPerRow; ++col) {
+                /// 4 строки пикселей по 4 байта на пиксель
+                const uint8_t* pSource = pixels + (row * 4 * w + col * 4) * 4;
+                const uint32_t block = row * blocksPerRow + col;
 
                 switch (method) {
-                    case TextureCompression::None:
-                        return nullptr;
                     case TextureCompression::BC1:
                     case TextureCompression::BC4:
                         //! BC1, BC4 - has 8-byte cmp buffer
-                        CompressBlockBC1(
-                                pixels + colOffs + rowOffs * 16,            // source
-                                4 * w,                                      // count bytes
-                                cmpBuffer + colOffs / 2 + (rowOffs * 4) / 2 // dst
-                        );
+                        CompressBlockBC1(pSource, 4 * w, pOutput + block * 8);
                         break;
                     case TextureCompression::BC2:
                     case TextureCompression::BC3:
@@ -34,17 +36,173 @@ namespace SR_GRAPH_NS {
                     case TextureCompression::BC6:
                     case TextureCompression::BC7:
                         //! other BC has 16-byte cmp buffer
-                        CompressBlockBC7(
-                                pixels + colOffs + rowOffs * 16,    // source
-                                4 * w,                              // count bytes
-                                cmpBuffer + colOffs+ (rowOffs * 4)  // dst
-                        );
+                        CompressBlockBC7(pSource, 4 * w, pOutput + block * 16);
                         break;
                     default:
                         break;
                 }
             }
         }
+    }
+
+    /// Уменьшает изображение RGBA8 вдвое усреднением каждых 2x2 пикселей
+    static void DownsampleLevel(uint32_t w, uint32_t h, const uint8_t* pixels, uint8_t* pOutput) {
+        const uint32_t nw = w / 2;
+        const uint32_t nh = h / 2;
+
+        for (uint32_t y = 0; y < nh; ++y) {
+            const uint8_t* pRow0 = pixels + static_cast<size_t>(y * 2) * w * 4;
+            const uint8_t* pRow1 = pRow0 + static_cast<size_t>(w) * 4;
+
+            for (uint32_t x = 0; x < nw; ++x) {
+                for (uint32_t channel = 0; channel < 4; ++channel) {
+                    const uint32_t sum = pRow0[x * 8 + channel] + pRow0[x * 8 + 4 + channel] + pRow1[x * 8 + channel] + pRow1[x * 8 + 4 + channel];
+                    pOutput[(static_cast<size_t>(y) * nw + x) * 4 + channel] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    uint32_t GetCompressedMipLevels(uint32_t w, uint32_t h, uint32_t maxLevels) {
+        uint32_t levels = 0;
+
+        while (w >= 4 && h >= 4 && w % 4 == 0 && h % 4 == 0 && (maxLevels == 0 || levels < maxLevels)) {
+            ++levels;
+            w /= 2;
+            h /= 2;
+        }
+
+        return levels;
+    }
+
+    uint32_t GetCompressedBlockSize(TextureCompression method) {
+        switch (method) {
+            case TextureCompression::BC1:
+            case TextureCompression::BC4:
+                return 8;
+            case TextureCompression::BC2:
+            case TextureCompression::BC3:
+            case TextureCompression::BC5:
+            case TextureCompression::BC6:
+            case TextureCompression::BC7:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    std::vector<uint64_t> GetCompressedMipOffsets(uint32_t w, uint32_t h, TextureCompression method, uint32_t mipLevels) {
+        const uint32_t blockSize = GetCompressedBlockSize(method);
+
+        if (blockSize == 0 || mipLevels == 0 || mipLevels > GetCompressedMipLevels(w, h, 0)) {
+            return { };
+        }
+
+        std::vector<uint64_t> offsets(mipLevels + 1);
+
+        for (uint32_t level = 0; level < mipLevels; ++level) {
+            offsets[level + 1] = offsets[level] + static_cast<uint64_t>(blockSize) * ((w >> level) / 4) * ((h >> level) / 4);
+        }
+
+        return offsets;
+    }
+
+    uint8_t* Compress(uint32_t w, uint32_t h, const uint8_t* pixels, TextureCompression method, uint32_t mipLevels, const TextureCompressProgressFn& progressFn) {
+        SR_TRACY_ZONE;
+
+        const uint32_t blockSize = GetCompressedBlockSize(method);
+        if (blockSize == 0) {
+            return nullptr;
+        }
+
+        if (mipLevels == 0 || mipLevels > GetCompressedMipLevels(w, h, 0)) {
+            return nullptr;
+        }
+
+        struct CompressLevel {
+            uint32_t width = 0;
+            uint32_t blockRows = 0;
+            const uint8_t* pPixels = nullptr;
+            size_t outputOffset = 0;
+        };
+
+        struct CompressTile {
+            uint32_t level = 0;
+            uint32_t firstRow = 0;
+        };
+
+        std::vector<CompressLevel> levels(mipLevels);
+        std::vector<CompressTile> tiles;
+        /// Уменьшенные уровни, исходный уровень берется из pixels без копирования
+        std::vector<std::vector<uint8_t>> downsampled(mipLevels - 1);
+        size_t outputSize = 0;
+
+        for (uint32_t level = 0; level < mipLevels; ++level) {
+            const uint32_t levelWidth = w >> level;
+            const uint32_t levelHeight = h >> level;
+
+            if (level == 0) {
+                levels[level].pPixels = pixels;
+            }
+            else {
+                auto&& levelPixels = downsampled[level - 1];
+                levelPixels.resize(static_cast<size_t>(levelWidth) * levelHeight * 4);
+                DownsampleLevel(levelWidth * 2, levelHeight * 2, levels[level - 1].pPixels, levelPixels.data());
+                levels[level].pPixels = levelPixels.data();
+            }
+
+            levels[level].width = levelWidth;
+            levels[level].blockRows = levelHeight / 4;
+            levels[level].outputOffset = outputSize;
+
+            outputSize += static_cast<size_t>(blockSize) * (levelWidth / 4) * levels[level].blockRows;
+
+            for (uint32_t row = 0; row < levels[level].blockRows; row += SR_COMPRESS_TILE_BLOCK_ROWS) {
+                tiles.emplace_back(CompressTile { level, row });
+            }
+        }
+
+        auto* cmpBuffer = (uint8_t*)malloc(outputSize);
+        if (!cmpBuffer || tiles.empty()) {
+            free(cmpBuffer);
+            return nullptr;
+        }
+
+        const uint32_t tilesCount = static_cast<uint32_t>(tiles.size());
+
+        std::atomic<bool> cancelled = false;
+        uint32_t doneTiles = 0;
+        std::mutex progressMutex;
+
+        auto&& processTile = [&](uint32_t index) {
+            auto&& tile = tiles[index];
+            auto&& level = levels[tile.level];
+
+            CompressBlockRows(level.width, tile.firstRow, SR_MIN(tile.firstRow + SR_COMPRESS_TILE_BLOCK_ROWS, level.blockRows),
+                level.pPixels, cmpBuffer + level.outputOffset, method);
+
+            if (progressFn) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                if (!progressFn(static_cast<float_t>(++doneTiles) / static_cast<float_t>(tilesCount))) {
+                    cancelled = true;
+                }
+            }
+        };
+
+        /// Первую полосу сжимаем до запуска потоков: cmp_core лениво и без синхронизации
+        /// инициализирует глобальные таблицы BC7 при первом вызове
+        processTile(0);
+
+        ParallelFor(tilesCount - 1, 0, [&](uint32_t task) {
+            if (!cancelled) {
+                processTile(task + 1);
+            }
+        });
+
+        if (cancelled) {
+            free(cmpBuffer);
+            return nullptr;
+        }
 
         return cmpBuffer;
     }
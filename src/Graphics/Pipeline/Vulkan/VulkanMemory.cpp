@@ -129,6 +129,11 @@ namespace SR_GRAPH_NS::VulkanTools {
         return true;
     }
 
+    bool MemoryManager::FreeIndirectBuffer(uint32_t id) {
+        delete m_indirectPool.RemoveByIndex(static_cast<int32_t>(id));
+        return true;
+    }
+
     bool MemoryManager::FreeVBO(uint32_t id) {
         delete m_vboPool.RemoveByIndex(static_cast<int32_t>(id));
         return true;
@@ -277,12 +282,22 @@ namespace SR_GRAPH_NS::VulkanTools {
         const uint8_t *pixels, uint32_t w, uint32_t h,
         VkFormat format,
         VkFilter filter,
-        SR_GRAPH_NS::TextureCompression /*compression*/,
+        SR_GRAPH_NS::TextureCompression compression,
         uint8_t mipLevels,
         bool cpuUsage)
     {
         EvoVulkan::Types::Texture* pTexture = nullptr;
 
+        /// Сжатые уровни нельзя построить на видеокарте, они уже лежат в pixels подряд
+        std::vector<uint64_t> mipOffsets;
+        if (compression != TextureCompression::None && mipLevels > 1) {
+            mipOffsets = GetCompressedMipOffsets(w, h, compression, mipLevels);
+            if (mipOffsets.empty()) {
+                SR_ERROR("MemoryManager::AllocateTexture() : invalid compressed mip chain!");
+                return SR_ID_INVALID;
+            }
+        }
+
         if (mipLevels == 0) {
             pTexture = EvoVulkan::Types::Texture::LoadAutoMip(m_device, m_allocator, m_descriptorManager, m_pool, pixels, format, w, h, filter, cpuUsage);
         }
@@ -298,9 +313,117 @@ namespace SR_GRAPH_NS::VulkanTools {
             return SR_ID_INVALID;
         }
 
+        if (!mipOffsets.empty() && !UploadMipLevels(pTexture, pixels, w, h, mipOffsets)) {
+            SR_ERROR("MemoryManager::AllocateTexture() : failed to upload compressed mip levels!");
+            delete pTexture;
+            return SR_ID_INVALID;
+        }
+
         return m_texturePool.Add(pTexture);
     }
 
+    bool MemoryManager::UploadMipLevels(EvoVulkan::Types::Texture* pTexture, const uint8_t* pixels, uint32_t w, uint32_t h, const std::vector<uint64_t>& offsets) {
+        SR_TRACY_ZONE;
+
+        const uint32_t mipLevels = static_cast<uint32_t>(offsets.size()) - 1;
+        const uint64_t size = offsets.back();
+
+        auto&& pStaging = EvoVulkan::Types::VmaBuffer::Create(
+            m_allocator,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VMA_MEMORY_USAGE_CPU_ONLY,
+            size
+        );
+
+        if (!pStaging) {
+            SR_ERROR("MemoryManager::UploadMipLevels() : failed to create staging buffer!");
+            return false;
+        }
+
+        pStaging->CopyToDevice((void*)pixels, size);
+
+        std::vector<VkBufferImageCopy> regions(mipLevels);
+
+        for (uint32_t level = 0; level < mipLevels; ++level) {
+            VkBufferImageCopy& region = regions[level];
+            region.bufferOffset = offsets[level];
+            /// Блоки уровня лежат плотно, поэтому длина строки и высота берутся из размеров уровня
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = level;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = { 0, 0, 0 };
+            region.imageExtent = { SR_MAX(w >> level, 1U), SR_MAX(h >> level, 1U), 1 };
+        }
+
+        const VkImage vkImage = pTexture->GetImage();
+
+        VkImageMemoryBarrier barrier = { };
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        /// Все уровни перезаписываются целиком, прежнее содержимое не нужно
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = vkImage;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = mipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        const VkCommandPool vkCmdPool = m_device->CreateCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        if (vkCmdPool == VK_NULL_HANDLE) {
+            SR_ERROR("MemoryManager::UploadMipLevels() : failed to create command pool!");
+            delete pStaging;
+            return false;
+        }
+
+        VkCommandBuffer vkCmd = VK_NULL_HANDLE;
+        auto&& allocateInfo = EvoVulkan::Tools::Initializers::CommandBufferAllocateInfo(vkCmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
+
+        bool result = vkAllocateCommandBuffers(*m_device, &allocateInfo, &vkCmd) == VK_SUCCESS;
+
+        if (result) {
+            VkCommandBufferBeginInfo beginInfo = EvoVulkan::Tools::Initializers::CommandBufferBeginInfo();
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            vkBeginCommandBuffer(vkCmd, &beginInfo);
+
+            vkCmdPipelineBarrier(vkCmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            vkCmdCopyBufferToImage(vkCmd, *pStaging, vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, regions.data());
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(vkCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            vkEndCommandBuffer(vkCmd);
+
+            VkSubmitInfo submitInfo = { };
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &vkCmd;
+
+            auto&& vkQueue = m_device->GetQueues()->GetGraphicsQueue();
+
+            result = vkQueueSubmit(vkQueue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS;
+            result &= vkQueueWaitIdle(vkQueue) == VK_SUCCESS;
+        }
+
+        vkDestroyCommandPool(*m_device, vkCmdPool, nullptr);
+        delete pStaging;
+
+        return result;
+    }
+
     void SR_GRAPH_NS::VulkanTools::MemoryManager::Free() {
         SRAssert2(m_fboPool.IsEmpty(), "FBOs are not empty!");
         SRAssert2(m_uboPool.IsEmpty(), "UBOs are not empty!");
@@ -310,6 +433,7 @@ namespace SR_GRAPH_NS::VulkanTools {
         SRAssert2(m_descriptorSetPool.IsEmpty(), "Descriptor sets are not empty!");
         SRAssert2(m_shaderProgramPool.IsEmpty(), "Shaders are not empty!");
         SRAssert2(m_ssboPool.IsEmpty(), "SSBOs are not empty!");
+        SRAssert2(m_indirectPool.IsEmpty(), "Indirect buffers are not empty!");
         delete this;
     }
 
@@ -375,4 +499,27 @@ namespace SR_GRAPH_NS::VulkanTools {
 
         return m_ssboPool.Add(pBuffer);
     }
+
+    int32_t MemoryManager::AllocateIndirectBuffer(uint32_t size) {
+        SR_TRACY_ZONE;
+
+        /// Аргументы переписываются с процессора при изменении видимости, поэтому память доступна хосту
+        auto&& pBuffer = EvoVulkan::Types::VmaBuffer::Create(
+            m_kernel->GetAllocator(),
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU,
+            size,
+            VK_SHARING_MODE_EXCLUSIVE,
+            static_cast<VkBufferCreateFlags>(0),
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            nullptr
+        );
+
+        if (!pBuffer) {
+            SR_ERROR("MemoryManager::AllocateIndirectBuffer() : failed to create indirect buffer!");
+            return SR_ID_INVALID;
+        }
+
+        return m_indirectPool.Add(pBuffer);
+    }
 }
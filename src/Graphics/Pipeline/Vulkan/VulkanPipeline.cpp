@@ -263,6 +263,10 @@ namespace SR_GRAPH_NS {
 
         m_supportedSampleCount = m_kernel->GetDevice()->GetMSAASamplesCount();
 
+        VkPhysicalDeviceProperties vkProperties = { };
+        vkGetPhysicalDeviceProperties(*m_kernel->GetDevice(), &vkProperties);
+        m_uboOffsetAlignment = SR_MAX(1U, static_cast<uint32_t>(vkProperties.limits.minUniformBufferOffsetAlignment));
+
         return Super::Init();
     }
 
@@ -397,6 +401,7 @@ namespace SR_GRAPH_NS {
         }
 
         m_currentVkShader->Bind(m_currentCmd);
+        m_shadowState.ResetShader();
 
         m_lastVkShader = m_currentVkShader;
         m_isShaderChanged = true;
@@ -579,7 +584,12 @@ namespace SR_GRAPH_NS {
 
             SR_LOG("VulkanPipeline::CalculateTexture() : compress " + SR_UTILS_NS::ToString(textureCreateInfo.width * textureCreateInfo.height * 4 / 1024 / 1024) + "MB source image...");
 
-            textureCreateInfo.pData = Graphics::Compress(textureCreateInfo.width, textureCreateInfo.height, textureCreateInfo.pData, textureCreateInfo.compression);
+            /// Уровни сжатого изображения нельзя построить на видеокарте, поэтому они сжимаются вместе с исходным
+            const uint32_t mipLevels = GetCompressedMipLevels(textureCreateInfo.width, textureCreateInfo.height, textureCreateInfo.mipLevels);
+            textureCreateInfo.mipLevels = static_cast<uint8_t>(mipLevels);
+
+            textureCreateInfo.pData = Graphics::Compress(textureCreateInfo.width, textureCreateInfo.height, textureCreateInfo.pData,
+                textureCreateInfo.compression, mipLevels, textureCreateInfo.compressProgress);
             if (textureCreateInfo.pData == nullptr) {
                 PipelineError("VulkanPipeline::AllocateTexture() : failed to compress image!");
                 return SR_ID_INVALID;
@@ -627,11 +637,31 @@ namespace SR_GRAPH_NS {
 
         std::vector<VkWriteDescriptorSet> writeDescriptorSets;
 
+        /// адреса элементов передаются в VkWriteDescriptorSet, поэтому вектор не должен переаллоцироваться
+        std::vector<VkDescriptorBufferInfo> bufferInfos;
+        bufferInfos.reserve(updateInfo.size());
+
         for (auto&& info : updateInfo) {
             switch (info.descriptorType) {
                 case DescriptorType::Storage: {
                     auto&& vkStorageBuffer = m_memory->GetSSBO(info.ubo)->GetDescriptorRef();
 
+                    if (info.range > 0) {
+                        /// область внутри общего буфера, например участок костей меша
+                        VkDescriptorBufferInfo& rangeInfo = bufferInfos.emplace_back(*vkStorageBuffer);
+                        rangeInfo.offset = info.offset;
+                        rangeInfo.range = info.range;
+
+                        writeDescriptorSets.emplace_back(EvoVulkan::Tools::Initializers::WriteDescriptorSet(
+                            vkDescriptorSet,
+                            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                            info.binding,
+                            &rangeInfo
+                        ));
+
+                        break;
+                    }
+
                     writeDescriptorSets.emplace_back(EvoVulkan::Tools::Initializers::WriteDescriptorSet(
                         vkDescriptorSet,
                         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
@@ -644,6 +674,22 @@ namespace SR_GRAPH_NS {
                 case DescriptorType::Uniform: {
                     auto&& vkUBODescriptor = m_memory->GetUBO(info.ubo)->GetDescriptorRef();
 
+                    if (info.range > 0) {
+                        /// область внутри общей страницы UBO
+                        VkDescriptorBufferInfo& rangeInfo = bufferInfos.emplace_back(*vkUBODescriptor);
+                        rangeInfo.offset = info.offset;
+                        rangeInfo.range = info.range;
+
+                        writeDescriptorSets.emplace_back(EvoVulkan::Tools::Initializers::WriteDescriptorSet(
+                            vkDescriptorSet,
+                            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                            info.binding,
+                            &rangeInfo
+                        ));
+
+                        break;
+                    }
+
                     writeDescriptorSets.emplace_back(EvoVulkan::Tools::Initializers::WriteDescriptorSet(
                         vkDescriptorSet,
                         VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
@@ -653,6 +699,23 @@ namespace SR_GRAPH_NS {
 
                     break;
                 }
+                case DescriptorType::DynamicUniform: {
+                    /// смещение объекта внутри страницы передается при привязке набора
+                    VkDescriptorBufferInfo& dynamicInfo = bufferInfos.emplace_back(*m_memory->GetUBO(info.ubo)->GetDescriptorRef());
+                    dynamicInfo.offset = 0;
+                    dynamicInfo.range = info.range > 0 ? info.range : VK_WHOLE_SIZE;
+
+                    m_dynamicUBOs[static_cast<int32_t>(descriptorSet)] = DynamicUBO { static_cast<int32_t>(info.ubo), info.offset };
+
+                    writeDescriptorSets.emplace_back(EvoVulkan::Tools::Initializers::WriteDescriptorSet(
+                        vkDescriptorSet,
+                        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                        info.binding,
+                        &dynamicInfo
+                    ));
+
+                    break;
+                }
                 default:
                     SRHalt("VulkanPipeline::UpdateDescriptorSets() : unknown type!");
                     return;
@@ -674,6 +737,54 @@ namespace SR_GRAPH_NS {
         m_memory->GetUBO(UBO)->CopyToDevice(pData, size);
     }
 
+    void VulkanPipeline::UpdateUBORange(uint32_t UBO, void* pData, uint64_t size, uint64_t offset) {
+        SR_TRACY_ZONE;
+        SRAssert2(UBO != SR_ID_INVALID, "Invalid UBO ID!");
+        Super::UpdateUBORange(UBO, pData, size, offset);
+
+        auto&& page = m_uboRanges[UBO];
+
+        if (page.memory.size() < offset + size) {
+            page.memory.resize(offset + size);
+        }
+
+        memcpy(page.memory.data() + offset, pData, size);
+
+        if (!page.dirty) {
+            page.dirty = true;
+            m_dirtyUBORanges.emplace_back(UBO);
+        }
+    }
+
+    void VulkanPipeline::FlushUBORanges() {
+        SR_TRACY_ZONE;
+
+        for (auto&& UBO : m_dirtyUBORanges) {
+            auto&& pIt = m_uboRanges.find(UBO);
+            if (pIt == m_uboRanges.end()) {
+                continue; /// страница была освобождена
+            }
+            pIt->second.dirty = false;
+            m_memory->GetUBO(UBO)->CopyToDevice(pIt->second.memory.data(), pIt->second.memory.size());
+        }
+
+        m_dirtyUBORanges.clear();
+    }
+
+    void VulkanPipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndexedIndirectCommand* pCommands, uint32_t count) {
+        SR_TRACY_ZONE;
+        SRAssert2(buffer != SR_ID_INVALID, "Invalid indirect buffer ID!");
+        Super::UpdateIndirectBuffer(buffer, pCommands, count);
+        m_memory->GetIndirectBuffer(buffer)->CopyToDevice((void*)pCommands, count * sizeof(DrawIndexedIndirectCommand));
+    }
+
+    void VulkanPipeline::UpdateIndirectBuffer(uint32_t buffer, const DrawIndirectCommand& command) {
+        SR_TRACY_ZONE;
+        SRAssert2(buffer != SR_ID_INVALID, "Invalid indirect buffer ID!");
+        Super::UpdateIndirectBuffer(buffer, command);
+        m_memory->GetIndirectBuffer(buffer)->CopyToDevice((void*)&command, sizeof(DrawIndirectCommand));
+    }
+
     void VulkanPipeline::UpdateSSBO(uint32_t SSBO, void *pData, uint64_t size) {
         SR_TRACY_ZONE;
         SRAssert2(SSBO != SR_ID_INVALID, "Invalid SSBO ID!");
@@ -1009,6 +1120,8 @@ namespace SR_GRAPH_NS {
     void VulkanPipeline::DrawFrame() {
         Super::DrawFrame();
 
+        FlushUBORanges();
+
         switch (m_kernel->NextFrame()) {
             case EvoVulkan::Core::RenderResult::Fatal:
                 SR_UTILS_NS::EventManager::Instance().Broadcast(SR_UTILS_NS::EventManager::Event::FatalError);
@@ -1107,6 +1220,10 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        OnResourceFreed(DescriptorType::CombinedImage, *id);
+
+        ForgetShadowTextures();
+
         if (!m_memory || !m_memory->FreeTexture(static_cast<uint32_t>(*id))) {
             SR_ERROR("VulkanPipeline::FreeTexture() : failed to free texture!");
             return false;
@@ -1149,6 +1266,10 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        if (auto&& pShaderProgram = *id != SR_ID_INVALID ? m_memory->GetShaderProgram(*id) : nullptr) {
+            m_freedShaderHandles.emplace_back((void*)pShaderProgram->GetPipeline());
+        }
+
         if (!m_memory->FreeShaderProgram(*id)) {
             PipelineError("VulkanPipeline::FreeShader() : failed free shader program!");
             return false;
@@ -1182,6 +1303,10 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        OnResourceFreed(DescriptorType::CombinedImage, *id);
+
+        ForgetShadowTextures();
+
         const bool result = m_memory->FreeTexture(*id);
 
         *id = SR_ID_INVALID;
@@ -1240,6 +1365,9 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        ForgetShadowTextures();
+        m_dynamicUBOs.erase(*id);
+
         EVK_PUSH_LOG_LEVEL(EvoVulkan::Tools::LogLevel::ErrorsOnly);
 
         if (!m_memory->FreeDescriptorSet(*id)) {
@@ -1262,6 +1390,8 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        ForgetShadowVBO(*id);
+
         const bool result = m_memory->FreeVBO(*id);
 
         *id = SR_ID_INVALID;
@@ -1280,6 +1410,8 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        ForgetShadowIBO(*id);
+
         const bool result = m_memory->FreeIBO(*id);
 
         *id = SR_ID_INVALID;
@@ -1298,6 +1430,9 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        OnResourceFreed(DescriptorType::Uniform, *id);
+        m_uboRanges.erase(static_cast<uint32_t>(*id));
+
         const bool result = m_memory->FreeUBO(*id);
 
         *id = SR_ID_INVALID;
@@ -1444,6 +1579,10 @@ namespace SR_GRAPH_NS {
             return;
         }
 
+        if (!FilterPushConstants(pData, size)) {
+            return;
+        }
+
         vkCmdPushConstants(m_currentCmd, m_currentLayout,
             pushConstants.data()->stageFlags,
             0, size, pData
@@ -1522,11 +1661,21 @@ namespace SR_GRAPH_NS {
 
     void VulkanPipeline::BindVBO(uint32_t VBO) {
         Super::BindVBO(VBO);
+
+        if (!FilterVBO(VBO)) {
+            return;
+        }
+
         vkCmdBindVertexBuffers(m_currentCmd, 0, 1, m_memory->GetVBO(VBO)->GetCRef(), m_offsets);
     }
 
     void VulkanPipeline::BindIBO(uint32_t IBO) {
         Super::BindIBO(IBO);
+
+        if (!FilterIBO(IBO)) {
+            return;
+        }
+
         vkCmdBindIndexBuffer(m_currentCmd, *m_memory->GetIBO(IBO), 0, VK_INDEX_TYPE_UINT32);
     }
 
@@ -1534,6 +1683,10 @@ namespace SR_GRAPH_NS {
         Super::BindUBO(UBO);
     }
 
+    void VulkanPipeline::BindUBORange(uint32_t UBO, uint32_t offset, uint32_t range) {
+        Super::BindUBORange(UBO, offset, range);
+    }
+
     bool VulkanPipeline::IsSamplerValid(int32_t id) const {
         return m_memory->IsTextureValid(id);
     }
@@ -1559,6 +1712,10 @@ namespace SR_GRAPH_NS {
             return;
         }
 
+        if (!FilterTexture(activeTexture, textureId)) {
+            return;
+        }
+
         auto&& descriptorSet = m_memory->GetDescriptorSet(m_state.descriptorSetId);
         auto&& pTexture = m_memory->GetTexture(textureId);
 
@@ -1571,28 +1728,138 @@ namespace SR_GRAPH_NS {
         vkUpdateDescriptorSets(*m_kernel->GetDevice(), 1, &descriptorSetWrite, 0, nullptr);
     }
 
+    void VulkanPipeline::BindTextureTable(uint8_t binding, const std::vector<int32_t>& textures, uint32_t first, uint32_t count, int32_t fallbackTexture) {
+        SR_TRACY_ZONE;
+
+        Super::BindTextureTable(binding, textures, first, count, fallbackTexture);
+
+        if (!m_bindedDescriptors.Get(m_state.descriptorSetId, false)) {
+            PipelineError("VulkanPipeline::BindTextureTable() : descriptor set not binded!");
+            return;
+        }
+
+        if (!m_isRenderState || m_state.buildIteration > 0) SR_UNLIKELY_ATTRIBUTE {
+            PipelineError("VulkanPipeline::BindTextureTable() : render state isn't active or not in first build iteration!");
+            SRHaltOnce0();
+            return;
+        }
+
+        if (!IsSamplerValid(fallbackTexture)) {
+            PipelineError("VulkanPipeline::BindTextureTable() : fallback texture is not exists! Id: " + SR_UTILS_NS::ToString(fallbackTexture));
+            return;
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        auto&& fallbackDescriptor = *m_memory->GetTexture(fallbackTexture)->GetDescriptorRef();
+
+        /// Все элементы массива должны быть валидны, поэтому пустые слоты указывают на заглушку
+        m_textureTableInfos.assign(count, fallbackDescriptor);
+
+        const uint32_t tableEnd = SR_MIN(first + count, static_cast<uint32_t>(textures.size()));
+        for (uint32_t i = first; i < tableEnd; ++i) {
+            if (textures[i] != SR_ID_INVALID && IsSamplerValid(textures[i])) SR_LIKELY_ATTRIBUTE {
+                m_textureTableInfos[i - first] = *m_memory->GetTexture(textures[i])->GetDescriptorRef();
+            }
+        }
+
+        VkWriteDescriptorSet descriptorSetWrite = { };
+        descriptorSetWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorSetWrite.dstSet = m_memory->GetDescriptorSet(m_state.descriptorSetId).descriptorSet;
+        descriptorSetWrite.dstBinding = binding;
+        descriptorSetWrite.dstArrayElement = first;
+        descriptorSetWrite.descriptorCount = count;
+        descriptorSetWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorSetWrite.pImageInfo = m_textureTableInfos.data();
+
+        vkUpdateDescriptorSets(*m_kernel->GetDevice(), 1, &descriptorSetWrite, 0, nullptr);
+    }
+
+    void VulkanPipeline::BindCurrentDescriptorSet() {
+        if (!m_currentDescriptorSet) {
+            return;
+        }
+
+        uint32_t dynamicOffset = 0;
+        uint32_t dynamicOffsetsCount = 0;
+
+        if (auto&& pIt = m_dynamicUBOs.find(m_state.descriptorSetId); pIt != m_dynamicUBOs.end()) {
+            /// Набор мог быть записан другим объектом той же страницы, берем смещение привязанного UBO
+            dynamicOffset = m_state.UBOId == pIt->second.ubo ? m_state.UBOOffset : pIt->second.offset;
+            dynamicOffsetsCount = 1;
+        }
+
+        if (FilterDescriptorSet(m_currentDescriptorSet, m_currentLayout, dynamicOffset)) {
+            vkCmdBindDescriptorSets(m_currentCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_currentLayout, 0, 1, &m_currentDescriptorSet, dynamicOffsetsCount, &dynamicOffset);
+        }
+    }
+
     void VulkanPipeline::Draw(uint32_t count) {
         SR_TRACY_ZONE;
 
         Super::Draw(count);
 
-        if (m_currentDescriptorSet) {
-            vkCmdBindDescriptorSets(m_currentCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_currentLayout, 0, 1, &m_currentDescriptorSet, 0, nullptr);
-        }
+        BindCurrentDescriptorSet();
 
         vkCmdDraw(m_currentCmd, count, 1, 0, 0);
     }
 
-    void VulkanPipeline::DrawIndices(uint32_t count) {
+    void VulkanPipeline::DrawIndices(uint32_t count, uint32_t firstIndex) {
+        SR_TRACY_ZONE;
+
+        Super::DrawIndices(count, firstIndex);
+
+        BindCurrentDescriptorSet();
+
+        vkCmdDrawIndexed(m_currentCmd, count, 1, firstIndex, 0, 0);
+    }
+
+    void VulkanPipeline::DrawIndicesInstanced(uint32_t count, uint32_t instanceCount, uint32_t firstIndex) {
+        SR_TRACY_ZONE;
+
+        Super::DrawIndicesInstanced(count, instanceCount, firstIndex);
+
+        BindCurrentDescriptorSet();
+
+        vkCmdDrawIndexed(m_currentCmd, count, instanceCount, firstIndex, 0, 0);
+    }
+
+    void VulkanPipeline::DrawInstanced(uint32_t count, uint32_t instanceCount) {
+        SR_TRACY_ZONE;
+
+        Super::DrawInstanced(count, instanceCount);
+
+        BindCurrentDescriptorSet();
+
+        vkCmdDraw(m_currentCmd, count, instanceCount, 0, 0);
+    }
+
+    void VulkanPipeline::DrawIndicesIndirect(uint32_t buffer, uint32_t first, uint32_t drawCount) {
         SR_TRACY_ZONE;
 
-        Super::DrawIndices(count);
+        Super::DrawIndicesIndirect(buffer, first, drawCount);
+
+        BindCurrentDescriptorSet();
 
-        if (m_currentDescriptorSet) {
-            vkCmdBindDescriptorSets(m_currentCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_currentLayout, 0, 1, &m_currentDescriptorSet, 0, nullptr);
+        const VkBuffer vkBuffer = *m_memory->GetIndirectBuffer(buffer);
+        constexpr uint32_t stride = sizeof(DrawIndexedIndirectCommand);
+
+        /// Устройство создает EvoVulkan без multiDrawIndirect, поэтому команды отправляются по одной
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            vkCmdDrawIndexedIndirect(m_currentCmd, vkBuffer, static_cast<VkDeviceSize>(first + i) * stride, 1, stride);
         }
+    }
 
-        vkCmdDrawIndexed(m_currentCmd, count, 1, 0, 0, 0);
+    void VulkanPipeline::DrawIndirect(uint32_t buffer) {
+        SR_TRACY_ZONE;
+
+        Super::DrawIndirect(buffer);
+
+        BindCurrentDescriptorSet();
+
+        vkCmdDrawIndirect(m_currentCmd, *m_memory->GetIndirectBuffer(buffer), 0, 1, sizeof(DrawIndirectCommand));
     }
 
     void VulkanPipeline::SetVSyncEnabled(bool enabled) {
@@ -1623,6 +1890,7 @@ namespace SR_GRAPH_NS {
 
     void VulkanPipeline::ResetLastShader() {
         m_lastVkShader = nullptr;
+        m_shadowState.ResetShader();
         Super::ResetLastShader();
     }
 
@@ -1794,6 +2062,8 @@ namespace SR_GRAPH_NS {
         ++m_state.operations;
         ++m_state.deletions;
 
+        OnResourceFreed(DescriptorType::Storage, *id);
+
         const bool result = m_memory->FreeSSBO(*id);
 
         *id = SR_ID_INVALID;
@@ -1826,6 +2096,46 @@ namespace SR_GRAPH_NS {
         return SR_ID_INVALID;
     }
 
+    bool VulkanPipeline::FreeIndirectBuffer(int32_t* id) {
+        SR_TRACY_ZONE;
+
+        ++m_state.operations;
+        ++m_state.deletions;
+
+        const bool result = m_memory->FreeIndirectBuffer(*id);
+
+        *id = SR_ID_INVALID;
+
+        if (!result) {
+            PipelineError("VulkanPipeline::FreeIndirectBuffer() : failed to free indirect buffer!");
+            return false;
+        }
+
+        return true;
+    }
+
+    int32_t VulkanPipeline::AllocateIndirectBuffer(uint32_t commandsCount) {
+        if (!m_memory) SR_UNLIKELY_ATTRIBUTE {
+            SR_ERROR("VulkanPipeline::AllocateIndirectBuffer() : memory manager is nullptr!");
+            return SR_ID_INVALID;
+        }
+
+        const uint32_t size = commandsCount * sizeof(DrawIndexedIndirectCommand);
+
+        ++m_state.operations;
+        ++m_state.allocations;
+        m_state.allocatedMemory += size;
+
+        SRAssert2(size > 0, "Incorrect indirect buffer size!");
+
+        if (auto&& id = m_memory->AllocateIndirectBuffer(size); id >= 0) SR_LIKELY_ATTRIBUTE {
+            return id;
+        }
+
+        PipelineError("VulkanPipeline::AllocateIndirectBuffer() : failed to allocate indirect buffer!");
+        return SR_ID_INVALID;
+    }
+
     void VulkanPipeline::BindSSBO(uint32_t SSBO) {
         Super::BindSSBO(SSBO);
     }
@@ -40,7 +40,27 @@ namespace SR_GRAPH_NS {
 
         using namespace std::placeholders;
 
+        if (SR_UTILS_NS::Features::Instance().Enabled("DebugRendererBatching", true)) {
+            m_batching = InitBatches();
+            m_depthTest = SR_UTILS_NS::Features::Instance().Enabled("DebugRendererDepthTest", true);
+        }
+
         SR_UTILS_NS::DebugDraw::Callbacks callbacks;
+
+        if (m_batching) {
+            callbacks.removeCallback = std::bind(&DebugRenderer::RemoveBatched, this, _1);
+            callbacks.drawLineCallback = std::bind(&DebugRenderer::DrawLineBatched, this, _1, _2, _3, _4, _5);
+            callbacks.drawCubeCallback = std::bind(&DebugRenderer::DrawMeshBatched, this, m_meshes[0], 0, _1, _2, _3, _4, _5, _6);
+            callbacks.drawPlaneCallback = std::bind(&DebugRenderer::DrawMeshBatched, this, m_meshes[1], 0, _1, _2, _3, _4, _5, _6);
+            callbacks.drawSphereCallback = std::bind(&DebugRenderer::DrawMeshBatched, this, m_meshes[2], 0, _1, _2, _3, _4, _5, _6);
+            callbacks.drawCapsuleCallback = std::bind(&DebugRenderer::DrawMeshBatched, this, m_meshes[3], 0, _1, _2, _3, _4, _5, _6);
+            callbacks.drawMeshCallback = std::bind(&DebugRenderer::DrawMeshBatched, this, _1, _2, _3, _4, _5, _6, _7, _8);
+
+            SR_UTILS_NS::DebugDraw::Instance().SetCallbacks(this, std::move(callbacks));
+
+            return;
+        }
+
         callbacks.removeCallback = std::bind(&DebugRenderer::Remove, this, _1);
         callbacks.drawLineCallback = std::bind(&DebugRenderer::DrawLine, this, _1, _2, _3, _4, _5);
         callbacks.drawCubeCallback = std::bind(&DebugRenderer::DrawMesh, this, m_meshes[0], 0, _1, _2, _3, _4, _5, _6);
@@ -56,6 +76,8 @@ namespace SR_GRAPH_NS {
         SR_LOCK_GUARD;
         SR_UTILS_NS::DebugDraw::Instance().RemoveCallbacks(this);
 
+        DeInitBatches();
+
         for (auto&& pMesh : m_meshes) {
             if (pMesh) {
                 pMesh->RemoveUsePoint();
@@ -78,6 +100,10 @@ namespace SR_GRAPH_NS {
 
         SR_LOCK_GUARD;
 
+        if (m_batching) {
+            PrepareBatches();
+        }
+
         auto&& timePoint = SR_HTYPES_NS::Time::Instance().Count();
 
         for (uint64_t i = 0; i < m_timedObjects.size(); ++i) {
@@ -236,6 +262,8 @@ namespace SR_GRAPH_NS {
     void DebugRenderer::Clear() {
         SR_LOCK_GUARD;
 
+        ClearBatches();
+
         for (uint64_t i = 0; i < m_timedObjects.size(); ++i) {
             auto&& timed = m_timedObjects[i];
 
@@ -254,7 +282,7 @@ namespace SR_GRAPH_NS {
     }
 
     bool DebugRenderer::IsEmpty() const {
-        return m_timedObjects.size() == m_emptyIds.size();
+        return m_timedObjects.size() == m_emptyIds.size() && m_batchObjects.size() == m_batchEmptyIds.size();
     }
 
     uint64_t DebugRenderer::DrawMesh(SR_HTYPES_NS::RawMesh* pRawMesh, int32_t meshId, uint64_t id, const SR_MATH_NS::FVector3& pos,
@@ -312,4 +340,253 @@ namespace SR_GRAPH_NS {
             return id;
         }
     }
+
+    bool DebugRenderer::InitBatches() {
+        static const std::array<std::string_view, static_cast<uint8_t>(BatchType::Count)> materials = {
+            "Engine/Materials/Debug/lineBatch.mat",
+            "Engine/Materials/Debug/wireframeBatch.mat",
+            "Engine/Materials/Debug/lineBatchNoDepth.mat",
+            "Engine/Materials/Debug/wireframeBatchNoDepth.mat",
+        };
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(BatchType::Count); ++i) {
+            auto&& pMaterial = FileMaterial::Load(SR_UTILS_NS::Path(materials[i]));
+            if (!pMaterial) {
+                SR_WARN("DebugRenderer::InitBatches() : failed to load batch material, using per-object meshes! Path: " + std::string(materials[i]));
+                DeInitBatches();
+                return false;
+            }
+
+            pMaterial->AddUsePoint();
+            m_batchMaterials[i] = pMaterial;
+
+            m_batches[i] = new SR_GTYPES_NS::DebugLineBatch(SR_UTILS_NS::StringAtom("Debug"));
+            m_batches[i]->SetMaterial(pMaterial);
+        }
+
+        return true;
+    }
+
+    void DebugRenderer::DeInitBatches() {
+        for (auto&& pBatch : m_batches) {
+            if (pBatch && !pBatch->DestroyMesh() && m_batchesRegistered) {
+                SRHalt("Failed to unregister debug batch!");
+            }
+            pBatch = nullptr;
+        }
+
+        for (auto&& pMaterial : m_batchMaterials) {
+            if (pMaterial) {
+                pMaterial->RemoveUsePoint();
+                pMaterial = nullptr;
+            }
+        }
+
+        m_batchesRegistered = false;
+        m_batching = false;
+    }
+
+    void DebugRenderer::PrepareBatches() {
+        SR_TRACY_ZONE;
+
+        auto&& timePoint = SR_HTYPES_NS::Time::Instance().Count();
+
+        for (auto&& vertices : m_batchVertices) {
+            vertices.clear();
+        }
+
+        for (uint64_t i = 0; i < m_batchObjects.size(); ++i) {
+            auto&& object = m_batchObjects[i];
+
+            if (!object.alive) {
+                continue;
+            }
+
+            if (object.drawn && object.endPoint <= timePoint) {
+                object.alive = false;
+                object.points.clear();
+                m_batchEmptyIds.emplace_back(i);
+                continue;
+            }
+
+            auto&& vertices = m_batchVertices[static_cast<uint8_t>(GetBatchType(object.type, object.depthTest))];
+
+            for (auto&& point : object.points) {
+                vertices.emplace_back(SR_GTYPES_NS::DebugLineBatch::Vertex { glm::vec4(point, 1.f), object.color });
+            }
+
+            object.drawn = true;
+        }
+
+        if (!m_batchesRegistered) {
+            for (auto&& pBatch : m_batches) {
+                m_renderScene->Register(pBatch);
+            }
+            m_batchesRegistered = true;
+        }
+
+        bool reallocated = false;
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(BatchType::Count); ++i) {
+            reallocated |= m_batches[i]->Upload(m_batchVertices[i]);
+        }
+
+        /// Буфер вершин записан в дескрипторы, поэтому команды рендера перезаписываются только при его пересоздании
+        if (reallocated) {
+            m_renderScene->SetDirty();
+        }
+    }
+
+    void DebugRenderer::ClearBatches() {
+        for (uint64_t i = 0; i < m_batchObjects.size(); ++i) {
+            auto&& object = m_batchObjects[i];
+
+            if (!object.alive) {
+                continue;
+            }
+
+            object.alive = false;
+            object.points.clear();
+            m_batchEmptyIds.emplace_back(i);
+        }
+    }
+
+    void DebugRenderer::RemoveBatched(uint64_t id) {
+        SR_LOCK_GUARD;
+
+        if (id == SR_ID_INVALID || id >= m_batchObjects.size()) {
+            SRHalt0();
+        }
+        else if (m_batchObjects[id].alive) {
+            m_batchObjects[id].endPoint = SR_HTYPES_NS::Time::Instance().Count();
+        }
+    }
+
+    DebugRenderer::DebugBatchObject& DebugRenderer::AcquireBatchObject(uint64_t& id, BatchType type, float_t time) {
+        if (id == SR_ID_INVALID || id >= m_batchObjects.size() || !m_batchObjects[id].alive) {
+            if (m_batchEmptyIds.empty()) {
+                id = m_batchObjects.size();
+                m_batchObjects.emplace_back();
+            }
+            else {
+                id = m_batchEmptyIds.back();
+                m_batchEmptyIds.pop_back();
+            }
+        }
+
+        auto&& duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float_t>(time));
+
+        auto&& object = m_batchObjects[id];
+
+        object.endPoint = SR_HTYPES_NS::Time::Instance().Count() + duration.count();
+        object.type = type;
+        object.depthTest = m_depthTest;
+        object.alive = true;
+        object.drawn = false;
+        object.points.clear();
+
+        return object;
+    }
+
+    DebugRenderer::BatchType DebugRenderer::GetBatchType(BatchType type, bool depthTest) {
+        if (depthTest) SR_LIKELY_ATTRIBUTE {
+            return type;
+        }
+
+        switch (type) {
+            case BatchType::Line: return BatchType::LineNoDepth;
+            case BatchType::Wireframe: return BatchType::WireframeNoDepth;
+            default:
+                return type;
+        }
+    }
+
+    void DebugRenderer::SetDepthTest(bool enabled) {
+        SR_LOCK_GUARD;
+        m_depthTest = enabled;
+    }
+
+    uint64_t DebugRenderer::DrawLineBatched(uint64_t id, const SR_MATH_NS::FVector3& start, const SR_MATH_NS::FVector3& end, const SR_MATH_NS::FColor& color, float_t time) {
+        SR_LOCK_GUARD;
+
+        auto&& object = AcquireBatchObject(id, BatchType::Line, time);
+
+        /// Цвет передается как есть, в диапазон 0..1 его переводит шейдер батча, как и у DebugLine
+        object.color = color.Cast<float_t>().ToGLM();
+
+        object.points.emplace_back(start.x, start.y, start.z);
+        object.points.emplace_back(end.x, end.y, end.z);
+
+        return id;
+    }
+
+    uint64_t DebugRenderer::DrawMeshBatched(SR_HTYPES_NS::RawMesh* pRawMesh, int32_t meshId, uint64_t id, const SR_MATH_NS::FVector3& pos,
+        const SR_MATH_NS::Quaternion& rot, const SR_MATH_NS::FVector3& scale,
+        const SR_MATH_NS::FColor& color, float_t time
+    ) {
+        SR_TRACY_ZONE;
+        SR_LOCK_GUARD;
+
+        if (!pRawMesh) {
+            return SR_ID_INVALID;
+        }
+
+        auto&& edges = GetMeshEdges(pRawMesh, meshId);
+        if (edges.empty()) {
+            return SR_ID_INVALID;
+        }
+
+        auto&& object = AcquireBatchObject(id, BatchType::Wireframe, time);
+
+        object.color = color.Cast<float_t>().ToGLM();
+
+        const SR_MATH_NS::Matrix4x4 matrix(pos, rot, scale);
+
+        object.points.reserve(edges.size());
+
+        for (auto&& point : edges) {
+            const SR_MATH_NS::FVector4 world = matrix * SR_MATH_NS::FVector4(point.x, point.y, point.z, 1.f);
+            object.points.emplace_back(world.x, world.y, world.z);
+        }
+
+        return id;
+    }
+
+    const std::vector<glm::vec3>& DebugRenderer::GetMeshEdges(SR_HTYPES_NS::RawMesh* pRawMesh, int32_t meshId) {
+        auto&& identifier = SR_FORMAT("{}|{}|{}", pRawMesh->GetResourceId().c_str(), meshId, pRawMesh->GetReloadCount());
+
+        if (auto&& pIt = m_meshEdges.find(identifier); pIt != m_meshEdges.end()) {
+            return pIt->second;
+        }
+
+        auto&& edges = m_meshEdges[identifier];
+
+        auto&& vertices = pRawMesh->GetVertices(meshId);
+        auto&& indices = pRawMesh->GetIndices(meshId);
+
+        /// Каркасный материал рисует ребра треугольников, общие ребра соседних треугольников берем один раз
+        ska::flat_hash_set<uint64_t> unique;
+
+        const auto addEdge = [&](uint32_t a, uint32_t b) {
+            if (a >= vertices.size() || b >= vertices.size()) {
+                return;
+            }
+
+            const uint64_t key = (static_cast<uint64_t>(SR_MIN(a, b)) << 32U) | SR_MAX(a, b);
+            if (!unique.insert(key).second) {
+                return;
+            }
+
+            edges.emplace_back(*reinterpret_cast<const glm::vec3*>((const void*)&vertices[a].position));
+            edges.emplace_back(*reinterpret_cast<const glm::vec3*>((const void*)&vertices[b].position));
+        };
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            addEdge(indices[i + 0], indices[i + 1]);
+            addEdge(indices[i + 1], indices[i + 2]);
+            addEdge(indices[i + 2], indices[i + 0]);
+        }
+
+        return edges;
+    }
 }
\ No newline at end of file
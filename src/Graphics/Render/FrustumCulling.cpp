@@ -2,4 +2,117 @@
 // Created by Monika on 07.04.2024.
 //
 
-#include <Graphics/Render/FrustumCulling.h>
\ No newline at end of file
+#include <Graphics/Render/FrustumCulling.h>
+
+namespace SR_GRAPH_NS {
+    void FrustumCulling::UpdateFrustum(const SR_MATH_NS::Matrix4x4& viewProjection) noexcept {
+        SR_TRACY_ZONE;
+
+        /// Столбцы матрицы, строки собираем из их компонент
+        const SR_MATH_NS::FVector4 c0 = viewProjection * SR_MATH_NS::FVector4(1.f, 0.f, 0.f, 0.f);
+        const SR_MATH_NS::FVector4 c1 = viewProjection * SR_MATH_NS::FVector4(0.f, 1.f, 0.f, 0.f);
+        const SR_MATH_NS::FVector4 c2 = viewProjection * SR_MATH_NS::FVector4(0.f, 0.f, 1.f, 0.f);
+        const SR_MATH_NS::FVector4 c3 = viewProjection * SR_MATH_NS::FVector4(0.f, 0.f, 0.f, 1.f);
+
+        const SR_MATH_NS::FVector4 row0(c0.x, c1.x, c2.x, c3.x);
+        const SR_MATH_NS::FVector4 row1(c0.y, c1.y, c2.y, c3.y);
+        const SR_MATH_NS::FVector4 row2(c0.z, c1.z, c2.z, c3.z);
+        const SR_MATH_NS::FVector4 row3(c0.w, c1.w, c2.w, c3.w);
+
+        m_planes[0] = row3 + row0; /// left
+        m_planes[1] = row3 - row0; /// right
+        m_planes[2] = row3 + row1; /// bottom
+        m_planes[3] = row3 - row1; /// top
+        m_planes[4] = row3 + row2; /// near (для глубины 0..1 плоскость получается с запасом)
+        m_planes[5] = row3 - row2; /// far
+
+        for (auto&& plane : m_planes) {
+            const float_t length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.f) SR_LIKELY_ATTRIBUTE {
+                plane = SR_MATH_NS::FVector4(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+            }
+        }
+    }
+
+    bool FrustumCulling::IsSphereInFrustum(const SR_MATH_NS::FVector3& center, float_t radius) const noexcept {
+        for (auto&& plane : m_planes) {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool FrustumCulling::IsBoxInFrustum(const SR_MATH_NS::FVector3& min, const SR_MATH_NS::FVector3& max) const noexcept {
+        const SR_MATH_NS::FVector3 center = (min + max) * 0.5f;
+        const SR_MATH_NS::FVector3 extents = (max - min) * 0.5f;
+
+        for (auto&& plane : m_planes) {
+            const float_t distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            const float_t radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            if (distance < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void FrustumCulling::CullSpheres(const float_t* pX, const float_t* pY, const float_t* pZ, const float_t* pRadius,
+        uint32_t count, uint8_t* pVisible) const noexcept
+    {
+        SR_TRACY_ZONE;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            pVisible[i] = 1;
+        }
+
+        for (auto&& plane : m_planes) {
+            const float_t a = plane.x, b = plane.y, c = plane.z, d = plane.w;
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const float_t distance = a * pX[i] + b * pY[i] + c * pZ[i] + d;
+                pVisible[i] &= static_cast<uint8_t>(distance >= -pRadius[i]);
+            }
+        }
+    }
+
+    void FrustumCulling::CullBoxes(const float_t* pX, const float_t* pY, const float_t* pZ,
+        const float_t* pExtentX, const float_t* pExtentY, const float_t* pExtentZ,
+        uint32_t count, uint8_t* pVisible) const noexcept
+    {
+        SR_TRACY_ZONE;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            pVisible[i] = 1;
+        }
+
+        for (auto&& plane : m_planes) {
+            const float_t a = plane.x, b = plane.y, c = plane.z, d = plane.w;
+            const float_t absA = std::abs(a), absB = std::abs(b), absC = std::abs(c);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const float_t distance = a * pX[i] + b * pY[i] + c * pZ[i] + d;
+                const float_t radius = absA * pExtentX[i] + absB * pExtentY[i] + absC * pExtentZ[i];
+                pVisible[i] &= static_cast<uint8_t>(distance >= -radius);
+            }
+        }
+    }
+
+    Frustum FrustumCulling::GetFrustum() const noexcept {
+        auto&& toPlane = [](const SR_MATH_NS::FVector4& plane) -> FrustumPlane {
+            FrustumPlane result;
+            result.normal = SR_MATH_NS::FVector3(plane.x, plane.y, plane.z);
+            result.distance = plane.w;
+            return result;
+        };
+
+        Frustum frustum;
+        frustum.leftFace = toPlane(m_planes[0]);
+        frustum.rightFace = toPlane(m_planes[1]);
+        frustum.bottomFace = toPlane(m_planes[2]);
+        frustum.topFace = toPlane(m_planes[3]);
+        frustum.nearFace = toPlane(m_planes[4]);
+        frustum.farFace = toPlane(m_planes[5]);
+        return frustum;
+    }
+}
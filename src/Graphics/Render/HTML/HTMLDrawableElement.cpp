@@ -104,7 +104,7 @@ namespace SR_GRAPH_NS {
                     m_pShader->SetSampler2D("image"_atom, m_pTexture);
                 }
                 m_pShader->FlushSamplers();
-                descriptorManager.Flush();
+                descriptorManager.Flush(m_virtualDescriptor);
             }
             m_pipeline->GetCurrentShader()->FlushConstants();
         }
@@ -79,54 +79,124 @@ namespace SR_GRAPH_NS {
 
         ClearTextAtlases();
 
+        DrawDocument();
+
+        for (auto&& shaderInfo : m_shaders | std::views::values) {
+            shaderInfo.recordedCount = shaderInfo.index;
+        }
+    }
+
+    void HTMLRenderContainer::DrawDocument() {
         for (auto&& [id, shaderInfo] : m_shaders) {
             if (shaderInfo.pShader->HasErrors()) {
-                SR_ERROR("HTMLRenderContainer::Draw() : shader \"{}\" has errors!", id.c_str());
+                SR_ERROR("HTMLRenderContainer::DrawDocument() : shader \"{}\" has errors!", id.c_str());
                 return;
             }
             shaderInfo.index = 0;
         }
 
-        if (SRVerify2(GetPage(), "HTMLRenderContainer::Draw() : page is not set!")) {
+        if (SRVerify2(GetPage(), "HTMLRenderContainer::DrawDocument() : page is not set!")) {
             litehtml::position clip;
             get_client_rect(clip);
             m_viewSize = SR_MATH_NS::FVector2(clip.width, clip.height);
-            GetPage()->GetDocument()->draw(reinterpret_cast<litehtml::uint_ptr>(this), m_scroll.x, m_scroll.y, &clip);
+
+            /// Отсечение по всему документу, сдвинутому на прокрутку: набор элементов от прокрутки не зависит,
+            /// поэтому при прокрутке достаточно переписать их юниформы без перезаписи командных буферов
+            auto&& pDocument = GetPage()->GetDocument();
+            clip.x = m_scroll.x;
+            clip.y = m_scroll.y;
+            clip.width = SR_MAX(clip.width, pDocument->width());
+            clip.height = SR_MAX(clip.height, pDocument->height());
+
+            pDocument->draw(reinterpret_cast<litehtml::uint_ptr>(this), m_scroll.x, m_scroll.y, &clip);
         }
     }
 
-    void HTMLRenderContainer::Update() {
+    void HTMLRenderContainer::RedrawElements() {
         SR_TRACY_ZONE;
 
-        if (!m_isRendered) {
-            return;
+        m_updateMode = true;
+        m_needRebuild = false;
+
+        DrawDocument();
+
+        m_updateMode = false;
+
+        for (auto&& shaderInfo : m_shaders | std::views::values) {
+            m_needRebuild |= shaderInfo.index != shaderInfo.recordedCount;
         }
 
-        if (SR_UTILS_NS::Input::Instance().GetKeyDown(SR_UTILS_NS::KeyCode::Tilde)) {
-            m_scroll = SR_MATH_NS::IVector2(0, 0);
+        if (m_needRebuild) {
             m_pipeline->SetDirty(true);
         }
+    }
+
+    void HTMLRenderContainer::UpdateInput() {
+        auto&& input = SR_UTILS_NS::Input::Instance();
+
+        const auto scroll = m_scroll;
 
-        if (SR_UTILS_NS::Input::Instance().GetKey(SR_UTILS_NS::KeyCode::DownArrow)) {
+        if (input.GetKeyDown(SR_UTILS_NS::KeyCode::Tilde)) {
+            m_scroll = SR_MATH_NS::IVector2(0, 0);
+        }
+
+        if (input.GetKey(SR_UTILS_NS::KeyCode::DownArrow)) {
             m_scroll.y -= 10;
-            m_pipeline->SetDirty(true);
         }
 
-        if (SR_UTILS_NS::Input::Instance().GetKey(SR_UTILS_NS::KeyCode::UpArrow)) {
+        if (input.GetKey(SR_UTILS_NS::KeyCode::UpArrow)) {
             m_scroll.y += 10;
-            m_pipeline->SetDirty(true);
         }
 
-        if (SR_UTILS_NS::Input::Instance().GetKey(SR_UTILS_NS::KeyCode::LeftArrow)) {
+        if (input.GetKey(SR_UTILS_NS::KeyCode::LeftArrow)) {
             m_scroll.x += 10;
-            m_pipeline->SetDirty(true);
         }
 
-        if (SR_UTILS_NS::Input::Instance().GetKey(SR_UTILS_NS::KeyCode::RightArrow)) {
+        if (input.GetKey(SR_UTILS_NS::KeyCode::RightArrow)) {
             m_scroll.x -= 10;
-            m_pipeline->SetDirty(true);
         }
 
+        if (!GetPage() || !m_pipeline || !m_pipeline->GetWindow()) {
+            return;
+        }
+
+        /// Позиции элементов записаны в их юниформы, поэтому прокрутка их переписывает
+        bool redraw = scroll != m_scroll;
+
+        auto&& pDocument = GetPage()->GetDocument();
+
+        const auto client = m_pipeline->GetWindow()->ScreenToClient(SR_PLATFORM_NS::GetMousePos().Cast<int32_t>());
+        const auto position = SR_MATH_NS::IVector2(client.x - m_scroll.x, client.y - m_scroll.y);
+
+        litehtml::position::vector redrawBoxes;
+
+        if (position != m_mousePosition) {
+            m_mousePosition = position;
+            redraw |= pDocument->on_mouse_over(position.x, position.y, client.x, client.y, redrawBoxes);
+        }
+
+        if (input.GetMouseDown(SR_UTILS_NS::MouseCode::MouseLeft)) {
+            redraw |= pDocument->on_lbutton_down(position.x, position.y, client.x, client.y, redrawBoxes);
+        }
+
+        if (input.GetMouseUp(SR_UTILS_NS::MouseCode::MouseLeft)) {
+            redraw |= pDocument->on_lbutton_up(position.x, position.y, client.x, client.y, redrawBoxes);
+        }
+
+        if (redraw) {
+            RedrawElements();
+        }
+    }
+
+    void HTMLRenderContainer::Update() {
+        SR_TRACY_ZONE;
+
+        if (!m_isRendered) {
+            return;
+        }
+
+        UpdateInput();
+
         for (auto&& [id, shaderInfo] : m_shaders) {
             if (!shaderInfo.pShader->Ready()) {
                 continue;
@@ -341,6 +411,12 @@ namespace SR_GRAPH_NS {
     }
 
     bool HTMLRenderContainer::BeginElement(ShaderInfo& shaderInfo) {
+        /// Вне построения командных буферов шейдер только выбирается для записи юниформ
+        if (m_updateMode) {
+            m_pipeline->SetCurrentShader(shaderInfo.pShader);
+            return true;
+        }
+
         if (m_pipeline->GetCurrentShader() != shaderInfo.pShader) {
             const auto result = shaderInfo.pShader->Use();
             if (result == ShaderBindResult::Failed) SR_UNLIKELY_ATTRIBUTE {
@@ -353,6 +429,10 @@ namespace SR_GRAPH_NS {
     }
 
     void HTMLRenderContainer::UpdateElement(ShaderInfo& shaderInfo) {
+        if (m_updateMode && m_needRebuild) {
+            return;
+        }
+
         auto&& pShader = m_pipeline->GetCurrentShader();
         if (!pShader->Flush()) {
             SR_ERROR("HTMLRenderContainer::UpdateElement() : failed to flush shader \"{}\"!", pShader->GetResourceId().c_str());
@@ -372,6 +452,12 @@ namespace SR_GRAPH_NS {
             }
         }
 
+        /// Новая текстура потребует обновления дескрипторов, которые уже записаны в командные буферы
+        if (m_updateMode) {
+            m_needRebuild = true;
+            return nullptr;
+        }
+
         if (!pTextBuilder->Build(text)) {
             //SR_ERROR("HTMLRenderContainer::GetTextAtlas() : failed to build text!");
             return nullptr;
@@ -420,6 +506,16 @@ namespace SR_GRAPH_NS {
     }
 
     void HTMLRenderContainer::DrawElement(ShaderInfo &shaderInfo) {
+        if (m_updateMode) {
+            if (shaderInfo.index >= shaderInfo.recordedCount) SR_UNLIKELY_ATTRIBUTE {
+                m_needRebuild = true;
+                return;
+            }
+
+            m_uboManager.BindUBO(shaderInfo.UBOs[shaderInfo.index].virtualUBO);
+            return;
+        }
+
         if (shaderInfo.index >= shaderInfo.UBOs.size()) SR_UNLIKELY_ATTRIBUTE {
             ShaderInfo::MemInfo memInfo;
 
@@ -443,7 +539,7 @@ namespace SR_GRAPH_NS {
 
         if (m_pipeline->GetCurrentBuildIteration() == 0) {
             shaderInfo.pShader->FlushSamplers();
-            m_descriptorManager.Flush();
+            m_descriptorManager.Flush(shaderInfo.UBOs[shaderInfo.index].virtualDescriptor);
             m_pipeline->GetCurrentShader()->FlushConstants();
         }
 
@@ -12,6 +12,7 @@
 #include <Graphics/Memory/UBOManager.h>
 #include <Graphics/Memory/SSBOManager.h>
 #include <Graphics/Pipeline/Vulkan/VulkanPipeline.h>
+#include <Graphics/Pipeline/EmptyPipeline.h>
 #include <Graphics/Pass/FramebufferPass.h>
 
 #include <Graphics/Types/Framebuffer.h>
@@ -24,7 +25,13 @@ namespace SR_GRAPH_NS {
     RenderContext::RenderContext()
         : Super(this)
     {
-        m_pipeline = new VulkanPipeline(GetThis());
+        /// Конвейер без видеокарты, для отладки и замеров рендера на CPU
+        if (SR_UTILS_NS::Features::Instance().Enabled("EmptyPipeline", false)) {
+            m_pipeline = new EmptyPipeline(GetThis());
+        }
+        else {
+            m_pipeline = new VulkanPipeline(GetThis());
+        }
     }
 
     bool RenderContext::Update() noexcept {
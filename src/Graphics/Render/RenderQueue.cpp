@@ -6,10 +6,67 @@
 #include <Graphics/Render/RenderQueue.h>
 #include <Graphics/Render/RenderContext.h>
 #include <Graphics/Render/RenderScene.h>
+#include <Graphics/Material/BaseMaterial.h>
+#include <Graphics/Types/Camera.h>
 
 #include <Utils/ECS/LayerManager.h>
 
 namespace SR_GRAPH_NS {
+    /// На более грубый уровень переходим с запасом, чтобы на границе уровни не переключались каждый кадр
+    static constexpr float_t SR_LOD_HYSTERESIS = 1.2f;
+
+    /// Разрядность полей ключа сортировки, от старших к младшим. Слой ключу не нужен - у каждого слоя своя очередь.
+    /// Непрозрачные: приоритет, 0, шейдер, материал, VBO, глубина (от ближних к дальним).
+    /// Прозрачные: приоритет, 1, глубина (от дальних к ближним), шейдер, материал
+    static constexpr uint32_t SR_SORT_KEY_PRIORITY_BITS = 16;
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_BITS = 1;
+    static constexpr uint32_t SR_SORT_KEY_SHADER_BITS = 11;
+    static constexpr uint32_t SR_SORT_KEY_MATERIAL_BITS = 14;
+    static constexpr uint32_t SR_SORT_KEY_VBO_BITS = 14;
+    static constexpr uint32_t SR_SORT_KEY_DEPTH_BITS = 8;
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_DEPTH_BITS = SR_SORT_KEY_VBO_BITS + SR_SORT_KEY_DEPTH_BITS;
+
+    static_assert(SR_SORT_KEY_PRIORITY_BITS + SR_SORT_KEY_TRANSPARENT_BITS + SR_SORT_KEY_SHADER_BITS + SR_SORT_KEY_MATERIAL_BITS + SR_SORT_KEY_VBO_BITS + SR_SORT_KEY_DEPTH_BITS == 64);
+
+    static constexpr uint32_t SR_SORT_KEY_VBO_SHIFT = SR_SORT_KEY_DEPTH_BITS;
+    static constexpr uint32_t SR_SORT_KEY_MATERIAL_SHIFT = SR_SORT_KEY_VBO_SHIFT + SR_SORT_KEY_VBO_BITS;
+    static constexpr uint32_t SR_SORT_KEY_SHADER_SHIFT = SR_SORT_KEY_MATERIAL_SHIFT + SR_SORT_KEY_MATERIAL_BITS;
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_SHIFT = SR_SORT_KEY_SHADER_SHIFT + SR_SORT_KEY_SHADER_BITS;
+    static constexpr uint32_t SR_SORT_KEY_PRIORITY_SHIFT = SR_SORT_KEY_TRANSPARENT_SHIFT + SR_SORT_KEY_TRANSPARENT_BITS;
+    static constexpr uint64_t SR_SORT_KEY_DEPTH_MASK = (1ull << SR_SORT_KEY_DEPTH_BITS) - 1;
+
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_MATERIAL_SHIFT = 0;
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_SHADER_SHIFT = SR_SORT_KEY_TRANSPARENT_MATERIAL_SHIFT + SR_SORT_KEY_MATERIAL_BITS;
+    static constexpr uint32_t SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT = SR_SORT_KEY_TRANSPARENT_SHADER_SHIFT + SR_SORT_KEY_SHADER_BITS;
+    static constexpr uint64_t SR_SORT_KEY_TRANSPARENT_DEPTH_MAX = (1ull << SR_SORT_KEY_TRANSPARENT_DEPTH_BITS) - 1;
+    static constexpr uint64_t SR_SORT_KEY_TRANSPARENT_DEPTH_MASK = SR_SORT_KEY_TRANSPARENT_DEPTH_MAX << SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT;
+
+    static_assert(SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT + SR_SORT_KEY_TRANSPARENT_DEPTH_BITS == SR_SORT_KEY_TRANSPARENT_SHIFT);
+
+    /// Корзин глубины прозрачных мешей на каждое удвоение расстояния
+    static constexpr float_t SR_TRANSPARENT_DEPTH_SCALE = 65536.f;
+    /// Насколько (около процента расстояния) один прозрачный вызов должен оказаться ближе предыдущего,
+    /// чтобы ради нового порядка перезаписать команды. Почти равноудаленные меши не перестраивают сцену каждый кадр
+    static constexpr uint64_t SR_TRANSPARENT_ORDER_HYSTERESIS = static_cast<uint64_t>(SR_TRANSPARENT_DEPTH_SCALE) / 64;
+
+    /// Выдает плотный номер значения. Когда номера заканчиваются, возвращает последний и просит пересчитать ключи
+    template<typename Map, typename Value> static uint32_t GetSortKeyId(Map& ids, const Value& value, uint32_t bits, bool& overflow) {
+        const uint32_t maxId = (1u << bits) - 1;
+
+        if (auto&& pIt = ids.find(value); pIt != ids.end()) SR_LIKELY_ATTRIBUTE {
+            return pIt->second;
+        }
+
+        if (ids.size() > maxId) SR_UNLIKELY_ATTRIBUTE {
+            overflow = true;
+            return maxId;
+        }
+
+        const auto id = static_cast<uint32_t>(ids.size());
+        ids.emplace(value, id);
+        return id;
+    }
+
     RenderQueue::RenderQueue(RenderStrategy* pStrategy, MeshDrawerPass* pDrawer)
         : Super(this, SR_UTILS_NS::SharedPtrPolicy::Manually)
         , m_uboManager(Memory::UBOManager::Instance())
@@ -28,8 +85,21 @@ namespace SR_GRAPH_NS {
 
         m_renderStrategy->RemoveQueue(this);
 
+        for (auto&& batch : m_instanceBatches) {
+            if (batch.ssbo != SR_ID_INVALID) {
+                m_pipeline->FreeSSBO(&batch.ssbo);
+            }
+        }
+
+        if (m_indirectBuffer != SR_ID_INVALID) {
+            m_pipeline->FreeIndirectBuffer(&m_indirectBuffer);
+        }
+
         for (auto&& [layer, queue] : m_queues) {
             for (auto&& meshInfo : queue) {
+                if (meshInfo.removed) {
+                    continue;
+                }
                 meshInfo.pMesh->GetRenderQueues().Remove({ this, meshInfo.shaderUseInfo });
                 if (meshInfo.pMesh->GetRenderQueues().empty()) {
                     meshInfo.pMesh->SetUniformsClean();
@@ -49,20 +119,41 @@ namespace SR_GRAPH_NS {
 
         MeshInfo meshInfo;
         meshInfo.pMesh = info.pMesh;
+        meshInfo.pMaterial = info.pMaterial;
         meshInfo.shaderUseInfo = GetShaderUseInfo(info);
         meshInfo.vbo = info.VBO.has_value() ? info.VBO.value() : SR_ID_INVALID;
         meshInfo.priority = info.priority.value_or(0);
-
-        ShaderInfo shaderInfo;
-        shaderInfo.info = meshInfo.shaderUseInfo;
+        meshInfo.transparent = info.pMaterial && info.pMaterial->GetShader() && info.pMaterial->IsTransparent();
+        meshInfo.sortKey = CalculateSortKey(meshInfo);
+
+        /// Уровень по экранному размеру выбирается сразу, первое построение запишет меш уже с ним
+        SR_MATH_NS::FVector3 cameraPosition;
+        float_t projection = 0.f;
+        if (GetLodView(cameraPosition, projection)) {
+            meshInfo.lod = SelectLod(meshInfo, cameraPosition, projection);
+        }
 
         info.pMesh->GetRenderQueues().Add({ this, meshInfo.shaderUseInfo });
 
+        /// Серии экземпляров будут собраны заново при следующем построении
+        m_instanceBatchesValid = false;
+
         for (auto&& [layer, queue] : m_queues) {
-            if (layer == info.layer) {
-                queue.Add(meshInfo);
-                break;
+            if (layer != info.layer) {
+                continue;
             }
+
+            /// Вставка в отсортированный массив сдвигала элементы, при массовой регистрации это было квадратично
+            if (auto&& pIt = queue.indices.find(info.pMesh); pIt != queue.indices.end()) SR_UNLIKELY_ATTRIBUTE {
+                queue.entries[pIt->second] = meshInfo;
+            }
+            else {
+                queue.indices.emplace(info.pMesh, static_cast<uint32_t>(queue.entries.size()));
+                queue.entries.emplace_back(meshInfo);
+            }
+
+            queue.dirty = true;
+            break;
         }
     }
 
@@ -86,21 +177,22 @@ namespace SR_GRAPH_NS {
             return;
         }
 
-        MeshInfo meshInfo;
-        meshInfo.pMesh = info.pMesh;
-        meshInfo.shaderUseInfo = GetShaderUseInfo(info);
-        meshInfo.vbo = info.VBO.has_value() ? info.VBO.value() : SR_ID_INVALID;
-        meshInfo.priority = info.priority.value_or(0);
-
         auto&& queues = info.pMesh->GetRenderQueues();
-        queues.Remove({ this, meshInfo.shaderUseInfo });
+        queues.Remove({ this, GetShaderUseInfo(info) });
+
+        m_instanceBatchesValid = false;
 
-        if (!pQueue->Remove(meshInfo)) {
+        if (auto&& pIt = pQueue->indices.find(info.pMesh); pIt != pQueue->indices.end()) SR_LIKELY_ATTRIBUTE {
+            pQueue->entries[pIt->second].removed = true;
+            pQueue->indices.erase(pIt);
+            pQueue->dirty = true;
+        }
+        else {
             SRHalt("RenderQueue::UnRegister() : mesh not found!");
         }
 
         if (queues.empty()) {
-            meshInfo.pMesh->SetUniformsClean();
+            info.pMesh->SetUniformsClean();
         }
     }
 
@@ -115,8 +207,17 @@ namespace SR_GRAPH_NS {
         SRAssert(m_isInitialized);
 
         PrepareLayers();
+        FlushQueues();
 
         m_rendered = false;
+        m_instanceBatchesCount = 0;
+        m_instanceBatchesValid = true;
+        m_indirectCommands.clear();
+        m_indirectMeshes.clear();
+        m_indirectDraw = !m_customMeshDraw &&
+            m_pipeline->IsIndirectDrawSupported() &&
+            m_meshDrawerPass->IsIndirectDrawEnabled() &&
+            PrepareIndirectBuffer();
 
         m_shaders.Clear();
 
@@ -124,18 +225,30 @@ namespace SR_GRAPH_NS {
             Render(layer, queue);
         }
 
+        if (!m_indirectCommands.empty()) {
+            m_pipeline->UpdateIndirectBuffer(m_indirectBuffer, m_indirectCommands.data(), static_cast<uint32_t>(m_indirectCommands.size()));
+            m_indirectDirty = false;
+        }
+
         return m_rendered;
     }
 
     void RenderQueue::Update() {
         SR_TRACY_ZONE;
 
+        FlushQueues();
+
         if (!m_rendered) {
             return;
         }
 
+        UpdateFrustumCulling();
+        UpdateLods();
+        UpdateTransparentOrder();
+
         UpdateShaders();
         UpdateMeshes();
+        UpdateInstances();
     }
 
     void RenderQueue::OnMeshDirty(MeshPtr pMesh, ShaderUseInfo info) {
@@ -168,6 +281,14 @@ namespace SR_GRAPH_NS {
 
             pMesh->SetUniformsClean();
 
+            /// Отсеченный меш не рисуется, его юниформы обновятся когда он снова станет видимым
+            if (m_hasCulledMeshes) SR_UNLIKELY_ATTRIBUTE {
+                if (auto&& pInfo = FindMeshInfo(pMesh); pInfo && pInfo->culled) {
+                    pInfo->skippedUniforms = true;
+                    continue;
+                }
+            }
+
             auto&& virtualUbo = pMesh->GetVirtualUBO();
             if (virtualUbo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
                 continue;
@@ -185,6 +306,258 @@ namespace SR_GRAPH_NS {
         m_meshes.clear();
     }
 
+    void RenderQueue::UpdateFrustumCulling() {
+        SR_TRACY_ZONE;
+
+        auto&& pCamera = m_meshDrawerPass->GetCamera();
+
+        /// Отсечение выключено, возвращаем все ранее отсеченные меши
+        if (!pCamera || !m_meshDrawerPass->IsFrustumCullingEnabled()) SR_UNLIKELY_ATTRIBUTE {
+            if (!m_hasCulledMeshes) SR_LIKELY_ATTRIBUTE {
+                return;
+            }
+
+            m_cullingRebuild = false;
+
+            for (auto&& [layer, queue] : m_queues) {
+                MeshInfo* pStart = queue.data();
+                const MeshInfo* pEnd = pStart + queue.size();
+
+                for (MeshInfo* pElement = pStart; pElement < pEnd; ++pElement) {
+                    SetMeshCulled(*pElement, false);
+                }
+            }
+
+            m_hasCulledMeshes = false;
+
+            if (m_cullingRebuild) SR_UNLIKELY_ATTRIBUTE {
+                m_renderScene->SetDirty();
+            }
+
+            return;
+        }
+
+        m_frustumCulling.UpdateFrustum(pCamera->GetProjection() * pCamera->GetViewTranslate());
+        m_cullingRebuild = false;
+
+        m_sphereBatch.Clear();
+        m_boxBatch.Clear();
+
+        for (auto&& [layer, queue] : m_queues) {
+            MeshInfo* pStart = queue.data();
+            const MeshInfo* pEnd = pStart + queue.size();
+
+            for (MeshInfo* pElement = pStart; pElement < pEnd; ++pElement) {
+                const auto pMesh = pElement->pMesh;
+                const auto cullingType = pMesh->GetFrustumCullingType();
+                auto&& bounds = pMesh->GetLocalBounds();
+
+                if (cullingType == FrustumCullingType::None || !bounds.valid) SR_UNLIKELY_ATTRIBUTE {
+                    SetMeshCulled(*pElement, false);
+                    continue;
+                }
+
+                auto&& matrix = pMesh->GetMatrix();
+                const auto localCenter = bounds.Center();
+                const auto localExtents = bounds.Extents();
+
+                const SR_MATH_NS::FVector4 center = matrix * SR_MATH_NS::FVector4(localCenter.x, localCenter.y, localCenter.z, 1.f);
+                const SR_MATH_NS::FVector4 axisX = matrix * SR_MATH_NS::FVector4(1.f, 0.f, 0.f, 0.f);
+                const SR_MATH_NS::FVector4 axisY = matrix * SR_MATH_NS::FVector4(0.f, 1.f, 0.f, 0.f);
+                const SR_MATH_NS::FVector4 axisZ = matrix * SR_MATH_NS::FVector4(0.f, 0.f, 1.f, 0.f);
+
+                if (cullingType == FrustumCullingType::Sphere) {
+                    const float_t scale = std::sqrt(SR_MAX(
+                        axisX.x * axisX.x + axisX.y * axisX.y + axisX.z * axisX.z, SR_MAX(
+                        axisY.x * axisY.x + axisY.y * axisY.y + axisY.z * axisY.z,
+                        axisZ.x * axisZ.x + axisZ.y * axisZ.y + axisZ.z * axisZ.z
+                    )));
+
+                    m_sphereBatch.x.emplace_back(center.x);
+                    m_sphereBatch.y.emplace_back(center.y);
+                    m_sphereBatch.z.emplace_back(center.z);
+                    m_sphereBatch.extentX.emplace_back(bounds.Radius() * scale);
+                    m_sphereBatch.meshes.emplace_back(pElement);
+                    continue;
+                }
+
+                /// OBB, DOP8 и ConvexHull пока проверяются по описанному AABB, это консервативно
+                m_boxBatch.x.emplace_back(center.x);
+                m_boxBatch.y.emplace_back(center.y);
+                m_boxBatch.z.emplace_back(center.z);
+                m_boxBatch.extentX.emplace_back(std::abs(axisX.x) * localExtents.x + std::abs(axisY.x) * localExtents.y + std::abs(axisZ.x) * localExtents.z);
+                m_boxBatch.extentY.emplace_back(std::abs(axisX.y) * localExtents.x + std::abs(axisY.y) * localExtents.y + std::abs(axisZ.y) * localExtents.z);
+                m_boxBatch.extentZ.emplace_back(std::abs(axisX.z) * localExtents.x + std::abs(axisY.z) * localExtents.y + std::abs(axisZ.z) * localExtents.z);
+                m_boxBatch.meshes.emplace_back(pElement);
+            }
+        }
+
+        const auto spheresCount = static_cast<uint32_t>(m_sphereBatch.meshes.size());
+        m_sphereBatch.visible.resize(spheresCount);
+        m_frustumCulling.CullSpheres(
+            m_sphereBatch.x.data(), m_sphereBatch.y.data(), m_sphereBatch.z.data(), m_sphereBatch.extentX.data(),
+            spheresCount, m_sphereBatch.visible.data()
+        );
+
+        const auto boxesCount = static_cast<uint32_t>(m_boxBatch.meshes.size());
+        m_boxBatch.visible.resize(boxesCount);
+        m_frustumCulling.CullBoxes(
+            m_boxBatch.x.data(), m_boxBatch.y.data(), m_boxBatch.z.data(),
+            m_boxBatch.extentX.data(), m_boxBatch.extentY.data(), m_boxBatch.extentZ.data(),
+            boxesCount, m_boxBatch.visible.data()
+        );
+
+        m_hasCulledMeshes = false;
+
+        for (auto&& pBatch : { &m_sphereBatch, &m_boxBatch }) {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(pBatch->meshes.size()); ++i) {
+                const bool culled = pBatch->visible[i] == 0;
+                SetMeshCulled(*pBatch->meshes[i], culled);
+                m_hasCulledMeshes |= culled;
+            }
+        }
+
+        /// Прямые вызовы записаны вместе с видимостью, поменять ее можно только перестроением
+        if (m_cullingRebuild) SR_UNLIKELY_ATTRIBUTE {
+            m_renderScene->SetDirty();
+        }
+    }
+
+    void RenderQueue::UpdateLods() {
+        SR_TRACY_ZONE;
+
+        SR_MATH_NS::FVector3 cameraPosition;
+        float_t projection = 0.f;
+        const bool enabled = GetLodView(cameraPosition, projection);
+
+        /// Выключено и все меши уже на исходном уровне. Серии ссылаются на элементы очереди,
+        /// пока они не собраны заново уровень выбирать не для чего
+        if ((!enabled && !m_hasLods) || !m_instanceBatchesValid) SR_LIKELY_ATTRIBUTE {
+            return;
+        }
+
+        m_hasLods = false;
+        bool rebuild = false;
+
+        for (auto&& [layer, queue] : m_queues) {
+            MeshInfo* pStart = queue.data();
+            const MeshInfo* pEnd = pStart + queue.size();
+
+            for (MeshInfo* pElement = pStart; pElement < pEnd; ++pElement) {
+                /// Отсеченные меши не рисуются, уровень для них пересчитается когда они станут видимыми
+                if (enabled && pElement->culled) {
+                    m_hasLods |= pElement->lod != 0;
+                    continue;
+                }
+
+                pElement->lod = enabled ? SelectLod(*pElement, cameraPosition, projection) : 0;
+                m_hasLods |= pElement->lod != 0;
+
+                /// Непрямая команда получит уровень при обновлении аргументов. Прямой вызов записан со своим
+                /// диапазоном индексов, ради более подробного уровня его нужно перезаписать
+                rebuild |= pElement->direct && pElement->lod < pElement->recordedLod;
+            }
+        }
+
+        if (rebuild) SR_UNLIKELY_ATTRIBUTE {
+            m_renderScene->SetDirty();
+        }
+    }
+
+    bool RenderQueue::GetLodView(SR_MATH_NS::FVector3& cameraPosition, float_t& projection) const {
+        auto&& pCamera = m_meshDrawerPass->GetCamera();
+        if (!pCamera || !m_meshDrawerPass->IsLodEnabled()) {
+            return false;
+        }
+
+        cameraPosition = pCamera->GetPosition();
+        /// Сколько пикселей по вертикали занимает единица длины на единичном расстоянии
+        projection = static_cast<float_t>(pCamera->GetSize().y) / (2.f * std::tan(SR_RAD(pCamera->GetFOV()) * 0.5f));
+
+        return true;
+    }
+
+    uint8_t RenderQueue::SelectLod(const MeshInfo& info, const SR_MATH_NS::FVector3& cameraPosition, float_t projection) const {
+        const auto pMesh = info.pMesh;
+        const uint8_t lodsCount = pMesh->GetLodsCount();
+        auto&& bounds = pMesh->GetLocalBounds();
+
+        if (lodsCount <= 1 || !bounds.valid) SR_LIKELY_ATTRIBUTE {
+            return 0;
+        }
+
+        auto&& matrix = pMesh->GetMatrix();
+        const auto localCenter = bounds.Center();
+
+        const SR_MATH_NS::FVector4 center = matrix * SR_MATH_NS::FVector4(localCenter.x, localCenter.y, localCenter.z, 1.f);
+        const SR_MATH_NS::FVector4 axisX = matrix * SR_MATH_NS::FVector4(1.f, 0.f, 0.f, 0.f);
+        const SR_MATH_NS::FVector4 axisY = matrix * SR_MATH_NS::FVector4(0.f, 1.f, 0.f, 0.f);
+        const SR_MATH_NS::FVector4 axisZ = matrix * SR_MATH_NS::FVector4(0.f, 0.f, 1.f, 0.f);
+
+        const float_t scale = std::sqrt(SR_MAX(
+            axisX.x * axisX.x + axisX.y * axisX.y + axisX.z * axisX.z, SR_MAX(
+            axisY.x * axisY.x + axisY.y * axisY.y + axisY.z * axisY.z,
+            axisZ.x * axisZ.x + axisZ.y * axisZ.y + axisZ.z * axisZ.z
+        )));
+
+        const float_t dx = center.x - cameraPosition.x;
+        const float_t dy = center.y - cameraPosition.y;
+        const float_t dz = center.z - cameraPosition.z;
+
+        /// Расстояние до ближайшей точки ограничивающей сферы, камера внутри - рисуем исходную сетку
+        const float_t distance = std::sqrt(dx * dx + dy * dy + dz * dz) - bounds.Radius() * scale;
+        if (distance <= 0.f) {
+            return 0;
+        }
+
+        const float_t pixelsPerUnit = scale * projection / distance;
+        const float_t threshold = m_meshDrawerPass->GetLodErrorThreshold();
+
+        uint8_t lod = 0;
+
+        for (uint8_t level = 1; level < lodsCount; ++level) {
+            float_t error = pMesh->GetLod(level).error * pixelsPerUnit;
+
+            if (level > info.lod) {
+                error *= SR_LOD_HYSTERESIS;
+            }
+
+            if (error > threshold) {
+                break;
+            }
+
+            lod = level;
+        }
+
+        return lod;
+    }
+
+    void RenderQueue::SetMeshCulled(MeshInfo& info, bool culled) {
+        if (info.culled == culled) SR_LIKELY_ATTRIBUTE {
+            return;
+        }
+
+        info.culled = culled;
+
+        if (!culled && info.skippedUniforms) {
+            info.skippedUniforms = false;
+            m_meshes.emplace_back(info.pMesh, info.shaderUseInfo);
+        }
+
+        /// Меш из непрямой серии остается в записанной команде, его матрица просто не попадет в буфер экземпляров
+        m_cullingRebuild |= info.direct && info.recordedCulled != culled;
+    }
+
+    RenderQueue::MeshInfo* RenderQueue::FindMeshInfo(MeshPtr pMesh) {
+        for (auto&& [layer, queue] : m_queues) {
+            if (auto&& pIt = queue.indices.find(pMesh); pIt != queue.indices.end()) {
+                return &queue.entries[pIt->second];
+            }
+        }
+
+        return nullptr;
+    }
+
     bool RenderQueue::IsSuitable(const MeshRegistrationInfo &info) const {
         SR_TRACY_ZONE;
 
@@ -202,6 +575,9 @@ namespace SR_GRAPH_NS {
     void RenderQueue::Render(const SR_UTILS_NS::StringAtom& layer, RenderQueue::Queue& queue) {
         SR_TRACY_ZONE_S(layer.c_str());
 
+        /// Порядок записывается в команды рендера, поэтому глубина обновляется только при построении
+        UpdateDepthKeys(queue);
+
         ShaderPtr pCurrentShader = nullptr;
         VBO currentVBO = 0;
 
@@ -209,6 +585,12 @@ namespace SR_GRAPH_NS {
         const MeshInfo* pEnd = pStart + queue.size();
         bool shaderOk = false;
 
+        for (MeshInfo* pElement = pStart; pElement < pEnd; ++pElement) {
+            pElement->instanceBatch = SR_ID_INVALID;
+            pElement->indirectCommand = SR_ID_INVALID;
+            pElement->direct = false;
+        }
+
         for (MeshInfo* pElement = pStart; pElement < pEnd; ) {
             const MeshInfo info = *pElement;
 
@@ -235,24 +617,51 @@ namespace SR_GRAPH_NS {
                 }
             }
 
-            if (info.vbo != currentVBO) SR_UNLIKELY_ATTRIBUTE {
-                if (!info.pMesh->BindMesh()) SR_UNLIKELY_ATTRIBUTE {
-                    pElement->state = QUEUE_STATE_VBO_ERROR;
-                    pElement = FindNextVBO(queue, pElement);
-                    continue;
+            uint32_t instanceCount = 1;
+            bool visible = true;
+
+            if (!m_customMeshDraw && pCurrentShader->IsInstancingSupported()) {
+                instanceCount = PrepareInstancing(pElement, pEnd, IsIndirectCandidate(info), visible);
+            }
+            else if (IsIndirectCandidate(info)) {
+                /// Своя команда меша, отсечение и уровень детализации меняют только ее аргументы
+                if (pElement->indirectCommand = AddIndirectCommand(); pElement->indirectCommand != SR_ID_INVALID) SR_LIKELY_ATTRIBUTE {
+                    m_indirectMeshes.emplace_back(pElement);
+                    UpdateIndirectCommand(*pElement);
+                    info.pMesh->SetInstancing(SR_ID_INVALID, 1, m_indirectBuffer, pElement->indirectCommand);
                 }
-                currentVBO = info.vbo;
+                else {
+                    visible = PrepareDirect(*pElement);
+                }
+            }
+            else {
+                visible = PrepareDirect(*pElement);
             }
 
-            if (m_customMeshDraw) SR_UNLIKELY_ATTRIBUTE {
-                CustomDrawMesh(info);
+            if (visible) SR_LIKELY_ATTRIBUTE {
+                if (info.vbo != currentVBO) SR_UNLIKELY_ATTRIBUTE {
+                    if (!info.pMesh->BindMesh()) SR_UNLIKELY_ATTRIBUTE {
+                        pElement->state = QUEUE_STATE_VBO_ERROR;
+                        pElement = FindNextVBO(queue, pElement);
+                        continue;
+                    }
+                    currentVBO = info.vbo;
+                }
+
+                if (m_customMeshDraw) SR_UNLIKELY_ATTRIBUTE {
+                    CustomDrawMesh(info);
+                }
+                else {
+                    m_meshDrawerPass->UseSSBO(info.shaderUseInfo);
+                    info.pMesh->Draw();
+                }
             }
-            else {
-                info.pMesh->Draw();
+
+            for (MeshInfo* pInstance = pElement; pInstance < pElement + instanceCount; ++pInstance) {
+                pInstance->state = QUEUE_STATE_OK;
             }
 
-            pElement->state = QUEUE_STATE_OK;
-            ++pElement;
+            pElement += instanceCount;
             m_rendered = true;
         }
 
@@ -261,41 +670,501 @@ namespace SR_GRAPH_NS {
         }
     }
 
-    RenderQueue::MeshInfo* RenderQueue::FindNextShader(Queue& queue, MeshInfo* pElement) {
+    bool RenderQueue::PrepareDirect(MeshInfo& info) {
+        /// Прямой вызов, отсеченный меш в команды рендера не попадает
+        info.direct = true;
+        info.recordedCulled = info.culled;
+        info.recordedLod = info.lod;
+        info.pMesh->SetInstancing(SR_ID_INVALID, 1);
+        info.pMesh->SetLod(info.lod);
+        return !info.culled;
+    }
+
+    bool RenderQueue::IsIndirectCandidate(const MeshInfo& info) const {
+        return m_indirectDraw && info.pMesh->IsSupportVBO();
+    }
+
+    uint32_t RenderQueue::PrepareInstancing(MeshInfo* pElement, const MeshInfo* pEnd, bool indirect, bool& visible) {
+        SR_TRACY_ZONE;
+
+        const MeshInfo& info = *pElement;
+
+        uint32_t instanceCount = 1;
+        visible = true;
+
+        /// Очередь отсортирована по приоритету, шейдеру и VBO, поэтому одинаковые меши идут подряд
+        if (m_meshDrawerPass->IsInstancingEnabled() && info.pMesh->IsInstancingSupported()) SR_LIKELY_ATTRIBUTE {
+            const auto pMaterial = info.pMesh->GetMaterial();
+
+            for (const MeshInfo* pNext = pElement + 1; pNext < pEnd; ++pNext) {
+                const bool compatible =
+                    pNext->shaderUseInfo.pShader == info.shaderUseInfo.pShader &&
+                    pNext->vbo == info.vbo &&
+                    pNext->priority == info.priority &&
+                    (!indirect || IsIndirectCandidate(*pNext)) &&
+                    pNext->pMesh->GetMaterial() == pMaterial &&
+                    pNext->pMesh->IsInstancingSupported();
+
+                if (!compatible) {
+                    break;
+                }
+
+                ++instanceCount;
+            }
+        }
+
+        /// Шейдер с поддержкой инстансинга всегда берет матрицу из буфера экземпляров,
+        /// поэтому одиночный меш тоже получает свою серию из одного элемента
+        if (m_instanceBatchesCount == m_instanceBatches.size()) {
+            m_instanceBatches.emplace_back();
+        }
+
+        auto&& batch = m_instanceBatches[m_instanceBatchesCount++];
+
+        batch.meshes.clear();
+        batch.indirect = false;
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            batch.meshes.emplace_back(pElement + i);
+        }
+
+        if (batch.capacity < instanceCount) SR_UNLIKELY_ATTRIBUTE {
+            if (batch.ssbo != SR_ID_INVALID) {
+                m_pipeline->FreeSSBO(&batch.ssbo);
+            }
+
+            /// С запасом, чтобы при появлении новых экземпляров не пересоздавать буфер
+            batch.capacity = SR_MAX(16U, instanceCount + instanceCount / 2);
+            batch.ssbo = m_pipeline->AllocateSSBO(batch.capacity * sizeof(SR_MATH_NS::Matrix4x4), SSBOUsage::Write);
+
+            if (batch.ssbo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("RenderQueue::PrepareInstancing() : failed to allocate instance buffer!");
+                batch.capacity = 0;
+                batch.meshes.clear();
+                --m_instanceBatchesCount;
+                visible = PrepareDirect(*pElement);
+                return 1;
+            }
+        }
+
+        batch.indirectCommand = indirect ? AddIndirectCommand() : SR_ID_INVALID;
+        batch.indirect = batch.indirectCommand != SR_ID_INVALID;
+
+        /// Прямой вызов рисует только меши, видимые при построении, смена их видимости вызовет перестроение.
+        /// Уровень у него общий - самый подробный из нужных видимым мешам
+        uint32_t drawCount = 0;
+        uint8_t level = UINT8_MAX;
+
+        for (auto&& pInfo : batch.meshes) {
+            pInfo->instanceBatch = m_instanceBatchesCount - 1;
+            pInfo->indirectCommand = batch.indirectCommand;
+            pInfo->direct = !batch.indirect;
+            pInfo->recordedCulled = pInfo->culled;
+            if (!pInfo->culled) {
+                ++drawCount;
+                level = SR_MIN(level, pInfo->lod);
+            }
+        }
+
+        level = level == UINT8_MAX ? 0 : level;
+
+        for (auto&& pInfo : batch.meshes) {
+            pInfo->recordedLod = level;
+        }
+
+        UploadInstanceBatch(batch);
+
+        if (batch.indirect) {
+            info.pMesh->SetInstancing(batch.ssbo, instanceCount, m_indirectBuffer, batch.indirectCommand);
+        }
+        else {
+            visible = drawCount > 0;
+            info.pMesh->SetInstancing(batch.ssbo, drawCount);
+            info.pMesh->SetLod(level);
+        }
+
+        return instanceCount;
+    }
+
+    bool RenderQueue::PrepareIndirectBuffer() {
+        uint32_t count = 0;
+        for (auto&& [layer, queue] : m_queues) {
+            count += static_cast<uint32_t>(queue.size());
+        }
+
+        if (count <= m_indirectCapacity) SR_LIKELY_ATTRIBUTE {
+            return m_indirectBuffer != SR_ID_INVALID || count == 0;
+        }
+
+        if (m_indirectBuffer != SR_ID_INVALID) {
+            m_pipeline->FreeIndirectBuffer(&m_indirectBuffer);
+        }
+
+        /// С запасом, чтобы при регистрации новых мешей не пересоздавать буфер
+        m_indirectCapacity = SR_MAX(64U, count + count / 2);
+
+        if (m_indirectBuffer = m_pipeline->AllocateIndirectBuffer(m_indirectCapacity); m_indirectBuffer == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            SR_ERROR("RenderQueue::PrepareIndirectBuffer() : failed to allocate indirect buffer!");
+            m_indirectCapacity = 0;
+            return false;
+        }
+
+        m_indirectCommands.reserve(m_indirectCapacity);
+
+        return true;
+    }
+
+    uint32_t RenderQueue::AddIndirectCommand() {
+        if (m_indirectCommands.size() >= m_indirectCapacity) SR_UNLIKELY_ATTRIBUTE {
+            return SR_ID_INVALID;
+        }
+
+        /// Экземпляры нумеруются с нуля, так что drawIndirectFirstInstance не требуется
+        m_indirectCommands.emplace_back();
+
+        return static_cast<uint32_t>(m_indirectCommands.size() - 1);
+    }
+
+    void RenderQueue::UpdateIndirectCommand(const MeshInfo& info) {
+        const MeshLod lod = info.pMesh->GetLod(info.lod);
+        const uint32_t instanceCount = info.culled ? 0 : 1;
+
+        auto&& command = m_indirectCommands[info.indirectCommand];
+
+        if (command.instanceCount != instanceCount || command.firstIndex != lod.firstIndex || command.indexCount != lod.indicesCount) {
+            command.indexCount = lod.indicesCount;
+            command.instanceCount = instanceCount;
+            command.firstIndex = lod.firstIndex;
+            m_indirectDirty = true;
+        }
+    }
+
+    void RenderQueue::UpdateInstances() {
         SR_TRACY_ZONE;
 
-        auto pEnd = queue.data() + queue.size();
-        auto pShader = pElement->shaderUseInfo.pShader;
+        /// Меши могли быть удалены после построения, данные обновятся после перестроения
+        if (!m_instanceBatchesValid) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        for (uint32_t i = 0; i < m_instanceBatchesCount; ++i) {
+            auto&& batch = m_instanceBatches[i];
+
+            if (batch.ssbo != SR_ID_INVALID) SR_LIKELY_ATTRIBUTE {
+                UploadInstanceBatch(batch);
+            }
+        }
+
+        for (auto&& pInfo : m_indirectMeshes) {
+            UpdateIndirectCommand(*pInfo);
+        }
+
+        if (m_indirectDirty) {
+            m_pipeline->UpdateIndirectBuffer(m_indirectBuffer, m_indirectCommands.data(), static_cast<uint32_t>(m_indirectCommands.size()));
+            m_indirectDirty = false;
+        }
+    }
+
+    void RenderQueue::UploadInstanceBatch(InstanceBatch& batch) {
+        m_instanceMatrices.clear();
+
+        /// Экземпляры рисуются по порядку номеров, поэтому прозрачная серия сортируется от дальних
+        /// к ближним прямо в буфере, без перезаписи команд. Ключи обновляет UpdateTransparentOrder
+        if (batch.meshes.size() > 1 && batch.meshes.front()->transparent) {
+            std::sort(batch.meshes.begin(), batch.meshes.end(), [](const MeshInfo* pLeft, const MeshInfo* pRight) {
+                return pLeft->sortKey < pRight->sortKey;
+            });
+        }
+
+        /// Количество экземпляров прямого вызова записано при построении, до перестроения рисуются те же меши
+        for (auto&& pInfo : batch.meshes) {
+            if (!(batch.indirect ? pInfo->culled : pInfo->recordedCulled)) SR_LIKELY_ATTRIBUTE {
+                m_instanceMatrices.emplace_back(pInfo->pMesh->GetMatrix());
+            }
+        }
+
+        const auto visibleCount = static_cast<uint32_t>(m_instanceMatrices.size());
+
+        if (batch.indirect) {
+            /// Серия рисуется самым подробным уровнем из нужных ее видимым мешам
+            uint8_t level = UINT8_MAX;
+            for (auto&& pInfo : batch.meshes) {
+                if (!pInfo->culled) SR_LIKELY_ATTRIBUTE {
+                    level = SR_MIN(level, pInfo->lod);
+                }
+            }
+
+            const MeshLod lod = batch.meshes.front()->pMesh->GetLod(level == UINT8_MAX ? 0 : level);
 
-        ++pElement;
+            auto&& command = m_indirectCommands[batch.indirectCommand];
 
-        while (pElement != pEnd) SR_UNLIKELY_ATTRIBUTE {
-            if (pElement->shaderUseInfo.pShader != pShader) SR_UNLIKELY_ATTRIBUTE {
-                return pElement;
+            if (command.instanceCount != visibleCount || command.firstIndex != lod.firstIndex || command.indexCount != lod.indicesCount) {
+                command.indexCount = lod.indicesCount;
+                command.instanceCount = visibleCount;
+                command.firstIndex = lod.firstIndex;
+                m_indirectDirty = true;
             }
-            ++pElement;
         }
 
-        return pEnd;
+        if (!m_instanceMatrices.empty()) SR_LIKELY_ATTRIBUTE {
+            m_pipeline->UpdateSSBO(batch.ssbo, m_instanceMatrices.data(), m_instanceMatrices.size() * sizeof(SR_MATH_NS::Matrix4x4));
+        }
+    }
+
+    RenderQueue::MeshInfo* RenderQueue::FindNextShader(Queue& queue, MeshInfo* pElement) {
+        return queue.data() + pElement->shaderRunEnd;
     }
 
     RenderQueue::MeshInfo* RenderQueue::FindNextVBO(Queue& queue, MeshInfo* pElement) {
+        return queue.data() + pElement->vboRunEnd;
+    }
+
+    uint64_t RenderQueue::CalculateSortKey(const MeshInfo& info) {
+        const auto priority = static_cast<uint64_t>(std::clamp<int64_t>(info.priority, INT16_MIN, INT16_MAX) - INT16_MIN);
+        const uint64_t shader = GetSortKeyId(m_sortKeyIds.shaders, info.shaderUseInfo.pShader, SR_SORT_KEY_SHADER_BITS, m_needRekey);
+        const uint64_t material = GetSortKeyId(m_sortKeyIds.materials, info.pMaterial, SR_SORT_KEY_MATERIAL_BITS, m_needRekey);
+
+        /// Прозрачные меши рисуются после непрозрачных того же приоритета, порядок между ними задает глубина
+        if (info.transparent) {
+            return
+                (priority << SR_SORT_KEY_PRIORITY_SHIFT) |
+                (1ull << SR_SORT_KEY_TRANSPARENT_SHIFT) |
+                (info.sortKey & SR_SORT_KEY_TRANSPARENT_DEPTH_MASK) |
+                (shader << SR_SORT_KEY_TRANSPARENT_SHADER_SHIFT) |
+                (material << SR_SORT_KEY_TRANSPARENT_MATERIAL_SHIFT);
+        }
+
+        const uint64_t vbo = GetSortKeyId(m_sortKeyIds.vbos, info.vbo, SR_SORT_KEY_VBO_BITS, m_needRekey);
+
+        return
+            (priority << SR_SORT_KEY_PRIORITY_SHIFT) |
+            (shader << SR_SORT_KEY_SHADER_SHIFT) |
+            (material << SR_SORT_KEY_MATERIAL_SHIFT) |
+            (vbo << SR_SORT_KEY_VBO_SHIFT) |
+            (info.sortKey & SR_SORT_KEY_DEPTH_MASK);
+    }
+
+    uint64_t RenderQueue::CalculateDepthKey(const MeshInfo& info, const SR_MATH_NS::FVector3& cameraPosition) const {
+        auto&& matrix = info.pMesh->GetMatrix();
+        auto&& bounds = info.pMesh->GetLocalBounds();
+        const auto localCenter = bounds.valid ? bounds.Center() : SR_MATH_NS::FVector3();
+        const SR_MATH_NS::FVector4 center = matrix * SR_MATH_NS::FVector4(localCenter.x, localCenter.y, localCenter.z, 1.f);
+
+        const float_t dx = center.x - cameraPosition.x;
+        const float_t dy = center.y - cameraPosition.y;
+        const float_t dz = center.z - cameraPosition.z;
+
+        float_t distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        if (!info.transparent) {
+            /// Логарифмическая шкала: вблизи корзины мельче, 16 корзин на каждое удвоение расстояния
+            const float_t bucket = std::log2(1.f + distance) * 16.f;
+            const uint64_t depth = static_cast<uint64_t>(SR_MIN(bucket, static_cast<float_t>(SR_SORT_KEY_DEPTH_MASK)));
+            return (info.sortKey & ~SR_SORT_KEY_DEPTH_MASK) | depth;
+        }
+
+        if (info.pMaterial) {
+            distance += info.pMaterial->GetSortBias();
+        }
+
+        /// Дальние меши должны идти первыми, поэтому ключ инвертирован
+        const float_t bucket = std::log2(1.f + SR_MAX(distance, 0.f)) * SR_TRANSPARENT_DEPTH_SCALE;
+        const uint64_t depth = SR_SORT_KEY_TRANSPARENT_DEPTH_MAX - static_cast<uint64_t>(SR_MIN(bucket, static_cast<float_t>(SR_SORT_KEY_TRANSPARENT_DEPTH_MAX)));
+
+        return (info.sortKey & ~SR_SORT_KEY_TRANSPARENT_DEPTH_MASK) | (depth << SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT);
+    }
+
+    void RenderQueue::UpdateDepthKeys(Queue& queue) {
+        SR_TRACY_ZONE;
+
+        auto&& pCamera = m_meshDrawerPass->GetCamera();
+        if (!pCamera || queue.entries.size() < 2) {
+            return;
+        }
+
+        const SR_MATH_NS::FVector3 cameraPosition = pCamera->GetPosition();
+        bool changed = false;
+
+        for (auto&& info : queue.entries) {
+            const uint64_t sortKey = CalculateDepthKey(info, cameraPosition);
+            changed |= sortKey != info.sortKey;
+            info.sortKey = sortKey;
+        }
+
+        if (changed) {
+            SortQueue(queue);
+        }
+    }
+
+    void RenderQueue::UpdateTransparentOrder() {
+        SR_TRACY_ZONE;
+
+        auto&& pCamera = m_meshDrawerPass->GetCamera();
+        if (!pCamera || !m_instanceBatchesValid) {
+            return;
+        }
+
+        const SR_MATH_NS::FVector3 cameraPosition = pCamera->GetPosition();
+
+        for (auto&& [layer, queue] : m_queues) {
+            if (queue.transparentCount < 2) SR_LIKELY_ATTRIBUTE {
+                continue;
+            }
+
+            auto&& entries = queue.entries;
+
+            for (auto&& info : entries) {
+                if (info.transparent) {
+                    info.sortKey = CalculateDepthKey(info, cameraPosition);
+                }
+            }
+
+            /// Непрозрачные меши и серии экземпляров ссылаются на элементы очереди, поэтому здесь очередь не переставляется.
+            /// Внутри серии порядок меняется в буфере экземпляров каждый кадр. Порядок разных вызовов записан в
+            /// команды рендера, сцена перестраивается только когда они действительно поменялись местами
+            for (size_t i = 1; i < entries.size(); ++i) {
+                auto&& previous = entries[i - 1];
+                auto&& current = entries[i];
+
+                if (!previous.transparent || !current.transparent || previous.priority != current.priority) {
+                    continue;
+                }
+
+                if (previous.instanceBatch != SR_ID_INVALID && previous.instanceBatch == current.instanceBatch) {
+                    continue;
+                }
+
+                const uint64_t previousDepth = (previous.sortKey & SR_SORT_KEY_TRANSPARENT_DEPTH_MASK) >> SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT;
+                const uint64_t currentDepth = (current.sortKey & SR_SORT_KEY_TRANSPARENT_DEPTH_MASK) >> SR_SORT_KEY_TRANSPARENT_DEPTH_SHIFT;
+
+                if (previousDepth > currentDepth + SR_TRANSPARENT_ORDER_HYSTERESIS) SR_UNLIKELY_ATTRIBUTE {
+                    m_renderScene->SetDirty();
+                    return;
+                }
+            }
+        }
+    }
+
+    void RenderQueue::FlushQueues() {
+        SR_TRACY_ZONE;
+
+        if (m_needRekey) SR_UNLIKELY_ATTRIBUTE {
+            m_needRekey = false;
+            m_sortKeyIds.Clear();
+
+            for (auto&& [layer, queue] : m_queues) {
+                for (auto&& info : queue.entries) {
+                    if (!info.removed) {
+                        info.sortKey = CalculateSortKey(info);
+                    }
+                }
+                queue.dirty = true;
+            }
+
+            SRAssert2(!m_needRekey, "RenderQueue::FlushQueues() : too many unique shaders, materials or VBOs!");
+        }
+
+        for (auto&& [layer, queue] : m_queues) {
+            FlushQueue(queue);
+        }
+    }
+
+    void RenderQueue::FlushQueue(Queue& queue) {
+        if (!queue.dirty) SR_LIKELY_ATTRIBUTE {
+            return;
+        }
+
+        queue.dirty = false;
+
+        /// Элементы будут переставлены, серии экземпляров ссылаются на них и соберутся при следующем построении
+        m_instanceBatchesValid = false;
+
+        queue.entries.erase(std::remove_if(queue.entries.begin(), queue.entries.end(), [](const MeshInfo& info) {
+            return info.removed;
+        }), queue.entries.end());
+
+        SortQueue(queue);
+    }
+
+    void RenderQueue::SortQueue(Queue& queue) {
         SR_TRACY_ZONE;
 
-        auto pEnd = queue.data() + queue.size();
-        auto vbo = pElement->vbo;
+        auto&& entries = queue.entries;
+        const auto count = static_cast<uint32_t>(entries.size());
 
-        while (pElement != pEnd) {
-            if (pElement->vbo != vbo) {
-                return pElement;
+        bool sorted = true;
+        for (uint32_t i = 1; i < count && sorted; ++i) {
+            sorted = entries[i - 1].sortKey <= entries[i].sortKey;
+        }
+
+        if (!sorted) {
+            m_sortKeys.resize(count);
+            m_sortTmpKeys.resize(count);
+            m_sortIndices.resize(count);
+            m_sortTmpIndices.resize(count);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                m_sortKeys[i] = entries[i].sortKey;
+                m_sortIndices[i] = i;
             }
-            ++pElement;
+
+            uint64_t* pKeys = m_sortKeys.data();
+            uint64_t* pTmpKeys = m_sortTmpKeys.data();
+            uint32_t* pIndices = m_sortIndices.data();
+            uint32_t* pTmpIndices = m_sortTmpIndices.data();
+
+            /// LSD по 8 бит, сортировка устойчивая, поэтому равные ключи сохраняют порядок регистрации
+            for (uint32_t shift = 0; shift < 64; shift += 8) {
+                uint32_t offsets[256] = { };
+
+                for (uint32_t i = 0; i < count; ++i) {
+                    ++offsets[(pKeys[i] >> shift) & 0xFFu];
+                }
+
+                /// Все ключи совпадают в этом разряде, проход ничего не изменит
+                if (offsets[(pKeys[0] >> shift) & 0xFFu] == count) {
+                    continue;
+                }
+
+                uint32_t sum = 0;
+                for (auto&& offset : offsets) {
+                    const uint32_t digitCount = offset;
+                    offset = sum;
+                    sum += digitCount;
+                }
+
+                for (uint32_t i = 0; i < count; ++i) {
+                    const uint32_t index = offsets[(pKeys[i] >> shift) & 0xFFu]++;
+                    pTmpKeys[index] = pKeys[i];
+                    pTmpIndices[index] = pIndices[i];
+                }
+
+                std::swap(pKeys, pTmpKeys);
+                std::swap(pIndices, pTmpIndices);
+            }
+
+            /// Сами элементы переставляются один раз, а не на каждом проходе
+            m_sortEntries.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                m_sortEntries[i] = entries[pIndices[i]];
+            }
+            entries.swap(m_sortEntries);
         }
 
-        return pEnd;
+        queue.indices.clear();
+        queue.indices.reserve(count);
+        queue.transparentCount = 0;
+
+        /// Границы серий считаются с конца, поиск следующего шейдера и VBO при построении становится O(1)
+        for (uint32_t i = count; i-- > 0; ) {
+            auto&& info = entries[i];
+            const bool hasNext = i + 1 < count;
 
-        //const ShaderVBOMismatchPredicate predicate(pElement->shaderUseInfo.pShader, pElement->vbo);
-        //return queue.UpperBound(pElement, queue.data() + queue.size(), *pElement, predicate);
+            info.shaderRunEnd = hasNext && entries[i + 1].shaderUseInfo.pShader == info.shaderUseInfo.pShader ? entries[i + 1].shaderRunEnd : i + 1;
+            info.vboRunEnd = hasNext && entries[i + 1].vbo == info.vbo ? entries[i + 1].vboRunEnd : i + 1;
+
+            queue.indices.emplace(info.pMesh, i);
+            queue.transparentCount += info.transparent ? 1 : 0;
+        }
     }
 
     bool RenderQueue::UseShader(ShaderUseInfo info) {
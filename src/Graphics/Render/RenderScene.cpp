@@ -9,18 +9,21 @@
 #include <Graphics/Render/RenderContext.h>
 #include <Graphics/Render/RenderStrategy.h>
 #include <Graphics/Memory/CameraManager.h>
+#include <Graphics/Memory/DescriptorManager.h>
 #include <Graphics/Types/Camera.h>
 #include <Graphics/Types/Geometry/DebugLine.h>
 #include <Graphics/Render/RenderTechnique.h>
 #include <Graphics/Material/FileMaterial.h>
 #include <Graphics/Render/DebugRenderer.h>
 #include <Graphics/Lighting/LightSystem.h>
+#include <Graphics/Animations/SkinningBuffer.h>
 #include <Graphics/Window/Window.h>
 
 namespace SR_GRAPH_NS {
     RenderScene::RenderScene(const ScenePtr& scene, RenderContext* pContext)
         : SR_HTYPES_NS::SafePtr<RenderScene>(this)
         , m_lightSystem(new LightSystem(GetThis()))
+        , m_skinningBuffer(new SR_ANIMATIONS_NS::SkinningBuffer())
         , m_scene(scene)
         , m_debugRender(new DebugRenderer(this))
         , m_context(pContext)
@@ -30,14 +33,22 @@ namespace SR_GRAPH_NS {
     }
 
     RenderScene::~RenderScene() {
-        SRAssert(!m_lightSystem && !m_debugRender && !m_technique);
+        SRAssert(!m_lightSystem && !m_skinningBuffer && !m_debugRender && !m_technique);
         m_renderStrategy.AutoFree();
         SRAssert(IsEmpty());
     }
 
     void RenderScene::DeInit() {
+        if (m_lightSystem) {
+            m_lightSystem->FreeVideoMemory();
+        }
         SR_SAFE_DELETE_PTR(m_lightSystem);
 
+        if (m_skinningBuffer) {
+            m_skinningBuffer->FreeVideoMemory(GetPipeline().Get());
+        }
+        SR_SAFE_DELETE_PTR(m_skinningBuffer);
+
         if (m_debugRender) {
             m_debugRender->DeInit();
             delete m_debugRender;
@@ -151,6 +162,7 @@ namespace SR_GRAPH_NS {
         GetPipeline()->ClearFrameBuffersQueue();
 
         m_hasDrawData = false;
+        m_textureTableVersion = DescriptorManager::Instance().GetTextureTableVersion();
 
         SR_RENDER_TECHNIQUES_RETURN_CALL(Render)
 
@@ -248,6 +260,20 @@ namespace SR_GRAPH_NS {
             SortCameras();
         }
 
+        /// Таблица текстур копируется в наборы дескрипторов, записанные в командные буферы.
+        /// Перезаписать их можно только при построении, поэтому изменение таблицы его запрашивает
+        if (auto&& descriptorManager = DescriptorManager::Instance(); descriptorManager.GetTextureTableSetsCount() > 0) {
+            if (descriptorManager.GetTextureTableVersion() != m_textureTableVersion) {
+                SetDirty();
+            }
+        }
+
+        if (m_lightSystem) {
+            m_lightSystem->Update(GetMainCamera().Get());
+        }
+
+        UploadSkinningBuffer();
+
         if (m_renderStrategy) {
             m_renderStrategy->Prepare();
         }
@@ -255,6 +281,21 @@ namespace SR_GRAPH_NS {
         SR_RENDER_TECHNIQUES_CALL(Prepare)
     }
 
+    void RenderScene::UploadSkinningBuffer() {
+        /// Матрицы костей всех скелетных мешей уходят в видеопамять одним вызовом
+        if (!m_skinningBuffer || !m_skinningBuffer->Upload(GetPipeline().Get())) {
+            return;
+        }
+
+        m_renderStrategy->ForEachMesh([](SR_GTYPES_NS::Mesh* pMesh) {
+            if (pMesh->GetMeshType() == MeshType::Skinned) {
+                pMesh->MarkMaterialDirty();
+            }
+        });
+
+        SetDirty();
+    }
+
     void RenderScene::Register(RenderScene::WidgetManagerPtr pWidgetManager) {
         if (!pWidgetManager) {
             return;
@@ -293,6 +293,7 @@ namespace SR_GRAPH_NS {
         m_isRendered = true;
 
         for (auto&& pMesh : m_meshes) {
+            pMesh->SetInstancing(SR_ID_INVALID, 1);
             pMesh->Draw();
         }
 
@@ -329,6 +330,7 @@ namespace SR_GRAPH_NS {
         }
 
         for (auto&& pMesh : m_meshes) {
+            pMesh->SetInstancing(SR_ID_INVALID, 1);
             pMesh->Draw();
         }
 
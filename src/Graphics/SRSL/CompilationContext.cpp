@@ -0,0 +1,28 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/SRSL/CompilationContext.h>
+
+namespace SR_SRSL_NS {
+    static thread_local SRSLCompilationContext* g_currentSRSLContext = nullptr;
+
+    SRSLCompilationContext::Scope::Scope(SRSLCompilationContext& context)
+        : m_previous(g_currentSRSLContext)
+    {
+        g_currentSRSLContext = &context;
+    }
+
+    SRSLCompilationContext::Scope::~Scope() {
+        g_currentSRSLContext = m_previous;
+    }
+
+    SRSLCompilationContext& SRSLCompilationContext::Current() {
+        if (g_currentSRSLContext) SR_LIKELY_ATTRIBUTE {
+            return *g_currentSRSLContext;
+        }
+
+        static thread_local SRSLCompilationContext defaultContext;
+        return defaultContext;
+    }
+}
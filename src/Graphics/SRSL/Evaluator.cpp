@@ -3,16 +3,13 @@
 //
 
 #include <Graphics/SRSL/Evaluator.h>
-#include <Graphics/SRSL/Lexer.h>
-#include <Graphics/SRSL/LexicalAnalyzer.h>
+#include <Graphics/SRSL/CompilationContext.h>
 #include <Graphics/SRSL/MathExpression.h>
 
 namespace SR_SRSL_NS {
     double_t SRSLEvaluator::Evaluate(const std::string& code) {
-        SR_GLOBAL_LOCK
-
-        auto&& lexems = SRSLLexer::Instance().ParseString(code, 0);
-        auto&& [pTree, result] = SRSLLexicalAnalyzer::Instance().Analyze(std::move(lexems));
+        auto&& lexems = SRSLCompilationContext::Current().GetLexer().ParseString(code, 0);
+        auto&& [pTree, result] = SRSLCompilationContext::Current().GetLexicalAnalyzer().Analyze(std::move(lexems));
 
         if (result.HasErrors()) {
             SR_ERROR("SSRSLEvaluator::Evaluate() : failed to parse expression!");
@@ -34,8 +31,6 @@ namespace SR_SRSL_NS {
     }
 
     double_t SRSLEvaluator::Evaluate(const SRSLExpr* pExpr) {
-        SR_GLOBAL_LOCK
-
         if (pExpr->args.empty()) {
             if (SR_MATH_NS::IsNumber(pExpr->token)) {
                 return SR_UTILS_NS::LexicalCast<double_t>(pExpr->token);
@@ -7,8 +7,6 @@
 
 namespace SR_SRSL_NS {
     ISRSLCodeGenerator::SRSLCodeGenRes GLSLCodeGenerator::GenerateStages(const SRSLShader* pShader) {
-        SR_GLOBAL_LOCK
-
         Clear();
 
         m_shader = pShader;
@@ -519,6 +517,14 @@ namespace SR_SRSL_NS {
             return code;
         }
 
+        /// индекс bindless текстуры используется там же, где и сам семплер
+        auto&& isFieldUsed = [&pFunction](const std::string& fieldName) -> bool {
+            if (fieldName.rfind(SR_SRSL_TEXTURE_INDEX_PREFIX, 0) == 0) {
+                return pFunction->IsVariableUsed(fieldName.substr(SR_SRSL_TEXTURE_INDEX_PREFIX.size()));
+            }
+            return pFunction->IsVariableUsed(fieldName);
+        };
+
         /// ------------------------------------------------------------------------------------------------------------
 
         std::string uniformsCode;
@@ -528,7 +534,7 @@ namespace SR_SRSL_NS {
             bool hasUsage = false;
 
             for (auto&& field : uniformBlock.fields) {
-                hasUsage |= pFunction->IsVariableUsed(field.name);
+                hasUsage |= isFieldUsed(field.name.ToStringRef());
 
                 auto&& typeName = ReplaceToken(SRSLTypeInfo::Instance().GetTypeName(field.type));
                 auto&& dimension = SRSLTypeInfo::Instance().GetDimension(field.type, nullptr);
@@ -553,10 +559,17 @@ namespace SR_SRSL_NS {
         for (auto&& [name, uniformBlock] : m_shader->GetSSBOBlocks()) {
             std::string blockCode = SR_SPRINTF("layout (set = 0, binding = %d) buffer StorageBuffer_%s {\n", uniformBlock.binding, name.c_str());
             bool hasUsage = false;
+            std::string defineCode;
 
             for (auto&& field : uniformBlock.fields) {
                 hasUsage |= pFunction->IsVariableUsed(field.name);
 
+                /// блок экземпляров подставляется вместо юниформы MODEL_MATRIX
+                if (field.name.ToString() == SR_SRSL_INSTANCE_MATRICES && pFunction->IsVariableUsed("MODEL_MATRIX")) {
+                    hasUsage = true;
+                    defineCode += SR_FORMAT("#define MODEL_MATRIX {}[gl_InstanceIndex]\n", field.name.c_str());
+                }
+
                 auto&& typeName = ReplaceToken(SRSLTypeInfo::Instance().GetTypeName(field.type));
                 auto&& dimension = SRSLTypeInfo::Instance().GetDimension(field.type, nullptr);
 
@@ -577,16 +590,35 @@ namespace SR_SRSL_NS {
             blockCode += "};\n";
 
             if (hasUsage) {
-                uniformsCode += blockCode;
+                uniformsCode += blockCode + defineCode;
             }
         }
 
         /// ------------------------------------------------------------------------------------------------------------
 
         std::string samplersCode;
+        std::string bindlessCode;
 
         for (auto&& [name, sampler] : m_shader->GetSamplers()) {
-            if (pFunction->IsVariableUsed(name)) {
+            if (sampler.bindless && pFunction->IsVariableUsed(name)) {
+                bindlessCode += SR_FORMAT("#define {} {}[{}{}] // (bindless sampler) {}\n",
+                        name.c_str(),
+                        SR_SRSL_TEXTURE_TABLE.c_str(),
+                        SR_SRSL_TEXTURE_INDEX_PREFIX.c_str(),
+                        name.c_str(),
+                        sampler.isPublic ? "public" : "private"
+                );
+            }
+        }
+
+        for (auto&& [name, sampler] : m_shader->GetSamplers()) {
+            if (sampler.bindless) {
+                continue;
+            }
+
+            const bool isTextureTable = name.ToStringRef() == SR_SRSL_TEXTURE_TABLE;
+
+            if (isTextureTable ? !bindlessCode.empty() : pFunction->IsVariableUsed(name)) {
                 std::string layout;
 
                 if (sampler.attachment >= 0) {
@@ -596,6 +628,16 @@ namespace SR_SRSL_NS {
                     layout = SR_FORMAT("(binding = {})", sampler.binding);
                 }
 
+                if (isTextureTable) {
+                    samplersCode += SR_FORMAT("layout {} uniform {} {}[{}]; // (texture table)\n",
+                            layout.c_str(),
+                            sampler.type.c_str(),
+                            name.c_str(),
+                            sampler.count
+                    );
+                    continue;
+                }
+
                 samplersCode += SR_FORMAT("layout {} uniform {} {}; // (sampler) {}\n",
                         layout.c_str(),
                         sampler.type.c_str(),
@@ -605,6 +647,9 @@ namespace SR_SRSL_NS {
             }
         }
 
+        /// имя bindless семплера раскрывается в обращение к таблице по индексу из блока юниформ
+        samplersCode += bindlessCode;
+
         /// ------------------------------------------------------------------------------------------------------------
 
         std::string pushConstantsCode;
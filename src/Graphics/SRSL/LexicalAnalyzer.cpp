@@ -3,11 +3,14 @@
 //
 
 #include <Graphics/SRSL/LexicalAnalyzer.h>
+#include <Graphics/SRSL/CompilationContext.h>
 
 namespace SR_SRSL_NS {
-    std::pair<SRSLAnalyzedTree::Ptr, SRSLResult> SRSLLexicalAnalyzer::Analyze(std::vector<Lexem>&& lexems) {
-        SR_GLOBAL_LOCK
+    SRSLLexicalAnalyzer::~SRSLLexicalAnalyzer() {
+        Clear();
+    }
 
+    std::pair<SRSLAnalyzedTree::Ptr, SRSLResult> SRSLLexicalAnalyzer::Analyze(std::vector<Lexem>&& lexems) {
         Clear();
 
         m_lexems = SR_UTILS_NS::Exchange(lexems, { });
@@ -410,7 +413,7 @@ namespace SR_SRSL_NS {
             return;
         }
 
-        auto&& [pExpr, result] = SR_SRSL_NS::SRSLMathExpression::Instance().Analyze(std::move(exprLexems));
+        auto&& [pExpr, result] = SRSLCompilationContext::Current().GetMathExpression().Analyze(std::move(exprLexems));
         m_expr = pExpr;
         m_result = std::move(result);
     }
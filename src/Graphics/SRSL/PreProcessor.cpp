@@ -3,6 +3,8 @@
 //
 
 #include <Graphics/SRSL/PreProcessor.h>
+#include <Graphics/SRSL/CompilationContext.h>
+#include <Graphics/SRSL/ShaderVariables.h>
 
 namespace SR_SRSL_NS {
     SRSLPreProcessor::OutResult SRSLPreProcessor::Process(std::vector<Lexem>&& lexems, Includes& includes) {
@@ -72,6 +74,14 @@ namespace SR_SRSL_NS {
                     m_state = PPState::Idle;
                     m_lexems.erase(m_lexems.begin() + m_currentLexem);
 
+                    if (auto&& pIt = SR_SRSL_BUILTIN_INCLUDES.find(m_include); pIt != SR_SRSL_BUILTIN_INCLUDES.end()) {
+                        m_includes.emplace_back(SR_EXCHANGE(m_include, {}));
+
+                        auto&& lexems = SRSLCompilationContext::Current().GetLexer().ParseString(pIt->second, m_includes.size() - 1);
+                        m_lexems.insert(m_lexems.begin() + m_currentLexem, lexems.begin(), lexems.end());
+                        break;
+                    }
+
                     auto&& includePath = SR_UTILS_NS::ResourceManager::Instance().GetResPath().Concat(m_include);
                     if (!includePath.Exists(SR_UTILS_NS::Path::Type::File)) {
                         m_result.AddError(SRSLMessage(SRSLReturnCode::IncludeNotExists, GetCurrentLexem()))
@@ -81,7 +91,7 @@ namespace SR_SRSL_NS {
 
                     m_includes.emplace_back(SR_EXCHANGE(m_include, {}));
 
-                    auto&& lexems = SR_SRSL_NS::SRSLLexer::Instance().Parse(includePath, m_include.size());
+                    auto&& lexems = SRSLCompilationContext::Current().GetLexer().Parse(includePath, m_include.size());
                     if (lexems.empty()) {
                         SR_ERROR("SRSLPreProcessor::ProcessMain() : failed to parse lexems!\n\tPath: " + includePath.ToString());
                         m_result.AddError(SRSLMessage(SRSLReturnCode::IncludeError, GetCurrentLexem())).SetDescription(includePath);
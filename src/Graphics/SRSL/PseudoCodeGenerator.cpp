@@ -7,8 +7,6 @@
 
 namespace SR_SRSL_NS {
     ISRSLCodeGenerator::SRSLCodeGenRes SRSLPseudoCodeGenerator::GenerateStages(const SRSLShader* pShader) {
-        SR_GLOBAL_LOCK
-
         Clear();
 
         ISRSLCodeGenerator::SRSLCodeGenRes codeGenRes;
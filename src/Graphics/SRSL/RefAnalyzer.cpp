@@ -107,7 +107,6 @@ namespace SR_SRSL_NS {
     /// ----------------------------------------------------------------------------------------------------------------
 
     SRSLUseStack::Ptr SRSLRefAnalyzer::Analyze(const SRSLAnalyzedTree::Ptr& pAnalyzedTree) {
-        SR_GLOBAL_LOCK
         m_analyzedTree = pAnalyzedTree;
         std::list<std::string> stack;
         return AnalyzeTree(stack, pAnalyzedTree->pLexicalTree);
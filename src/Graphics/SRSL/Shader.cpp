@@ -3,17 +3,172 @@
 //
 
 #include <Graphics/SRSL/Shader.h>
-#include <Graphics/SRSL/Lexer.h>
-#include <Graphics/SRSL/PseudoCodeGenerator.h>
-#include <Graphics/SRSL/GLSLCodeGenerator.h>
-#include <Graphics/SRSL/AssignExpander.h>
-#include <Graphics/SRSL/PreProcessor.h>
+#include <Graphics/SRSL/CompilationContext.h>
 #include <Graphics/SRSL/TypeInfo.h>
 #include <Graphics/SRSL/ShaderVariables.h>
 
 #include <Utils/Platform/Platform.h>
+#include <Utils/Common/Features.h>
+
+#include <fstream>
 
 namespace SR_SRSL_NS {
+    /// Двоичный буфер артефакта компиляции
+    class SRSLArtifactWriter {
+    public:
+        template<typename T> void Write(const T& value) {
+            auto&& pBytes = reinterpret_cast<const uint8_t*>(&value);
+            m_data.insert(m_data.end(), pBytes, pBytes + sizeof(T));
+        }
+
+        void WriteString(const std::string& value) {
+            Write<uint32_t>(static_cast<uint32_t>(value.size()));
+            m_data.insert(m_data.end(), value.begin(), value.end());
+        }
+
+        SR_NODISCARD const std::vector<uint8_t>& GetData() const noexcept { return m_data; }
+
+    private:
+        std::vector<uint8_t> m_data;
+
+    };
+
+    /// Чтение артефакта с проверкой границ. Обрезанный или поврежденный файл переводит читателя в состояние ошибки,
+    /// после чего все чтения возвращают пустые значения, не выходя за пределы буфера и не выделяя лишнюю память
+    class SRSLArtifactReader {
+    public:
+        SRSLArtifactReader(const uint8_t* pData, size_t size)
+            : m_data(pData)
+            , m_size(size)
+        { }
+
+        template<typename T> T Read() {
+            T value = T();
+
+            if (!IsAvailable(sizeof(T))) {
+                return value;
+            }
+
+            memcpy(&value, m_data + m_position, sizeof(T));
+            m_position += sizeof(T);
+
+            return value;
+        }
+
+        std::string ReadString() {
+            const auto size = Read<uint32_t>();
+
+            if (!IsAvailable(size)) {
+                return std::string();
+            }
+
+            std::string value(reinterpret_cast<const char*>(m_data + m_position), size);
+            m_position += size;
+
+            return value;
+        }
+
+        /// Число элементов, каждый из которых занимает в артефакте не меньше minElementSize байт
+        uint32_t ReadCount(uint32_t minElementSize) {
+            const auto count = Read<uint32_t>();
+
+            if (!IsAvailable(static_cast<uint64_t>(count) * minElementSize)) {
+                return 0;
+            }
+
+            return count;
+        }
+
+        SR_NODISCARD bool IsFailed() const noexcept { return m_failed; }
+        SR_NODISCARD bool IsEnd() const noexcept { return m_position == m_size; }
+
+    private:
+        bool IsAvailable(uint64_t size) {
+            if (m_failed || size > m_size - m_position) {
+                m_failed = true;
+                return false;
+            }
+
+            return true;
+        }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_position = 0;
+        bool m_failed = false;
+
+    };
+
+    static uint64_t GetArtifactPayloadHash(const uint8_t* pData, size_t size) {
+        return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char*>(pData), size));
+    }
+
+    static void WriteUniformBlock(SRSLArtifactWriter& writer, const SRSLUniformBlock& block) {
+        writer.Write<uint64_t>(block.size);
+        writer.Write<uint64_t>(block.binding);
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(block.fields.size()));
+        for (auto&& field : block.fields) {
+            writer.WriteString(field.type.ToStringRef());
+            writer.WriteString(field.name.ToStringRef());
+            writer.Write<uint64_t>(field.size);
+            writer.Write<uint64_t>(field.alignedSize);
+            writer.Write<bool>(field.isPublic);
+
+            /// по умолчанию SRSL умеет вычислять только векторы
+            if (field.defaultValue.has_value() && std::holds_alternative<SR_MATH_NS::FVector2>(field.defaultValue.value())) {
+                writer.Write<uint8_t>(2);
+                writer.Write<SR_MATH_NS::FVector2>(std::get<SR_MATH_NS::FVector2>(field.defaultValue.value()));
+            }
+            else if (field.defaultValue.has_value() && std::holds_alternative<SR_MATH_NS::FVector3>(field.defaultValue.value())) {
+                writer.Write<uint8_t>(3);
+                writer.Write<SR_MATH_NS::FVector3>(std::get<SR_MATH_NS::FVector3>(field.defaultValue.value()));
+            }
+            else if (field.defaultValue.has_value() && std::holds_alternative<SR_MATH_NS::FVector4>(field.defaultValue.value())) {
+                writer.Write<uint8_t>(4);
+                writer.Write<SR_MATH_NS::FVector4>(std::get<SR_MATH_NS::FVector4>(field.defaultValue.value()));
+            }
+            else {
+                writer.Write<uint8_t>(0);
+            }
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(block.stages.size()));
+        for (auto&& stage : block.stages) {
+            writer.Write<uint8_t>(static_cast<uint8_t>(stage));
+        }
+    }
+
+    static void ReadUniformBlock(SRSLArtifactReader& reader, SRSLUniformBlock& block) {
+        block.size = reader.Read<uint64_t>();
+        block.binding = reader.Read<uint64_t>();
+
+        /// два размера строк, два размера полей, флаг и тип значения по умолчанию
+        block.fields.resize(reader.ReadCount(2 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + 2));
+
+        for (auto&& field : block.fields) {
+            field.type = reader.ReadString();
+            field.name = reader.ReadString();
+            field.size = reader.Read<uint64_t>();
+            field.alignedSize = reader.Read<uint64_t>();
+            field.isPublic = reader.Read<bool>();
+
+            switch (reader.Read<uint8_t>()) {
+                case 2: field.defaultValue = reader.Read<SR_MATH_NS::FVector2>(); break;
+                case 3: field.defaultValue = reader.Read<SR_MATH_NS::FVector3>(); break;
+                case 4: field.defaultValue = reader.Read<SR_MATH_NS::FVector4>(); break;
+                default:
+                    break;
+            }
+        }
+
+        const auto stagesCount = reader.ReadCount(sizeof(uint8_t));
+        for (uint32_t i = 0; i < stagesCount; ++i) {
+            block.stages.insert(static_cast<ShaderStage>(reader.Read<uint8_t>()));
+        }
+    }
+
     void SRSLUniformBlock::Align(const SRSLAnalyzedTree::Ptr& pAnalyzedTree) {
         for (auto&& field : fields) {
             field.size = SRSLTypeInfo::Instance().GetTypeSize(field.type, pAnalyzedTree);
@@ -39,36 +194,78 @@ namespace SR_SRSL_NS {
             return nullptr;
         }
 
+        const bool cacheEnabled = SR_UTILS_NS::Features::Instance().Enabled("ShaderCaching", true);
+
+        if (cacheEnabled) {
+            if (auto&& pCachedShader = LoadArtifact(path)) {
+                return pCachedShader;
+            }
+        }
+
+        /// У каждой компиляции свое состояние стадий, поэтому шейдеры можно загружать из разных потоков
+        SRSLCompilationContext context;
+        SRSLCompilationContext::Scope contextScope(context);
+
+        auto&& pShader = Compile(path);
+        if (!pShader) {
+            return nullptr;
+        }
+
+        if (!pShader->SaveCache()) {
+            SR_WARN("SRSLShader::Load() : failed to save shader cache shader!\n\tPath: " + path.ToString());
+        }
+
+        if (cacheEnabled) {
+            auto&& [result, stages] = pShader->GenerateStages(ShaderLanguage::GLSL);
+            if (result.HasErrors()) {
+                SR_ERROR("SRSLShader::Load() : failed to generate shader code!" + result.ToString(pShader->m_includes));
+                return nullptr;
+            }
+
+            pShader->m_generatedStages[ShaderLanguage::GLSL] = std::move(stages);
+
+            if (!pShader->SaveArtifact()) {
+                SR_WARN("SRSLShader::Load() : failed to save shader artifact!\n\tPath: " + path.ToString());
+            }
+        }
+
+        return pShader;
+    }
+
+    SRSLShader::Ptr SRSLShader::Compile(const SR_UTILS_NS::Path& path) {
+        auto&& context = SRSLCompilationContext::Current();
+        auto&& absPath = SR_UTILS_NS::ResourceManager::Instance().GetResPath().Concat(path);
+
         auto&& pShader = SRSLShader::Ptr(new SRSLShader(path));
 
-        auto&& lexems = SR_SRSL_NS::SRSLLexer::Instance().Parse(absPath, 0);
+        auto&& lexems = context.GetLexer().Parse(absPath, 0);
         if (lexems.empty()) {
-            SR_ERROR("SRSLShader::Load() : failed to parse lexems!\n\tPath: " + path.ToString());
+            SR_ERROR("SRSLShader::Compile() : failed to parse lexems!\n\tPath: " + path.ToString());
             return nullptr;
         }
 
         SRSLPreProcessor::Includes includes = { path.ToStringRef() };
 
-        auto&& [preProcessedLexems, preProcessResult] = SRSLPreProcessor::Instance().Process(std::move(lexems), includes);
+        auto&& [preProcessedLexems, preProcessResult] = context.GetPreProcessor().Process(std::move(lexems), includes);
         if (preProcessResult.HasErrors()) {
-            SR_ERROR("SRSLShader::Load() : failed to pre-process shader!" + preProcessResult.ToString(includes));
+            SR_ERROR("SRSLShader::Compile() : failed to pre-process shader!" + preProcessResult.ToString(includes));
             return nullptr;
         }
 
         lexems = std::move(preProcessedLexems);
 
-        auto&& [expandedLexems, expandResult] = SR_SRSL_NS::SRSLAssignExpander::Instance().Expand(std::move(lexems));
+        auto&& [expandedLexems, expandResult] = context.GetAssignExpander().Expand(std::move(lexems));
         if (expandResult.HasErrors()) {
-            SR_ERROR("SRSLShader::Load() : failed to expand assign shader!" + expandResult.ToString(includes));
+            SR_ERROR("SRSLShader::Compile() : failed to expand assign shader!" + expandResult.ToString(includes));
             return nullptr;
         }
 
         lexems = std::move(expandedLexems);
 
-        auto&& [pAnalyzedTree, analyzeResult] = SR_SRSL_NS::SRSLLexicalAnalyzer::Instance().Analyze(std::move(lexems));
+        auto&& [pAnalyzedTree, analyzeResult] = context.GetLexicalAnalyzer().Analyze(std::move(lexems));
 
         if (!pAnalyzedTree || analyzeResult.HasErrors()) {
-            SR_ERROR("SRSLShader::Load() : failed to analyze shader!" + analyzeResult.ToString(includes));
+            SR_ERROR("SRSLShader::Compile() : failed to analyze shader!" + analyzeResult.ToString(includes));
             return nullptr;
         }
 
@@ -76,17 +273,290 @@ namespace SR_SRSL_NS {
         pShader->m_includes = std::move(includes);
 
         if (!pShader->Prepare()) {
-            SR_ERROR("SRSLShader::Load() : failed to prepare shader!\n\tPath: " + path.ToString());
+            SR_ERROR("SRSLShader::Compile() : failed to prepare shader!\n\tPath: " + path.ToString());
             return nullptr;
         }
 
-        if (!pShader->SaveCache()) {
-            SR_WARN("SRSLShader::Load() : failed to save shader cache shader!\n\tPath: " + path.ToString());
+        return pShader;
+    }
+
+    bool SRSLShader::RestoreAnalyzedState() const {
+        if (m_analyzedTree) SR_LIKELY_ATTRIBUTE {
+            return true;
+        }
+
+        SR_TRACY_ZONE;
+
+        /// Отдельный контекст, чтобы не затереть состояние стадий вызывающей компиляции
+        SRSLCompilationContext context;
+        SRSLCompilationContext::Scope contextScope(context);
+
+        auto&& pCompiled = Compile(m_path);
+        if (!pCompiled) {
+            SR_ERROR("SRSLShader::RestoreAnalyzedState() : failed to compile shader!\n\tPath: " + m_path.ToString());
+            return false;
+        }
+
+        /// Переменные указывают в дерево разбора, поэтому забираются вместе с ним
+        m_analyzedTree = pCompiled->m_analyzedTree;
+        m_useStack = pCompiled->m_useStack;
+        m_shared = pCompiled->m_shared;
+        m_constants = pCompiled->m_constants;
+
+        return true;
+    }
+
+    SR_UTILS_NS::Path SRSLShader::GetArtifactPath() const {
+        return SR_UTILS_NS::ResourceManager::Instance().GetCachePath().Concat("Shaders").Concat(m_path).ConcatExt("artifact");
+    }
+
+    SRSLShader::Ptr SRSLShader::LoadArtifact(const SR_UTILS_NS::Path& path) {
+        SR_TRACY_ZONE;
+
+        auto&& pShader = SRSLShader::Ptr(new SRSLShader(path));
+
+        auto&& artifactPath = pShader->GetArtifactPath();
+        if (!artifactPath.Exists(SR_UTILS_NS::Path::Type::File)) {
+            return nullptr;
+        }
+
+        std::ifstream file(artifactPath.ToStringRef(), std::ios::binary);
+        if (!file.is_open()) {
+            SR_WARN("SRSLShader::LoadArtifact() : failed to load artifact!\n\tPath: " + artifactPath.ToString());
+            return nullptr;
+        }
+
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        /// Заголовок: версия формата и хеш содержимого, которым проверяется целостность остального файла
+        constexpr size_t headerSize = 2 * sizeof(uint64_t);
+
+        SRSLArtifactReader header(data.data(), data.size());
+
+        if (header.Read<uint64_t>() != VERSION) {
+            return nullptr;
+        }
+
+        const auto payloadHash = header.Read<uint64_t>();
+
+        if (header.IsFailed() || payloadHash != GetArtifactPayloadHash(data.data() + headerSize, data.size() - headerSize)) {
+            SR_WARN("SRSLShader::LoadArtifact() : artifact is corrupted!\n\tPath: " + artifactPath.ToString());
+            return nullptr;
+        }
+
+        SRSLArtifactReader reader(data.data() + headerSize, data.size() - headerSize);
+
+        const auto hash = reader.Read<uint64_t>();
+
+        const auto includesCount = reader.ReadCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < includesCount; ++i) {
+            pShader->m_includes.emplace_back(reader.ReadString());
+        }
+
+        /// хеш считается по всем подключенным файлам, поэтому изменение любого include инвалидирует артефакт
+        if (reader.IsFailed() || pShader->m_includes.empty() || hash != pShader->GetHash()) {
+            return nullptr;
+        }
+
+        pShader->m_type = static_cast<ShaderType>(reader.Read<uint8_t>());
+
+        auto&& createInfo = pShader->m_createInfo;
+        createInfo.polygonMode = static_cast<PolygonMode>(reader.Read<int32_t>());
+        createInfo.cullMode = static_cast<CullMode>(reader.Read<int32_t>());
+        createInfo.depthCompare = static_cast<DepthCompare>(reader.Read<int32_t>());
+        createInfo.primitiveTopology = static_cast<PrimitiveTopology>(reader.Read<int32_t>());
+        createInfo.blendEnabled = reader.Read<bool>();
+        createInfo.depthWrite = reader.Read<bool>();
+        createInfo.depthTest = reader.Read<bool>();
+
+        const auto stagesCount = reader.ReadCount(sizeof(uint8_t) + 2 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < stagesCount; ++i) {
+            auto&& stageInfo = createInfo.stages[static_cast<ShaderStage>(reader.Read<uint8_t>())];
+            stageInfo.path = reader.ReadString();
+
+            const auto pushConstantsCount = reader.ReadCount(2 * sizeof(uint64_t));
+            for (uint32_t j = 0; j < pushConstantsCount; ++j) {
+                auto&& pushConstant = stageInfo.pushConstants.emplace_back();
+                pushConstant.size = reader.Read<uint64_t>();
+                pushConstant.offset = reader.Read<uint64_t>();
+            }
+        }
+
+        const auto uniformsCount = reader.ReadCount(sizeof(int32_t) + sizeof(uint8_t) + 2 * sizeof(uint64_t) + sizeof(uint32_t));
+        for (uint32_t i = 0; i < uniformsCount; ++i) {
+            auto&& uniform = createInfo.uniforms.emplace_back();
+            uniform.type = static_cast<LayoutBinding>(reader.Read<int32_t>());
+            uniform.stage = static_cast<ShaderStage>(reader.Read<uint8_t>());
+            uniform.binding = reader.Read<uint64_t>();
+            uniform.size = reader.Read<uint64_t>();
+            uniform.count = reader.Read<uint32_t>();
+        }
+
+        const auto uniformBlocksCount = reader.ReadCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < uniformBlocksCount; ++i) {
+            ReadUniformBlock(reader, pShader->m_uniformBlocks[reader.ReadString()]);
+        }
+
+        const auto ssboBlocksCount = reader.ReadCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < ssboBlocksCount; ++i) {
+            ReadUniformBlock(reader, pShader->m_ssboBlocks[reader.ReadString()]);
         }
 
+        ReadUniformBlock(reader, pShader->m_pushConstants);
+
+        const auto samplersCount = reader.ReadCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < samplersCount; ++i) {
+            auto&& sampler = pShader->m_samplers[reader.ReadString()];
+            sampler.type = reader.ReadString();
+            sampler.isPublic = reader.Read<bool>();
+            sampler.binding = reader.Read<uint64_t>();
+            sampler.attachment = reader.Read<int32_t>();
+            sampler.count = reader.Read<uint32_t>();
+            sampler.bindless = reader.Read<bool>();
+            sampler.defaultValue = reader.ReadString();
+
+            const auto samplerStagesCount = reader.ReadCount(sizeof(uint8_t));
+            for (uint32_t j = 0; j < samplerStagesCount; ++j) {
+                sampler.stages.insert(static_cast<ShaderStage>(reader.Read<uint8_t>()));
+            }
+        }
+
+        const auto languagesCount = reader.ReadCount(sizeof(uint8_t) + sizeof(uint32_t));
+        for (uint32_t i = 0; i < languagesCount; ++i) {
+            auto&& stages = pShader->m_generatedStages[static_cast<ShaderLanguage>(reader.Read<uint8_t>())];
+
+            const auto generatedStagesCount = reader.ReadCount(sizeof(uint8_t) + sizeof(uint32_t));
+            for (uint32_t j = 0; j < generatedStagesCount; ++j) {
+                auto&& stage = static_cast<ShaderStage>(reader.Read<uint8_t>());
+                stages[stage] = reader.ReadString();
+            }
+        }
+
+        /// хеш содержимого совпал, поэтому сюда приводит только ошибка формата
+        if (reader.IsFailed() || !reader.IsEnd()) {
+            SR_WARN("SRSLShader::LoadArtifact() : artifact is corrupted!\n\tPath: " + artifactPath.ToString());
+            return nullptr;
+        }
+
+        /// описание вершин не сохраняется, оно однозначно определяется типом шейдера
+        auto&& vertexInfo = Vertices::GetVertexInfo(pShader->GetVertexType());
+        createInfo.vertexAttributes = vertexInfo.m_attributes;
+        createInfo.vertexDescriptions = vertexInfo.m_descriptions;
+
         return pShader;
     }
 
+    bool SRSLShader::SaveArtifact() const {
+        SR_TRACY_ZONE;
+
+        SRSLArtifactWriter writer;
+
+        writer.Write<uint64_t>(GetHash());
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_includes.size()));
+        for (auto&& include : m_includes) {
+            writer.WriteString(include.ToStringRef());
+        }
+
+        writer.Write<uint8_t>(static_cast<uint8_t>(m_type));
+
+        writer.Write<int32_t>(static_cast<int32_t>(m_createInfo.polygonMode));
+        writer.Write<int32_t>(static_cast<int32_t>(m_createInfo.cullMode));
+        writer.Write<int32_t>(static_cast<int32_t>(m_createInfo.depthCompare));
+        writer.Write<int32_t>(static_cast<int32_t>(m_createInfo.primitiveTopology));
+        writer.Write<bool>(m_createInfo.blendEnabled);
+        writer.Write<bool>(m_createInfo.depthWrite);
+        writer.Write<bool>(m_createInfo.depthTest);
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_createInfo.stages.size()));
+        for (auto&& [stage, stageInfo] : m_createInfo.stages) {
+            writer.Write<uint8_t>(static_cast<uint8_t>(stage));
+            writer.WriteString(stageInfo.path.ToString());
+
+            writer.Write<uint32_t>(static_cast<uint32_t>(stageInfo.pushConstants.size()));
+            for (auto&& pushConstant : stageInfo.pushConstants) {
+                writer.Write<uint64_t>(pushConstant.size);
+                writer.Write<uint64_t>(pushConstant.offset);
+            }
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_createInfo.uniforms.size()));
+        for (auto&& uniform : m_createInfo.uniforms) {
+            writer.Write<int32_t>(static_cast<int32_t>(uniform.type));
+            writer.Write<uint8_t>(static_cast<uint8_t>(uniform.stage));
+            writer.Write<uint64_t>(uniform.binding);
+            writer.Write<uint64_t>(uniform.size);
+            writer.Write<uint32_t>(uniform.count);
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_uniformBlocks.size()));
+        for (auto&& [name, block] : m_uniformBlocks) {
+            writer.WriteString(name.ToStringRef());
+            WriteUniformBlock(writer, block);
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_ssboBlocks.size()));
+        for (auto&& [name, block] : m_ssboBlocks) {
+            writer.WriteString(name.ToStringRef());
+            WriteUniformBlock(writer, block);
+        }
+
+        WriteUniformBlock(writer, m_pushConstants);
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_samplers.size()));
+        for (auto&& [name, sampler] : m_samplers) {
+            writer.WriteString(name.ToStringRef());
+            writer.WriteString(sampler.type.ToStringRef());
+            writer.Write<bool>(sampler.isPublic);
+            writer.Write<uint64_t>(sampler.binding);
+            writer.Write<int32_t>(sampler.attachment);
+            writer.Write<uint32_t>(sampler.count);
+            writer.Write<bool>(sampler.bindless);
+            writer.WriteString(sampler.defaultValue.ToStringRef());
+
+            writer.Write<uint32_t>(static_cast<uint32_t>(sampler.stages.size()));
+            for (auto&& stage : sampler.stages) {
+                writer.Write<uint8_t>(static_cast<uint8_t>(stage));
+            }
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(m_generatedStages.size()));
+        for (auto&& [language, stages] : m_generatedStages) {
+            writer.Write<uint8_t>(static_cast<uint8_t>(language));
+
+            writer.Write<uint32_t>(static_cast<uint32_t>(stages.size()));
+            for (auto&& [stage, code] : stages) {
+                writer.Write<uint8_t>(static_cast<uint8_t>(stage));
+                writer.WriteString(code);
+            }
+        }
+
+        auto&& payload = writer.GetData();
+
+        SRSLArtifactWriter header;
+        header.Write<uint64_t>(VERSION);
+        header.Write<uint64_t>(GetArtifactPayloadHash(payload.data(), payload.size()));
+
+        auto&& artifactPath = GetArtifactPath();
+
+        if (!artifactPath.Create()) {
+            SR_ERROR("SRSLShader::SaveArtifact() : failed to create artifact!\n\tPath: " + artifactPath.ToString());
+            return false;
+        }
+
+        std::ofstream file(artifactPath.ToStringRef(), std::ios::binary | std::ios::trunc);
+
+        file.write(reinterpret_cast<const char*>(header.GetData().data()), static_cast<std::streamsize>(header.GetData().size()));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+        if (!file.good()) {
+            SR_ERROR("SRSLShader::SaveArtifact() : failed to save artifact!\n\tPath: " + artifactPath.ToString());
+            return false;
+        }
+
+        return true;
+    }
+
     bool SRSLShader::IsCacheActual() const {
         auto&& cachedPath = SR_UTILS_NS::ResourceManager::Instance().GetCachePath().Concat("Shaders").Concat(m_path);
         return GetHash() == SR_UTILS_NS::FileSystem::ReadHashFromFile(cachedPath.ConcatExt("hash"));
@@ -103,6 +573,12 @@ namespace SR_SRSL_NS {
         uint64_t hash = 0;
 
         for (auto&& include : m_includes) {
+            /// Встроенный модуль не лежит в ресурсах, его исходник зашит в движок
+            if (auto&& pIt = SR_SRSL_BUILTIN_INCLUDES.find(include.ToStringRef()); pIt != SR_SRSL_BUILTIN_INCLUDES.end()) {
+                hash = SR_UTILS_NS::CombineTwoHashes(hash, std::hash<std::string>()(pIt->second));
+                continue;
+            }
+
             auto&& absPath = SR_UTILS_NS::ResourceManager::Instance().GetResPath().Concat(include);
             hash = SR_UTILS_NS::CombineTwoHashes(hash, absPath.GetFileHash());
         }
@@ -117,7 +593,7 @@ namespace SR_SRSL_NS {
     }
 
     std::string SRSLShader::ToString(ShaderLanguage shaderLanguage) const {
-        auto&& [result, stages] = GenerateStages(shaderLanguage);
+        auto&& [result, stages] = GetStages(shaderLanguage);
 
         if (result.HasErrors()) {
             return "SRSLShader::ToStringAtom() : " + result.ToString(m_includes);
@@ -133,15 +609,27 @@ namespace SR_SRSL_NS {
     }
 
     const SRSLAnalyzedTree::Ptr SRSLShader::GetAnalyzedTree() const {
+        RestoreAnalyzedState();
         return m_analyzedTree;
     }
 
     const SRSLUseStack::Ptr SRSLShader::GetUseStack() const {
+        RestoreAnalyzedState();
         return m_useStack;
     }
 
+    const std::vector<std::pair<SR_UTILS_NS::StringAtom, SRSLVariable*>>& SRSLShader::GetShared() const {
+        RestoreAnalyzedState();
+        return m_shared;
+    }
+
+    const std::map<SR_UTILS_NS::StringAtom, SRSLVariable*>& SRSLShader::GetConstants() const {
+        RestoreAnalyzedState();
+        return m_constants;
+    }
+
     bool SRSLShader::Prepare() {
-        m_useStack = SRSLRefAnalyzer::Instance().Analyze(m_analyzedTree);
+        m_useStack = SRSLCompilationContext::Current().GetRefAnalyzer().Analyze(m_analyzedTree);
         if (!m_useStack) {
             SR_ERROR("SRSLShader::Prepare() : failed to analyze shader refs!");
             return false;
@@ -249,12 +737,34 @@ namespace SR_SRSL_NS {
                 continue;
             }
 
-            if (SR_SRSL_NS::IsSampler(pVariable->GetType())) {
+            /// не добавляем в блок переменные, которые объявили и не используем
+            if (!m_useStack->IsVariableUsedInEntryPoints(pVariable->GetName())) {
                 continue;
             }
 
-            /// не добавляем в блок переменные, которые объявили и не используем
-            if (!m_useStack->IsVariableUsedInEntryPoints(pVariable->GetName())) {
+            if (SR_SRSL_NS::IsSampler(pVariable->GetType())) {
+                if (!pVariable->pDecorators->Find("bindless") || !pVariable->pDecorators->Find("uniform")) {
+                    continue;
+                }
+
+                if (pVariable->GetType() != "sampler2D") {
+                    SR_ERROR("SRSLShader::PrepareUniformBlocks() : only sampler2D can be bindless! Name: " + pVariable->GetName());
+                    return false;
+                }
+
+                /// Вместо биндинга семплера в блок юниформ попадает индекс текстуры в общей таблице
+                SRSLUniformBlock::Field field;
+
+                field.name = SR_SRSL_TEXTURE_INDEX_PREFIX + pVariable->GetName();
+                field.type = "int";
+                field.isPublic = false;
+
+                auto&& usedStages = m_useStack->IsVariableUsedInEntryPointsExt(pVariable->GetName());
+
+                auto&& uniformBlock = m_uniformBlocks["BLOCK"];
+                uniformBlock.fields.emplace_back(field);
+                uniformBlock.stages.insert(usedStages.begin(), usedStages.end());
+
                 continue;
             }
 
@@ -335,7 +845,24 @@ namespace SR_SRSL_NS {
 
         /// ------------------------------------------------------------------
 
+        const bool instancing = IsInstancingAvailable();
+        if (instancing) {
+            SRSLUniformBlock::Field field;
+
+            field.name = SR_SRSL_INSTANCE_MATRICES;
+            field.type = "mat4[]";
+            field.isPublic = false;
+
+            auto&& uniformBlock = m_ssboBlocks[SR_SRSL_INSTANCES_BLOCK];
+            uniformBlock.fields.emplace_back(field);
+            uniformBlock.stages.insert(ShaderStage::Vertex);
+        }
+
         for (auto&& [defaultUniform, type] : SR_SRSL_DEFAULT_UNIFORMS) {
+            if (instancing && defaultUniform == "MODEL_MATRIX") {
+                continue;
+            }
+
             auto&& usedStages = m_useStack->IsVariableUsedInEntryPointsExt(defaultUniform);
             if (!usedStages.empty()) {
                 SRSLUniformBlock::Field field;
@@ -396,7 +923,43 @@ namespace SR_SRSL_NS {
         return true;
     }
 
+    bool SRSLShader::IsInstancingAvailable() const {
+        if (GetType() != ShaderType::Spatial && GetType() != ShaderType::SpatialCustom) {
+            return false;
+        }
+
+        /// шейдер сам объявил блок экземпляров
+        if (m_ssboBlocks.count(SR_SRSL_INSTANCES_BLOCK) == 1) {
+            return false;
+        }
+
+        auto&& modelStages = m_useStack->IsVariableUsedInEntryPointsExt("MODEL_MATRIX");
+        if (modelStages.size() != 1 || *modelStages.begin() != ShaderStage::Vertex) {
+            return false;
+        }
+
+        /// MODEL_MATRIX объявлена явно как обычная юниформа
+        if (auto&& pBlock = FindUniformBlock("BLOCK")) {
+            for (auto&& field : pBlock->fields) {
+                if (field.name.ToString() == "MODEL_MATRIX") {
+                    return false;
+                }
+            }
+        }
+
+        /// остальные юниформы объекта у каждого меша свои
+        for (auto&& [defaultUniform, type] : SR_SRSL_DEFAULT_UNIFORMS) {
+            if (defaultUniform != "MODEL_MATRIX" && !m_useStack->IsVariableUsedInEntryPointsExt(defaultUniform).empty()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool SRSLShader::PrepareSamplers() {
+        std::set<ShaderStage> textureTableStages;
+
         for (auto&& pUnit : m_analyzedTree->pLexicalTree->lexicalTree) {
             auto&& pVariable = dynamic_cast<SRSLVariable*>(pUnit);
             if (!pVariable || !pVariable->pDecorators) {
@@ -432,10 +995,27 @@ namespace SR_SRSL_NS {
                     sampler.attachment = SR_UTILS_NS::LexicalCast<int32_t>(pAttachment->args.front()->token);
                 }
 
+                if (pVariable->pDecorators->Find("bindless")) {
+                    sampler.bindless = true;
+                    textureTableStages.insert(sampler.stages.begin(), sampler.stages.end());
+                }
+
                 m_samplers[pVariable->GetName()] = sampler;
             }
         }
 
+        /// Одна таблица на все bindless семплеры шейдера
+        if (!textureTableStages.empty()) {
+            SRSLSampler sampler;
+
+            sampler.type = "sampler2D";
+            sampler.isPublic = false;
+            sampler.count = SR_SRSL_TEXTURE_TABLE_SIZE;
+            sampler.stages = std::move(textureTableStages);
+
+            m_samplers[SR_SRSL_TEXTURE_TABLE] = sampler;
+        }
+
         for (auto&& [defaultSampler, type] : SR_SRSL_DEFAULT_SAMPLERS) {
             auto&& stages = m_useStack->IsVariableUsedInEntryPointsExt(defaultSampler);
             if (stages.empty()) {
@@ -459,7 +1039,7 @@ namespace SR_SRSL_NS {
             return true;
         }
 
-        auto&& [result, stages] = GenerateStages(shaderLanguage);
+        auto&& [result, stages] = GetStages(shaderLanguage);
 
         if (result.HasErrors()) {
             SR_ERROR("SRSLShader::Export() : " + result.ToString(m_includes));
@@ -480,12 +1060,12 @@ namespace SR_SRSL_NS {
             }
         }
 
-        auto&& absPath = SR_UTILS_NS::ResourceManager::Instance().GetResPath().Concat(m_path);
         auto&& cachedPath = SR_UTILS_NS::ResourceManager::Instance().GetCachePath().Concat("Shaders").Concat(m_path);
 
+        /// тот же хеш по всем include, что проверяет IsCacheActual
         SR_UTILS_NS::FileSystem::WriteHashToFile(
                 cachedPath.ConcatExt("hash").ConcatExt(SR_UTILS_NS::EnumReflector::ToStringAtom(shaderLanguage)),
-                absPath.GetFileHash()
+                GetHash()
         );
 
         return true;
@@ -507,6 +1087,9 @@ namespace SR_SRSL_NS {
             }
 
             for (auto&& [samplerName, sampler] : m_samplers) {
+                if (sampler.bindless) {
+                    continue;
+                }
                 sampler.binding = binding;
                 ++binding;
             }
@@ -531,7 +1114,8 @@ namespace SR_SRSL_NS {
                 uniform.binding = block.binding;
                 uniform.size = block.size;
                 uniform.stage = stage;
-                uniform.type = LayoutBinding::Uniform;
+                /// Блок объекта лежит в общей странице UBO, его смещение задается при привязке набора
+                uniform.type = name.ToStringRef() == "BLOCK" ? LayoutBinding::DynamicUniform : LayoutBinding::Uniform;
 
                 m_createInfo.uniforms.emplace_back(uniform);
             }
@@ -553,7 +1137,7 @@ namespace SR_SRSL_NS {
             /// текстуры/аттачменты
 
             for (auto&& [name, sampler] : m_samplers) {
-                if (sampler.stages.count(stage) == 0) {
+                if (sampler.stages.count(stage) == 0 || sampler.bindless) {
                     continue;
                 }
 
@@ -561,6 +1145,7 @@ namespace SR_SRSL_NS {
                 uniform.binding = sampler.binding;
                 uniform.size = 0;
                 uniform.stage = stage;
+                uniform.count = sampler.count;
 
                 if (sampler.attachment >= 0) {
                     uniform.type = LayoutBinding::Attachhment;
@@ -671,15 +1256,44 @@ namespace SR_SRSL_NS {
         return std::nullopt;
     }
 
+    ISRSLCodeGenerator::SRSLCodeGenRes SRSLShader::GetStages(ShaderLanguage shaderLanguage) const {
+        if (auto&& pIt = m_generatedStages.find(shaderLanguage); pIt != m_generatedStages.end()) {
+            ISRSLCodeGenerator::SRSLCodeGenRes codeGenRes;
+            codeGenRes.second = pIt->second;
+            return codeGenRes;
+        }
+
+        auto&& codeGenRes = GenerateStages(shaderLanguage);
+        if (codeGenRes.first.HasErrors()) {
+            return codeGenRes;
+        }
+
+        m_generatedStages[shaderLanguage] = codeGenRes.second;
+
+        /// следующий запуск получит код этого языка из артефакта
+        if (SR_UTILS_NS::Features::Instance().Enabled("ShaderCaching", true) && !SaveArtifact()) {
+            SR_WARN("SRSLShader::GetStages() : failed to save shader artifact!\n\tPath: " + m_path.ToString());
+        }
+
+        return codeGenRes;
+    }
+
     ISRSLCodeGenerator::SRSLCodeGenRes SRSLShader::GenerateStages(ShaderLanguage shaderLanguage) const {
         ISRSLCodeGenerator::SRSLCodeGenRes codeGenRes;
 
+        /// шейдер из артефакта компилируется заново только тогда, когда нужен код, которого в артефакте нет
+        if (!RestoreAnalyzedState()) {
+            SR_ERROR("SRSLShader::GenerateStages() : shader has no analyzed tree! Path: " + m_path.ToString());
+            codeGenRes.first = SRSLReturnCode::InvalidLexicalTree;
+            return codeGenRes;
+        }
+
         switch (shaderLanguage) {
             case ShaderLanguage::PseudoCode:
-                codeGenRes = SRSLPseudoCodeGenerator::Instance().GenerateStages(this);
+                codeGenRes = SRSLCompilationContext::Current().GetPseudoCodeGenerator().GenerateStages(this);
                 break;
             case ShaderLanguage::GLSL:
-                codeGenRes = GLSLCodeGenerator::Instance().GenerateStages(this);
+                codeGenRes = SRSLCompilationContext::Current().GetGLSLCodeGenerator().GenerateStages(this);
                 break;
             case ShaderLanguage::HLSL:
             case ShaderLanguage::Metal:
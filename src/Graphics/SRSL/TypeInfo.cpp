@@ -3,8 +3,7 @@
 //
 
 #include <Graphics/SRSL/TypeInfo.h>
-#include <Graphics/SRSL/Lexer.h>
-#include <Graphics/SRSL/LexicalAnalyzer.h>
+#include <Graphics/SRSL/CompilationContext.h>
 #include <Graphics/SRSL/MathExpression.h>
 #include <Graphics/SRSL/Evaluator.h>
 
@@ -139,8 +138,8 @@ namespace SR_SRSL_NS {
     }
 
     SRSLAnalyzedTree::Ptr SRSLTypeInfo::Analyze(const std::string &code) {
-        auto&& lexems = SRSLLexer::Instance().ParseString(code, 0);
-        auto&& [pTree, result] = SRSLLexicalAnalyzer::Instance().Analyze(std::move(lexems));
+        auto&& lexems = SRSLCompilationContext::Current().GetLexer().ParseString(code, 0);
+        auto&& [pTree, result] = SRSLCompilationContext::Current().GetLexicalAnalyzer().Analyze(std::move(lexems));
 
         if (result.HasErrors()) {
             SR_ERROR("SRSLTypeInfo::Analyze() : failed to parse expression!");
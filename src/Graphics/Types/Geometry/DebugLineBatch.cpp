@@ -0,0 +1,123 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Types/Geometry/DebugLineBatch.h>
+
+namespace SR_GTYPES_NS {
+    DebugLineBatch::DebugLineBatch(SR_UTILS_NS::StringAtom layer)
+        : Super(MeshType::Line)
+        , m_layer(layer)
+    { }
+
+    bool DebugLineBatch::Upload(const std::vector<Vertex>& vertices) {
+        SR_TRACY_ZONE;
+
+        if (m_hasErrors) SR_UNLIKELY_ATTRIBUTE {
+            return false;
+        }
+
+        const auto count = static_cast<uint32_t>(vertices.size());
+        bool reallocated = false;
+
+        if (count > m_capacity && count > m_failedCapacity) SR_UNLIKELY_ATTRIBUTE {
+            reallocated = Reserve(count);
+            if (m_hasErrors) SR_UNLIKELY_ATTRIBUTE {
+                return false;
+            }
+        }
+
+        /// Если буфер вырасти не смог, рисуем сколько помещается
+        const uint32_t drawCount = SR_MIN(count, m_capacity);
+
+        if (m_drawBuffer != SR_ID_INVALID) {
+            if (drawCount > 0) {
+                GetPipeline()->UpdateSSBO(m_ssbo, (void*)vertices.data(), drawCount * sizeof(Vertex));
+            }
+
+            if (drawCount != m_drawCount) {
+                GetPipeline()->UpdateIndirectBuffer(m_drawBuffer, DrawIndirectCommand { drawCount, 1, 0, 0 });
+                m_drawCount = drawCount;
+            }
+
+            return reallocated;
+        }
+
+        /// Хвост прошлого кадра затираем пустыми вершинами
+        const uint32_t uploadCount = SR_MAX(drawCount, m_uploaded);
+
+        m_staging.resize(uploadCount);
+
+        if (drawCount > 0) {
+            memcpy(m_staging.data(), vertices.data(), drawCount * sizeof(Vertex));
+        }
+
+        if (uploadCount > drawCount) {
+            memset(m_staging.data() + drawCount, 0, (uploadCount - drawCount) * sizeof(Vertex));
+        }
+
+        if (uploadCount > 0) {
+            GetPipeline()->UpdateSSBO(m_ssbo, m_staging.data(), uploadCount * sizeof(Vertex));
+        }
+
+        m_uploaded = drawCount;
+
+        return reallocated;
+    }
+
+    bool DebugLineBatch::Reserve(uint32_t count) {
+        /// Растем степенями двойки, чтобы при плавном росте количества отрезков сцена перестраивалась редко
+        uint32_t capacity = SR_MAX(1024U, m_capacity);
+        while (capacity < count) {
+            capacity *= 2;
+        }
+
+        /// Старый буфер освобождаем только после успешного выделения нового, он еще записан в команды рендера
+        const int32_t ssbo = GetPipeline()->AllocateSSBO(capacity * sizeof(Vertex), SSBOUsage::Write);
+        if (ssbo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            SR_ERROR("DebugLineBatch::Reserve() : failed to allocate vertex buffer! Capacity: " + std::to_string(capacity));
+            m_failedCapacity = capacity;
+            m_hasErrors = m_ssbo == SR_ID_INVALID;
+            return false;
+        }
+
+        if (m_ssbo != SR_ID_INVALID) {
+            GetPipeline()->FreeSSBO(&m_ssbo);
+        }
+
+        m_ssbo = ssbo;
+        m_capacity = capacity;
+        m_uploaded = capacity;
+
+        if (m_drawBuffer == SR_ID_INVALID && GetPipeline()->IsIndirectDrawSupported()) {
+            m_drawBuffer = GetPipeline()->AllocateIndirectBuffer(1);
+            m_drawCount = SR_UINT32_MAX;
+        }
+
+        m_dirtyInstancing = true;
+
+        return true;
+    }
+
+    void DebugLineBatch::UseSSBO() {
+        GetPipeline()->GetCurrentShader()->BindSSBO(SHADER_DEBUG_VERTICES_BLOCK, m_ssbo);
+        Super::UseSSBO();
+    }
+
+    void DebugLineBatch::FreeVideoMemory() {
+        if (m_ssbo != SR_ID_INVALID) {
+            GetPipeline()->FreeSSBO(&m_ssbo);
+        }
+
+        if (m_drawBuffer != SR_ID_INVALID) {
+            GetPipeline()->FreeIndirectBuffer(&m_drawBuffer);
+        }
+
+        m_capacity = 0;
+        m_failedCapacity = 0;
+        m_uploaded = 0;
+        m_drawCount = SR_UINT32_MAX;
+
+        Super::FreeVideoMemory();
+    }
+}
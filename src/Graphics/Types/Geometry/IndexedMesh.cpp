@@ -28,6 +28,8 @@ namespace SR_GTYPES_NS {
 
         using namespace Memory;
 
+        m_lods.clear();
+
         if (!IsUniqueMesh()) {
             m_IBO = MeshManager::Instance().CopyIfExists<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(GetMeshIdentifier());
         }
@@ -40,8 +42,21 @@ namespace SR_GTYPES_NS {
                 return false;
             }
 
-            if (m_IBO = m_pipeline->AllocateIBO((void *) indices.data(), sizeof(uint32_t), m_countIndices, m_VBO); m_IBO == SR_ID_INVALID) {
+            /// Упрощенные уровни используют тот же VBO и лежат в том же IBO после исходных индексов
+            if (SR_UTILS_NS::Features::Instance().Enabled("MeshLod", true)) {
+                for (auto&& level : GetLodChain()) {
+                    m_lods.emplace_back(MeshLod {
+                        static_cast<uint32_t>(indices.size()),
+                        static_cast<uint32_t>(level.indices.size()),
+                        level.error
+                    });
+                    indices.insert(indices.end(), level.indices.begin(), level.indices.end());
+                }
+            }
+
+            if (m_IBO = m_pipeline->AllocateIBO((void *) indices.data(), sizeof(uint32_t), indices.size(), m_VBO); m_IBO == SR_ID_INVALID) {
                 SR_ERROR("IndexedMesh::CalculateIBO() : failed calculate IBO \"" + GetGeometryName() + "\" mesh!");
+                m_lods.clear();
                 m_hasErrors = true;
                 return false;
             }
@@ -49,17 +64,19 @@ namespace SR_GTYPES_NS {
                 return Mesh::Calculate();
             }
 
-            return MeshManager::Instance().Register<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(
-                GetMeshIdentifier(),
-                m_countIndices,
-                m_IBO
-            );
+            auto&& manager = MeshManager::Instance();
+
+            if (!manager.Register<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(GetMeshIdentifier(), m_countIndices, m_IBO)) {
+                return false;
+            }
+
+            return manager.SetLods(GetMeshIdentifier(), m_lods);
         }
 
         if (!IsUniqueMesh()) {
-            m_countIndices = MeshManager::Instance().Size<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(
-                GetMeshIdentifier()
-            );
+            auto&& manager = MeshManager::Instance();
+            m_countIndices = manager.Size<Vertices::VertexType::Unknown, MeshMemoryType::IBO>(GetMeshIdentifier());
+            m_lods = manager.GetLods(GetMeshIdentifier());
         }
 
         return true;
@@ -82,6 +99,7 @@ namespace SR_GTYPES_NS {
         }
 
         m_IBO = SR_ID_INVALID;
+        m_lods.clear();
 
         return true;
     }
@@ -136,4 +154,12 @@ namespace SR_GTYPES_NS {
 
         return m_IBO;
     }
+
+    MeshLod IndexedMesh::GetLod(uint8_t level) const {
+        if (level == 0 || level > m_lods.size()) {
+            return MeshLod { 0, m_countIndices, 0.f };
+        }
+
+        return m_lods[level - 1];
+    }
 }
\ No newline at end of file
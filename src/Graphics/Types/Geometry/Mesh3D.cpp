@@ -11,6 +11,7 @@
 #include <Graphics/Types/Uniforms.h>
 #include <Graphics/Types/Shader.h>
 #include <Graphics/Utils/MeshUtils.h>
+#include <Graphics/Utils/MeshLodCache.h>
 
 namespace SR_GTYPES_NS {
     Mesh3D::Mesh3D()
@@ -40,14 +41,44 @@ namespace SR_GTYPES_NS {
             return false;
         }
 
+        if (m_frustumCullingType != FrustumCullingType::None && !m_localBounds.valid) {
+            CalculateBounds();
+        }
+
         return IndexedMesh::Calculate();
     }
 
+    void Mesh3D::CalculateBounds() {
+        SR_TRACY_ZONE;
+
+        auto&& vertices = GetVertices();
+        if (vertices.empty()) {
+            return;
+        }
+
+        glm::vec3 min(std::numeric_limits<float_t>::max());
+        glm::vec3 max(std::numeric_limits<float_t>::lowest());
+
+        for (auto&& vertex : vertices) {
+            auto&& position = *reinterpret_cast<const glm::vec3*>((const void*)&vertex.position);
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        m_localBounds.min = SR_MATH_NS::FVector3(min.x, min.y, min.z);
+        m_localBounds.max = SR_MATH_NS::FVector3(max.x, max.y, max.z);
+        m_localBounds.valid = true;
+    }
+
     std::vector<uint32_t> Mesh3D::GetIndices() const {
         SR_TRACY_ZONE;
         return GetRawMesh()->GetIndices(GetMeshId());
     }
 
+    std::vector<MeshLodLevel> Mesh3D::GetLodChain() const {
+        return MeshLodCache::Instance().Load(GetRawMesh(), GetMeshId(), m_countIndices, m_countVertices);
+    }
+
     bool Mesh3D::IsCalculatable() const {
         return IsValidMeshId() && Super::IsCalculatable();
     }
@@ -58,6 +89,7 @@ namespace SR_GTYPES_NS {
     }
 
     void Mesh3D::UseModelMatrix() {
+        Super::UseModelMatrix();
         auto&& pShader = GetRenderContext()->GetCurrentShader();
         pShader->SetMat4(SHADER_MODEL_MATRIX, GetMatrix());
     }
@@ -67,11 +99,14 @@ namespace SR_GTYPES_NS {
 
         if (GetRawMesh() && IsValidMeshId()) {
             SetGeometryName(GetRawMesh()->GetGeometryName(GetMeshId()));
+            /// Цепочка LOD строится при загрузке меша, при расчете на потоке рендера она только читается из кеша
+            MeshLodCache::Instance().Prepare(GetRawMesh());
         }
 
         ReRegisterMesh();
 
         MarkMaterialDirty();
+        m_localBounds = MeshBounds();
         m_isCalculated = false;
     }
 
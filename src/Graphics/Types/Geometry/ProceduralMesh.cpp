@@ -68,9 +68,17 @@ namespace SR_GTYPES_NS {
         auto&& pShader = m_materialProperty.GetMaterial()->GetShader();
         auto&& uboManager = Memory::UBOManager::Instance();
 
-        if (m_dirtyMaterial)
+        if (m_instanceSSBO == SR_ID_INVALID && pShader->IsInstancingSupported()) {
+            if (!PrepareModelSSBO()) {
+                m_hasErrors = true;
+                return;
+            }
+        }
+
+        if (m_dirtyMaterial || m_dirtyInstancing)
         {
             m_dirtyMaterial = false;
+            m_dirtyInstancing = false;
 
             m_virtualUBO = uboManager.AllocateUBO(m_virtualUBO);
 
@@ -83,6 +91,7 @@ namespace SR_GTYPES_NS {
             }
 
             //pShader->InitUBOBlock();
+            UseSSBO();
             pShader->Flush();
 
             m_materialProperty.GetMaterial()->UseSamplers();
@@ -92,6 +101,7 @@ namespace SR_GTYPES_NS {
         switch (uboManager.BindUBO(m_virtualUBO)) {
             case Memory::UBOManager::BindResult::Duplicated:
                 //pShader->InitUBOBlock();
+                UseSSBO();
                 pShader->Flush();
                 m_materialProperty.GetMaterial()->UseSamplers();
                 pShader->FlushSamplers();
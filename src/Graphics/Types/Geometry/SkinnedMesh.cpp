@@ -3,6 +3,8 @@
 //
 
 #include <Graphics/Types/Geometry/SkinnedMesh.h>
+#include <Graphics/Render/RenderScene.h>
+#include <Graphics/Memory/MeshManager.h>
 
 namespace SR_GTYPES_NS {
     SkinnedMesh::SkinnedMesh()
@@ -42,23 +44,70 @@ namespace SR_GTYPES_NS {
             return false;
         }
 
-        const uint32_t sizeBones = GetRawMesh()->GetOptimizedBones().size() * sizeof(SR_MATH_NS::Matrix4x4);
-        const uint32_t sizeOffsets = GetRawMesh()->GetBoneOffsets().size() * sizeof(SR_MATH_NS::Matrix4x4);
+        if (!AllocateOffsets()) {
+            return false;
+        }
+
+        if (auto&& pRenderScene = TryGetRenderScene(); pRenderScene && pRenderScene->GetSkinningBuffer()) {
+            m_bonesRegion = pRenderScene->GetSkinningBuffer()->Allocate(static_cast<uint32_t>(GetRawMesh()->GetOptimizedBones().size()));
+            /// Буфер мог вырасти, дескриптор этого меша еще не записан и получит новый
+            pRenderScene->UploadSkinningBuffer();
+        }
 
-        m_ssboBones = GetPipeline()->AllocateSSBO(sizeBones, SSBOUsage::Write);
-        m_ssboOffsets = GetPipeline()->AllocateSSBO(sizeOffsets, SSBOUsage::Write);
+        MarkUniformsDirty();
 
         return IndexedMesh::Calculate();
     }
 
-    void SkinnedMesh::FreeSSBO() {
-        if (m_ssboBones != SR_ID_INVALID) {
-            GetPipeline()->FreeSSBO(&m_ssboBones);
+    bool SkinnedMesh::AllocateOffsets() {
+        using namespace SR_GRAPH_NS::Memory;
+
+        auto&& identifier = GetBoneOffsetsIdentifier();
+
+        m_ssboOffsets = MeshManager::Instance().CopyIfExists<Vertices::VertexType::Unknown, MeshMemoryType::SSBO>(identifier);
+        if (m_ssboOffsets != SR_ID_INVALID) {
+            return true;
+        }
+
+        auto&& offsets = GetRawMesh()->GetBoneOffsets();
+        const uint32_t size = offsets.size() * sizeof(SR_MATH_NS::Matrix4x4);
+
+        if (size == 0) {
+            return true;
+        }
+
+        if ((m_ssboOffsets = GetPipeline()->AllocateSSBO(size, SSBOUsage::Write)) == SR_ID_INVALID) {
+            SR_ERROR("SkinnedMesh::AllocateOffsets() : failed to allocate SSBO!\n\tIdentifier: " + identifier);
+            return false;
         }
 
+        /// Смещения не меняются, загружаем их один раз
+        GetPipeline()->UpdateSSBO(m_ssboOffsets, (void*)offsets.data(), size);
+
+        return MeshManager::Instance().Register<Vertices::VertexType::Unknown, MeshMemoryType::SSBO>(identifier, size, m_ssboOffsets);
+    }
+
+    void SkinnedMesh::FreeSSBO() {
+        using namespace SR_GRAPH_NS::Memory;
+
         if (m_ssboOffsets != SR_ID_INVALID) {
-            GetPipeline()->FreeSSBO(&m_ssboOffsets);
+            if (MeshManager::Instance().Free<MeshMemoryType::SSBO>(m_ssboOffsets) == MeshManager::FreeResult::Freed) {
+                GetPipeline()->FreeSSBO(&m_ssboOffsets);
+            }
+            m_ssboOffsets = SR_ID_INVALID;
         }
+
+        if (m_bonesRegion.Valid()) {
+            if (auto&& pRenderScene = TryGetRenderScene(); pRenderScene && pRenderScene->GetSkinningBuffer()) {
+                pRenderScene->GetSkinningBuffer()->Free(m_bonesRegion);
+            }
+            m_bonesRegion = SR_ANIMATIONS_NS::SkinningBuffer::Region();
+        }
+    }
+
+    std::string SkinnedMesh::GetBoneOffsetsIdentifier() const {
+        auto&& pRawMesh = GetRawMesh();
+        return SR_FORMAT("{}|{}|BoneOffsets", pRawMesh->GetResourceId().c_str(), pRawMesh->GetReloadCount());
     }
 
     std::vector<uint32_t> SkinnedMesh::GetIndices() const {
@@ -83,15 +132,18 @@ namespace SR_GTYPES_NS {
         }
 
         if (!m_skeletonIsBroken && usable) {
-            if (m_ssboBones == SR_ID_INVALID || m_ssboOffsets == SR_ID_INVALID) {
+            if (!m_bonesRegion.Valid() || m_ssboOffsets == SR_ID_INVALID) {
                 return Super::LateUpdate();
             }
             auto&& pSkeleton = GetSkeleton().GetComponent<SR_ANIMATIONS_NS::Skeleton>();
             if (!pSkeleton || pSkeleton->GetOptimizedBones().empty()) {
                 return Super::LateUpdate();
             }
-            GetPipeline()->UpdateSSBO(m_ssboBones, (void*)pSkeleton->GetMatrices().data(), pSkeleton->GetMatrices().size() * sizeof(SR_MATH_NS::Matrix4x4));
-            GetPipeline()->UpdateSSBO(m_ssboOffsets, (void*)pSkeleton->GetOffsets().data(), pSkeleton->GetOffsets().size() * sizeof(SR_MATH_NS::Matrix4x4));
+            /// Матрицы пишутся в общий буфер сцены, в видеопамять он уходит раз за кадр
+            if (auto&& pRenderScene = TryGetRenderScene(); pRenderScene && pRenderScene->GetSkinningBuffer()) {
+                auto&& matrices = pSkeleton->GetMatrices();
+                pRenderScene->GetSkinningBuffer()->Write(m_bonesRegion, matrices.data(), static_cast<uint32_t>(matrices.size()));
+            }
             return Super::LateUpdate();
         }
 
@@ -251,8 +303,14 @@ namespace SR_GTYPES_NS {
     }
 
     void SkinnedMesh::UseSSBO() {
-        GetPipeline()->GetCurrentShader()->BindSSBO("bones", m_ssboBones);
-        GetPipeline()->GetCurrentShader()->BindSSBO("offsets", m_ssboOffsets);
+        auto&& pShader = GetPipeline()->GetCurrentShader();
+
+        if (auto&& pRenderScene = TryGetRenderScene(); pRenderScene && pRenderScene->GetSkinningBuffer()) {
+            /// Привязывается только участок меша, поэтому шейдер читает свои кости с нулевого индекса
+            pShader->BindSSBO(SHADER_BONES_BLOCK, pRenderScene->GetSkinningBuffer()->GetSSBO(), m_bonesRegion.GetByteOffset(), m_bonesRegion.GetByteRange());
+        }
+
+        pShader->BindSSBO(SHADER_BONE_OFFSETS_BLOCK, m_ssboOffsets);
         Super::UseSSBO();
     }
 }
@@ -106,6 +106,13 @@ namespace SR_GTYPES_NS {
             m_descriptorManager.FreeDescriptorSet(&m_virtualDescriptor);
         }
 
+        if (m_modelSSBO != SR_ID_INVALID) {
+            if (m_instanceSSBO == m_modelSSBO) {
+                SetInstancing(SR_ID_INVALID, 1);
+            }
+            m_pipeline->FreeSSBO(&m_modelSSBO);
+        }
+
         IGraphicsResource::FreeVideoMemory();
     }
 
@@ -167,6 +174,13 @@ namespace SR_GTYPES_NS {
             return;
         }
 
+        if (m_instanceSSBO == SR_ID_INVALID && m_pipeline->GetCurrentShader()->IsInstancingSupported()) SR_UNLIKELY_ATTRIBUTE {
+            if (!PrepareModelSSBO()) SR_UNLIKELY_ATTRIBUTE {
+                m_hasErrors = true;
+                return;
+            }
+        }
+
         if (m_dirtyMaterial) SR_UNLIKELY_ATTRIBUTE {
             m_virtualUBO = m_uboManager.AllocateUBO(m_virtualUBO);
             if (m_virtualUBO == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
@@ -182,18 +196,42 @@ namespace SR_GTYPES_NS {
         const auto result = m_descriptorManager.Bind(m_virtualDescriptor);
 
         if (m_pipeline->GetCurrentBuildIteration() == 0) {
-            if (result == DescriptorManager::BindResult::Duplicated || m_dirtyMaterial) SR_UNLIKELY_ATTRIBUTE {
+            /// Таблица текстур копируется в каждый набор дескрипторов, поэтому после ее изменения набор перезаписывается.
+            /// Построение после изменения таблицы запрашивает RenderScene, в набор попадают только измененные элементы
+            const bool textureTableChanged = m_pipeline->GetCurrentShader()->HasTextureTable() &&
+                m_textureTableVersion != m_descriptorManager.GetTextureTableVersion();
+
+            if (result == DescriptorManager::BindResult::Duplicated || m_dirtyMaterial || m_dirtyInstancing || textureTableChanged) SR_UNLIKELY_ATTRIBUTE {
                 UseSamplers();
                 UseSSBO();
                 MarkUniformsDirty(true);
-                m_descriptorManager.Flush();
+                m_descriptorManager.Flush(m_virtualDescriptor);
+                m_textureTableVersion = m_descriptorManager.GetTextureTableVersion();
             }
             m_pipeline->GetCurrentShader()->FlushConstants();
         }
 
         if (result != DescriptorManager::BindResult::Failed) SR_UNLIKELY_ATTRIBUTE {
-            if (IsSupportVBO()) {
-                m_pipeline->DrawIndices(GetIndicesCount());
+            if (auto&& indirectBuffer = GetIndirectBuffer(); indirectBuffer != SR_ID_INVALID) {
+                if (IsSupportVBO()) {
+                    m_pipeline->DrawIndicesIndirect(indirectBuffer, m_indirectCommand, 1);
+                }
+                else {
+                    m_pipeline->DrawIndirect(indirectBuffer);
+                }
+            }
+            else if (m_instanceSSBO != SR_ID_INVALID) {
+                if (IsSupportVBO()) {
+                    const MeshLod lod = GetLod(m_lod);
+                    m_pipeline->DrawIndicesInstanced(lod.indicesCount, m_instanceCount, lod.firstIndex);
+                }
+                else {
+                    m_pipeline->DrawInstanced(GetIndicesCount(), m_instanceCount);
+                }
+            }
+            else if (IsSupportVBO()) {
+                const MeshLod lod = GetLod(m_lod);
+                m_pipeline->DrawIndices(lod.indicesCount, lod.firstIndex);
             }
             else {
                 m_pipeline->Draw(GetIndicesCount());
@@ -201,6 +239,46 @@ namespace SR_GTYPES_NS {
         }
 
         m_dirtyMaterial = false;
+        m_dirtyInstancing = false;
+    }
+
+    void Mesh::UseSSBO() {
+        if (m_instanceSSBO != SR_ID_INVALID) {
+            m_pipeline->GetCurrentShader()->BindSSBO(SHADER_INSTANCES_BLOCK, m_instanceSSBO);
+        }
+    }
+
+    void Mesh::SetInstancing(int32_t ssbo, uint32_t instanceCount, int32_t indirectBuffer, uint32_t indirectCommand) {
+        /// Дескриптор хранит сам буфер, а количество экземпляров передается при отрисовке
+        m_dirtyInstancing |= m_instanceSSBO != ssbo;
+        m_instanceSSBO = ssbo;
+        m_instanceCount = instanceCount;
+        m_indirectBuffer = indirectBuffer;
+        m_indirectCommand = indirectCommand;
+        m_lod = 0;
+    }
+
+    bool Mesh::PrepareModelSSBO() {
+        if (m_modelSSBO == SR_ID_INVALID) {
+            m_modelSSBO = m_pipeline->AllocateSSBO(sizeof(SR_MATH_NS::Matrix4x4), SSBOUsage::Write);
+            if (m_modelSSBO == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("Mesh::PrepareModelSSBO() : failed to allocate model matrix buffer!");
+                return false;
+            }
+        }
+
+        /// Остальные аргументы отрисовки задал вызывающий, меняется только буфер
+        m_dirtyInstancing |= m_instanceSSBO != m_modelSSBO;
+        m_instanceSSBO = m_modelSSBO;
+        UseModelMatrix();
+
+        return true;
+    }
+
+    void Mesh::UseModelMatrix() {
+        if (m_modelSSBO != SR_ID_INVALID) {
+            m_pipeline->UpdateSSBO(m_modelSSBO, (void*)&GetMatrix(), sizeof(SR_MATH_NS::Matrix4x4));
+        }
     }
 
     void Mesh::UseSamplers() {
@@ -9,11 +9,16 @@
 #include <Utils/Common/Hashes.h>
 
 #include <Graphics/Pipeline/Pipeline.h>
+#include <Graphics/Memory/DescriptorManager.h>
 #include <Graphics/Types/Texture.h>
 #include <Graphics/Render/RenderContext.h>
 #include <Graphics/Types/Shader.h>
 #include <Graphics/SRSL/Shader.h>
+#include <Graphics/SRSL/ShaderVariables.h>
 #include <Graphics/SRSL/TypeInfo.h>
+#include <Graphics/Utils/ParallelFor.h>
+
+#include <atomic>
 
 namespace SR_GRAPH_NS::Types {
     Shader::Shader()
@@ -49,13 +54,22 @@ namespace SR_GRAPH_NS::Types {
                 if (sampler.isAttachment || sampler.isArray) {
                     continue;
                 }
+
+                Texture* pTexture = nullptr;
+
                 auto&& pIt = m_defaultSamplers.find(sampler.defaultValue);
                 if (pIt != m_defaultSamplers.end()) {
                     LoadDefaultSampler(sampler.defaultValue);
-                    sampler.samplerId = pIt->second->GetId();
+                    pTexture = pIt->second;
                 }
                 else {
-                    sampler.samplerId = pContext->GetDefaultTexture()->GetId();
+                    pTexture = pContext->GetDefaultTexture();
+                }
+
+                sampler.samplerId = pTexture->GetId();
+
+                if (sampler.isBindless) {
+                    m_uniformBlock.SetDefault(sampler.tableIndexField, pTexture->GetTableIndex());
                 }
             }
 
@@ -173,17 +187,92 @@ namespace SR_GRAPH_NS::Types {
         }
     }
 
+    SR_UTILS_NS::Path Shader::NormalizePath(const SR_UTILS_NS::Path& rawPath) {
+        return SR_UTILS_NS::Path(rawPath).RemoveSubPath(SR_UTILS_NS::ResourceManager::Instance().GetResPath());
+    }
+
     Shader* Shader::Load(const SR_UTILS_NS::Path &rawPath) {
         SR_TRACY_ZONE;
 
+        SR_UTILS_NS::Path&& path = NormalizePath(rawPath);
+
+        if (auto&& pShader = SR_UTILS_NS::ResourceManager::Instance().Find<Shader>(path)) {
+            return pShader;
+        }
+
+        return Create(path, nullptr);
+    }
+
+    std::vector<Shader*> Shader::Load(const std::vector<SR_UTILS_NS::Path>& rawPaths) {
+        SR_TRACY_ZONE;
+
         auto&& resourceManager = SR_UTILS_NS::ResourceManager::Instance();
 
-        SR_UTILS_NS::Path&& path = SR_UTILS_NS::Path(rawPath).RemoveSubPath(resourceManager.GetResPath());
+        std::vector<Shader*> shaders(rawPaths.size(), nullptr);
+        std::vector<SR_UTILS_NS::Path> paths(rawPaths.size());
+        std::vector<SR_SRSL_NS::SRSLShader::Ptr> compiled(rawPaths.size());
+        std::vector<uint8_t> failed(rawPaths.size(), 0);
 
-        if (auto&& pShader = resourceManager.Find<Shader>(path)) {
-            return pShader;
+        /// Индексы шейдеров, которых еще нет в менеджере ресурсов, каждый путь встречается один раз
+        std::vector<uint32_t> pending;
+        /// Для повторов пути - индекс его первого вхождения
+        std::vector<int32_t> firstIndices(rawPaths.size(), SR_ID_INVALID);
+        std::unordered_map<std::string, uint32_t> uniquePaths;
+
+        for (uint32_t i = 0; i < rawPaths.size(); ++i) {
+            paths[i] = NormalizePath(rawPaths[i]);
+
+            if ((shaders[i] = resourceManager.Find<Shader>(paths[i]))) {
+                continue;
+            }
+
+            if (auto&& [pIt, inserted] = uniquePaths.try_emplace(paths[i].ToString(), i); !inserted) {
+                firstIndices[i] = static_cast<int32_t>(pIt->second);
+                continue;
+            }
+
+            if (paths[i].IsEmpty() || paths[i].IsAbs() || paths[i].GetExtensionView() != "srsl") {
+                shaders[i] = Create(paths[i], nullptr); /// сообщит об ошибке
+                continue;
+            }
+
+            pending.emplace_back(i);
         }
 
+        /// Фронтенд SRSL и экспорт не трогают ресурсы и конвейер, поэтому выполняются в рабочих потоках.
+        /// Ошибки компиляции сообщает SRSLShader::Load, повторно такой шейдер не собирается
+        SR_GRAPH_NS::ParallelFor(static_cast<uint32_t>(pending.size()), 0, [&](uint32_t task) {
+            const uint32_t index = pending[task];
+
+            auto&& pSRSLShader = SR_SRSL_NS::SRSLShader::Load(paths[index]);
+            if (pSRSLShader && pSRSLShader->Export(SRSL2::ShaderLanguage::GLSL)) {
+                compiled[index] = std::move(pSRSLShader);
+            }
+            else {
+                failed[index] = 1;
+            }
+        });
+
+        for (const uint32_t index : pending) {
+            if (failed[index]) {
+                continue;
+            }
+
+            shaders[index] = Create(paths[index], std::move(compiled[index]));
+        }
+
+        for (uint32_t i = 0; i < rawPaths.size(); ++i) {
+            if (firstIndices[i] != SR_ID_INVALID) {
+                shaders[i] = shaders[firstIndices[i]];
+            }
+        }
+
+        return shaders;
+    }
+
+    Shader* Shader::Create(const SR_UTILS_NS::Path& path, SR_SRSL_NS::SRSLShader::Ptr pPrecompiled) {
+        auto&& resourceManager = SR_UTILS_NS::ResourceManager::Instance();
+
         if (SR_UTILS_NS::Debug::Instance().GetLevel() >= SR_UTILS_NS::Debug::Level::Medium) {
             SR_LOG("Shader::Load() : load \"" + path.ToString() + "\" shader...");
         }
@@ -201,6 +290,7 @@ namespace SR_GRAPH_NS::Types {
         auto&& pShader = new Shader();
 
         pShader->SetId(path.ToString(), false);
+        pShader->m_precompiled = std::move(pPrecompiled);
 
         if (!pShader->Reload()) {
             SR_ERROR("Shader::Load() : failed to reload shader!\n\tPath: " + path.ToString());
@@ -251,6 +341,14 @@ namespace SR_GRAPH_NS::Types {
     void Shader::SetConstVec2(uint64_t hashId, const SR_MATH_NS::FVector2& v) noexcept { SetValue<true>(hashId, &v); }
     void Shader::SetConstIVec2(uint64_t hashId, const SR_MATH_NS::IVector2& v) noexcept { SetValue<true>(hashId, &v); }
 
+    void Shader::ResolveSlot(Memory::ShaderSlot& slot, uint64_t hashId) const noexcept {
+        slot.hashId = hashId;
+        slot.layoutVersion = m_layoutVersion;
+        slot.uniform = m_uniformBlock.GetSlot(hashId);
+        slot.shared = m_uniformSharedBlock.GetSlot(hashId);
+        slot.constant = m_constBlock.GetSlot(hashId);
+    }
+
     void Shader::SetSampler(SR_UTILS_NS::StringAtom name, int32_t sampler) noexcept {
         m_samplers.at(name).samplerId = sampler;
     }
@@ -271,15 +369,52 @@ namespace SR_GRAPH_NS::Types {
         SetSampler(name, sampler);
     }
 
-    void Shader::BindSSBO(SR_UTILS_NS::StringAtom name, uint32_t ssbo) noexcept {
+    void Shader::BindSSBO(SR_UTILS_NS::StringAtom name, uint32_t ssbo, uint32_t offset, uint32_t range) noexcept {
         for (auto&& ssboBinding : m_ssboBindings) {
             if (ssboBinding.name == name) {
                 ssboBinding.ssbo = ssbo;
+                ssboBinding.offset = offset;
+                ssboBinding.range = range;
                 return;
             }
         }
     }
 
+    bool Shader::IsBindlessSampler(SR_UTILS_NS::StringAtom name) const noexcept {
+        if (m_bindlessSamplersCount == 0) SR_LIKELY_ATTRIBUTE {
+            return false;
+        }
+
+        auto&& pIt = m_samplers.find(name);
+        return pIt != m_samplers.end() && pIt->second.isBindless;
+    }
+
+    bool Shader::SetTextureIndex(SR_UTILS_NS::StringAtom name, SR_GTYPES_NS::Texture* pTexture) noexcept {
+        if (m_bindlessSamplersCount == 0) SR_LIKELY_ATTRIBUTE {
+            return false;
+        }
+
+        auto&& pIt = m_samplers.find(name);
+        if (pIt == m_samplers.end() || !pIt->second.isBindless) {
+            return false;
+        }
+
+        if (!pTexture) {
+            pTexture = GetRenderContext()->GetNoneTexture();
+        }
+
+        /// Текстура не попала в таблицу (таблица заполнена) - используем индекс заглушки
+        int32_t index = pTexture ? pTexture->GetTableIndex() : SR_ID_INVALID;
+        if (index == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            auto&& pNoneTexture = GetRenderContext()->GetNoneTexture();
+            index = pNoneTexture ? SR_MAX(pNoneTexture->GetTableIndex(), 0) : 0;
+        }
+
+        SetInt(pIt->second.tableIndexField.GetHash(), index);
+
+        return true;
+    }
+
     void Shader::SetSampler2D(SR_UTILS_NS::StringAtom name, SR_GTYPES_NS::Texture* pSampler) noexcept {
         if (!IsLoaded() || m_samplers.count(name) == 0) {
             return;
@@ -338,14 +473,28 @@ namespace SR_GRAPH_NS::Types {
             return false;
         }
 
-        auto&& ubo = m_pipeline->GetCurrentUBO();
-        if (ubo != SR_ID_INVALID && m_uniformBlock.Valid()) SR_LIKELY_ATTRIBUTE {
-            m_pipeline->UpdateUBO(ubo, m_uniformBlock.m_memory, m_uniformBlock.m_size);
+        if (m_uniformBlock.Valid()) SR_LIKELY_ATTRIBUTE {
+            UpdateCurrentUBO(m_uniformBlock.m_memory, m_uniformBlock.m_size);
         }
 
         return true;
     }
 
+    void Shader::UpdateCurrentUBO(void* pMemory, uint64_t size) const {
+        auto&& ubo = m_pipeline->GetCurrentUBO();
+        if (ubo == SR_ID_INVALID) SR_UNLIKELY_ATTRIBUTE {
+            return;
+        }
+
+        if (m_pipeline->GetCurrentUBORange() > 0) SR_LIKELY_ATTRIBUTE {
+            SRAssert2(size <= m_pipeline->GetCurrentUBORange(), "UBO range overflow!");
+            m_pipeline->UpdateUBORange(ubo, pMemory, size, m_pipeline->GetCurrentUBOOffset());
+        }
+        else {
+            m_pipeline->UpdateUBO(ubo, pMemory, size);
+        }
+    }
+
     uint32_t Shader::GetSamplersCount() const {
         return m_samplers.size();
     }
@@ -410,15 +559,19 @@ namespace SR_GRAPH_NS::Types {
             return false;
         }
 
-        auto&& pShader = SR_SRSL_NS::SRSLShader::Load(path);
+        /// Пакетная загрузка уже скомпилировала и экспортировала шейдер, используем его только один раз
+        SR_SRSL_NS::SRSLShader::Ptr pShader = SR_UTILS_NS::Exchange(m_precompiled, { });
+
         if (!pShader) {
-            SR_ERROR("Shader::Load() : failed to load srsl shader!\n\tPath: " + path.ToString());
-            return false;
-        }
+            if (!(pShader = SR_SRSL_NS::SRSLShader::Load(path))) {
+                SR_ERROR("Shader::Load() : failed to load srsl shader!\n\tPath: " + path.ToString());
+                return false;
+            }
 
-        if (!pShader->Export(SRSL2::ShaderLanguage::GLSL)) {
-            SR_ERROR("Shader::Load() : failed to export srsl shader!\n\tPath: " + path.ToString());
-            return false;
+            if (!pShader->Export(SRSL2::ShaderLanguage::GLSL)) {
+                SR_ERROR("Shader::Load() : failed to export srsl shader!\n\tPath: " + path.ToString());
+                return false;
+            }
         }
 
         m_shaderCreateInfo = pShader->GetCreateInfo();
@@ -483,6 +636,11 @@ namespace SR_GRAPH_NS::Types {
 
         m_constBlock.Init();
 
+        {
+            static std::atomic<uint32_t> layoutVersion = 0;
+            m_layoutVersion = ++layoutVersion;
+        }
+
         /// ------------------------------------------------------------------------------------------------------------
 
         for (auto&& [name, ssbo] : pShader->GetSSBOBlocks()) {
@@ -491,16 +649,29 @@ namespace SR_GRAPH_NS::Types {
             ssboBinding.binding = ssbo.binding;
             ssboBinding.ssbo = SR_ID_INVALID;
             m_ssboBindings.emplace_back(ssboBinding);
+
+            m_instancingSupported |= ssboBinding.name == SHADER_INSTANCES_BLOCK;
         }
 
         /// ------------------------------------------------------------------------------------------------------------
 
         for (auto&& [name, sampler] : pShader->GetSamplers()) {
+            if (name.ToStringRef() == SR_SRSL_NS::SR_SRSL_TEXTURE_TABLE) {
+                m_textureTableBinding = static_cast<uint32_t>(sampler.binding);
+                continue;
+            }
+
             m_samplers[name].binding = sampler.binding;
             m_samplers[name].isAttachment = sampler.attachment >= 0;
             m_samplers[name].isArray = sampler.type.Contains("Array");
             m_samplers[name].defaultValue = sampler.defaultValue;
 
+            if (sampler.bindless) {
+                m_samplers[name].isBindless = true;
+                m_samplers[name].tableIndexField = SR_SRSL_NS::SR_SRSL_TEXTURE_INDEX_PREFIX + name.ToStringRef();
+                ++m_bindlessSamplersCount;
+            }
+
             if (!sampler.defaultValue.empty()) {
                 m_defaultSamplers.insert(std::make_pair(sampler.defaultValue, nullptr));
             }
@@ -541,8 +712,12 @@ namespace SR_GRAPH_NS::Types {
         m_uniformBlock.DeInit();
         m_uniformSharedBlock.DeInit();
         m_constBlock.DeInit();
+        m_layoutVersion = 0;
 
         m_ssboBindings.clear();
+        m_instancingSupported = false;
+        m_textureTableBinding = SR_ID_INVALID;
+        m_bindlessSamplersCount = 0;
         m_includes.clear();
         m_properties.clear();
         m_samplers.clear();
@@ -578,6 +753,10 @@ namespace SR_GRAPH_NS::Types {
 
     void Shader::FlushSamplers() {
         for (auto&& [hashName, samplerInfo] : m_samplers) {
+            if (samplerInfo.isBindless) {
+                continue;
+            }
+
             if (samplerInfo.isAttachment) {
                 m_pipeline->BindAttachment(samplerInfo.binding, samplerInfo.samplerId);
             }
@@ -676,7 +855,7 @@ namespace SR_GRAPH_NS::Types {
         m_sharedUBOMode = false;
 
         if (m_uniformSharedBlock.Valid()) SR_LIKELY_ATTRIBUTE {
-            m_pipeline->UpdateUBO(m_pipeline->GetCurrentUBO(), m_uniformSharedBlock.m_memory, m_uniformSharedBlock.m_size);
+            UpdateCurrentUBO(m_uniformSharedBlock.m_memory, m_uniformSharedBlock.m_size);
         }
     }
 
@@ -684,6 +863,10 @@ namespace SR_GRAPH_NS::Types {
         SR_TRACY_ZONE;
 
         for (auto&& [hashName, samplerInfo] : m_samplers) {
+            if (samplerInfo.isBindless) {
+                continue;
+            }
+
             if (samplerInfo.isAttachment) {
                 m_pipeline->BindAttachment(samplerInfo.binding, samplerInfo.samplerId);
             }
@@ -692,6 +875,25 @@ namespace SR_GRAPH_NS::Types {
             }
         }
 
+        if (HasTextureTable()) {
+            auto&& descriptorManager = DescriptorManager::Instance();
+
+            /// В набор пишутся только элементы, измененные с его последней записи
+            auto&& [first, last] = descriptorManager.AcquireTextureTableRange(m_pipeline->GetCurrentDescriptorSet());
+
+            if (first < last) {
+                auto&& pNoneTexture = GetRenderContext()->GetNoneTexture();
+
+                m_pipeline->BindTextureTable(
+                    static_cast<uint8_t>(m_textureTableBinding),
+                    descriptorManager.GetTextureTable(),
+                    first,
+                    last - first,
+                    pNoneTexture ? pNoneTexture->GetId() : SR_ID_INVALID
+                );
+            }
+        }
+
         auto&& descriptorSet = GetPipeline()->GetCurrentDescriptorSet();
         if (descriptorSet == SR_ID_INVALID) {
             return;
@@ -703,7 +905,9 @@ namespace SR_GRAPH_NS::Types {
             SRDescriptorUpdateInfo updateInfo;
             updateInfo.binding = m_uniformBlock.m_binding;
             updateInfo.ubo = ubo;
-            updateInfo.descriptorType = DescriptorType::Uniform;
+            updateInfo.offset = GetPipeline()->GetCurrentUBOOffset();
+            updateInfo.range = GetPipeline()->GetCurrentUBORange();
+            updateInfo.descriptorType = DescriptorType::DynamicUniform;
 
             GetPipeline()->UpdateDescriptorSets(descriptorSet, { updateInfo });
         }
@@ -711,7 +915,7 @@ namespace SR_GRAPH_NS::Types {
         if (m_uniformSharedBlock.Valid()) {
             SRDescriptorUpdateInfo updateInfo;
             updateInfo.binding = m_uniformSharedBlock.m_binding;
-            updateInfo.ubo = m_uboManager.GetUBO(m_virtualUBO.first);
+            updateInfo.ubo = m_uboManager.GetUBO(m_virtualUBO.first, &updateInfo.offset, &updateInfo.range);
             updateInfo.descriptorType = DescriptorType::Uniform;
 
             GetPipeline()->UpdateDescriptorSets(descriptorSet, { updateInfo });
@@ -725,11 +929,85 @@ namespace SR_GRAPH_NS::Types {
             SRDescriptorUpdateInfo updateInfo;
             updateInfo.binding = ssbo.binding;
             updateInfo.ubo = ssbo.ssbo;
+            updateInfo.offset = ssbo.offset;
+            updateInfo.range = ssbo.range;
             updateInfo.descriptorType = DescriptorType::Storage;
 
             GetPipeline()->UpdateDescriptorSets(descriptorSet, { updateInfo });
+        }
+
+        ResetSSBOBindings();
+    }
 
+    void Shader::ResetSSBOBindings() noexcept {
+        for (auto&& ssbo : m_ssboBindings) {
             ssbo.ssbo = SR_ID_INVALID;
+            ssbo.offset = 0;
+            ssbo.range = 0;
         }
     }
+
+    uint64_t Shader::GetDescriptorContentHash(std::vector<DescriptorResource>* pResources) const {
+        SR_TRACY_ZONE;
+
+        uint64_t hash = SR_UTILS_NS::HashCombine(m_layoutVersion, 0);
+
+        for (auto&& [hashName, samplerInfo] : m_samplers) {
+            if (samplerInfo.isBindless) {
+                continue;
+            }
+
+            /// Вложения пересоздаются вместе с кадровым буфером под тем же идентификатором
+            if (samplerInfo.isAttachment) {
+                return 0;
+            }
+
+            hash = SR_UTILS_NS::HashCombine(samplerInfo.binding, hash);
+            hash = SR_UTILS_NS::HashCombine(samplerInfo.samplerId, hash);
+
+            if (pResources) {
+                pResources->emplace_back(DescriptorResource { DescriptorType::CombinedImage, static_cast<int32_t>(samplerInfo.samplerId) });
+            }
+        }
+
+        if (HasTextureTable()) {
+            hash = SR_UTILS_NS::HashCombine(DescriptorManager::Instance().GetTextureTableVersion(), hash);
+        }
+
+        /// Смещение блока объекта задается при привязке набора, поэтому объекты одной страницы UBO делят набор
+        if (m_uniformBlock.Valid()) SR_LIKELY_ATTRIBUTE {
+            hash = SR_UTILS_NS::HashCombine(m_pipeline->GetCurrentUBO(), hash);
+            hash = SR_UTILS_NS::HashCombine(m_pipeline->GetCurrentUBORange(), hash);
+
+            if (pResources) {
+                pResources->emplace_back(DescriptorResource { DescriptorType::Uniform, static_cast<int32_t>(m_pipeline->GetCurrentUBO()) });
+            }
+        }
+
+        if (m_uniformSharedBlock.Valid()) {
+            uint32_t offset = 0;
+            uint32_t range = 0;
+            const auto ubo = m_uboManager.GetUBO(m_virtualUBO.first, &offset, &range);
+            hash = SR_UTILS_NS::HashCombine(ubo, hash);
+            hash = SR_UTILS_NS::HashCombine(offset, hash);
+            hash = SR_UTILS_NS::HashCombine(range, hash);
+
+            if (pResources) {
+                pResources->emplace_back(DescriptorResource { DescriptorType::Uniform, static_cast<int32_t>(ubo) });
+            }
+        }
+
+        for (auto&& ssbo : m_ssboBindings) {
+            hash = SR_UTILS_NS::HashCombine(ssbo.binding, hash);
+            hash = SR_UTILS_NS::HashCombine(ssbo.ssbo, hash);
+            hash = SR_UTILS_NS::HashCombine(ssbo.offset, hash);
+            hash = SR_UTILS_NS::HashCombine(ssbo.range, hash);
+
+            if (pResources) {
+                pResources->emplace_back(DescriptorResource { DescriptorType::Storage, static_cast<int32_t>(ssbo.ssbo) });
+            }
+        }
+
+        return hash;
+    }
 }
\ No newline at end of file
@@ -228,7 +228,7 @@ namespace SR_GTYPES_NS {
         if (GetPipeline()->GetCurrentBuildIteration() == 0) {
             if (result == DescriptorManager::BindResult::Duplicated || m_dirtyShader) SR_UNLIKELY_ATTRIBUTE {
                 m_shader->SetSamplerCube(SHADER_SKYBOX_DIFFUSE, m_cubeMap);
-                m_descriptorManager.Flush();
+                m_descriptorManager.Flush(m_virtualDescriptor);
             }
             m_pipeline->GetCurrentShader()->FlushConstants();
         }
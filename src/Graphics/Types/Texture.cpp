@@ -8,6 +8,7 @@
 #include <Graphics/Types/Texture.h>
 #include <Graphics/Loaders/TextureLoader.h>
 #include <Graphics/Render/RenderContext.h>
+#include <Graphics/Memory/DescriptorManager.h>
 
 namespace SR_GTYPES_NS {
     Texture::Texture()
@@ -176,6 +177,10 @@ namespace SR_GTYPES_NS {
         createInfo.format = m_config.m_format;
         createInfo.mipLevels = m_config.m_mipLevels;
         createInfo.filter = m_config.m_filter;
+        /// Сжатие большой текстуры долгое, уничтоженную текстуру нет смысла дожимать
+        createInfo.compressProgress = [this](float_t) {
+            return !IsDestroyed();
+        };
 
         m_id = m_pipeline->AllocateTexture(createInfo);
 
@@ -191,6 +196,14 @@ namespace SR_GTYPES_NS {
             }
         }
 
+        /// При пересоздании текстуры индекс в таблице сохраняется
+        if (m_tableIndex == SR_ID_INVALID) {
+            m_tableIndex = DescriptorManager::Instance().RegisterTexture(m_id);
+        }
+        else {
+            DescriptorManager::Instance().UpdateTexture(m_tableIndex, m_id);
+        }
+
         m_isCalculated = true;
 
         return true;
@@ -208,6 +221,10 @@ namespace SR_GTYPES_NS {
 
         SRAssert(m_pipeline);
 
+        if (m_tableIndex != SR_ID_INVALID) {
+            DescriptorManager::Instance().UnregisterTexture(&m_tableIndex);
+        }
+
         if (m_pipeline && !m_pipeline->FreeTexture(&m_id)) {
             SR_ERROR("Texture::FreeVideoMemory() : failed to free texture!");
         }
@@ -243,6 +260,14 @@ namespace SR_GTYPES_NS {
         return m_id;
     }
 
+    int32_t Texture::GetTableIndex() noexcept {
+        if (GetId() == SR_ID_INVALID) {
+            return SR_ID_INVALID;
+        }
+
+        return m_tableIndex;
+    }
+
     Texture* Texture::LoadFromMemory(const std::string& data, const Memory::TextureConfig &config) {
         SR_TRACY_ZONE;
 
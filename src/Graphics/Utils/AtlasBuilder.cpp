@@ -4,9 +4,28 @@
 //
 
 #include <Graphics/Utils/AtlasBuilder.h>
+#include <Graphics/Utils/ParallelFor.h>
 #include <Utils/Common/Hashes.h>
 
 namespace SR_GRAPH_NS {
+    namespace {
+        SR_NODISCARD uint32_t NextPowerOfTwo(uint32_t value) {
+            uint32_t result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        SR_NODISCARD uint32_t PreviousPowerOfTwo(uint32_t value) {
+            uint32_t result = 1;
+            while ((result << 1) <= value && (result << 1) != 0) {
+                result <<= 1;
+            }
+            return result;
+        }
+    }
+
     AtlasBuilder::AtlasBuilder(AtlasBuilderData data)
         : m_data(std::move(data))
     { }
@@ -43,8 +62,6 @@ namespace SR_GRAPH_NS {
 
         m_data.destination = m_data.destination.Concat("Atlas").ConcatExt(m_data.extension);
 
-        std::vector<SR_GRAPH_NS::TextureData::Ptr> spriteList;
-
         auto&& files = resourcePath.Concat(m_data.source).GetFiles();
 
         if (files.empty()) {
@@ -52,22 +69,7 @@ namespace SR_GRAPH_NS {
             return false;
         }
 
-        m_sprites.reserve(files.size());
-
-        for (auto&& filePath : files) {
-            auto&& sprite = SR_GRAPH_NS::TextureData::Load(filePath);
-
-            if (!sprite) {
-                continue;
-            }
-
-            m_totalSize.x += sprite->GetWidth();
-            m_totalSize.y += sprite->GetHeight();
-
-            m_sprites.emplace_back(sprite);
-        }
-
-        if (m_sprites.empty()) {
+        if (!LoadSprites(files)) {
             SR_ERROR("AtlasBuilder::Generate() : specified path does not contain any sprites. \nPath: \"" + m_data.source.ToString() + "\"");
             return false;
         }
@@ -91,20 +93,78 @@ namespace SR_GRAPH_NS {
         rootNode.AppendChild("SpriteSource").AppendAttribute("Value", m_data.source.ToString());
         rootNode.AppendChild("AtlasPath").AppendAttribute("Value", atlasPath);
         rootNode.AppendChild("IsSavedInCache").AppendAttribute("Value", m_data.saveInCache);
-        rootNode.AppendChild("QuantityOnX").AppendAttribute("Value", m_data.quantityOnAxes.x);
-        rootNode.AppendChild("QuantityOnY").AppendAttribute("Value", m_data.quantityOnAxes.y);
-        rootNode.AppendChild("WidthStep").AppendAttribute("Value", m_data.step.x);
-        rootNode.AppendChild("HeightStep").AppendAttribute("Value", m_data.step.y);
+        rootNode.AppendChild("IsPacked").AppendAttribute("Value", m_data.pack);
+
+        /// Сетка есть только у линейного атласа, у упакованного положение каждого спрайта хранится в Sprites
+        if (!m_data.pack) {
+            rootNode.AppendChild("QuantityOnX").AppendAttribute("Value", m_data.quantityOnAxes.x);
+            rootNode.AppendChild("QuantityOnY").AppendAttribute("Value", m_data.quantityOnAxes.y);
+            rootNode.AppendChild("WidthStep").AppendAttribute("Value", m_data.step.x);
+            rootNode.AppendChild("HeightStep").AppendAttribute("Value", m_data.step.y);
+        }
+
+        rootNode.AppendChild("PagesCount").AppendAttribute("Value", static_cast<uint32_t>(m_pages.size()));
+
+        auto&& spritesNode = rootNode.AppendNode("Sprites");
+
+        for (auto&& sprite : m_sprites) {
+            auto&& spriteNode = spritesNode.AppendNode("Sprite");
+            spriteNode.AppendAttribute("Name", sprite.name);
+            spriteNode.AppendAttribute("Page", sprite.page);
+            spriteNode.AppendAttribute("X", sprite.x);
+            spriteNode.AppendAttribute("Y", sprite.y);
+            spriteNode.AppendAttribute("Width", sprite.pTextureData->GetWidth());
+            spriteNode.AppendAttribute("Height", sprite.pTextureData->GetHeight());
+            spriteNode.AppendAttribute("Rotated", sprite.rotated);
+        }
 
         return document.Save(path.ConcatExt("xml"));
     }
 
+    bool AtlasBuilder::LoadSprites(const std::vector<SR_UTILS_NS::Path>& files) {
+        SR_TRACY_ZONE;
+
+        std::vector<SR_GRAPH_NS::TextureData::Ptr> loaded(files.size());
+
+        /// Декодирование не трогает общих данных, поэтому файлы разбираются рабочими потоками
+        ParallelFor(static_cast<uint32_t>(files.size()), 0, [&](uint32_t file) {
+            loaded[file] = SR_GRAPH_NS::TextureData::Load(files[file]);
+        });
+
+        m_sprites.reserve(files.size());
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(files.size()); ++i) {
+            if (!loaded[i]) {
+                continue;
+            }
+
+            /// Атлас копирует пиксели по 4 байта, спрайты должны быть загружены в RGBA
+            if (loaded[i]->GetFormat() != ImageLoadFormat::RGBA) {
+                SR_ERROR("AtlasBuilder::LoadSprites() : sprite is not in RGBA format, skipped!\n\tPath: " + files[i].ToStringRef());
+                continue;
+            }
+
+            m_totalSize.x += loaded[i]->GetWidth();
+            m_totalSize.y += loaded[i]->GetHeight();
+
+            auto&& sprite = m_sprites.emplace_back();
+            sprite.pTextureData = loaded[i];
+            sprite.name = files[i].GetBaseNameAndExt();
+        }
+
+        return !m_sprites.empty();
+    }
+
     bool AtlasBuilder::Create() {
+        if (m_data.pack) {
+            return CreatePackedAtlas();
+        }
+
         bool isSpritesSameSize = true;
 
-        auto&& maxSize = m_sprites.front()->GetSize();
-        for (auto&& pSprite : m_sprites) {
-            auto&& spriteSize = pSprite->GetSize();
+        auto&& maxSize = m_sprites.front().pTextureData->GetSize();
+        for (auto&& sprite : m_sprites) {
+            auto&& spriteSize = sprite.pTextureData->GetSize();
             if (spriteSize != maxSize) {
                 isSpritesSameSize = false;
                 maxSize.x = std::max(spriteSize.x, maxSize.x);
@@ -116,7 +176,7 @@ namespace SR_GRAPH_NS {
         if (isSpriteCountEven) {
             if (isSpritesSameSize) {
                 m_data.quantityOnAxes = {  static_cast<uint32_t>(m_sprites.size()), 1 };
-                m_data.step.x = m_sprites.front()->GetWidth();
+                m_data.step.x = m_sprites.front().pTextureData->GetWidth();
 
                 return CreateLinearAtlas();
             }
@@ -130,9 +190,9 @@ namespace SR_GRAPH_NS {
         // Calculate total width and height of the atlas
         uint32_t totalWidth = 0;
         uint32_t totalHeight = 0;
-        for (auto&& pSprite : m_sprites) {
-            totalWidth += pSprite->GetWidth();
-            totalHeight = std::max(totalHeight, pSprite->GetHeight());
+        for (auto&& sprite : m_sprites) {
+            totalWidth += sprite.pTextureData->GetWidth();
+            totalHeight = std::max(totalHeight, sprite.pTextureData->GetHeight());
         }
 
         // Allocate memory for the atlas
@@ -142,9 +202,12 @@ namespace SR_GRAPH_NS {
 
         // Copy each sprite into the atlas
         uint32_t currentWidth = 0;
-        for (auto&& pSprite : m_sprites) {
-            const auto&& spriteSize = pSprite->GetSize();
-            const auto&& spriteData = pSprite->GetData();
+        for (auto&& sprite : m_sprites) {
+            const auto&& spriteSize = sprite.pTextureData->GetSize();
+            const auto&& spriteData = sprite.pTextureData->GetData();
+
+            sprite.x = currentWidth;
+            sprite.y = 0;
 
             for (uint32_t y = 0; y < spriteSize.y; ++y) {
                 uint32_t offset = y * spriteSize.x * 4;
@@ -156,9 +219,9 @@ namespace SR_GRAPH_NS {
         }
 
         // Create the atlas texture
-        m_atlas = TextureData::Create(totalWidth, totalHeight, pGeneralData, [](uint8_t* pData) {
+        m_pages.emplace_back(TextureData::Create(totalWidth, totalHeight, pGeneralData, [](uint8_t* pData) {
             delete[] pData;
-        });
+        }));
 
         // Save the atlas
         if (!Save()) {
@@ -169,15 +232,220 @@ namespace SR_GRAPH_NS {
         return true;
     }
 
+    bool AtlasBuilder::CreatePackedAtlas() {
+        SR_TRACY_ZONE;
+
+        SR_MATH_NS::UVector2 maxPageSize = m_data.maxPageSize;
+        if (m_data.powerOfTwo) {
+            maxPageSize = SR_MATH_NS::UVector2(PreviousPowerOfTwo(maxPageSize.x), PreviousPowerOfTwo(maxPageSize.y));
+        }
+
+        for (auto&& sprite : m_sprites) {
+            auto&& slot = GetSlotSize(sprite);
+            const bool fits = slot.x <= maxPageSize.x + m_data.padding && slot.y <= maxPageSize.y + m_data.padding;
+            const bool fitsRotated = m_data.allowRotation && slot.y <= maxPageSize.x + m_data.padding && slot.x <= maxPageSize.y + m_data.padding;
+
+            if (!fits && !fitsRotated) {
+                SR_ERROR("AtlasBuilder::CreatePackedAtlas() : sprite is larger than the page!\n\tSprite: " + sprite.name);
+                return false;
+            }
+        }
+
+        /// Крупные спрайты раскладываются первыми, так упаковка плотнее
+        std::stable_sort(m_sprites.begin(), m_sprites.end(), [this](const AtlasSprite& left, const AtlasSprite& right) {
+            auto&& leftSize = GetSlotSize(left);
+            auto&& rightSize = GetSlotSize(right);
+
+            const uint32_t leftSide = SR_MAX(leftSize.x, leftSize.y);
+            const uint32_t rightSide = SR_MAX(rightSize.x, rightSize.y);
+
+            if (leftSide != rightSide) {
+                return leftSide > rightSide;
+            }
+
+            return leftSize.x * leftSize.y > rightSize.x * rightSize.y;
+        });
+
+        const auto spritesCount = static_cast<uint32_t>(m_sprites.size());
+
+        for (uint32_t begin = 0; begin < spritesCount; ) {
+            const auto page = static_cast<uint32_t>(m_pages.size());
+
+            SR_MATH_NS::UVector2 usedSize;
+            const uint32_t count = PackPage(begin, spritesCount, maxPageSize, usedSize);
+
+            if (count == 0) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("AtlasBuilder::CreatePackedAtlas() : failed to pack sprites!");
+                return false;
+            }
+
+            SR_MATH_NS::UVector2 pageSize = maxPageSize;
+
+            if (!m_data.fixedPageSize && m_data.powerOfTwo) {
+                pageSize = SR_MATH_NS::UVector2(NextPowerOfTwo(usedSize.x), NextPowerOfTwo(usedSize.y));
+
+                uint64_t spritesArea = 0;
+                for (uint32_t i = begin; i < begin + count; ++i) {
+                    auto&& slot = GetSlotSize(m_sprites[i]);
+                    spritesArea += static_cast<uint64_t>(slot.x) * slot.y;
+                }
+
+                /// Жадная раскладка на большой странице не самая плотная,
+                /// пробуем уложить те же спрайты в меньшие степени двойки
+                std::vector<SR_MATH_NS::UVector2> candidates;
+                for (uint32_t width = 1; width <= maxPageSize.x; width <<= 1) {
+                    for (uint32_t height = 1; height <= maxPageSize.y; height <<= 1) {
+                        const uint64_t area = static_cast<uint64_t>(width) * height;
+                        if (area >= spritesArea && area < static_cast<uint64_t>(pageSize.x) * pageSize.y) {
+                            candidates.emplace_back(width, height);
+                        }
+                    }
+                }
+
+                std::stable_sort(candidates.begin(), candidates.end(), [](const SR_MATH_NS::UVector2& left, const SR_MATH_NS::UVector2& right) {
+                    return static_cast<uint64_t>(left.x) * left.y < static_cast<uint64_t>(right.x) * right.y;
+                });
+
+                const std::vector<AtlasSprite> placed(m_sprites.begin() + begin, m_sprites.begin() + begin + count);
+                bool repacked = false;
+
+                for (auto&& candidate : candidates) {
+                    SR_MATH_NS::UVector2 candidateUsed;
+                    if (PackPage(begin, begin + count, candidate, candidateUsed) == count) {
+                        pageSize = candidate;
+                        repacked = true;
+                        break;
+                    }
+                    std::copy(placed.begin(), placed.end(), m_sprites.begin() + begin);
+                }
+
+                if (!repacked) {
+                    std::copy(placed.begin(), placed.end(), m_sprites.begin() + begin);
+                }
+            }
+            else if (!m_data.fixedPageSize) {
+                pageSize = usedSize;
+            }
+
+            const uint64_t size = static_cast<uint64_t>(pageSize.x) * pageSize.y * 4;
+            auto* pPageData = new uint8_t[size];
+            std::memset(pPageData, 0, size);
+
+            for (uint32_t i = begin; i < begin + count; ++i) {
+                m_sprites[i].page = page;
+                BlitSprite(pPageData, pageSize.x, pageSize.y, m_sprites[i]);
+            }
+
+            m_pages.emplace_back(TextureData::Create(pageSize.x, pageSize.y, pPageData, [](uint8_t* pData) {
+                delete[] pData;
+            }));
+
+            begin += count;
+        }
+
+        if (!Save()) {
+            SR_ERROR("AtlasBuilder::CreatePackedAtlas() : failed to save data.");
+            return false;
+        }
+
+        return true;
+    }
+
+    SR_MATH_NS::UVector2 AtlasBuilder::GetSlotSize(const AtlasSprite& sprite) const {
+        const uint32_t border = m_data.extrude * 2 + m_data.padding;
+        return SR_MATH_NS::UVector2(sprite.pTextureData->GetWidth() + border, sprite.pTextureData->GetHeight() + border);
+    }
+
+    uint32_t AtlasBuilder::PackPage(uint32_t begin, uint32_t end, const SR_MATH_NS::UVector2& pageSize, SR_MATH_NS::UVector2& usedSize) {
+        /// Отступ идет справа и снизу от спрайта, у края страницы он не нужен
+        RectPacker packer(m_data.packMethod, pageSize.x + m_data.padding, pageSize.y + m_data.padding, m_data.allowRotation);
+
+        uint32_t count = 0;
+
+        for (uint32_t i = begin; i < end; ++i) {
+            auto&& slot = GetSlotSize(m_sprites[i]);
+
+            PackedRect rect;
+            if (!packer.Insert(slot.x, slot.y, rect)) {
+                continue;
+            }
+
+            m_sprites[i].x = rect.x + m_data.extrude;
+            m_sprites[i].y = rect.y + m_data.extrude;
+            m_sprites[i].rotated = rect.rotated;
+
+            /// Уложенные спрайты собираются в начале диапазона, остальные уйдут на следующую страницу
+            std::swap(m_sprites[i], m_sprites[begin + count]);
+            ++count;
+        }
+
+        usedSize.x = packer.GetUsedWidth() > m_data.padding ? packer.GetUsedWidth() - m_data.padding : 0;
+        usedSize.y = packer.GetUsedHeight() > m_data.padding ? packer.GetUsedHeight() - m_data.padding : 0;
+
+        return count;
+    }
+
+    void AtlasBuilder::BlitSprite(uint8_t* pPage, uint32_t pageWidth, uint32_t pageHeight, const AtlasSprite& sprite) const {
+        auto&& pTextureData = sprite.pTextureData;
+        SRAssert(pTextureData->GetFormat() == ImageLoadFormat::RGBA);
+
+        const auto width = static_cast<int32_t>(pTextureData->GetWidth());
+        const auto height = static_cast<int32_t>(pTextureData->GetHeight());
+        const int32_t placedWidth = sprite.rotated ? height : width;
+        const int32_t placedHeight = sprite.rotated ? width : height;
+        const auto extrude = static_cast<int32_t>(m_data.extrude);
+
+        const uint8_t* pSource = pTextureData->GetData();
+
+        for (int32_t y = -extrude; y < placedHeight + extrude; ++y) {
+            const int32_t pageY = static_cast<int32_t>(sprite.y) + y;
+            if (pageY < 0 || pageY >= static_cast<int32_t>(pageHeight)) {
+                continue;
+            }
+
+            /// За краем спрайта повторяется ближайший крайний пиксель
+            const int32_t localY = std::clamp(y, 0, placedHeight - 1);
+
+            for (int32_t x = -extrude; x < placedWidth + extrude; ++x) {
+                const int32_t pageX = static_cast<int32_t>(sprite.x) + x;
+                if (pageX < 0 || pageX >= static_cast<int32_t>(pageWidth)) {
+                    continue;
+                }
+
+                const int32_t localX = std::clamp(x, 0, placedWidth - 1);
+
+                /// Поворот на 90 градусов по часовой стрелке
+                const int32_t sourceX = sprite.rotated ? localY : localX;
+                const int32_t sourceY = sprite.rotated ? height - 1 - localX : localY;
+
+                std::memcpy(
+                    pPage + (static_cast<size_t>(pageY) * pageWidth + pageX) * 4,
+                    pSource + (static_cast<size_t>(sourceY) * width + sourceX) * 4,
+                    4
+                );
+            }
+        }
+    }
+
+    SR_UTILS_NS::Path AtlasBuilder::GetPagePath(uint32_t page) const {
+        if (page == 0) {
+            return m_data.destination;
+        }
+
+        return m_data.destination.GetFolder().Concat("Atlas" + std::to_string(page)).ConcatExt(m_data.extension);
+    }
+
     bool AtlasBuilder::Save() const {
-        if (!m_atlas) {
+        if (m_pages.empty()) {
             SR_ERROR("AtlasBuilder::Save() : atlas is not created!");
             return false;
         }
 
-        if (!m_atlas->Save(m_data.destination)) {
-            SR_ERROR("AtlasBuilder::Save() : failed to save atlas to file!");
-            return false;
+        for (uint32_t page = 0; page < static_cast<uint32_t>(m_pages.size()); ++page) {
+            if (!m_pages[page]->Save(GetPagePath(page))) {
+                SR_ERROR("AtlasBuilder::Save() : failed to save atlas to file!");
+                return false;
+            }
         }
 
         if (!SaveConfig(m_data.destination)) {
@@ -0,0 +1,138 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Utils/Types/RawMesh.h>
+#include <Utils/Resources/ResourceManager.h>
+
+#include <Graphics/Utils/MeshLodCache.h>
+
+namespace SR_GRAPH_NS {
+    /// Меняется вместе с форматом файла или параметрами построения цепочки
+    static constexpr uint64_t SR_MESH_LOD_CACHE_VERSION = 1;
+
+    void MeshLodCache::Prepare(SR_HTYPES_NS::RawMesh* pRawMesh) {
+        SR_TRACY_ZONE;
+
+        if (!pRawMesh || !SR_UTILS_NS::Features::Instance().Enabled("MeshLod", true)) {
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_prepared.emplace(SR_FORMAT("{}|{}", pRawMesh->GetResourceId().c_str(), pRawMesh->GetReloadCount())).second) {
+                return;
+            }
+        }
+
+        auto&& sourcePath = SR_UTILS_NS::ResourceManager::Instance().GetResPath().Concat(pRawMesh->GetResourcePath());
+        const uint64_t hash = SR_UTILS_NS::CombineTwoHashes(sourcePath.GetFileHash(), SR_MESH_LOD_CACHE_VERSION);
+
+        const auto meshesCount = static_cast<uint32_t>(pRawMesh->GetMeshesCount());
+
+        for (uint32_t meshId = 0; meshId < meshesCount; ++meshId) {
+            auto&& cachePath = GetCachePath(pRawMesh, meshId);
+            auto&& cacheHashPath = cachePath.ConcatExt(".hash");
+
+            if (cacheHashPath.Exists(SR_UTILS_NS::Path::Type::File) && SR_UTILS_NS::FileSystem::ReadHashFromFile(cacheHashPath) == hash) {
+                continue;
+            }
+
+            auto&& vertices = pRawMesh->GetVertices(meshId);
+            auto&& indices = pRawMesh->GetIndices(meshId);
+
+            std::vector<MeshLodLevel> levels;
+
+            if (!vertices.empty() && !indices.empty()) {
+                const MeshSimplifier simplifier(&vertices[0].position, sizeof(vertices[0]), static_cast<uint32_t>(vertices.size()));
+                levels = simplifier.BuildLodChain(indices, MeshLodSettings());
+            }
+
+            if (!Save(cachePath, levels)) {
+                SR_ERROR("MeshLodCache::Prepare() : failed to save lods to file \"" + cachePath.ToStringRef() + "\"!");
+                continue;
+            }
+
+            if (!SR_UTILS_NS::FileSystem::WriteHashToFile(cacheHashPath, hash)) {
+                SR_ERROR("MeshLodCache::Prepare() : failed to write hash to file \"" + cacheHashPath.ToStringRef() + "\"!");
+            }
+        }
+    }
+
+    std::vector<MeshLodLevel> MeshLodCache::Load(SR_HTYPES_NS::RawMesh* pRawMesh, uint32_t meshId, uint32_t indicesCount, uint32_t verticesCount) const {
+        SR_TRACY_ZONE;
+
+        if (!pRawMesh) {
+            return { };
+        }
+
+        auto&& cachePath = GetCachePath(pRawMesh, meshId);
+        if (!cachePath.Exists(SR_UTILS_NS::Path::Type::File)) {
+            return { };
+        }
+
+        auto&& marshal = SR_HTYPES_NS::Marshal::Load(cachePath);
+        if (!marshal) {
+            SR_WARN("MeshLodCache::Load() : failed to load lods from file \"" + cachePath.ToStringRef() + "\"!");
+            return { };
+        }
+
+        if (marshal.Read<uint64_t>() != SR_MESH_LOD_CACHE_VERSION) {
+            return { };
+        }
+
+        const auto levelsCount = marshal.Read<uint32_t>();
+
+        if (levelsCount > MeshLodSettings().levels) {
+            SR_WARN("MeshLodCache::Load() : lods file is corrupted \"" + cachePath.ToStringRef() + "\"!");
+            return { };
+        }
+
+        std::vector<MeshLodLevel> levels(levelsCount);
+
+        for (auto&& level : levels) {
+            level.error = marshal.Read<float_t>();
+
+            /// Упрощенный уровень не может быть больше исходной сетки, иначе кеш поврежден или устарел
+            const auto size = marshal.Read<uint64_t>();
+
+            if (size > static_cast<uint64_t>(indicesCount) * sizeof(uint32_t) || size % (sizeof(uint32_t) * 3) != 0) {
+                SR_WARN("MeshLodCache::Load() : lods file is corrupted \"" + cachePath.ToStringRef() + "\"!");
+                return { };
+            }
+
+            level.indices.resize(size / sizeof(uint32_t));
+            marshal.Stream::Read(level.indices.data(), size);
+
+            for (auto&& index : level.indices) {
+                if (index >= verticesCount) {
+                    SR_WARN("MeshLodCache::Load() : lods file is corrupted \"" + cachePath.ToStringRef() + "\"!");
+                    return { };
+                }
+            }
+        }
+
+        return levels;
+    }
+
+    SR_UTILS_NS::Path MeshLodCache::GetCachePath(SR_HTYPES_NS::RawMesh* pRawMesh, uint32_t meshId) const {
+        return SR_UTILS_NS::ResourceManager::Instance().GetCachePath()
+            .Concat("Meshes")
+            .Concat(pRawMesh->GetResourcePath())
+            .ConcatExt(SR_FORMAT("{}.lod", meshId));
+    }
+
+    bool MeshLodCache::Save(const SR_UTILS_NS::Path& path, const std::vector<MeshLodLevel>& levels) const {
+        auto&& marshal = SR_HTYPES_NS::Marshal();
+
+        marshal.Write<uint64_t>(SR_MESH_LOD_CACHE_VERSION);
+        marshal.Write<uint32_t>(static_cast<uint32_t>(levels.size()));
+
+        for (auto&& level : levels) {
+            marshal.Write<float_t>(level.error);
+            marshal.WriteBlock((void*)level.indices.data(), level.indices.size() * sizeof(uint32_t));
+        }
+
+        return marshal.Save(path);
+    }
+}
@@ -0,0 +1,386 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Utils/MeshSimplifier.h>
+
+namespace SR_GRAPH_NS {
+    namespace {
+        struct PositionKey {
+            uint32_t x = 0, y = 0, z = 0;
+
+            bool operator==(const PositionKey& other) const noexcept {
+                return x == other.x && y == other.y && z == other.z;
+            }
+        };
+
+        struct PositionKeyHash {
+            SR_NODISCARD size_t operator()(const PositionKey& key) const noexcept {
+                size_t hash = 0;
+                hash = SR_UTILS_NS::HashCombine(key.x, hash);
+                hash = SR_UTILS_NS::HashCombine(key.y, hash);
+                hash = SR_UTILS_NS::HashCombine(key.z, hash);
+                return hash;
+            }
+        };
+
+        struct Collapse {
+            uint32_t from = 0;
+            uint32_t to = 0;
+            double_t cost = 0.0;
+        };
+
+        /// Ненормированная нормаль треугольника, ее длина равна удвоенной площади
+        void TriangleNormal(const float_t* a, const float_t* b, const float_t* c, double_t* pNormal) {
+            const double_t e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            const double_t e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+            pNormal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            pNormal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            pNormal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        /// Доля треугольников, которую должен убрать уровень, чтобы имело смысл его хранить
+        constexpr float_t MIN_LOD_GAIN = 0.9f;
+    }
+
+    void MeshSimplifier::Quadric::Add(const Quadric& other) {
+        a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+        b2 += other.b2; bc += other.bc; bd += other.bd;
+        c2 += other.c2; cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+
+    double_t MeshSimplifier::Quadric::Evaluate(float_t x, float_t y, float_t z) const {
+        const double_t rx = a2 * x + ab * y + ac * z + ad;
+        const double_t ry = ab * x + b2 * y + bc * z + bd;
+        const double_t rz = ac * x + bc * y + c2 * z + cd;
+        const double_t rw = ad * x + bd * y + cd * z + d2;
+
+        const double_t error = std::abs(rx * x + ry * y + rz * z + rw);
+
+        return weight > 0.0 ? error / weight : error;
+    }
+
+    MeshSimplifier::MeshSimplifier(const void* pPositions, uint32_t stride, uint32_t verticesCount)
+        : Super()
+        , m_positions(static_cast<const uint8_t*>(pPositions))
+        , m_stride(stride)
+        , m_verticesCount(verticesCount)
+    {
+        SR_TRACY_ZONE;
+
+        m_positionClass.resize(verticesCount);
+        m_seam.resize(verticesCount, false);
+
+        ska::flat_hash_map<PositionKey, uint32_t, PositionKeyHash> classes;
+        classes.reserve(verticesCount);
+
+        float_t min[3] = { std::numeric_limits<float_t>::max(), std::numeric_limits<float_t>::max(), std::numeric_limits<float_t>::max() };
+        float_t max[3] = { std::numeric_limits<float_t>::lowest(), std::numeric_limits<float_t>::lowest(), std::numeric_limits<float_t>::lowest() };
+
+        for (uint32_t vertex = 0; vertex < verticesCount; ++vertex) {
+            const float_t* pPosition = GetPosition(vertex);
+
+            PositionKey key;
+            memcpy(&key.x, pPosition + 0, sizeof(uint32_t));
+            memcpy(&key.y, pPosition + 1, sizeof(uint32_t));
+            memcpy(&key.z, pPosition + 2, sizeof(uint32_t));
+
+            auto&& [pIt, inserted] = classes.emplace(key, vertex);
+            m_positionClass[vertex] = pIt->second;
+
+            if (!inserted) {
+                m_seam[vertex] = true;
+                m_seam[pIt->second] = true;
+            }
+
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                min[axis] = SR_MIN(min[axis], pPosition[axis]);
+                max[axis] = SR_MAX(max[axis], pPosition[axis]);
+            }
+        }
+
+        if (verticesCount > 0) {
+            const float_t extents[3] = { (max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f };
+            m_radius = std::sqrt(extents[0] * extents[0] + extents[1] * extents[1] + extents[2] * extents[2]);
+        }
+    }
+
+    std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<uint32_t>& indices, uint32_t targetIndicesCount, float_t targetError, float_t* pError) const {
+        SR_TRACY_ZONE;
+
+        std::vector<uint32_t> result = indices;
+
+        if (pError) {
+            *pError = 0.f;
+        }
+
+        if (result.size() % 3 != 0) {
+            SR_ERROR("MeshSimplifier::Simplify() : indices count is not a multiple of 3!");
+            return result;
+        }
+
+        for (auto&& index : result) {
+            if (index >= m_verticesCount) SR_UNLIKELY_ATTRIBUTE {
+                SR_ERROR("MeshSimplifier::Simplify() : index out of range!");
+                return result;
+            }
+        }
+
+        if (result.size() <= targetIndicesCount) {
+            return result;
+        }
+
+        /// Квадрики и границы считаются по позициям, а не по вершинам,
+        /// иначе шов атрибутов выглядел бы как открытая граница
+        std::vector<Quadric> quadrics(m_verticesCount);
+
+        for (size_t i = 0; i < result.size(); i += 3) {
+            const float_t* a = GetPosition(result[i + 0]);
+            const float_t* b = GetPosition(result[i + 1]);
+            const float_t* c = GetPosition(result[i + 2]);
+
+            double_t normal[3];
+            TriangleNormal(a, b, c, normal);
+
+            const double_t length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length <= 0.0) {
+                continue;
+            }
+
+            const double_t nx = normal[0] / length, ny = normal[1] / length, nz = normal[2] / length;
+            const double_t d = -(nx * a[0] + ny * a[1] + nz * a[2]);
+            const double_t area = length * 0.5;
+
+            Quadric quadric;
+            quadric.a2 = area * nx * nx; quadric.ab = area * nx * ny; quadric.ac = area * nx * nz; quadric.ad = area * nx * d;
+            quadric.b2 = area * ny * ny; quadric.bc = area * ny * nz; quadric.bd = area * ny * d;
+            quadric.c2 = area * nz * nz; quadric.cd = area * nz * d;
+            quadric.d2 = area * d * d;
+            quadric.weight = area;
+
+            for (uint32_t k = 0; k < 3; ++k) {
+                quadrics[m_positionClass[result[i + k]]].Add(quadric);
+            }
+        }
+
+        std::vector<bool> locked(m_verticesCount, false);
+
+        for (uint32_t vertex = 0; vertex < m_verticesCount; ++vertex) {
+            locked[vertex] = m_seam[vertex];
+        }
+
+        {
+            ska::flat_hash_map<uint64_t, uint32_t> edges;
+            edges.reserve(result.size());
+
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    uint32_t a = m_positionClass[result[i + k]];
+                    uint32_t b = m_positionClass[result[i + (k + 1) % 3]];
+                    if (a > b) {
+                        std::swap(a, b);
+                    }
+                    ++edges[(static_cast<uint64_t>(a) << 32) | b];
+                }
+            }
+
+            for (auto&& [edge, count] : edges) {
+                if (count == 1) {
+                    locked[static_cast<uint32_t>(edge >> 32)] = true;
+                    locked[static_cast<uint32_t>(edge & 0xffffffffu)] = true;
+                }
+            }
+        }
+
+        const double_t errorLimit = static_cast<double_t>(targetError) * static_cast<double_t>(targetError);
+        double_t resultError = 0.0;
+
+        std::vector<uint32_t> remap(m_verticesCount);
+        std::vector<bool> touched(m_verticesCount);
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> adjacencyOffsets;
+        std::vector<uint32_t> adjacency;
+
+        while (result.size() > targetIndicesCount) {
+            collapses.clear();
+
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    for (uint32_t direction = 1; direction <= 2; ++direction) {
+                        const uint32_t from = result[i + k];
+                        const uint32_t to = result[i + (k + direction) % 3];
+
+                        /// Стягиваем только вершины без швов и границ, поэтому from - сам себе представитель
+                        if (locked[from]) {
+                            continue;
+                        }
+
+                        Quadric quadric = quadrics[from];
+                        quadric.Add(quadrics[m_positionClass[to]]);
+
+                        const float_t* pTo = GetPosition(to);
+                        collapses.emplace_back(Collapse { from, to, quadric.Evaluate(pTo[0], pTo[1], pTo[2]) });
+                    }
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right) {
+                return left.cost < right.cost;
+            });
+
+            adjacencyOffsets.assign(m_verticesCount + 1, 0);
+            adjacency.resize(result.size());
+
+            for (auto&& index : result) {
+                ++adjacencyOffsets[index + 1];
+            }
+
+            for (uint32_t vertex = 0; vertex < m_verticesCount; ++vertex) {
+                adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+            }
+
+            {
+                std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i) {
+                    adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            for (uint32_t vertex = 0; vertex < m_verticesCount; ++vertex) {
+                remap[vertex] = vertex;
+                touched[vertex] = false;
+            }
+
+            /// Каждое стягивание убирает примерно два треугольника
+            const size_t trianglesToRemove = (result.size() - targetIndicesCount) / 3;
+            size_t removed = 0;
+            uint32_t collapsed = 0;
+
+            for (auto&& collapse : collapses) {
+                if (collapse.cost > errorLimit || removed >= trianglesToRemove) {
+                    break;
+                }
+
+                if (touched[collapse.from] || touched[collapse.to] || touched[m_positionClass[collapse.to]]) {
+                    continue;
+                }
+
+                const float_t* pTo = GetPosition(collapse.to);
+                bool flipped = false;
+
+                for (uint32_t j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1] && !flipped; ++j) {
+                    const uint32_t* pTriangle = result.data() + adjacency[j] * 3;
+
+                    const float_t* positions[3];
+                    const float_t* moved[3];
+                    bool degenerate = false;
+
+                    for (uint32_t k = 0; k < 3; ++k) {
+                        positions[k] = GetPosition(pTriangle[k]);
+                        moved[k] = pTriangle[k] == collapse.from ? pTo : positions[k];
+                        degenerate |= m_positionClass[pTriangle[k]] == m_positionClass[collapse.to];
+                    }
+
+                    /// Треугольник на стягиваемом ребре исчезает, проверять его не нужно
+                    if (degenerate) {
+                        continue;
+                    }
+
+                    double_t before[3], after[3];
+                    TriangleNormal(positions[0], positions[1], positions[2], before);
+                    TriangleNormal(moved[0], moved[1], moved[2], after);
+
+                    flipped = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+                }
+
+                if (flipped) {
+                    continue;
+                }
+
+                /// Соседние треугольники меняются, в этом проходе их вершины больше не трогаем
+                for (uint32_t j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1]; ++j) {
+                    const uint32_t* pTriangle = result.data() + adjacency[j] * 3;
+                    for (uint32_t k = 0; k < 3; ++k) {
+                        touched[pTriangle[k]] = true;
+                        touched[m_positionClass[pTriangle[k]]] = true;
+                    }
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[m_positionClass[collapse.to]].Add(quadrics[collapse.from]);
+
+                resultError = SR_MAX(resultError, collapse.cost);
+                removed += 2;
+                ++collapsed;
+            }
+
+            if (collapsed == 0) {
+                break;
+            }
+
+            size_t write = 0;
+
+            for (size_t i = 0; i < result.size(); i += 3) {
+                const uint32_t a = remap[result[i + 0]];
+                const uint32_t b = remap[result[i + 1]];
+                const uint32_t c = remap[result[i + 2]];
+
+                if (m_positionClass[a] == m_positionClass[b] || m_positionClass[b] == m_positionClass[c] || m_positionClass[a] == m_positionClass[c]) {
+                    continue;
+                }
+
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+
+            result.resize(write);
+        }
+
+        if (pError) {
+            *pError = static_cast<float_t>(std::sqrt(resultError));
+        }
+
+        return result;
+    }
+
+    std::vector<MeshLodLevel> MeshSimplifier::BuildLodChain(const std::vector<uint32_t>& indices, const MeshLodSettings& settings) const {
+        SR_TRACY_ZONE;
+
+        std::vector<MeshLodLevel> levels;
+        levels.reserve(settings.levels);
+
+        const size_t minIndices = static_cast<size_t>(settings.minTriangles) * 3;
+        const float_t maxError = settings.maxRelativeError * m_radius;
+
+        const std::vector<uint32_t>* pSource = &indices;
+        float_t error = 0.f;
+
+        for (uint8_t level = 0; level < settings.levels; ++level) {
+            if (pSource->size() <= minIndices || error >= maxError) {
+                break;
+            }
+
+            const size_t triangles = pSource->size() / 3;
+            const auto targetIndices = static_cast<uint32_t>(SR_MAX(minIndices, static_cast<size_t>(static_cast<float_t>(triangles) * settings.reduction) * 3));
+
+            float_t levelError = 0.f;
+            auto&& simplified = Simplify(*pSource, targetIndices, maxError - error, &levelError);
+
+            if (simplified.empty() || static_cast<float_t>(simplified.size()) > static_cast<float_t>(pSource->size()) * MIN_LOD_GAIN) {
+                break;
+            }
+
+            /// Уровни строятся по цепочке, поэтому ошибки относительно исходной сетки складываются
+            error += levelError;
+
+            levels.emplace_back(MeshLodLevel { std::move(simplified), error });
+            pSource = &levels.back().indices;
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,102 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Utils/ParallelFor.h>
+
+namespace SR_GRAPH_NS {
+    ParallelForPool::ParallelForPool()
+        : Super()
+    {
+        /// Вызывающий поток сам выполняет задачи, поэтому рабочих на один меньше, чем ядер
+        const uint32_t threadsCount = SR_MAX(std::thread::hardware_concurrency(), 2u) - 1;
+
+        m_threads.reserve(threadsCount);
+
+        for (uint32_t i = 0; i < threadsCount; ++i) {
+            m_threads.emplace_back(&ParallelForPool::WorkerLoop, this);
+        }
+    }
+
+    ParallelForPool::~ParallelForPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_jobCondition.notify_all();
+
+        for (auto&& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void ParallelForPool::Run(Job& job) {
+        SR_TRACY_ZONE;
+
+        const uint32_t maxWorkers = SR_MIN(job.maxWorkers, GetThreadsCount());
+
+        if (maxWorkers > 0) SR_LIKELY_ATTRIBUTE {
+            {
+                std::lock_guard lock(m_mutex);
+                job.maxWorkers = maxWorkers;
+                m_jobs.emplace_back(&job);
+            }
+
+            if (maxWorkers == 1) {
+                m_jobCondition.notify_one();
+            }
+            else {
+                m_jobCondition.notify_all();
+            }
+        }
+
+        RunTasks(job);
+
+        std::unique_lock lock(m_mutex);
+
+        /// Все задачи уже разобраны, новые рабочие к заданию не подключатся
+        if (auto&& pIt = std::find(m_jobs.begin(), m_jobs.end(), &job); pIt != m_jobs.end()) {
+            m_jobs.erase(pIt);
+        }
+
+        /// Задание живет на стеке вызывающего, поэтому ждем, пока его не отпустит последний рабочий
+        m_doneCondition.wait(lock, [&job]() {
+            return job.workers == 0;
+        });
+    }
+
+    void ParallelForPool::WorkerLoop() {
+        std::unique_lock lock(m_mutex);
+
+        while (true) {
+            m_jobCondition.wait(lock, [this]() {
+                return m_stop || !m_jobs.empty();
+            });
+
+            if (m_stop) {
+                return;
+            }
+
+            Job& job = *m_jobs.front();
+
+            if (++job.workers >= job.maxWorkers) {
+                m_jobs.pop_front();
+            }
+
+            lock.unlock();
+            RunTasks(job);
+            lock.lock();
+
+            if (--job.workers == 0) {
+                m_doneCondition.notify_all();
+            }
+        }
+    }
+
+    void ParallelForPool::RunTasks(Job& job) {
+        for (uint32_t task = job.nextTask++; task < job.tasksCount; task = job.nextTask++) {
+            job.pInvoke(job.pFunction, task);
+        }
+    }
+}
@@ -0,0 +1,261 @@
+//
+// Created by Monika on 16.10.2026.
+//
+
+#include <Graphics/Utils/RectPacker.h>
+
+namespace SR_GRAPH_NS {
+    namespace {
+        SR_NODISCARD bool IsContainedIn(const PackedRect& inner, const PackedRect& outer) {
+            return inner.x >= outer.x && inner.y >= outer.y &&
+                inner.x + inner.width <= outer.x + outer.width &&
+                inner.y + inner.height <= outer.y + outer.height;
+        }
+    }
+
+    RectPacker::RectPacker(RectPackMethod method, uint32_t width, uint32_t height, bool allowRotation)
+        : Super()
+        , m_method(method)
+        , m_allowRotation(allowRotation)
+    {
+        Reset(width, height);
+    }
+
+    void RectPacker::Reset(uint32_t width, uint32_t height) {
+        m_width = width;
+        m_height = height;
+
+        m_usedWidth = 0;
+        m_usedHeight = 0;
+        m_usedArea = 0;
+
+        m_freeRects.clear();
+        m_skyline.clear();
+
+        if (m_method == RectPackMethod::MaxRects) {
+            m_freeRects.emplace_back(PackedRect { 0, 0, width, height, false });
+        }
+        else {
+            m_skyline.emplace_back(SkylineNode { 0, 0, width });
+        }
+    }
+
+    float_t RectPacker::GetOccupancy() const noexcept {
+        if (m_width == 0 || m_height == 0) {
+            return 0.f;
+        }
+
+        return static_cast<float_t>(static_cast<double_t>(m_usedArea) / (static_cast<double_t>(m_width) * m_height));
+    }
+
+    bool RectPacker::Insert(uint32_t width, uint32_t height, PackedRect& result) {
+        if (width == 0 || height == 0) {
+            return false;
+        }
+
+        const bool inserted = m_method == RectPackMethod::MaxRects ? InsertMaxRects(width, height, result) : InsertSkyline(width, height, result);
+
+        if (inserted) {
+            m_usedWidth = SR_MAX(m_usedWidth, result.x + result.width);
+            m_usedHeight = SR_MAX(m_usedHeight, result.y + result.height);
+            m_usedArea += static_cast<uint64_t>(width) * height;
+        }
+
+        return inserted;
+    }
+
+    bool RectPacker::InsertMaxRects(uint32_t width, uint32_t height, PackedRect& result) {
+        uint32_t bestShortSide = std::numeric_limits<uint32_t>::max();
+        uint32_t bestLongSide = std::numeric_limits<uint32_t>::max();
+        bool found = false;
+
+        auto&& tryPlace = [&](const PackedRect& freeRect, uint32_t w, uint32_t h, bool rotated) {
+            if (freeRect.width < w || freeRect.height < h) {
+                return;
+            }
+
+            const uint32_t leftoverX = freeRect.width - w;
+            const uint32_t leftoverY = freeRect.height - h;
+            const uint32_t shortSide = SR_MIN(leftoverX, leftoverY);
+            const uint32_t longSide = SR_MAX(leftoverX, leftoverY);
+
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                result = PackedRect { freeRect.x, freeRect.y, w, h, rotated };
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+                found = true;
+            }
+        };
+
+        for (auto&& freeRect : m_freeRects) {
+            tryPlace(freeRect, width, height, false);
+
+            if (m_allowRotation && width != height) {
+                tryPlace(freeRect, height, width, true);
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        SplitFreeRects(result);
+        PruneFreeRects();
+
+        return true;
+    }
+
+    void RectPacker::SplitFreeRects(const PackedRect& used) {
+        const size_t count = m_freeRects.size();
+
+        for (size_t i = 0; i < count; ++i) {
+            const PackedRect freeRect = m_freeRects[i];
+
+            if (used.x >= freeRect.x + freeRect.width || used.x + used.width <= freeRect.x ||
+                used.y >= freeRect.y + freeRect.height || used.y + used.height <= freeRect.y
+            ) {
+                continue;
+            }
+
+            /// Пересекающийся свободный прямоугольник заменяется до четырех максимальных остатков
+            if (used.x > freeRect.x) {
+                m_freeRects.emplace_back(PackedRect { freeRect.x, freeRect.y, used.x - freeRect.x, freeRect.height, false });
+            }
+
+            if (used.x + used.width < freeRect.x + freeRect.width) {
+                const uint32_t x = used.x + used.width;
+                m_freeRects.emplace_back(PackedRect { x, freeRect.y, freeRect.x + freeRect.width - x, freeRect.height, false });
+            }
+
+            if (used.y > freeRect.y) {
+                m_freeRects.emplace_back(PackedRect { freeRect.x, freeRect.y, freeRect.width, used.y - freeRect.y, false });
+            }
+
+            if (used.y + used.height < freeRect.y + freeRect.height) {
+                const uint32_t y = used.y + used.height;
+                m_freeRects.emplace_back(PackedRect { freeRect.x, y, freeRect.width, freeRect.y + freeRect.height - y, false });
+            }
+
+            m_freeRects[i].width = 0;
+        }
+
+        m_freeRects.erase(std::remove_if(m_freeRects.begin(), m_freeRects.end(), [](const PackedRect& rect) {
+            return rect.width == 0 || rect.height == 0;
+        }), m_freeRects.end());
+    }
+
+    void RectPacker::PruneFreeRects() {
+        for (size_t i = 0; i < m_freeRects.size(); ++i) {
+            for (size_t j = i + 1; j < m_freeRects.size(); ++j) {
+                if (IsContainedIn(m_freeRects[i], m_freeRects[j])) {
+                    m_freeRects.erase(m_freeRects.begin() + i);
+                    --i;
+                    break;
+                }
+
+                if (IsContainedIn(m_freeRects[j], m_freeRects[i])) {
+                    m_freeRects.erase(m_freeRects.begin() + j);
+                    --j;
+                }
+            }
+        }
+    }
+
+    bool RectPacker::InsertSkyline(uint32_t width, uint32_t height, PackedRect& result) {
+        uint32_t bestBottom = std::numeric_limits<uint32_t>::max();
+        uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+        uint32_t bestIndex = SR_ID_INVALID;
+
+        auto&& tryPlace = [&](uint32_t index, uint32_t w, uint32_t h, bool rotated) {
+            uint32_t y = 0;
+            if (!SkylineFits(index, w, h, y)) {
+                return;
+            }
+
+            /// Bottom left: ниже верхняя граница, при равенстве - уже участок горизонта
+            if (y + h < bestBottom || (y + h == bestBottom && m_skyline[index].width < bestWidth)) {
+                result = PackedRect { m_skyline[index].x, y, w, h, rotated };
+                bestBottom = y + h;
+                bestWidth = m_skyline[index].width;
+                bestIndex = index;
+            }
+        };
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_skyline.size()); ++i) {
+            tryPlace(i, width, height, false);
+
+            if (m_allowRotation && width != height) {
+                tryPlace(i, height, width, true);
+            }
+        }
+
+        if (bestIndex == SR_ID_INVALID) {
+            return false;
+        }
+
+        SkylineAddLevel(bestIndex, result);
+
+        return true;
+    }
+
+    bool RectPacker::SkylineFits(uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+        const uint32_t x = m_skyline[index].x;
+        if (x + width > m_width) {
+            return false;
+        }
+
+        int64_t widthLeft = width;
+        y = m_skyline[index].y;
+
+        while (widthLeft > 0) {
+            if (index >= m_skyline.size()) {
+                return false;
+            }
+
+            y = SR_MAX(y, m_skyline[index].y);
+            if (y + height > m_height) {
+                return false;
+            }
+
+            widthLeft -= m_skyline[index].width;
+            ++index;
+        }
+
+        return true;
+    }
+
+    void RectPacker::SkylineAddLevel(uint32_t index, const PackedRect& rect) {
+        m_skyline.insert(m_skyline.begin() + index, SkylineNode { rect.x, rect.y + rect.height, rect.width });
+
+        /// Участки, перекрытые новым, обрезаются или удаляются
+        for (size_t i = index + 1; i < m_skyline.size(); ++i) {
+            auto&& previous = m_skyline[i - 1];
+            auto&& node = m_skyline[i];
+
+            if (node.x >= previous.x + previous.width) {
+                break;
+            }
+
+            const uint32_t shrink = previous.x + previous.width - node.x;
+
+            if (node.width <= shrink) {
+                m_skyline.erase(m_skyline.begin() + i);
+                --i;
+                continue;
+            }
+
+            node.x += shrink;
+            node.width -= shrink;
+            break;
+        }
+
+        /// Соседние участки на одной высоте склеиваются
+        for (size_t i = 0; i + 1 < m_skyline.size(); ++i) {
+            if (m_skyline[i].y == m_skyline[i + 1].y) {
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + i + 1);
+                --i;
+            }
+        }
+    }
+}